@@ -15,6 +15,8 @@ src/C4AulParse.cpp
 src/C4AulScriptStrict.h
 src/C4Awaiter.cpp
 src/C4Awaiter.h
+src/C4Benchmark.cpp
+src/C4Benchmark.h
 src/C4ChatDlg.cpp
 src/C4ChatDlg.h
 src/C4Client.cpp
@@ -51,6 +53,7 @@ src/C4Effect.cpp
 src/C4Effects.h
 src/C4EnumeratedObjectPtr.cpp
 src/C4EnumeratedObjectPtr.h
+src/C4EventQueue.h
 src/C4Extra.cpp
 src/C4Extra.h
 src/C4Facet.cpp
@@ -64,6 +67,8 @@ src/C4FileSelDlg.cpp
 src/C4FileSelDlg.h
 src/C4FindObject.cpp
 src/C4FindObject.h
+src/C4FoWGrid.cpp
+src/C4FoWGrid.h
 src/C4Folder.cpp
 src/C4Folder.h
 src/C4Fonts.cpp
@@ -142,6 +147,7 @@ src/C4LangStringTable.cpp
 src/C4LangStringTable.h
 src/C4Language.cpp
 src/C4Language.h
+src/C4LayoutCache.h
 src/C4League.cpp
 src/C4League.h
 src/C4LoaderScreen.cpp
@@ -175,6 +181,7 @@ src/C4NameList.cpp
 src/C4NameList.h
 src/C4NetIO.cpp
 src/C4NetIO.h
+src/C4NetIOPacketRing.h
 src/C4Network2.cpp
 src/C4Network2.h
 src/C4Network2Address.cpp
@@ -195,6 +202,8 @@ src/C4Network2Reference.cpp
 src/C4Network2Reference.h
 src/C4Network2Res.cpp
 src/C4Network2Res.h
+src/C4Network2ResCache.cpp
+src/C4Network2ResCache.h
 src/C4Network2ResDlg.cpp
 src/C4Network2Stats.cpp
 src/C4Network2Stats.h
@@ -214,6 +223,7 @@ src/C4ObjectListDlg.cpp
 src/C4ObjectListDlg.h
 src/C4ObjectMenu.cpp
 src/C4ObjectMenu.h
+src/C4ObjectNumberIndex.h
 src/C4OpenURL.h
 src/C4PXS.cpp
 src/C4PXS.h
@@ -233,6 +243,8 @@ src/C4PlayerInfoListBox.cpp
 src/C4PlayerInfoListBox.h
 src/C4PlayerList.cpp
 src/C4PlayerList.h
+src/C4Pool.cpp
+src/C4Pool.h
 src/C4PropertyDlg.cpp
 src/C4PropertyDlg.h
 src/C4PuncherPacket.cpp
@@ -311,6 +323,8 @@ src/C4Toast.h
 src/C4ToastEventHandler.h
 src/C4ToolsDlg.cpp
 src/C4ToolsDlg.h
+src/C4TrackedObjectPtr.cpp
+src/C4TrackedObjectPtr.h
 src/C4TransferZone.cpp
 src/C4TransferZone.h
 src/C4UpdateDlg.cpp
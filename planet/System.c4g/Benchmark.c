@@ -0,0 +1,21 @@
+/*-- Functions called by the /benchcalls chat command, which times script calls --*/
+
+#strict 3
+
+// engine calls with the parameter counts of timer, effect and Hit/Contact callbacks
+global func BenchmarkCall0() { return 0; }
+global func BenchmarkCall2(int xdir, int ydir) { return xdir; }
+global func BenchmarkCall5(object target, int number, int a, int b, int c) { return number; }
+// functions using Par() still get all parameter slots
+global func BenchmarkCallPar() { return Par(0); }
+
+// script to script calls
+global func BenchmarkScriptCalls(int count)
+{
+  for (var i = 0; i < count; ++i)
+  {
+    BenchmarkCall0();
+    BenchmarkCall2(i, i);
+  }
+  return count;
+}
@@ -19,6 +19,7 @@
 #include <C4Include.h>
 #include <C4Application.h>
 #include <C4Version.h>
+#include <C4Benchmark.h>
 #ifdef _WIN32
 #include <StdRegistry.h>
 #include <C4UpdateDlg.h>
@@ -372,6 +373,8 @@ void C4Application::Quit()
 
 void C4Application::QuitGame()
 {
+	// benchmark: store results and continue with the next record
+	if (Benchmark) Benchmark->OnGameFinished();
 	// reinit desired? Do restart
 	if (UseStartupDialog || NextMission)
 	{
@@ -392,8 +395,12 @@ void C4Application::QuitGame()
 			SReplaceChar(Game.ScenarioFilename, '\\', DirSep[0]); // linux/mac: make sure we are using forward slashes
 			Game.fLobby = Game.NetworkActive = fWasNetworkActive;
 			if (fWasNetworkActive) Game.Network.SetPassword(password.getData());
-			Game.DefinitionFilenames = defs;
-			Game.FixedDefinitions = true;
+			// benchmark records each bring their own definitions
+			if (!Benchmark)
+			{
+				Game.DefinitionFilenames = defs;
+				Game.FixedDefinitions = true;
+			}
 			Game.fObserve = false;
 			NextMission.Clear();
 		}
@@ -31,8 +31,10 @@
 #include "StdApp.h"
 #include <StdWindow.h>
 
+#include <memory>
 #include <optional>
 
+class C4Benchmark;
 class C4ToastSystem;
 class CStdDDraw;
 
@@ -93,6 +95,8 @@ public:
 	StdStrBuf IncomingUpdate;
 	// set by ParseCommandLine, for manually invoking an update check by command line or url
 	bool CheckForUpdates;
+	// set by ParseCommandLine, for replaying a folder of records as benchmark
+	std::unique_ptr<C4Benchmark> Benchmark;
 	// Flag for launching editor on quit
 	bool launchEditor;
 	// Flag for restarting the engine at the end
@@ -95,6 +95,8 @@ public:
 		SoundFile &operator=(const SoundFile &) = delete;
 
 		virtual std::uint32_t GetDuration() const = 0;
+		// Size of the decoded sample data in bytes
+		virtual std::size_t GetSize() const = 0;
 	};
 
 	virtual SoundFile *CreateSoundFile(const void *buf, std::size_t size) = 0;
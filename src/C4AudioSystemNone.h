@@ -53,6 +53,7 @@ public:
 	public:
 		SoundFileNone() = default;
 		std::uint32_t GetDuration() const override { return 0u; }
+		std::size_t GetSize() const override { return 0u; }
 	};
 
 	SoundFile *CreateSoundFile(const void *, std::size_t) override { return new SoundFileNone{}; }
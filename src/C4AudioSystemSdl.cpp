@@ -116,6 +116,7 @@ public:
 
 	public:
 		std::uint32_t GetDuration() const override;
+		std::size_t GetSize() const override { return sample->alen; }
 
 	private:
 		const SDLMixChunkUniquePtr sample;
@@ -421,6 +421,7 @@ void C4AulScriptFunc::CopyBody(C4AulScriptFunc &FromFunc)
 	Script = FromFunc.Script;
 	VarNamed = FromFunc.VarNamed;
 	ParNamed = FromFunc.ParNamed;
+	ParSlots = FromFunc.ParSlots;
 	bNewFormat = FromFunc.bNewFormat;
 	bReturnRef = FromFunc.bReturnRef;
 	pOrgScript = FromFunc.pOrgScript;
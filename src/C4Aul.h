@@ -31,8 +31,10 @@
 #include <C4Script.h>
 #include <C4StringTable.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <list>
+#include <type_traits>
 #include <vector>
 
 // class predefs
@@ -104,21 +106,24 @@ enum C4AulAccess
 struct C4AulParSet
 {
 	C4Value Par[C4AUL_MAX_Par];
+	int Count{0}; // number of leading parameters actually passed; the rest is nil
 
 	C4AulParSet() {}
-	C4AulParSet(const C4Value &par0, const C4Value &par1 = C4Value(), const C4Value &par2 = C4Value(), const C4Value &par3 = C4Value(), const C4Value &par4 = C4Value(),
-		const C4Value &par5 = C4Value(), const C4Value &par6 = C4Value(), const C4Value &par7 = C4Value(), const C4Value &par8 = C4Value(), const C4Value &par9 = C4Value())
+
+	template<typename... Args> requires (sizeof...(Args) > 0 && sizeof...(Args) <= C4AUL_MAX_Par && (std::is_convertible_v<const Args &, const C4Value &> && ...))
+	C4AulParSet(const Args &... pars) : Count{sizeof...(Args)}
 	{
-		Par[0].Set(par0); Par[1].Set(par1); Par[2].Set(par2); Par[3].Set(par3); Par[4].Set(par4);
-		Par[5].Set(par5); Par[6].Set(par6); Par[7].Set(par7); Par[8].Set(par8); Par[9].Set(par9);
+		int i{0};
+		(Par[i++].Set(pars), ...);
 	}
 
-	C4Value &operator[](int iIdx) { return Par[iIdx]; }
+	// writing a parameter counts it as passed, reading doesn't
+	void Set(int iIdx, const C4Value &value) { Count = std::max(Count, iIdx + 1); Par[iIdx].Set(value); }
 	const C4Value &operator[](int iIdx) const { return Par[iIdx]; }
 };
 
-#define Copy2ParSet8(Pars, Vars) Pars[0].Set(Vars##0); Pars[1].Set(Vars##1); Pars[2].Set(Vars##2); Pars[3].Set(Vars##3); Pars[4].Set(Vars##4); Pars[5].Set(Vars##5); Pars[6].Set(Vars##6); Pars[7].Set(Vars##7);
-#define Copy2ParSet9(Pars, Vars) Pars[0].Set(Vars##0); Pars[1].Set(Vars##1); Pars[2].Set(Vars##2); Pars[3].Set(Vars##3); Pars[4].Set(Vars##4); Pars[5].Set(Vars##5); Pars[6].Set(Vars##6); Pars[7].Set(Vars##7); Pars[8].Set(Vars##8);
+#define Copy2ParSet8(Pars, Vars) Pars.Set(0, Vars##0); Pars.Set(1, Vars##1); Pars.Set(2, Vars##2); Pars.Set(3, Vars##3); Pars.Set(4, Vars##4); Pars.Set(5, Vars##5); Pars.Set(6, Vars##6); Pars.Set(7, Vars##7);
+#define Copy2ParSet9(Pars, Vars) Pars.Set(0, Vars##0); Pars.Set(1, Vars##1); Pars.Set(2, Vars##2); Pars.Set(3, Vars##3); Pars.Set(4, Vars##4); Pars.Set(5, Vars##5); Pars.Set(6, Vars##6); Pars.Set(7, Vars##7); Pars.Set(8, Vars##8);
 
 // byte code chunk type
 // some special script functions defined hard-coded to reduce the exec context
@@ -244,6 +249,7 @@ extern C4ScriptOpDef C4ScriptOpMap[];
 struct C4AulBCC
 {
 	C4AulBCCType bccType; // chunk type
+	std::int32_t bccParCnt; // number of passed parameters (calls only)
 	std::intptr_t bccX;
 	const char *SPos;
 };
@@ -303,6 +309,7 @@ public:
 	// Wether this function should be visible to players
 	virtual bool GetPublic() { return false; }
 	virtual int GetParCount() { return C4AUL_MAX_Par; }
+	virtual int GetParSlots() { return GetParCount(); } // parameters that must be present on the stack when called; missing ones are pushed as nil
 	virtual const C4V_Type *GetParType() { return nullptr; }
 	virtual C4V_Type GetRetType() { return C4V_Any; }
 	virtual C4Value Exec(C4AulContext *pCallerCtx, const C4Value pPars[], bool fPassErrors = false) { return C4Value(); } // execute func (script call)
@@ -341,13 +348,14 @@ public:
 	C4ValueMapNames VarNamed; // list of named vars in this function
 	C4ValueMapNames ParNamed; // list of named pars in this function
 	C4V_Type ParType[C4AUL_MAX_Par]; // parameter types
+	int ParSlots; // parameters accessed by the function: named ones only, or all if Par() or ... is used
 	bool bNewFormat; // new func format? [ func xyz(par abc) { ... } ]
 	bool bReturnRef; // return reference
 	C4AulScript *pOrgScript; // the original script (!= Owner if included or appended)
 
 	C4AulScriptFunc(C4AulScript *pOwner, const char *pName, bool bAtEnd = true) : C4AulFunc(pOwner, pName, bAtEnd),
 		idImage(C4ID_None), iImagePhase(0), Condition(nullptr), ControlMethod(C4AUL_ControlMethod_All), OwnerOverloaded(nullptr),
-		bReturnRef(false), tProfileTime(0)
+		ParSlots(C4AUL_MAX_Par), bReturnRef(false), tProfileTime(0)
 	{
 		for (int i = 0; i < C4AUL_MAX_Par; i++) ParType[i] = C4V_Any;
 	}
@@ -355,6 +363,7 @@ public:
 	virtual void UnLink() override;
 
 	virtual bool GetPublic() override { return true; }
+	virtual int GetParSlots() override { return ParSlots; }
 	virtual const C4V_Type *GetParType() override { return ParType; }
 	virtual C4V_Type GetRetType() override { return bReturnRef ? C4V_pC4Value : C4V_Any; }
 	virtual C4Value Exec(C4AulContext *pCallerCtx, const C4Value pPars[], bool fPassErrors = false) override; // execute func (script call, should not happen)
@@ -429,6 +438,8 @@ public:
 	static void Abort();
 	static void StartProfiling(C4AulScript *pScript);
 	static void StopProfiling();
+	// times iCalls calls of each of the Benchmark* functions of System.c4g (/benchcalls)
+	static bool BenchmarkCalls(int32_t iCalls);
 };
 
 C4LOGGERCONFIG_NAME_TYPE(C4AulProfiler);
@@ -480,7 +491,7 @@ protected:
 	C4AulFunc *GetOverloadedFunc(C4AulFunc *ByFunc);
 	C4AulFunc *GetFunc(const char *pIdtf); // get local function by name
 
-	void AddBCC(C4AulBCCType eType, std::intptr_t = 0, const char *SPos = nullptr); // add byte code chunk and advance
+	void AddBCC(C4AulBCCType eType, std::intptr_t = 0, const char *SPos = nullptr, std::int32_t iParCnt = 0); // add byte code chunk and advance
 	bool Preparse(); // preparse script; return if successful
 	void ParseFn(C4AulScriptFunc *Fn, bool fExprOnly = false); // parse single script function
 
@@ -26,7 +26,10 @@
 #include <C4ValueHash.h>
 #include <C4Wrappers.h>
 
+#include <array>
+#include <chrono>
 #include <format>
+#include <utility>
 
 C4AulExecError::C4AulExecError(C4Object *pObj, const std::string_view error)
 	: cObj(pObj)
@@ -127,7 +130,8 @@ private:
 	C4AulScript *pProfiledScript;
 
 public:
-	C4Value Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value pPars[], bool fPassErrors, bool fTemporaryScript = false);
+	C4Value Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value pPars[], int iParCnt, bool fPassErrors, bool fTemporaryScript = false);
+	C4Value Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4AulParSet &Pars, bool fPassErrors, bool nonStrict3WarnConversionOnly, bool convertNilToIntBool); // engine call
 	C4Value Exec(C4AulBCC *pCPos, bool fPassErrors);
 
 	void StartTrace();
@@ -322,19 +326,65 @@ private:
 			CheckOpPar<false>(pCurVal, C4ScriptOpMap[iOpID].Type1, C4ScriptOpMap[iOpID].Identifier);
 	}
 
-	C4AulBCC *Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4Object *pObj = nullptr, C4Def *pDef = nullptr, bool globalContext = false);
+	C4AulBCC *Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, int iParCnt, C4Object *pObj = nullptr, C4Def *pDef = nullptr, bool globalContext = false);
+
+private:
+	int PushPars(C4AulScriptFunc *pSFunc, const C4Value *pnPars, int iParCnt);
+	C4Value ExecPushed(C4AulScriptFunc *pSFunc, C4Object *pObj, C4Value *pPars, bool fPassErrors, bool fTemporaryScript);
 };
 
 C4AulExec AulExec;
 
-C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value *pnPars, bool fPassErrors, bool fTemporaryScript)
+static bool TryCheckConvertFunctionParameters(C4Object *const ctxObject, C4AulFunc *const pFunc, C4Value *pPars, int iParCnt, const bool convertToAnyEagerly, const bool convertNilToIntBool, bool passErrors, bool onlyWarn);
+
+int C4AulExec::PushPars(C4AulScriptFunc *pSFunc, const C4Value *pnPars, int iParCnt)
+{
+	// Push passed parameters only; slots the function accesses but which were not passed are nil
+	for (int i = 0; i < iParCnt; i++)
+		PushValue(pnPars[i]);
+	if (iParCnt < pSFunc->ParSlots)
+	{
+		PushNullVals(pSFunc->ParSlots - iParCnt);
+		iParCnt = pSFunc->ParSlots;
+	}
+	return iParCnt;
+}
+
+C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value *pnPars, int iParCnt, bool fPassErrors, bool fTemporaryScript)
 {
-	// Push parameters
 	C4Value *pPars = pCurVal + 1;
-	if (pnPars)
-		for (int i = 0; i < C4AUL_MAX_Par; i++)
-			PushValue(pnPars[i]);
+	PushPars(pSFunc, pnPars, iParCnt);
+	return ExecPushed(pSFunc, pObj, pPars, fPassErrors, fTemporaryScript);
+}
+
+C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4AulParSet &Pars, bool fPassErrors, bool nonStrict3WarnConversionOnly, bool convertNilToIntBool)
+{
+	C4Value *pPars = pCurVal + 1;
+	const int iParCnt{PushPars(pSFunc, Pars.Par, Pars.Count)};
+
+	// Typecheck on the stack
+	const auto isAtLeastStrict3 = pSFunc->HasStrictNil();
+	bool fOk;
+	try
+	{
+		fOk = TryCheckConvertFunctionParameters(pObj, pSFunc, pPars, iParCnt, !isAtLeastStrict3, isAtLeastStrict3 && convertNilToIntBool, fPassErrors, nonStrict3WarnConversionOnly && !isAtLeastStrict3);
+	}
+	catch (const C4AulError &)
+	{
+		PopValuesUntil(pPars - 1);
+		throw;
+	}
+	if (!fOk)
+	{
+		PopValuesUntil(pPars - 1);
+		return C4VNull;
+	}
 
+	return ExecPushed(pSFunc, pObj, pPars, fPassErrors, false);
+}
+
+C4Value C4AulExec::ExecPushed(C4AulScriptFunc *pSFunc, C4Object *pObj, C4Value *pPars, bool fPassErrors, bool fTemporaryScript)
+{
 	// Push variables
 	C4Value *pVars = pCurVal + 1;
 	PushNullVals(pSFunc->VarNamed.iSize);
@@ -1101,11 +1151,11 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				{
 					throw C4AulExecError(pCurCtx->Obj, std::format("Insufficient access level for function \"{}\"!", +pFunc->Name));
 				}
-				C4Value *pPars = pCurVal - pFunc->GetParCount() + 1;
+				C4Value *pPars = pCurVal - pCPos->bccParCnt + 1;
 				// Save current position
 				pCurCtx->CPos = pCPos;
 				// Do the call
-				C4AulBCC *pJump = Call(pFunc, pPars, pPars, nullptr);
+				C4AulBCC *pJump = Call(pFunc, pPars, pPars, pCPos->bccParCnt, nullptr);
 				if (pJump)
 				{
 					pCPos = pJump;
@@ -1218,8 +1268,8 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			case AB_CALLGLOBAL:
 			{
 				const auto isGlobal = pCPos->bccType == AB_CALLGLOBAL;
-				C4Value *pPars = pCurVal - C4AUL_MAX_Par + 1;
-				C4Value *pTargetVal = pCurVal - C4AUL_MAX_Par;
+				C4Value *pPars = pCurVal - pCPos->bccParCnt + 1;
+				C4Value *pTargetVal = pPars - 1;
 
 				// Check for call to null
 				if (!isGlobal && !*pTargetVal)
@@ -1294,7 +1344,7 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				pCurCtx->CPos = pCPos;
 
 				// Call function
-				C4AulBCC *pNewCPos = Call(pFunc, pTargetVal, pPars, pDestObj, pDestDef, isGlobal);
+				C4AulBCC *pNewCPos = Call(pFunc, pTargetVal, pPars, pCPos->bccParCnt, pDestObj, pDestDef, isGlobal);
 				if (pNewCPos)
 				{
 					// Jump
@@ -1361,12 +1411,13 @@ static void ErrorOrWarning(C4Object *context, const std::string_view message, bo
 	}
 }
 
-static bool CheckConvertFunctionParameters(C4Object *const ctxObject, C4AulFunc *const pFunc, C4Value *pPars, const bool convertToAnyEagerly, const bool convertNilToIntBool, bool onlyWarn = false)
+static bool CheckConvertFunctionParameters(C4Object *const ctxObject, C4AulFunc *const pFunc, C4Value *pPars, const int iParCnt, const bool convertToAnyEagerly, const bool convertNilToIntBool, bool onlyWarn = false)
 {
 	auto ok = true;
 	// Convert parameters (typecheck)
 	const auto pTypes = pFunc->GetParType();
-	for (int i = 0; i < pFunc->GetParCount(); i++)
+	const auto count = std::min(iParCnt, pFunc->GetParCount());
+	for (int i = 0; i < count; i++)
 	{
 		if (convertToAnyEagerly && pTypes[i] != C4V_pC4Value && !pPars[i])
 		{
@@ -1396,11 +1447,11 @@ static bool CheckConvertFunctionParameters(C4Object *const ctxObject, C4AulFunc
 	return ok || onlyWarn;
 }
 
-static bool TryCheckConvertFunctionParameters(C4Object *const ctxObject, C4AulFunc *const pFunc, C4Value *pPars, const bool convertToAnyEagerly, const bool convertNilToIntBool, bool passErrors, bool onlyWarn)
+static bool TryCheckConvertFunctionParameters(C4Object *const ctxObject, C4AulFunc *const pFunc, C4Value *pPars, const int iParCnt, const bool convertToAnyEagerly, const bool convertNilToIntBool, bool passErrors, bool onlyWarn)
 {
 	try
 	{
-		return CheckConvertFunctionParameters(ctxObject, pFunc, pPars, convertToAnyEagerly, convertNilToIntBool, onlyWarn);
+		return CheckConvertFunctionParameters(ctxObject, pFunc, pPars, iParCnt, convertToAnyEagerly, convertNilToIntBool, onlyWarn);
 	}
 	catch (const C4AulError &e)
 	{
@@ -1414,7 +1465,7 @@ static bool TryCheckConvertFunctionParameters(C4Object *const ctxObject, C4AulFu
 	}
 }
 
-C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4Object *pObj, C4Def *pDef, bool globalContext)
+C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, int iParCnt, C4Object *pObj, C4Def *pDef, bool globalContext)
 {
 	// No object given? Use current context
 	if (globalContext)
@@ -1436,7 +1487,14 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 
 	const bool convertNilToIntBool = convertToAnyEagerly && pSFunc && pSFunc->HasStrictNil();
 
-	CheckConvertFunctionParameters(pCurCtx->Obj, pFunc, pPars, convertToAnyEagerly, convertNilToIntBool);
+	// Parameters the callee accesses but which were not passed are nil
+	if (const int iParSlots{pFunc->GetParSlots()}; iParCnt < iParSlots)
+	{
+		PushNullVals(iParSlots - iParCnt);
+		iParCnt = iParSlots;
+	}
+
+	CheckConvertFunctionParameters(pCurCtx->Obj, pFunc, pPars, iParCnt, convertToAnyEagerly, convertNilToIntBool);
 
 	if (pSFunc)
 	{
@@ -1479,7 +1537,7 @@ C4AulBCC *C4AulExec::Call(C4AulFunc *pFunc, C4Value *pReturn, C4Value *pPars, C4
 				callText = std::format("Object({}): ", pObj->Number);
 			callText += pFunc->Name;
 			callText += '(';
-			for (int i = 0; i < C4AUL_MAX_Par; ++i)
+			for (int i = 0; i < iParCnt; ++i)
 			{
 				if (i) callText += ',';
 				C4Value &rV = pPars[i];
@@ -1579,6 +1637,40 @@ void C4AulProfiler::Abort()
 	AulExec.AbortProfiling();
 }
 
+bool C4AulProfiler::BenchmarkCalls(const int32_t iCalls)
+{
+	const auto logger = Application.LogSystem.CreateLogger(Config.Logging.AulProfiler);
+	const auto timeCalls = [&logger](const char *const szFunc, const C4AulParSet &pars, const int32_t iRepeat, const int32_t iCallsPerExec)
+	{
+		C4AulFunc *const pFunc{Game.ScriptEngine.GetFirstFunc(szFunc)};
+		if (!pFunc)
+		{
+			logger->error("{} not found (System.c4g too old?)", szFunc);
+			return false;
+		}
+		const auto start = std::chrono::steady_clock::now();
+		for (int32_t i = 0; i < iRepeat; ++i)
+			pFunc->Exec(nullptr, pars);
+		const std::chrono::duration<double, std::nano> time{std::chrono::steady_clock::now() - start};
+		logger->info("{}: {} calls in {:.1f} ms, {:.0f} ns per call", szFunc, iRepeat * iCallsPerExec, time.count() / 1e6, time.count() / (iRepeat * iCallsPerExec));
+		return true;
+	};
+
+	// engine calls, as for callbacks
+	C4AulParSet pars5;
+	for (int i = 0; i < 5; ++i) pars5.Set(i, C4VInt(i));
+	const std::array<std::pair<const char *, C4AulParSet>, 4> engineCalls{{
+		{"BenchmarkCall0", C4AulParSet{}},
+		{"BenchmarkCall2", C4AulParSet{C4VInt(1), C4VInt(2)}},
+		{"BenchmarkCall5", pars5},
+		{"BenchmarkCallPar", C4AulParSet{C4VInt(1)}}
+	}};
+	for (const auto &[szFunc, pars] : engineCalls)
+		if (!timeCalls(szFunc, pars, iCalls, 1)) return false;
+	// script calls: two per loop iteration
+	return timeCalls("BenchmarkScriptCalls", C4AulParSet{C4VInt(iCalls)}, 1, 2 * iCalls);
+}
+
 void C4AulProfiler::CollectEntry(C4AulScriptFunc *pFunc, time_t tProfileTime)
 {
 	// zero entries are not collected to have a cleaner list
@@ -1618,7 +1710,7 @@ C4Value C4AulFunc::Exec(C4Object *pObj, const C4AulParSet &pPars, bool fPassErro
 	const auto sFunc = SFunc();
 	const auto hasStrictNil = sFunc && sFunc->HasStrictNil();
 	auto pars = pPars;
-	if (TryCheckConvertFunctionParameters(pObj, this, pars.Par, !hasStrictNil, hasStrictNil && convertNilToIntBool, fPassErrors, nonStrict3WarnConversionOnly && !hasStrictNil))
+	if (TryCheckConvertFunctionParameters(pObj, this, pars.Par, C4AUL_MAX_Par, !hasStrictNil, hasStrictNil && convertNilToIntBool, fPassErrors, nonStrict3WarnConversionOnly && !hasStrictNil))
 	{
 		// execute
 		return Exec(&ctx, pars.Par, fPassErrors);
@@ -1632,7 +1724,7 @@ C4Value C4AulScriptFunc::Exec(C4AulContext *pCtx, const C4Value pPars[], bool fP
 	if (Owner->State != ASS_PARSED) return C4VNull;
 
 	// execute
-	return AulExec.Exec(this, pCtx->Obj, pPars, fPassErrors);
+	return AulExec.Exec(this, pCtx->Obj, pPars, C4AUL_MAX_Par, fPassErrors);
 }
 
 C4Value C4AulScriptFunc::Exec(C4Object *pObj, const C4AulParSet &pPars, bool fPassErrors, bool nonStrict3WarnConversionOnly, bool convertNilToIntBool)
@@ -1640,14 +1732,8 @@ C4Value C4AulScriptFunc::Exec(C4Object *pObj, const C4AulParSet &pPars, bool fPa
 	// handle easiest case first
 	if (Owner->State != ASS_PARSED) return C4VNull;
 
-	const auto isAtLeastStrict3 = HasStrictNil();
-	auto pars = pPars;
-	if (TryCheckConvertFunctionParameters(pObj, this, pars.Par, !isAtLeastStrict3, isAtLeastStrict3 && convertNilToIntBool, fPassErrors, nonStrict3WarnConversionOnly && !isAtLeastStrict3))
-	{
-		// execute
-		return AulExec.Exec(this, pObj, pars.Par, fPassErrors);
-	}
-	return C4VNull;
+	// execute; parameters are typechecked on the stack
+	return AulExec.Exec(this, pObj, pPars, fPassErrors, nonStrict3WarnConversionOnly, convertNilToIntBool);
 }
 
 bool C4AulScriptFunc::HasStrictNil() const noexcept
@@ -1700,7 +1786,7 @@ C4Value C4AulScript::DirectExec(C4Object *pObj, const char *szScript, const char
 	pFunc->Code = pScript->Code;
 	pScript->State = ASS_PARSED;
 	// Execute. The TemporaryScript-parameter makes sure the script will be deleted later on.
-	C4Value vRetVal(AulExec.Exec(pFunc, pObj, nullptr, fPassErrors, true));
+	C4Value vRetVal(AulExec.Exec(pFunc, pObj, nullptr, 0, fPassErrors, true));
 	// profiler
 	AulExec.StopDirectExec();
 	return vRetVal;
@@ -151,7 +151,8 @@ public:
 	void Parse_Function();
 	void Parse_Statement();
 	void Parse_Block();
-	int Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc = nullptr);
+	int Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc = nullptr, bool fBalance = true);
+	int Parse_CallParams(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc); // returns number of parameters passed
 	void Parse_Array();
 	void Parse_Map();
 	void Parse_While();
@@ -191,7 +192,7 @@ private:
 	bool fJump;
 	std::intptr_t iStack;
 
-	void AddBCC(C4AulBCCType eType, std::intptr_t X = 0);
+	void AddBCC(C4AulBCCType eType, std::intptr_t X = 0, std::int32_t iParCnt = 0);
 
 	size_t JumpHere(); // Get position for a later jump to next instruction added
 	void SetJumpHere(size_t iJumpOp); // Use the next inserted instruction as jump target for the given jump operation
@@ -920,7 +921,7 @@ static const char *GetTTName(C4AulBCCType e)
 	return "?";
 }
 
-void C4AulScript::AddBCC(C4AulBCCType eType, std::intptr_t X, const char *SPos)
+void C4AulScript::AddBCC(C4AulBCCType eType, std::intptr_t X, const char *SPos, std::int32_t iParCnt)
 {
 	// range check
 	if (CodeSize >= CodeBufSize)
@@ -938,6 +939,7 @@ void C4AulScript::AddBCC(C4AulBCCType eType, std::intptr_t X, const char *SPos)
 	}
 	// store chunk
 	CPos->bccType = eType;
+	CPos->bccParCnt = iParCnt;
 	CPos->bccX = X;
 	CPos->SPos = SPos;
 	CPos++; CodeSize++;
@@ -983,7 +985,7 @@ bool C4AulScript::Preparse()
 	return true;
 }
 
-void C4AulParseState::AddBCC(C4AulBCCType eType, std::intptr_t X)
+void C4AulParseState::AddBCC(C4AulBCCType eType, std::intptr_t X, std::int32_t iParCnt)
 {
 	if (Type != PARSER) return;
 	// Track stack size
@@ -1056,13 +1058,13 @@ void C4AulParseState::AddBCC(C4AulBCCType eType, std::intptr_t X)
 		break;
 
 	case AB_FUNC:
-		iStack -= reinterpret_cast<C4AulFunc *>(X)->GetParCount() - 1;
+		iStack -= iParCnt - 1;
 		break;
 
 	case AB_CALL:
 	case AB_CALLFS:
 	case AB_CALLGLOBAL:
-		iStack -= C4AUL_MAX_Par;
+		iStack -= iParCnt;
 		break;
 
 	case AB_DEREF:
@@ -1136,7 +1138,7 @@ void C4AulParseState::AddBCC(C4AulBCCType eType, std::intptr_t X)
 	}
 
 	// Add
-	a->AddBCC(eType, X, SPos);
+	a->AddBCC(eType, X, SPos, iParCnt);
 
 	// Reset jump flag
 	fJump = false;
@@ -1201,7 +1203,7 @@ namespace
 
 				case AB_FUNC:
 				{
-					const auto pars = reinterpret_cast<C4AulFunc *>(CPos->bccX)->GetParCount();
+					const auto pars = CPos->bccParCnt;
 					--CPos;
 					SkipExpressions(pars, CPos, Code);
 					--n;
@@ -1213,10 +1215,13 @@ namespace
 					break;
 
 				case AB_CALL: case AB_CALLFS: case AB_CALLGLOBAL:
+				{
+					const auto pars = CPos->bccParCnt + (CPos->bccType != AB_CALLGLOBAL ? 1 : 0);
 					--CPos;
-					SkipExpressions(C4AUL_MAX_Par + (CPos->bccType != AB_CALLGLOBAL ? 1 : 0), CPos, Code);
+					SkipExpressions(pars, CPos, Code);
 					--n;
 					break;
+				}
 
 				default:
 					// operator?
@@ -1410,6 +1415,8 @@ void C4AulScript::ParseFn(C4AulScriptFunc *Fn, bool fExprOnly)
 	// (relative position to code start; code pointer may change while
 	//  parsing)
 	Fn->Code = reinterpret_cast<C4AulBCC *>(CPos - Code);
+	// only named parameters need to be passed, unless the function uses Par() or ... (set while parsing)
+	Fn->ParSlots = Fn->ParNamed.iSize;
 	// parse
 	C4AulParseState state(Fn, this, C4AulParseState::PARSER);
 	// get first token
@@ -2238,9 +2245,10 @@ void C4AulParseState::Parse_Statement()
 				return;
 			}
 			// The preparser assumes the syntax is correct
+			int iParCnt{0};
 			if (TokenType == ATT_BOPEN || Type == PARSER)
-				Parse_Params(FoundFn ? FoundFn->GetParCount() : 10, FoundFn ? FoundFn->Name : Idtf, FoundFn);
-			AddBCC(AB_FUNC, reinterpret_cast<std::intptr_t>(FoundFn));
+				iParCnt = Parse_CallParams(FoundFn ? FoundFn->GetParCount() : C4AUL_MAX_Par, FoundFn ? FoundFn->Name : Idtf, FoundFn);
+			AddBCC(AB_FUNC, reinterpret_cast<std::intptr_t>(FoundFn), iParCnt);
 			if (gotohack)
 			{
 				AddBCC(AB_RETURN);
@@ -2261,7 +2269,13 @@ void C4AulParseState::Parse_Statement()
 	}
 }
 
-int C4AulParseState::Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc)
+int C4AulParseState::Parse_CallParams(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc)
+{
+	// only the passed parameters are pushed, the call chunk stores their count
+	return std::min(Parse_Params(iMaxCnt, sWarn, pFunc, false), iMaxCnt);
+}
+
+int C4AulParseState::Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFunc, bool fBalance)
 {
 	int size = 0;
 	// so it's a regular function; force "("
@@ -2294,6 +2308,7 @@ int C4AulParseState::Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFu
 		{
 			Shift();
 			// Push all unnamed parameters of the current function as parameters
+			if (Type == PARSER) Fn->ParSlots = C4AUL_MAX_Par;
 			int i = Fn->ParNamed.iSize;
 			while (size < iMaxCnt && i < C4AUL_MAX_Par)
 			{
@@ -2339,8 +2354,8 @@ int C4AulParseState::Parse_Params(int iMaxCnt, const char *sWarn, C4AulFunc *pFu
 	// too many parameters?
 	if (sWarn && size > iMaxCnt && Type == PARSER)
 		Warn(std::format("{}: passing {} parameters, but only {} are used", sWarn, size, iMaxCnt), nullptr);
-	// Balance stack
-	if (size != iMaxCnt)
+	// Balance stack; calls get the number of passed parameters instead and leave the missing ones to the callee
+	if (size > iMaxCnt || (fBalance && size != iMaxCnt))
 		AddBCC(AB_STACK, iMaxCnt - size);
 	return size;
 }
@@ -2764,6 +2779,7 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 			Shift();
 			Parse_Params(1, C4AUL_Par);
 			AddBCC(AB_PAR_R);
+			if (Type == PARSER) Fn->ParSlots = C4AUL_MAX_Par;
 		}
 		else if (SEqual(Idtf, C4AUL_Var))
 		{
@@ -2781,8 +2797,8 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 			if (Fn->OwnerOverloaded)
 			{
 				// add direct call to byte code
-				Parse_Params(Fn->OwnerOverloaded->GetParCount(), nullptr, Fn->OwnerOverloaded);
-				AddBCC(AB_FUNC, reinterpret_cast<std::intptr_t>(Fn->OwnerOverloaded));
+				const int iParCnt{Parse_CallParams(Fn->OwnerOverloaded->GetParCount(), nullptr, Fn->OwnerOverloaded)};
+				AddBCC(AB_FUNC, reinterpret_cast<std::intptr_t>(Fn->OwnerOverloaded), iParCnt);
 			}
 			else
 				// not found? raise an error, if it's not a safe call
@@ -2800,8 +2816,8 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 		{
 			// old syntax: do not allow recursive calls in overloaded functions
 			Shift();
-			Parse_Params(Fn->OwnerOverloaded->GetParCount(), Fn->Name, Fn);
-			AddBCC(AB_FUNC, reinterpret_cast<std::intptr_t>(Fn->OwnerOverloaded));
+			const int iParCnt{Parse_CallParams(Fn->OwnerOverloaded->GetParCount(), Fn->Name, Fn)};
+			AddBCC(AB_FUNC, reinterpret_cast<std::intptr_t>(Fn->OwnerOverloaded), iParCnt);
 		}
 		else
 		{
@@ -2822,11 +2838,10 @@ void C4AulParseState::Parse_Expression(int iParentPrio)
 			{
 				Shift();
 				// Function parameters for all functions except "this", which can be used without
+				int iParCnt{0};
 				if (!SEqual(FoundFn->Name, C4AUL_this) || TokenType == ATT_BOPEN)
-					Parse_Params(FoundFn->GetParCount(), FoundFn->Name, FoundFn);
-				else
-					AddBCC(AB_STACK, FoundFn->GetParCount());
-				AddBCC(AB_FUNC, reinterpret_cast<std::intptr_t>(FoundFn));
+					iParCnt = Parse_CallParams(FoundFn->GetParCount(), FoundFn->Name, FoundFn);
+				AddBCC(AB_FUNC, reinterpret_cast<std::intptr_t>(FoundFn), iParCnt);
 			}
 			else
 			{
@@ -3237,10 +3252,10 @@ bool C4AulParseState::Parse_Expression3()
 			}
 			// add call chunk
 			Shift();
-			Parse_Params(C4AUL_MAX_Par, pFunc ? pFunc->Name : nullptr, pFunc);
+			const int iParCnt{Parse_CallParams(C4AUL_MAX_Par, pFunc ? pFunc->Name : nullptr, pFunc)};
 			if (idNS != 0)
 				AddBCC(AB_CALLNS, static_cast<std::intptr_t>(idNS));
-			AddBCC(eCallType, reinterpret_cast<std::intptr_t>(pFunc));
+			AddBCC(eCallType, reinterpret_cast<std::intptr_t>(pFunc), iParCnt);
 			break;
 		}
 		default:
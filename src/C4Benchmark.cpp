@@ -0,0 +1,231 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// headless record replay benchmark (/bench:<folder>)
+
+#include <C4Include.h>
+#include <C4Benchmark.h>
+
+#include <C4Application.h>
+#include <C4Game.h>
+#include <C4Log.h>
+#include <C4Stat.h>
+
+#include <StdFile.h>
+
+#include <algorithm>
+#include <format>
+
+#ifdef USE_STAT
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#endif
+
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifdef USE_STAT
+
+// count all allocations; only in developer statistics builds, as this replaces the global operator new
+
+namespace
+{
+	std::atomic<std::uint64_t> AllocationCount{0};
+}
+
+void *operator new(std::size_t size)
+{
+	AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (void *const ptr{std::malloc(size ? size : 1)}) return ptr;
+	throw std::bad_alloc{};
+}
+
+void *operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+#endif
+
+namespace
+{
+	std::string JsonEscape(std::string_view text)
+	{
+		std::string result;
+		result.reserve(text.size());
+		for (const char c : text)
+		{
+			switch (c)
+			{
+			case '"': result += "\\\""; break;
+			case '\\': result += "\\\\"; break;
+			default:
+				if (static_cast<unsigned char>(c) < 0x20)
+					result += std::format("\\u{:04x}", static_cast<unsigned char>(c));
+				else
+					result += c;
+			}
+		}
+		return result;
+	}
+}
+
+C4Benchmark::C4Benchmark(std::string recordFolder, std::string outputFile)
+	: recordFolder{std::move(recordFolder)}, outputFile{std::move(outputFile)} {}
+
+std::uint64_t C4Benchmark::GetAllocationCount()
+{
+#ifdef USE_STAT
+	return AllocationCount.load(std::memory_order_relaxed);
+#else
+	return 0;
+#endif
+}
+
+std::uint64_t C4Benchmark::GetPeakMemory()
+{
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS counters;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+	return counters.PeakWorkingSetSize / 1024;
+#else
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage)) return 0;
+#ifdef __APPLE__
+	return usage.ru_maxrss / 1024; // bytes
+#else
+	return usage.ru_maxrss; // KiB
+#endif
+#endif
+}
+
+bool C4Benchmark::Start()
+{
+	// collect records, in stable order
+	records.clear();
+	for (DirectoryIterator i(recordFolder.c_str()); *i; ++i)
+		if (WildcardMatch(C4CFN_ScenarioFiles, *i))
+			records.emplace_back(*i);
+	std::sort(records.begin(), records.end());
+	if (records.empty())
+	{
+		spdlog::error("Benchmark: No records found in {}", recordFolder);
+		return false;
+	}
+	LogNTr("Benchmark: {} records in {}", records.size(), recordFolder);
+
+	// replays run unattended
+	Config.General.Record = false;
+
+	// first record is the scenario to start
+	currentRecord = 0;
+	results.clear();
+	SCopy(records.front().c_str(), Game.ScenarioFilename, _MAX_PATH);
+	return true;
+}
+
+void C4Benchmark::OnGameStarted()
+{
+	// sections are timed per record, from the first call on, as each record is only played once
+	C4ST_SETWARMUP(0)
+	C4ST_RESET
+	running = true;
+	startFrame = Game.FrameCounter;
+	startAllocations = GetAllocationCount();
+	startTime = std::chrono::steady_clock::now();
+}
+
+void C4Benchmark::OnGameFinished()
+{
+	if (currentRecord >= records.size()) return;
+
+	Result &result{results.emplace_back()};
+	result.Record = GetFilename(records[currentRecord].c_str());
+	result.Started = running;
+	if (running)
+	{
+		result.Frames = Game.FrameCounter - startFrame;
+		result.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		result.Allocations = GetAllocationCount() - startAllocations;
+		for (C4Stat *stat{C4Stat::getMainStat()->GetFirst()}; stat; stat = stat->GetNext())
+			if (stat->GetCount())
+				result.Sections.push_back({stat->GetName(), stat->GetCount(), stat->GetTimeSum()});
+		std::sort(result.Sections.begin(), result.Sections.end(), [](const Section &a, const Section &b) { return a.Name < b.Name; });
+		LogNTr("Benchmark: {}: {} frames in {:.2f} s ({:.1f} fps)", result.Record, result.Frames, result.Seconds, result.Seconds > 0.0 ? result.Frames / result.Seconds : 0.0);
+	}
+	else
+	{
+		spdlog::error("Benchmark: {} could not be started", result.Record);
+	}
+	running = false;
+
+	// next record, or done
+	if (++currentRecord < records.size())
+	{
+		Application.SetNextMission(records[currentRecord].c_str());
+	}
+	else
+	{
+		Application.SetNextMission(nullptr);
+		if (WriteResults())
+			LogNTr("Benchmark: Results written to {}", outputFile);
+		else
+			spdlog::error("Benchmark: Could not write results to {}", outputFile);
+	}
+}
+
+bool C4Benchmark::WriteResults() const
+{
+	std::string json{"{\n\t\"records\": ["};
+	int32_t totalFrames{0};
+	double totalSeconds{0.0};
+	bool first{true};
+	for (const auto &result : results)
+	{
+		json += first ? "\n" : ",\n";
+		first = false;
+		json += std::format("\t\t{{\n\t\t\t\"record\": \"{}\",\n\t\t\t\"ok\": {}", JsonEscape(result.Record), result.Started);
+		if (result.Started)
+		{
+			json += std::format(",\n\t\t\t\"frames\": {},\n\t\t\t\"seconds\": {:.3f},\n\t\t\t\"fps\": {:.2f},\n\t\t\t\"allocations\": {},\n\t\t\t\"sections\": {{",
+				result.Frames, result.Seconds, result.Seconds > 0.0 ? result.Frames / result.Seconds : 0.0, result.Allocations);
+			bool firstSection{true};
+			for (const auto &section : result.Sections)
+			{
+				json += firstSection ? "\n" : ",\n";
+				firstSection = false;
+				json += std::format("\t\t\t\t\"{}\": {{ \"calls\": {}, \"ms\": {:.3f} }}", JsonEscape(section.Name), section.Calls, section.Time / 1000.0);
+			}
+			json += "\n\t\t\t}";
+			totalFrames += result.Frames;
+			totalSeconds += result.Seconds;
+		}
+		json += "\n\t\t}";
+	}
+	json += std::format("\n\t],\n\t\"total\": {{ \"frames\": {}, \"seconds\": {:.3f}, \"fps\": {:.2f}, \"peakMemoryKiB\": {} }}\n}}\n",
+		totalFrames, totalSeconds, totalSeconds > 0.0 ? totalFrames / totalSeconds : 0.0, GetPeakMemory());
+
+	CStdFile file;
+	return file.Create(outputFile.c_str(), false) && file.Write(json.data(), json.size()) && file.Close();
+}
@@ -0,0 +1,69 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// headless record replay benchmark (/bench:<folder>)
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class C4Benchmark
+{
+private:
+	struct Section
+	{
+		std::string Name;
+		unsigned int Calls;
+		std::uint64_t Time; // microseconds
+	};
+
+	struct Result
+	{
+		std::string Record;
+		bool Started{false};
+		int32_t Frames{0};
+		double Seconds{0.0};
+		std::uint64_t Allocations{0};
+		std::vector<Section> Sections;
+	};
+
+	std::string recordFolder;
+	std::string outputFile;
+	std::vector<std::string> records;
+	std::size_t currentRecord{0};
+	std::vector<Result> results;
+
+	// state of the currently running record
+	bool running{false};
+	int32_t startFrame{0};
+	std::uint64_t startAllocations{0};
+	std::chrono::steady_clock::time_point startTime;
+
+public:
+	C4Benchmark(std::string recordFolder, std::string outputFile);
+
+	bool Start(); // collect records and set up the first one as scenario
+	void OnGameStarted();
+	void OnGameFinished(); // store results and launch next record, if any
+
+	static std::uint64_t GetAllocationCount(); // only counted in USE_STAT builds
+	static std::uint64_t GetPeakMemory(); // KiB, highest of the process so far; never reset, so only reported for all records together
+
+private:
+	bool WriteResults() const;
+};
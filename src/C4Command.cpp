@@ -27,6 +27,7 @@
 #include <C4ObjectMenu.h>
 #include <C4Player.h>
 #include <C4Wrappers.h>
+#include <C4Pool.h>
 
 const int32_t MoveToRange = 5, LetGoRange1 = 7, LetGoRange2 = 30, DigRange = 1;
 const int32_t FollowRange = 6, PushToRange = 10, DigOutPositionRange = 15;
@@ -155,6 +156,21 @@ int32_t SolidOnWhichSide(int32_t iX, int32_t iY)
 	return 0;
 }
 
+namespace
+{
+	C4Pool CommandPool{"C4Command", sizeof(C4Command)};
+}
+
+void *C4Command::operator new(const std::size_t size)
+{
+	return CommandPool.Allocate(size);
+}
+
+void C4Command::operator delete(void *const ptr, const std::size_t size)
+{
+	CommandPool.Deallocate(ptr, size);
+}
+
 C4Command::C4Command()
 {
 	Default();
@@ -692,7 +708,7 @@ void C4Command::Grab()
 		// Scaling or hangling: let go
 		if ((cObj->GetProcedure() == DFA_SCALE) || (cObj->GetProcedure() == DFA_HANGLE))
 			ObjectComLetGo(cObj, (cObj->Action.Dir == DIR_Left) ? +1 : -1);
-		if (!Target->Call(PSF_RejectGrabbed, {C4VObj(cObj)}).getBool())
+		if (!Target->Call(C4DefCallback::RejectGrabbed, {C4VObj(cObj)}).getBool())
 		{
 			// Grab
 			cObj->Action.ComDir = COMD_Stop;
@@ -1094,7 +1110,7 @@ bool C4Command::GetTryEnter()
 	// No minimum con knowledge vehicles/items: fail
 	if (Target->Contained && CheckMinimumCon(Target)) { /* fail??! */ return false; }
 	// Target contained and container has RejectContents: fail
-	if (Target->Contained && Target->Contained->Call(PSF_RejectContents)) { Finish(); return false; }
+	if (Target->Contained && Target->Contained->Call(C4DefCallback::RejectContents)) { Finish(); return false; }
 	// Collection limit: drop other object
 	// return after drop, so multiple objects may be dropped
 	if (cObj->Def->CollectionLimit && (cObj->Contents.ObjectCount() >= cObj->Def->CollectionLimit))
@@ -1121,7 +1137,7 @@ bool C4Command::GetTryEnter()
 	// if not successfully entered for any other reason, fail
 	if (!fSuccess) { Finish(); return false; }
 	// get-callback for getting out of containers
-	if (fWasContained) cObj->Call(PSF_Get, {C4VObj(Target)});
+	if (fWasContained) cObj->Call(C4DefCallback::Get, {C4VObj(Target)});
 	// entered
 	return true;
 }
@@ -1767,7 +1783,7 @@ void C4Command::Construct()
 	}
 
 	// command has been validated: check for script overload now
-	int32_t scriptresult = cObj->Call(PSF_ControlCommandConstruction, {C4VObj(Target), Tx, C4VInt(Ty), C4VObj(Target2), C4VID(Data)}).getInt();
+	int32_t scriptresult = cObj->Call(C4DefCallback::ControlCommandConstruction, {C4VObj(Target), Tx, C4VInt(Ty), C4VObj(Target2), C4VID(Data)}).getInt();
 	// script call might have deleted object
 	if (!cObj->Status) return;
 	if (1 == scriptresult) return;
@@ -2091,7 +2107,7 @@ void C4Command::Acquire()
 	}
 
 	// script overload
-	int32_t scriptresult = cObj->Call(PSF_ControlCommandAcquire, {C4VObj(Target), Tx, C4VInt(Ty), C4VObj(Target2), C4VID(Data)}).getInt();
+	int32_t scriptresult = cObj->Call(C4DefCallback::ControlCommandAcquire, {C4VObj(Target), Tx, C4VInt(Ty), C4VObj(Target2), C4VID(Data)}).getInt();
 
 	// script call might have deleted object
 	if (!cObj->Status) return;
@@ -2186,7 +2202,7 @@ void C4Command::Fail(const char *szFailMessage)
 			// Needed components
 			if (!Target) break;
 			// BuildNeedsMaterial call to builder script...
-			if (cObj->Call(PSF_BuildNeedsMaterial, {
+			if (cObj->Call(C4DefCallback::BuildNeedsMaterial, {
 				C4VID(Target->Component.GetID(0)), C4VInt(Target->Component.GetCount(0))})) // WTF? This is passing current components. Not needed ones!
 				break; // no message
 			if (szFailMessage) break;
@@ -2341,6 +2357,7 @@ void C4Command::Set(int32_t iCommand, C4Object *pObj, C4Object *pTarget, C4Value
 	// Set
 	Command = iCommand;
 	cObj = pObj;
+	Target.SetOwner(pObj); Target2.SetOwner(pObj);
 	Target = pTarget;
 	Tx = nTx; Ty = iTy;
 	Target2 = pTarget2;
@@ -18,8 +18,8 @@
 
 #pragma once
 
-#include "C4EnumeratedObjectPtr.h"
 #include "C4ResStrTable.h"
+#include "C4TrackedObjectPtr.h"
 #include "C4Value.h"
 
 #include <string>
@@ -80,12 +80,15 @@ public:
 	C4Command();
 	~C4Command();
 
+	static void *operator new(std::size_t size); // from the command pool
+	static void operator delete(void *ptr, std::size_t size);
+
 public:
 	C4Object *cObj;
 	int32_t Command;
 	C4Value Tx;
 	int32_t Ty;
-	C4EnumeratedObjectPtr Target, Target2;
+	C4TrackedObjectPtr Target, Target2;
 	int32_t Data;
 	int32_t UpdateInterval;
 	int32_t Evaluated, PathChecked, Finished;
@@ -100,6 +100,8 @@
 #define C4CFN_PlayerInfos      "PlayerInfos.txt"
 #define C4CFN_SavePlayerInfos  "SavePlayerInfos.txt"
 #define C4CFN_RecPlayerInfos   "RecPlayerInfos.txt"
+#define C4CFN_RecSnapshots     "Snapshots.txt"
+#define C4CFN_RecSnapshot      "Snapshot{:08}.c4s"
 #define C4CFN_Teams            "Teams.txt"
 #define C4CFN_Parameters       "Parameters.txt"
 #define C4CFN_RoundResults     "RoundResults.txt"
@@ -115,6 +117,8 @@
 #define C4CFN_Names  "Names.txt"
 #define C4CFN_Titles "Title*.txt|Title.txt"
 
+#define C4CFN_NetResCache "ResCache" // in network path
+
 #define C4CFN_TempMap          "~Map.tmp"
 #define C4CFN_TempLandscape    "~Landscape.tmp"
 #define C4CFN_TempLandscapePNG "~Landscape2.tmp"
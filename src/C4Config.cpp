@@ -88,6 +88,7 @@ void C4ConfigGeneral::CompileFunc(StdCompiler *pComp)
 #endif
 	pComp->Value(mkNamingAdapt(FPS,                     "FPS",                     false,         false, true));
 	pComp->Value(mkNamingAdapt(Record,                  "Record",                  false,         false, true));
+	pComp->Value(mkNamingAdapt(RecordSnapshotInterval,  "RecordSnapshotInterval",  0,             false, true));
 	pComp->Value(mkNamingAdapt(ScreenshotFolder,        "ScreenshotFolder",        "Screenshots", false, true));
 	pComp->Value(mkNamingAdapt(FairCrew,                "NoCrew",                  false,         false, true));
 	pComp->Value(mkNamingAdapt(FairCrewStrength,        "DefCrewStrength",         1000,          false, true));
@@ -194,6 +195,8 @@ void C4ConfigGraphics::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(Shader,               "Shader",               false, false, true));
 	pComp->Value(mkNamingAdapt(AutoFrameSkip,        "AutoFrameSkip",        true,  false, true));
 	pComp->Value(mkNamingAdapt(CacheTexturesInRAM,   "CacheTexturesInRAM",   100));
+	pComp->Value(mkNamingAdapt(PixelBufferUpload,    "PixelBufferUpload",    true));
+	pComp->Value(mkNamingAdapt(ShaderLandscape,      "ShaderLandscape",      false, false, true));
 
 	StdEnumEntry<DisplayMode> DisplayModes[] =
 	{
@@ -230,6 +233,7 @@ void C4ConfigSound::CompileFunc(StdCompiler *pComp)
 	}
 
 	pComp->Value(mkNamingAdapt(MuteSoundCommand, "MuteSoundCommand", false, false, true));
+	pComp->Value(mkNamingAdapt(MaxDecodedSoundMemory, "MaxDecodedSoundMemory", 64 * 1024));
 }
 
 void C4ConfigNetwork::CompileFunc(StdCompiler *pComp)
@@ -249,6 +253,7 @@ void C4ConfigNetwork::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(LocalName,          "LocalName",          "Unknown",      false, true));
 	pComp->Value(mkNamingAdapt(Nick,               "Nick",               "",             false, true));
 	pComp->Value(mkNamingAdapt(MaxLoadFileSize,    "MaxLoadFileSize", 100 * 1024 * 1024, false, true));
+	pComp->Value(mkNamingAdapt(ResCacheSize,       "ResCacheSize",       256,            false, true));
 
 	pComp->Value(mkNamingAdapt(MasterServerSignUp,        "MasterServerSignUp",     true,   false, true));
 	pComp->Value(mkNamingAdapt(MasterReferencePeriod,     "MasterReferencePeriod",  120,    false, true));
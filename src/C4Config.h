@@ -67,6 +67,7 @@ public:
 	char MissionAccess[CFG_MaxString + 1];
 	bool FPS;
 	bool Record;
+	int32_t RecordSnapshotInterval; // frames between keyframe snapshots in records for seeking; 0 = none
 	bool FairCrew;   // don't use permanent crew physicals
 	int32_t FairCrewStrength; // strength of clonks in fair crew mode
 	int32_t MouseAScroll; // auto scroll strength
@@ -164,6 +165,8 @@ public:
 	int32_t MaxRefreshDelay; // minimum time after which graphics should be refreshed (ms)
 	bool AutoFrameSkip; // if true, gfx frames are skipped when they would slow down the game
 	int32_t CacheTexturesInRAM; // -1 for disabled; otherwise after CacheTexturesInRAM times of Locking, Unlock(true) keeps the texture in RAM
+	bool PixelBufferUpload; // stream texture uploads through pixel buffer objects if available
+	bool ShaderLandscape; // compose the landscape from the material map in a shader instead of lighting it on the CPU (needs Shader)
 	DisplayMode UseDisplayMode;
 #ifdef _WIN32
 	bool Maximized;
@@ -188,6 +191,7 @@ public:
 	int32_t MaxChannels;
 	bool PreferLinearResampling;
 	bool MuteSoundCommand; // whether to mute /sound by default
+	int32_t MaxDecodedSoundMemory; // in KiB; decoded sound effects that are not playing are freed beyond this
 	void CompileFunc(StdCompiler *pComp);
 };
 
@@ -208,6 +212,7 @@ public:
 	ValidatedStdStrBuf<C4InVal::VAL_NameNoEmpty> LocalName;
 	ValidatedStdStrBuf<C4InVal::VAL_NameAllowEmpty> Nick;
 	int32_t MaxLoadFileSize;
+	int32_t ResCacheSize; // MB; 0 disables the cache of downloaded ressources
 	char LastPassword[CFG_MaxString + 1];
 	char ServerAddress[CFG_MaxString + 1];
 	char AlternateServerAddress[CFG_MaxString + 1];
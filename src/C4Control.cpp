@@ -90,10 +90,11 @@ bool C4Control::PreExecute(const std::shared_ptr<spdlog::logger> &logger) const
 	return fReady;
 }
 
-void C4Control::Execute(const std::shared_ptr<spdlog::logger> &logger) const
+void C4Control::Execute(const std::shared_ptr<spdlog::logger> &logger, int32_t *piExecuted) const
 {
 	for (C4IDPacket *pPkt = firstPkt(); pPkt; pPkt = nextPkt(pPkt))
 	{
+		if (piExecuted) ++*piExecuted;
 		// recheck packet type: Must be control
 		if (pPkt->getPktType() & CID_First)
 		{
@@ -354,7 +355,7 @@ void C4ControlPlayerSelect::Execute(const std::shared_ptr<spdlog::logger> &) con
 			iControlChecksum += pObj->Number * (iControlChecksum + 4787821);
 			// user defined object selection: callback to object
 			if (pObj->Category & C4D_MouseSelect)
-				pObj->Call(PSF_MouseSelection, {C4VInt(iPlr)});
+				pObj->Call(C4DefCallback::MouseSelection, {C4VInt(iPlr)});
 			// player crew selection (recheck status of pObj)
 			if (pObj->Status && pPlr->ObjectInCrew(pObj))
 				SelectObjs.Add(pObj, C4ObjectList::stNone);
@@ -466,6 +467,20 @@ int32_t C4ControlSyncCheck::GetAllCrewPosX()
 	return cpx;
 }
 
+bool C4ControlSyncCheck::IsSameState(const C4ControlSyncCheck &other, const bool fCheckControlTick) const
+{
+	return Frame == other.Frame
+		&& (ControlTick           == other.ControlTick || !fCheckControlTick)
+		&& Random3                == other.Random3
+		&& RandomCount            == other.RandomCount
+		&& AllCrewPosX            == other.AllCrewPosX
+		&& PXSCount               == other.PXSCount
+		&& MassMoverIndex         == other.MassMoverIndex
+		&& ObjectCount            == other.ObjectCount
+		&& ObjectEnumerationIndex == other.ObjectEnumerationIndex
+		&& SectShapeSum           == other.SectShapeSum;
+}
+
 void C4ControlSyncCheck::Execute(const std::shared_ptr<spdlog::logger> &) const
 {
 	// control host?
@@ -480,16 +495,7 @@ void C4ControlSyncCheck::Execute(const std::shared_ptr<spdlog::logger> &) const
 	}
 
 	// Not equal
-	if (Frame != pSyncCheck->Frame
-		|| (ControlTick           != pSyncCheck->ControlTick && !Game.Control.isReplay())
-		|| Random3                != pSyncCheck->Random3
-		|| RandomCount            != pSyncCheck->RandomCount
-		|| AllCrewPosX            != pSyncCheck->AllCrewPosX
-		|| PXSCount               != pSyncCheck->PXSCount
-		|| MassMoverIndex         != pSyncCheck->MassMoverIndex
-		|| ObjectCount            != pSyncCheck->ObjectCount
-		|| ObjectEnumerationIndex != pSyncCheck->ObjectEnumerationIndex
-		|| SectShapeSum           != pSyncCheck->SectShapeSum)
+	if (!IsSameState(*pSyncCheck, !Game.Control.isReplay()))
 	{
 		const char *szThis = "Client", *szOther = Game.Control.isReplay() ? "Rec " : "Host";
 		if (iByClient != Game.Control.ClientID())
@@ -539,7 +545,12 @@ void C4ControlSyncCheck::CompileFunc(StdCompiler *pComp)
 void C4ControlSynchronize::Execute(const std::shared_ptr<spdlog::logger> &) const
 {
 	Game.Synchronize(fSavePlrFiles);
-	if (fSyncClearance) Game.SyncClearance();
+	if (fSyncClearance)
+	{
+		Game.SyncClearance();
+		// the game state now is the same as after loading a savegame of it
+		Game.Control.OnGameSyncCleared();
+	}
 }
 
 void C4ControlSynchronize::CompileFunc(StdCompiler *pComp)
@@ -90,7 +90,7 @@ public:
 
 	// control execution
 	bool PreExecute(const std::shared_ptr<spdlog::logger> &logger) const;
-	void Execute(const std::shared_ptr<spdlog::logger> &logger) const;
+	void Execute(const std::shared_ptr<spdlog::logger> &logger, int32_t *piExecuted = nullptr) const; // piExecuted is increased before each packet is executed
 	void PreRec(C4Record *pRecord) const;
 
 	virtual void CompileFunc(StdCompiler *pComp) override;
@@ -217,6 +217,7 @@ protected:
 
 public:
 	void Set();
+	bool IsSameState(const C4ControlSyncCheck &other, bool fCheckControlTick) const;
 	int32_t getFrame() const { return Frame; }
 	virtual bool Sync() const override { return false; }
 	DECLARE_C4CONTROL_VIRTUALS
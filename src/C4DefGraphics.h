@@ -19,11 +19,11 @@
 
 #pragma once
 
-#include <C4EnumeratedObjectPtr.h>
 #include <C4FacetEx.h>
 #include "C4ForwardDeclarations.h"
 #include <C4Material.h>
 #include <C4Surface.h>
+#include <C4TrackedObjectPtr.h>
 
 #define C4Portrait_None   "none"
 #define C4Portrait_Random "random"
@@ -179,7 +179,7 @@ protected:
 	C4FacetEx fctBlit; // current blit data
 	uint32_t dwBlitMode; // extra parameters for additive blits, etc.
 	uint32_t dwClrModulation; // colormod for this overlay
-	C4EnumeratedObjectPtr pOverlayObj; // object to be drawn as overlay in MODE_Object
+	C4TrackedObjectPtr pOverlayObj; // object to be drawn as overlay in MODE_Object
 	C4DrawTransform Transform; // drawing transformation: Rotation, zoom, etc.
 	int32_t iPhase; // action face for MODE_Action
 	bool fZoomToShape; // if true, overlay will be zoomed to match the target object shape
@@ -240,6 +240,7 @@ public:
 
 	C4DrawTransform *GetTransform() { return &Transform; }
 	C4Object *GetOverlayObject() const { return pOverlayObj; }
+	void SetOwner(C4Object *pForObj) { pOverlayObj.SetOwner(pForObj); } // object this overlay belongs to
 	int32_t GetID() const { return iID; }
 	void SetID(int32_t aID) { iID = aID; }
 	C4GraphicsOverlay *GetNext() const { return pNext; }
@@ -24,10 +24,16 @@
 #include <C4Log.h>
 #include <C4Game.h>
 #include <C4Wrappers.h>
+#include <C4Pool.h>
 
 #include <format>
 #include <numbers>
 
+namespace
+{
+	C4Pool EffectPool{"C4Effect", sizeof(C4Effect)};
+}
+
 void C4Effect::AssignCallbackFunctions()
 {
 	C4AulScript *pSrcScript = GetCallbackScript();
@@ -66,6 +72,7 @@ C4Effect::C4Effect(C4Object *pForObj, const char *szName, int32_t iPrio, int32_t
 	riStoredAsNumber = 0;
 	iIntervall = iTimerIntervall;
 	iTime = 0;
+	pCommandTarget.SetOwner(pForObj);
 	pCommandTarget = pCmdTarget;
 	pCommandTarget.Enumerate();
 	idCommandTarget = idCmdTarget;
@@ -159,6 +166,16 @@ C4Effect::C4Effect(StdCompiler *pComp) : EffectVars(0)
 	pComp->Value(*this);
 }
 
+void *C4Effect::operator new(const std::size_t size)
+{
+	return EffectPool.Allocate(size);
+}
+
+void C4Effect::operator delete(void *const ptr, const std::size_t size)
+{
+	EffectPool.Deallocate(ptr, size);
+}
+
 C4Effect::~C4Effect()
 {
 	// del following effects (not recursively)
@@ -603,12 +620,12 @@ int32_t FnFxFireStart(C4AulContext *ctx, C4Object *pObj, int32_t iNumber, int32_
 	{
 		// if object was blasted but not incinerated (i.e., inside extinguisher)
 		// do a script callback
-		if (fBlasted) pObj->Call(PSF_IncinerationEx, {C4VInt(iCausedBy)});
+		if (fBlasted) pObj->Call(C4DefCallback::IncinerationEx, {C4VInt(iCausedBy)});
 		return -1;
 	}
 	// determine fire appearance
 	int32_t iFireMode;
-	if (!(iFireMode = pObj->Call(PSF_FireMode).getInt()))
+	if (!(iFireMode = pObj->Call(C4DefCallback::FireMode).getInt()))
 	{
 		// set default fire modes
 		uint32_t dwCat = pObj->Category;
@@ -635,7 +652,7 @@ int32_t FnFxFireStart(C4AulContext *ctx, C4Object *pObj, int32_t iNumber, int32_
 	if (pObj->Shape.Wdt * pObj->Shape.Hgt > 500) StartSoundEffect("Inflame", false, 100, pObj);
 	if (pObj->Def->Mass >= 100) StartSoundEffect("Fire", true, 100, pObj);
 	// Engine script call
-	pObj->Call(PSF_Incineration, {C4VInt(iCausedBy)});
+	pObj->Call(C4DefCallback::Incineration, {C4VInt(iCausedBy)});
 	// Done, success
 	return C4Fx_OK;
 }
@@ -871,7 +888,7 @@ void Smoke(int32_t tx, int32_t ty, int32_t level, uint32_t dwClr)
 	level = BoundBy<int32_t>(level, 3, 32);
 	C4Object *pObj;
 	if (pObj = Game.CreateObjectConstruction(C4Id("FXS1"), nullptr, NO_OWNER, tx, ty, FullCon * level / 32))
-		pObj->Call(PSF_Activate);
+		pObj->Call(C4DefCallback::Activate);
 }
 
 void Explosion(int32_t tx, int32_t ty, int32_t level, C4Object *inobj, int32_t iCausedBy, C4Object *pByObj, C4ID idEffect, const char *szEffect)
@@ -908,7 +925,7 @@ void Explosion(int32_t tx, int32_t ty, int32_t level, C4Object *inobj, int32_t i
 				Game.Particles.Cast(Game.Particles.pFSpark, level / 5 + 1, static_cast<float>(tx), static_cast<float>(ty), level, level / 2 + 1.0f, 0x00ef0000, level + 1.0f, 0xffff1010);
 		}
 		else if (pBlast = Game.CreateObjectConstruction(idEffect ? idEffect : C4Id("FXB1"), pByObj, iCausedBy, tx, ty + level, FullCon * level / 20))
-			pBlast->Call(PSF_Activate);
+			pBlast->Call(C4DefCallback::Activate);
 	}
 	// Blast objects
 	Game.BlastObjects(tx, ty, level, inobj, iCausedBy, pByObj);
@@ -25,7 +25,7 @@
 #include "C4Aul.h"
 #include "C4Constants.h"
 #include "C4DeletionTrackable.h"
-#include "C4EnumeratedObjectPtr.h"
+#include "C4TrackedObjectPtr.h"
 #include "C4ValueList.h"
 
 typedef unsigned long C4ID;
@@ -78,7 +78,7 @@ class C4Effect : private C4DeletionTrackable
 {
 public:
 	char Name[C4MaxDefString + 1]; // name of effect
-	C4EnumeratedObjectPtr pCommandTarget; // target object for script callbacks - if deleted, the effect is removed without callbacks
+	C4TrackedObjectPtr pCommandTarget; // target object for script callbacks - if deleted, the effect is removed without callbacks
 	C4ID idCommandTarget; // ID of command target definition
 
 	int32_t iPriority; // effect priority for sorting into effect list; -1 indicates a dead effect
@@ -102,6 +102,9 @@ public:
 	C4Effect(StdCompiler *pComp); // ctor: compile
 	~C4Effect(); // dtor - deletes all following effects
 
+	static void *operator new(std::size_t size); // from the effect pool
+	static void operator delete(void *ptr, std::size_t size);
+
 	void EnumeratePointers(); // object pointers to numbers
 	void DenumeratePointers(); // numbers to object pointers
 	void ClearPointers(C4Object *pObj); // clear all pointers to object - may kill some effects w/o callback, because the callback target is lost
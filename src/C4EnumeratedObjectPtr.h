@@ -20,6 +20,7 @@
 #include <type_traits>
 
 class C4Object;
+class C4TrackedObjectPtr;
 class StdCompiler;
 
 class C4EnumeratedObjectPtr
@@ -78,7 +79,7 @@ namespace
 	constexpr void CheckArgs(Args &...args) noexcept
 	{
 		static_assert(sizeof...(args) > 0, "At least one argument is required");
-		static_assert((std::is_same_v<Args, C4EnumeratedObjectPtr> && ...), "Only C4EnumeratedObjectPtr& can be passed as arguments");
+		static_assert(((std::is_same_v<Args, C4EnumeratedObjectPtr> || std::is_same_v<Args, C4TrackedObjectPtr>) && ...), "Only C4EnumeratedObjectPtr& and C4TrackedObjectPtr& can be passed as arguments");
 	}
 }
 
@@ -0,0 +1,144 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// queue of events from any thread to a single consumer thread
+
+#pragma once
+
+#include "StdSync.h"
+
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+// Bounded lock-free ring buffer: any thread may push, only one consumer thread pops.
+// A slot's sequence number tells whether it is free for the producer at that position (== position)
+// or holds an item for the consumer (== position + 1). Slots are reused, so pushing does not allocate.
+// Items that do not fit into the ring go to a locked overflow list. As long as there are any,
+// all items are queued there, so that the items of each thread stay in order.
+template<typename T, std::size_t RingSize>
+class C4EventQueue
+{
+	static_assert(RingSize > 0 && (RingSize & (RingSize - 1)) == 0, "RingSize must be a power of two");
+
+private:
+	struct Slot
+	{
+		std::atomic<std::size_t> Sequence;
+		T Item;
+	};
+
+	std::unique_ptr<Slot[]> Ring;
+	// written by producers and consumer concurrently, so keep them on separate cache lines
+	alignas(64) std::atomic<std::size_t> PushPos{0};
+	alignas(64) std::size_t PopPos{0}; // by consumer
+
+	std::vector<T> Overflow;
+	std::atomic<bool> OverflowUsed{false};
+	CStdCSec OverflowCSec;
+
+public:
+	C4EventQueue() : Ring{std::make_unique<Slot[]>(RingSize)}
+	{
+		for (std::size_t i{0}; i < RingSize; ++i)
+			Ring[i].Sequence.store(i, std::memory_order_relaxed);
+	}
+
+	~C4EventQueue()
+	{
+		CStdLock OverflowLock(&OverflowCSec);
+		Overflow.clear();
+	}
+
+	void Push(T item) // by any thread
+	{
+		if (OverflowUsed.load(std::memory_order_acquire) || !TryPushRing(item))
+		{
+			// ring is full or earlier items are still waiting in the overflow list
+			CStdLock OverflowLock(&OverflowCSec);
+			Overflow.push_back(std::move(item));
+			OverflowUsed.store(true, std::memory_order_release);
+		}
+	}
+
+	// append up to iMaxCount items from the ring, or all of the overflow list once the ring is drained (by consumer)
+	void PopBatch(std::vector<T> &batch, const std::size_t iMaxCount)
+	{
+		std::size_t iCount{0};
+		for (; iCount < iMaxCount; ++iCount)
+		{
+			T &item{batch.emplace_back()};
+			if (!PopRing(item))
+			{
+				batch.pop_back();
+				break;
+			}
+		}
+		if (iCount == iMaxCount || !OverflowUsed.load(std::memory_order_acquire)) return;
+		// Take over the overflow list only once the ring is empty and no producer is about to fill a claimed slot,
+		// as the items in there are newer than the ones in the ring.
+		CStdLock OverflowLock(&OverflowCSec);
+		if (PushPos.load() != PopPos) return;
+		std::move(Overflow.begin(), Overflow.end(), std::back_inserter(batch));
+		Overflow.clear();
+		OverflowUsed.store(false, std::memory_order_release);
+	}
+
+private:
+	bool TryPushRing(T &item) // moves from item only on success
+	{
+		std::size_t iPos{PushPos.load(std::memory_order_relaxed)};
+		for (;;)
+		{
+			Slot &slot{Ring[iPos & (RingSize - 1)]};
+			const std::size_t iSeq{slot.Sequence.load(std::memory_order_acquire)};
+			const auto iDiff = static_cast<std::ptrdiff_t>(iSeq - iPos);
+			if (iDiff == 0)
+			{
+				// slot is free: claim it
+				if (PushPos.compare_exchange_weak(iPos, iPos + 1, std::memory_order_relaxed))
+				{
+					slot.Item = std::move(item);
+					slot.Sequence.store(iPos + 1, std::memory_order_release);
+					return true;
+				}
+			}
+			else if (iDiff < 0)
+			{
+				// slot still holds the item of the previous round: full
+				return false;
+			}
+			else
+			{
+				// another producer was faster
+				iPos = PushPos.load(std::memory_order_relaxed);
+			}
+		}
+	}
+
+	bool PopRing(T &item) // by consumer
+	{
+		Slot &slot{Ring[PopPos & (RingSize - 1)]};
+		if (slot.Sequence.load(std::memory_order_acquire) != PopPos + 1) return false;
+		item = std::move(slot.Item);
+		slot.Item = T{};
+		// free the slot for the producer of the next round
+		slot.Sequence.store(PopPos + RingSize, std::memory_order_release);
+		++PopPos;
+		return true;
+	}
+};
@@ -647,7 +647,7 @@ void C4FindObjectFunc::SetPar(int i, const C4Value &Par)
 	// Over limit?
 	if (i >= C4AUL_MAX_Par) return;
 	// Set parameter
-	Pars[i] = Par;
+	Pars.Set(i, Par.GetRefVal());
 }
 
 bool C4FindObjectFunc::Check(C4Object *pObj)
@@ -941,7 +941,7 @@ void C4SortObjectFunc::SetPar(int i, const C4Value &Par)
 	// Over limit?
 	if (i >= C4AUL_MAX_Par) return;
 	// Set parameter
-	Pars[i] = Par;
+	Pars.Set(i, Par.GetRefVal());
 }
 
 int32_t C4SortObjectFunc::CompareGetValue(C4Object *pObj)
@@ -0,0 +1,137 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// coarse grid of a player's FoW view objects, used to find the objects that may see a point
+
+#include <C4Include.h>
+#include <C4FoWGrid.h>
+
+#include <algorithm>
+#include <cstdlib>
+
+void C4FoWGrid::Clear()
+{
+	Cells.clear();
+	Global.clear();
+	Entries.clear();
+	CurrentMark = 0;
+}
+
+C4FoWGrid::Rect C4FoWGrid::GetCells(const int32_t iX, const int32_t iY, const int32_t iViewRange)
+{
+	// everything within the view range, no matter whether the object repels or generates fog
+	const int32_t iRange{std::abs(iViewRange)};
+	return {CellCoord(iX - iRange), CellCoord(iY - iRange), CellCoord(iX + iRange), CellCoord(iY + iRange)};
+}
+
+bool C4FoWGrid::IsGlobal(const Rect &rect)
+{
+	return static_cast<std::int64_t>(rect.X1 - rect.X0 + 1) * (rect.Y1 - rect.Y0 + 1) > MaxCells;
+}
+
+void C4FoWGrid::Link(C4Object *pObj, const Entry &entry)
+{
+	if (entry.Global)
+	{
+		Global.push_back(pObj);
+		return;
+	}
+	for (int32_t iY{entry.Cells.Y0}; iY <= entry.Cells.Y1; ++iY)
+		for (int32_t iX{entry.Cells.X0}; iX <= entry.Cells.X1; ++iX)
+			Cells[CellKey(iX, iY)].push_back(pObj);
+}
+
+void C4FoWGrid::Unlink(C4Object *pObj, const Entry &entry)
+{
+	if (entry.Global)
+	{
+		std::erase(Global, pObj);
+		return;
+	}
+	for (int32_t iY{entry.Cells.Y0}; iY <= entry.Cells.Y1; ++iY)
+		for (int32_t iX{entry.Cells.X0}; iX <= entry.Cells.X1; ++iX)
+		{
+			const auto it = Cells.find(CellKey(iX, iY));
+			if (it == Cells.end()) continue;
+			std::erase(it->second, pObj);
+			if (it->second.empty()) Cells.erase(it);
+		}
+}
+
+void C4FoWGrid::Add(C4Object *const pObj, const int32_t iX, const int32_t iY, const int32_t iViewRange)
+{
+	const Rect cells{GetCells(iX, iY, iViewRange)};
+	const auto [it, inserted] = Entries.try_emplace(pObj, Entry{cells, IsGlobal(cells)});
+	if (!inserted)
+	{
+		// already known: just move it
+		Update(pObj, iX, iY, iViewRange);
+		return;
+	}
+	Link(pObj, it->second);
+}
+
+void C4FoWGrid::Update(C4Object *const pObj, const int32_t iX, const int32_t iY, const int32_t iViewRange)
+{
+	const auto it = Entries.find(pObj);
+	if (it == Entries.end()) return;
+	// still covering the same cells?
+	const Rect cells{GetCells(iX, iY, iViewRange)};
+	if (cells == it->second.Cells) return;
+	Unlink(pObj, it->second);
+	it->second.Cells = cells;
+	it->second.Global = IsGlobal(cells);
+	Link(pObj, it->second);
+}
+
+void C4FoWGrid::Remove(C4Object *pObj)
+{
+	const auto it = Entries.find(pObj);
+	if (it == Entries.end()) return;
+	Unlink(pObj, it->second);
+	Entries.erase(it);
+}
+
+void C4FoWGrid::MarkInRect(int32_t iX0, int32_t iY0, int32_t iX1, int32_t iY1, int32_t iMargin)
+{
+	if (!++CurrentMark)
+	{
+		// wrapped around: old marks might match again
+		for (auto &[pObj, entry] : Entries) entry.Mark = 0;
+		CurrentMark = 1;
+	}
+	const Rect rect{CellCoord(iX0 - iMargin), CellCoord(iY0 - iMargin), CellCoord(iX1 + iMargin), CellCoord(iY1 + iMargin)};
+	// a big rectangle is cheaper to check against all objects than cell by cell
+	if (static_cast<std::int64_t>(rect.X1 - rect.X0 + 1) * (rect.Y1 - rect.Y0 + 1) > static_cast<std::int64_t>(Cells.size()))
+	{
+		for (auto &[pObj, entry] : Entries)
+			if (entry.Global || (entry.Cells.X0 <= rect.X1 && entry.Cells.X1 >= rect.X0 && entry.Cells.Y0 <= rect.Y1 && entry.Cells.Y1 >= rect.Y0))
+				entry.Mark = CurrentMark;
+		return;
+	}
+	for (C4Object *const pObj : Global)
+		Entries.find(pObj)->second.Mark = CurrentMark;
+	for (int32_t iY{rect.Y0}; iY <= rect.Y1; ++iY)
+		for (int32_t iX{rect.X0}; iX <= rect.X1; ++iX)
+			if (const auto it = Cells.find(CellKey(iX, iY)); it != Cells.end())
+				for (C4Object *const pObj : it->second)
+					Entries.find(pObj)->second.Mark = CurrentMark;
+}
+
+bool C4FoWGrid::IsMarked(C4Object *pObj) const
+{
+	const auto it = Entries.find(pObj);
+	return it != Entries.end() && it->second.Mark == CurrentMark;
+}
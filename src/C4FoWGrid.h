@@ -0,0 +1,81 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// coarse grid of a player's FoW view objects, used to find the objects that may see a point
+// objects are only used as keys here, so the grid does not depend on C4Object
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+class C4Object;
+
+class C4FoWGrid
+{
+public:
+	static constexpr int32_t CellSize{128};
+	static constexpr int32_t MaxCells{256}; // objects covering more cells than this are checked for every query
+
+private:
+	struct Rect
+	{
+		int32_t X0, Y0, X1, Y1; // in cells, inclusive
+
+		bool operator==(const Rect &) const = default;
+	};
+
+	struct Entry
+	{
+		Rect Cells;
+		bool Global;
+		std::uint32_t Mark{0};
+	};
+
+	std::unordered_map<std::int64_t, std::vector<C4Object *>> Cells;
+	std::vector<C4Object *> Global; // objects with huge view ranges
+	std::unordered_map<C4Object *, Entry> Entries;
+	std::uint32_t CurrentMark{0};
+
+public:
+	void Clear();
+	void Add(C4Object *pObj, int32_t iX, int32_t iY, int32_t iViewRange); // register view object at its position and range
+	void Update(C4Object *pObj, int32_t iX, int32_t iY, int32_t iViewRange); // position or view range changed; ignored for objects that are not registered
+	void Remove(C4Object *pObj);
+
+	// call f for every object whose view range may cover the point, until it returns false
+	template<typename Func> void ForEachAt(int32_t iX, int32_t iY, Func f) const
+	{
+		for (C4Object *const pObj : Global)
+			if (!f(pObj)) return;
+		if (const auto it = Cells.find(CellKey(CellCoord(iX), CellCoord(iY))); it != Cells.end())
+			for (C4Object *const pObj : it->second)
+				if (!f(pObj)) return;
+	}
+
+	// mark all objects whose view range, enlarged by iMargin, may overlap the rectangle; replaces previous marks
+	void MarkInRect(int32_t iX0, int32_t iY0, int32_t iX1, int32_t iY1, int32_t iMargin);
+	bool IsMarked(C4Object *pObj) const;
+
+private:
+	static int32_t CellCoord(int32_t iPos) { return (iPos >= 0 ? iPos : iPos - CellSize + 1) / CellSize; }
+	static std::int64_t CellKey(int32_t iCellX, int32_t iCellY) { return (static_cast<std::int64_t>(iCellY) << 32) | static_cast<std::uint32_t>(iCellX); }
+	static Rect GetCells(int32_t iX, int32_t iY, int32_t iViewRange);
+	static bool IsGlobal(const Rect &rect);
+
+	void Link(C4Object *pObj, const Entry &entry);
+	void Unlink(C4Object *pObj, const Entry &entry);
+};
@@ -17,6 +17,7 @@
 
 class C4AudioSystem;
 class C4AulFunc;
+class C4AulScript;
 class C4Def;
 class C4DefList;
 class C4Facet;
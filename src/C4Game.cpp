@@ -26,6 +26,7 @@
 #include <C4GameSave.h>
 #include <C4Record.h>
 #include <C4Application.h>
+#include <C4Benchmark.h>
 #include <C4Object.h>
 #include <C4ObjectInfo.h>
 #include <C4Random.h>
@@ -48,6 +49,7 @@
 #include <C4ObjectMenu.h>
 #include <C4GameLobby.h>
 #include <C4ChatDlg.h>
+#include <C4Pool.h>
 #include "C4KeyboardInput.h"
 #include "C4Thread.h"
 
@@ -58,6 +60,7 @@
 #include <iterator>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 constexpr unsigned int defaultIngameGameTickDelay = 28;
 
@@ -156,6 +159,9 @@ bool C4Game::OpenScenario()
 			LogNTr("{}: {}", LoadResStr(C4ResStrTableKey::IDS_PRC_FILENOTFOUND), +ScenarioFilename); return false;
 		}
 
+	// seeking in a record: start from the nearest snapshot instead
+	if (SeekFrame && !OpenSeekSnapshot()) return false;
+
 	// add scenario to group
 	GroupSet.RegisterGroup(ScenarioFile, false, C4GSPrio_Scenario, C4GSCnt_Scenario);
 
@@ -278,6 +284,33 @@ bool C4Game::OpenScenario()
 	return true;
 }
 
+bool C4Game::OpenSeekSnapshot()
+{
+	// find last snapshot before the seek frame; without one, the record is just fast-forwarded from the start
+	C4RecordSnapshotList snapshots;
+	if (!snapshots.Load(ScenarioFile)) return true;
+	const C4RecordSnapshot *const snapshot{snapshots.FindNearest(SeekFrame)};
+	if (!snapshot) return true;
+	// extract it to a temp file: control is still read from the record, which is reopened by name in InitControl
+	const std::string snapshotFilename{snapshot->GetFilename()};
+	const std::string tempFilename{Config.AtTempPath(snapshotFilename.c_str())};
+	if (!ScenarioFile.Extract(snapshotFilename.c_str(), tempFilename.c_str()))
+	{
+		spdlog::error("Record: Could not extract snapshot {}", snapshotFilename);
+		return true;
+	}
+	// continue with the snapshot as scenario
+	ScenarioFile.Close();
+	if (!ScenarioFile.Open(tempFilename.c_str()))
+	{
+		LogNTr("{}: {}", LoadResStr(C4ResStrTableKey::IDS_PRC_FILENOTFOUND), tempFilename); return false;
+	}
+	TempScenarioFile = true;
+	SeekSnapshot = *snapshot;
+	LogNTr("Record: Seeking to frame {} from snapshot at frame {}", SeekFrame, SeekSnapshot.Frame);
+	return true;
+}
+
 void C4Game::CloseScenario()
 {
 	// safe scenario file name
@@ -508,6 +541,7 @@ bool C4Game::Init()
 
 	// game running now!
 	IsRunning = true;
+	if (Application.Benchmark) Application.Benchmark->OnGameStarted();
 
 	// Start message
 	if (C4S.Head.NetworkGame)
@@ -622,6 +656,8 @@ void C4Game::Clear()
 	CloseScenario();
 	GroupSet.Clear();
 	KeyboardInput.Clear();
+	// everything deleted above may be reused by the next round
+	C4Pool::EndFrame();
 
 	if (Application.MusicSystem)
 	{
@@ -805,6 +841,7 @@ bool C4Game::Execute() // Returns true if the game is over
 
 	// Game
 
+	PathFinder.NextFrame();
 	EXEC_S(ExecObjects();, ExecObjectsStat)
 	if (pGlobalEffects)
 		EXEC_S_DR(pGlobalEffects->Execute(nullptr);, GEStats, "GEEx\0");
@@ -826,6 +863,9 @@ bool C4Game::Execute() // Returns true if the game is over
 
 	Control.DoSyncCheck();
 
+	// memory of objects, links, commands and effects deleted this frame may be reused from now on
+	C4Pool::EndFrame();
+
 	// Evaluation; Game over dlg
 	if (GameOver)
 	{
@@ -983,12 +1023,25 @@ void C4Game::ClearObjectPtrs(C4Object *pObj)
 	// May not call Objects.ClearPointers() because that would
 	// remove pObj from primary list and pObj is to be kept
 	// until CheckObjectRemoval().
-	C4Object *cObj; C4ObjectLink *clnk;
-	for (clnk = Objects.First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
-		cObj->ClearPointers(pObj);
-	// check in inactive objects as well
-	for (clnk = Objects.InactiveObjects.First; clnk && (cObj = clnk->Obj); clnk = clnk->Next)
-		cObj->ClearPointers(pObj);
+	// Only the object itself and the objects that have tracked pointers to it need to be cleared.
+	std::vector<C4Object *> referrers;
+	C4TrackedObjectPtr::GetReferrers(pObj, referrers);
+	pObj->ClearPointers(pObj);
+	for (C4Object *const cObj : referrers)
+		if (cObj != pObj)
+			cObj->ClearPointers(pObj);
+	// menus aren't tracked
+	C4ObjectMenu::ClearPointersInAll(pObj);
+#ifdef OBJECTREF_DEBUG
+	// compare with clearing in all objects
+	for (C4ObjectList *const pList : {static_cast<C4ObjectList *>(&Objects), &Objects.InactiveObjects})
+		for (C4ObjectLink *clnk = pList->First; clnk; clnk = clnk->Next)
+			if (clnk->Obj->HasPointersTo(pObj))
+			{
+				LogNTr(spdlog::level::err, "ClearObjectPtrs: {} (#{}) still points to {} (#{})", clnk->Obj->GetName(), clnk->Obj->Number, pObj->GetName(), pObj->Number);
+				clnk->Obj->ClearPointers(pObj);
+			}
+#endif
 	Application.SoundSystem->ClearPointers(pObj);
 }
 
@@ -1112,7 +1165,7 @@ C4Object *C4Game::NewObject(C4Def *pDef, C4Object *pCreator,
 	// From now on, object is ready to be used in scripts!
 	// Construction callback
 	C4AulParSet pars(C4VObj(pCreator));
-	objPtr->Call(PSF_Construction, pars);
+	objPtr->Call(C4DefCallback::Construction, pars);
 	// AssignRemoval called? (Con 0)
 	if (!objPtr->Status) { return nullptr; }
 	// Do initial con
@@ -1544,6 +1597,7 @@ int32_t C4Game::ObjectCount(C4ID id,
 
 void C4Game::ObjectRemovalCheck() // Every Tick255 by ExecObjects
 {
+	C4ST_STARTNEW(RemovalCheckStat, "C4Game::ObjectRemovalCheck")
 	C4Object *cObj; C4ObjectLink *clnk, *next;
 	for (clnk = Objects.First; clnk && (cObj = clnk->Obj); clnk = next)
 	{
@@ -1554,6 +1608,7 @@ void C4Game::ObjectRemovalCheck() // Every Tick255 by ExecObjects
 			delete cObj;
 		}
 	}
+	C4ST_STOP(RemovalCheckStat)
 }
 
 void C4Game::ExecObjects() // Every Tick1 by Execute
@@ -1763,6 +1818,8 @@ void C4Game::Default()
 	ObjectEnumerationIndex = 0;
 	FullSpeed = false;
 	FrameSkip = 1; DoSkipFrame = false;
+	SeekFrame = 0;
+	SeekSnapshot = {};
 	PreloadStatus = PreloadLevel::None;
 	Defs.Clear();
 	Material.Default();
@@ -1892,6 +1949,24 @@ void C4Game::Ticks()
 	if (FrameCounter % FrameSkip) DoSkipFrame = true;
 	// Control
 	Control.Ticks();
+	// Benchmark: no delay and no drawing at all
+	if (Application.Benchmark)
+	{
+		GameGo = true; DoSkipFrame = true;
+	}
+	// Seeking in replay: no delay and no drawing until the seek frame is reached
+	if (SeekFrame)
+	{
+		if (Control.isReplay() && FrameCounter < SeekFrame)
+		{
+			GameGo = true; DoSkipFrame = true;
+		}
+		else
+		{
+			if (Control.isReplay()) LogNTr("Record: Reached frame {}", FrameCounter);
+			SeekFrame = 0;
+		}
+	}
 	// Full speed
 	if (GameGo) Application.NextTick(false); // short-circuit the timer
 	// statistics
@@ -2883,7 +2958,14 @@ bool C4Game::InitControl()
 		// no joins
 		PlayerFilenames[0] = 0;
 		// start playback
-		if (!Control.InitReplay(ScenarioFile))
+		if (SeekSnapshot.Frame)
+		{
+			// started from a snapshot: control is in the record itself
+			C4Group RecordGrp;
+			if (!RecordGrp.Open(ScenarioFilename) || !Control.InitReplay(RecordGrp, &SeekSnapshot))
+				return false;
+		}
+		else if (!Control.InitReplay(ScenarioFile))
 			return false;
 	}
 	else if (Network.isEnabled())
@@ -3114,6 +3196,7 @@ void C4Game::ParseCommandLine(const char *szCmdLine)
 	NetworkActive = false;
 
 	// Scan additional parameters from command line
+	std::string benchmarkFolder, benchmarkOutput{"bench.json"};
 	char szParameter[_MAX_PATH + 1];
 	for (int32_t iPar = 0; SGetParameter(szCmdLine, iPar, szParameter, _MAX_PATH); iPar++)
 	{
@@ -3163,6 +3246,14 @@ void C4Game::ParseCommandLine(const char *szCmdLine)
 		// record stream
 		if (SEqual2NoCase(szParameter, "/stream:"))
 			RecordStream.Copy(szParameter + 8);
+		// record seek
+		if (SEqual2NoCase(szParameter, "/seek:"))
+			SeekFrame = std::max(atoi(szParameter + 6), 0);
+		// benchmark: replay all records in folder
+		if (SEqual2NoCase(szParameter, "/bench:"))
+			benchmarkFolder = szParameter + 7;
+		if (SEqual2NoCase(szParameter, "/benchout:"))
+			benchmarkOutput = szParameter + 10;
 		// startup start screen
 		if (SEqual2NoCase(szParameter, "/startup:"))
 			C4Startup::SetStartScreen(szParameter + 9);
@@ -3268,6 +3359,13 @@ void C4Game::ParseCommandLine(const char *szCmdLine)
 #endif
 	}
 
+	// Benchmark: first record becomes the scenario
+	if (!benchmarkFolder.empty() && !Application.Benchmark)
+	{
+		Application.Benchmark = std::make_unique<C4Benchmark>(benchmarkFolder, benchmarkOutput);
+		if (!Application.Benchmark->Start()) Application.Benchmark.reset();
+	}
+
 	// Check for fullscreen switch in command line
 	if (SSearchNoCase(szCmdLine, "/console"))
 		Application.isFullScreen = false;
@@ -155,6 +155,8 @@ public:
 	bool NetworkActive;
 	StdStrBuf RecordDumpFile;
 	StdStrBuf RecordStream;
+	int32_t SeekFrame; // replay: fast-forward to this frame
+	C4RecordSnapshot SeekSnapshot; // replay: record snapshot the game was started from; Frame is 0 if none
 	bool TempScenarioFile;
 	bool fPreinited; // set after PreInit has been called; unset by Clear and Default
 	int32_t FrameCounter;
@@ -315,6 +317,7 @@ protected:
 	void LinkScriptEngine();
 	bool InitPlayers();
 	bool OpenScenario();
+	bool OpenSeekSnapshot();
 	bool InitDefs();
 	bool InitMaterialTexture();
 	bool EnumerateMaterials();
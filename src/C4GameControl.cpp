@@ -69,7 +69,7 @@ bool C4GameControl::InitNetwork(C4Client *pLocal)
 	return true;
 }
 
-bool C4GameControl::InitReplay(C4Group &rGroup)
+bool C4GameControl::InitReplay(C4Group &rGroup, const C4RecordSnapshot *pStartSnapshot)
 {
 	// open replay
 	pPlayback = new C4Playback(Application.LogSystem.CreateLogger(Config.Logging.Playback));
@@ -79,6 +79,8 @@ bool C4GameControl::InitReplay(C4Group &rGroup)
 		delete pPlayback; pPlayback = nullptr;
 		return false;
 	}
+	// playing from a snapshot: skip control that led up to it
+	if (pStartSnapshot) pPlayback->SkipTo(*pStartSnapshot);
 	// set mode
 	eMode = CM_Replay; fInitComplete = true;
 	fHost = false; iClientID = C4ClientIDUnknown;
@@ -136,6 +138,18 @@ void C4GameControl::OnGameSynchronizing()
 	}
 }
 
+void C4GameControl::OnGameSyncCleared()
+{
+	// keyframe snapshot due? It is taken after the synchronize-call has been executed completely, so a replay
+	// continues with the control packet after it; anything before is contained in the snapshot
+	fSnapshotNeeded = false;
+	if (pRecord && pRecord->IsSnapshotDue(Game.FrameCounter))
+	{
+		CountFrame();
+		pRecord->Snapshot(iFramePackets, iFrameDebugRecs);
+	}
+}
+
 bool C4GameControl::StartRecord(bool fInitial, bool fStreaming)
 {
 	assert(fInitComplete);
@@ -227,7 +241,10 @@ void C4GameControl::Default()
 	SyncRate = C4SyncCheckRate;
 	DoSync = false;
 	fRecordNeeded = false;
+	fSnapshotNeeded = false;
 	pExecutingControl = nullptr;
+	iCountedFrame = -1;
+	iFramePackets = iFrameDebugRecs = 0;
 }
 
 bool C4GameControl::Prepare()
@@ -312,12 +329,20 @@ void C4GameControl::Execute()
 
 	// execute
 	pExecutingControl = &Control;
-	Control.Execute(logger);
+	CountFrame();
+	Control.Execute(logger, &iFramePackets);
 	Control.Clear();
 	pExecutingControl = nullptr;
 
 	// statistics record
 	if (Game.pNetworkStatistics) Game.pNetworkStatistics->ExecuteControlFrame();
+
+	// record snapshots must be taken in sync: request them through a synchronize-call
+	if (pRecord && fHost && !fSnapshotNeeded && pRecord->IsSnapshotDue(Game.FrameCounter))
+	{
+		fSnapshotNeeded = true;
+		DoInput(CID_Synchronize, new C4ControlSynchronize(false, true), CDT_Queue);
+	}
 }
 
 void C4GameControl::Ticks()
@@ -418,9 +443,13 @@ void C4GameControl::DbgRec(C4RecordChunkType eType, const uint8_t *pData, size_t
 	if (DoNoDebugRec > 0) return;
 	// record data
 	if (pRecord)
+	{
+		CountFrame();
+		++iFrameDebugRecs;
 		pRecord->Rec(Game.FrameCounter,
 			DecompileToBuf<StdCompilerBinWrite>(C4PktDebugRec(eType, StdBuf(pData, iSize))),
 			eType);
+	}
 	// check against playback
 	if (pPlayback)
 		pPlayback->Check(eType, pData, iSize);
@@ -472,7 +501,8 @@ void C4GameControl::ExecControl(const C4Control &rCtrl)
 	if (!rCtrl.firstPkt()) return;
 	// execute it
 	if (!rCtrl.PreExecute(logger)) logger->error("PreExecute failed for sync control!");
-	rCtrl.Execute(logger);
+	CountFrame();
+	rCtrl.Execute(logger, &iFramePackets);
 	// record
 	if (pRecord)
 		pRecord->Rec(rCtrl, Game.FrameCounter);
@@ -482,12 +512,21 @@ void C4GameControl::ExecControlPacket(C4PacketType eCtrlType, C4ControlPacket *p
 {
 	// execute it
 	if (!pPkt->PreExecute(logger)) logger->error("PreExecute failed for direct control!");
+	CountFrame();
+	++iFramePackets;
 	pPkt->Execute(logger);
 	// record it
 	if (pRecord)
 		pRecord->Rec(eCtrlType, pPkt, Game.FrameCounter);
 }
 
+void C4GameControl::CountFrame()
+{
+	if (iCountedFrame == Game.FrameCounter) return;
+	iCountedFrame = Game.FrameCounter;
+	iFramePackets = iFrameDebugRecs = 0;
+}
+
 C4ControlSyncCheck *C4GameControl::GetSyncCheck(int32_t iTick)
 {
 	for (C4IDPacket *pPkt = SyncChecks.firstPkt(); pPkt; pPkt = SyncChecks.nextPkt(pPkt))
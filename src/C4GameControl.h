@@ -58,6 +58,7 @@ protected:
 	bool fHost; // (set for local, too)
 	bool fActivated;
 	bool fRecordNeeded;
+	bool fSnapshotNeeded; // set if a synchronize has been requested for a record snapshot
 	int32_t iClientID;
 
 	C4Record *pRecord;
@@ -69,6 +70,9 @@ protected:
 
 	C4Control *pExecutingControl; // Control that is in the process of being executed - needed by non-initial records
 
+	// control packets executed and debug chunks recorded in iCountedFrame so far - tells where in its frame a record snapshot was taken
+	int32_t iCountedFrame, iFramePackets, iFrameDebugRecs;
+
 private:
 	std::shared_ptr<spdlog::logger> logger;
 
@@ -95,7 +99,7 @@ public:
 	void InitLogger();
 	bool InitLocal(C4Client *pLocal);
 	bool InitNetwork(C4Client *pLocal);
-	bool InitReplay(C4Group &rGroup);
+	bool InitReplay(C4Group &rGroup, const C4RecordSnapshot *pStartSnapshot = nullptr);
 
 	void ChangeToLocal();
 
@@ -141,12 +145,14 @@ public:
 	void ExecControl(const C4Control &rCtrl);
 	void ExecControlPacket(C4PacketType eCtrlType, class C4ControlPacket *pPkt);
 	void OnGameSynchronizing(); // start record if desired
+	void OnGameSyncCleared(); // take record snapshot if due
 
 	const std::shared_ptr<spdlog::logger> &GetLogger() const noexcept { return logger; }
 
 protected:
 	// sync checks
 	C4ControlSyncCheck *GetSyncCheck(int32_t iTick);
+	void CountFrame(); // reset frame counters if a new frame has begun
 	void RemoveOldSyncChecks();
 };
 
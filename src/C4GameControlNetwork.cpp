@@ -717,9 +717,12 @@ void C4GameControlNetwork::CheckCompleteCtrl(bool fSetEvent) // by both
 		if (fSetEvent && Game.GameGo && iControlReady >= Game.Control.ControlTick)
 			Application.NextTick(true);
 	}
-	// clear old ctrl
-	if (Game.Control.ControlTick >= C4ControlBacklog)
-		ClearCtrl(Game.Control.ControlTick - C4ControlBacklog);
+	// clear old ctrl (but keep what clients joining by a runtime dynamic still need)
+	int32_t iClearTick = Game.Control.ControlTick - C4ControlBacklog;
+	if (const int32_t iDynamicCtrlTick{Game.Network.getDynamicCtrlTick()}; iDynamicCtrlTick >= 0)
+		iClearTick = std::min(iClearTick, iDynamicCtrlTick);
+	if (iClearTick >= 0)
+		ClearCtrl(iClearTick);
 	// target ctrl tick to reach?
 	if (iControlReady < iTargetTick &&
 		(!fActivated || iControlSent > iControlReady) &&
@@ -27,10 +27,17 @@
 #include <C4Network2Stats.h>
 #include <C4Game.h>
 #include <C4Wrappers.h>
+#include <C4Stat.h>
+
+#include <algorithm>
+#include <iterator>
 
 C4GameObjects::C4GameObjects()
 {
 	Default();
+	// ObjectPointer is used for every enumerated pointer and object number in controls and scripts
+	EnableNumberIndex(true);
+	InactiveObjects.EnableNumberIndex(true);
 }
 
 C4GameObjects::~C4GameObjects()
@@ -43,6 +50,10 @@ void C4GameObjects::Default()
 	ResortProc = nullptr;
 	Sectors.Clear();
 	LastUsedMarker = 0;
+	DrawAnywhere.clear();
+	DrawCandidates.clear();
+	DrawOrderVersion = 0;
+	DrawOrderFrame = -1;
 }
 
 void C4GameObjects::Init(int32_t iWidth, int32_t iHeight)
@@ -128,8 +139,8 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 							if (Game.Players.Hostile(obj1->Owner, obj2->Owner))
 							{
 								// RejectFight callback
-								if (obj1->Call(PSF_RejectFight, {C4VObj(obj2)}).getBool()) continue;
-								if (obj2->Call(PSF_RejectFight, {C4VObj(obj1)}).getBool()) continue;
+								if (obj1->Call(C4DefCallback::RejectFight, {C4VObj(obj2)}).getBool()) continue;
+								if (obj2->Call(C4DefCallback::RejectFight, {C4VObj(obj1)}).getBool()) continue;
 								ObjectActionFight(obj1, obj2);
 								ObjectActionFight(obj2, obj1);
 								continue;
@@ -165,7 +176,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 										obj2->Marker = Marker;
 										// Hit
 										if ((obj2->OCF & OCF_HitSpeed2) && (obj1->OCF & OCF_Alive) && (obj2->Category & C4D_Object))
-											if (!obj1->Call(PSF_QueryCatchBlow, {C4VObj(obj2)}))
+											if (!obj1->Call(C4DefCallback::QueryCatchBlow, {C4VObj(obj2)}))
 											{
 												// "realistic" hit energy
 												C4Fixed dXDir = obj2->xdir - obj1->xdir, dYDir = obj2->ydir - obj1->ydir;
@@ -175,7 +186,7 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 												int tmass = std::max<int32_t>(obj1->Mass, 50);
 												if (!Tick3 || (obj1->Action.Act >= 0 && obj1->Def->ActMap[obj1->Action.Act].Procedure != DFA_FLIGHT))
 													obj1->Fling(obj2->xdir * 50 / tmass, -Abs(obj2->ydir / 2) * 50 / tmass, false, obj2->Controller);
-												obj1->Call(PSF_CatchBlow, {C4VInt(-iHitEnergy / 5),
+												obj1->Call(C4DefCallback::CatchBlow, {C4VInt(-iHitEnergy / 5),
 													C4VObj(obj2)});
 												// obj1 might have been tampered with
 												if (!obj1->Status || obj1->Contained || !(obj1->OCF & focf))
@@ -323,6 +334,64 @@ void C4GameObjects::DeleteObjects()
 	Mass = 0;
 }
 
+void C4GameObjects::UpdateDrawOrder()
+{
+	// list order and object state only change with game frames or list manipulation,
+	// unless the game is paused and objects are edited by script or in the editor
+	if (DrawOrderVersion == GetOrderVersion() && DrawOrderFrame == Game.FrameCounter && !Game.IsPaused()) return;
+	DrawOrderVersion = GetOrderVersion();
+	DrawOrderFrame = Game.FrameCounter;
+	DrawAnywhere.clear();
+	int32_t iOrder = 0;
+	for (C4ObjectLink *cLnk = First; cLnk; cLnk = cLnk->Next)
+	{
+		C4Object *const pObj{cLnk->Obj};
+		pObj->DrawOrder = iOrder++;
+		// parallax objects are shifted against the view, lines and particles are not bound to the shape,
+		// transformed objects and overlays may be much bigger, and action facets may exceed the view margin
+		if ((pObj->Category & C4D_Parallax) || (pObj->Def && pObj->Def->Line)
+			|| pObj->BackParticles || pObj->FrontParticles || pObj->pDrawTransform || pObj->pGfxOverlay
+			|| pObj->FacetExceedsShape(C4DrawViewMargin))
+			DrawAnywhere.push_back(pObj);
+	}
+}
+
+void C4GameObjects::DrawVisible(C4FacetEx &cgo, int iPlayer, uint32_t dwCat, bool fInvert)
+{
+	// no sectors yet, or command paths to display anywhere: draw everything
+	if (!Sectors.Sectors || Game.GraphicsSystem.ShowCommand)
+	{
+		DrawIfCategory(cgo, iPlayer, dwCat, fInvert);
+		return;
+	}
+
+	C4ST_STARTNEW(GatherStat, "C4GameObjects::DrawVisible: Gather")
+	UpdateDrawOrder();
+	const auto fnMatches = [dwCat, fInvert](C4Object *pObj) { return !(pObj->Category & dwCat) == fInvert; };
+	DrawCandidates.clear();
+	std::copy_if(DrawAnywhere.begin(), DrawAnywhere.end(), std::back_inserter(DrawCandidates), fnMatches);
+	// objects with shapes in the sectors around the view
+	C4LArea Area(&Sectors, cgo.TargetX - C4DrawViewMargin, cgo.TargetY - C4DrawViewMargin, cgo.Wdt + 2 * C4DrawViewMargin, cgo.Hgt + 2 * C4DrawViewMargin);
+	C4LSector *pSct;
+	for (C4ObjectList *pLst = Area.FirstObjectShapes(&pSct); pLst; pLst = Area.NextObjectShapes(pLst, &pSct))
+		for (C4ObjectLink *cLnk = pLst->First; cLnk; cLnk = cLnk->Next)
+			if (fnMatches(cLnk->Obj))
+				DrawCandidates.push_back(cLnk->Obj);
+	// merge into list order, drawn back to front like DrawIfCategory; objects spanning several sectors are found more than once
+	std::sort(DrawCandidates.begin(), DrawCandidates.end(), [](C4Object *pObj1, C4Object *pObj2) { return pObj1->DrawOrder > pObj2->DrawOrder; });
+	DrawCandidates.erase(std::unique(DrawCandidates.begin(), DrawCandidates.end()), DrawCandidates.end());
+	C4ST_STOP(GatherStat)
+
+	C4ST_STARTNEW(DrawStat, "C4GameObjects::DrawVisible: Draw")
+	// Draw objects (base)
+	for (C4Object *const pObj : DrawCandidates)
+		pObj->Draw(cgo, iPlayer);
+	// Draw objects (top face)
+	for (C4Object *const pObj : DrawCandidates)
+		pObj->DrawTopFace(cgo, iPlayer);
+	C4ST_STOP(DrawStat)
+}
+
 void C4GameObjects::Clear(bool fClearInactive)
 {
 	DeleteObjects();
@@ -409,7 +478,7 @@ void C4ObjResort::SortObject()
 	if (pSortObj->Status != C4OS_NORMAL || pSortObj->Unsorted) return;
 	// pre-build parameters
 	C4AulParSet Pars;
-	Pars[1].Set(C4VObj(pSortObj));
+	Pars.Set(1, C4VObj(pSortObj));
 	// first, check forward in list
 	C4ObjectLink *pMoveLink = nullptr;
 	C4ObjectLink *pLnk = Game.Objects.GetLink(pSortObj);
@@ -424,7 +493,7 @@ void C4ObjResort::SortObject()
 		// does the category still match?
 		if (!(pObj2->Category & pSortObj->Category)) break;
 		// perform the check
-		Pars[0].Set(C4VObj(pObj2));
+		Pars.Set(0, C4VObj(pObj2));
 		iResult = OrderFunc->Exec(nullptr, Pars).getInt();
 		if (iResult > 0) break;
 		if (iResult < 0) pMoveLink = pLnk;
@@ -442,7 +511,7 @@ void C4ObjResort::SortObject()
 	else
 	{
 		// no movement yet: check backwards in list
-		Pars[0].Set(C4VObj(pSortObj));
+		Pars.Set(0, C4VObj(pSortObj));
 		pLnk = pLnkBck;
 		while (pLnk = pLnk->Prev)
 		{
@@ -452,7 +521,7 @@ void C4ObjResort::SortObject()
 			// does the category still match?
 			if (!(pObj2->Category & pSortObj->Category)) break;
 			// perform the check
-			Pars[1].Set(C4VObj(pObj2));
+			Pars.Set(1, C4VObj(pObj2));
 			iResult = OrderFunc->Exec(nullptr, Pars).getInt();
 			if (iResult > 0) break;
 			if (iResult < 0) pMoveLink = pLnk;
@@ -497,12 +566,12 @@ void C4ObjResort::Sort(C4ObjectLink *pFirst, C4ObjectLink *pLast)
 			pCurr2 = pCurr->Prev;
 			while (!pCurr2->Obj->Status) pCurr2 = pCurr2->Prev;
 			// perform the check
-			Pars[0].Set(C4VObj(pCurr->Obj)); Pars[1].Set(C4VObj(pCurr2->Obj));
+			Pars.Set(0, C4VObj(pCurr->Obj)); Pars.Set(1, C4VObj(pCurr2->Obj));
 			if (OrderFunc->Exec(nullptr, Pars).getInt() < 0)
 			{
 				// so there's something to be reordered: swap the links
-				// FIXME: Inform C4ObjectList about this reorder
-				C4Object *pObj = pCurr->Obj; pCurr->Obj = pCurr2->Obj; pCurr2->Obj = pObj;
+				// FIXME: Inform C4ObjectListChangeListener about this reorder
+				Game.Objects.SwapLinkObjects(pCurr, pCurr2);
 				// and readd to sector lists
 				pCurr->Obj->Unsorted = pCurr2->Obj->Unsorted = true;
 				// grow list section to scan next
@@ -576,7 +645,7 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 	// if object numbers collideded, numbers will be adjusted afterwards
 	// so fake inactive object list empty meanwhile
 	C4ObjectLink *pInFirst;
-	if (fObjectNumberCollision) { pInFirst = InactiveObjects.First; InactiveObjects.First = nullptr; }
+	if (fObjectNumberCollision) { pInFirst = InactiveObjects.First; InactiveObjects.First = nullptr; InactiveObjects.EnableNumberIndex(false); }
 	// denumerate pointers
 	Denumerate();
 	// update object enumeration index now, because calls like UpdateTransferZone might create objects
@@ -589,6 +658,7 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 		for (cLnk = InactiveObjects.First; cLnk; cLnk = cLnk->Next)
 			if ((pObj = cLnk->Obj)->Status)
 				pObj->Number = ++Game.ObjectEnumerationIndex;
+		InactiveObjects.EnableNumberIndex(true);
 	}
 
 	// special checks:
@@ -645,9 +715,13 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 			else
 				InactiveObjects.First = cLnk;
 			InactiveObjects.Last = cLnk; cLnk->Next = nullptr;
+			cLnk->List = &InactiveObjects;
 			Mass -= pObj->Mass;
 		}
 	}
+	// links have been moved directly
+	EnableNumberIndex(true);
+	InactiveObjects.EnableNumberIndex(true);
 
 	{
 		C4DebugRecOff DBGRECOFF; // - script callbacks that would kill DebugRec-sync for runtime start
@@ -811,8 +885,7 @@ void C4GameObjects::FixObjectOrder()
 					DebugLog(spdlog::level::err, "Objects.txt: Wrong object order of #{}-#{}! (down)", static_cast<int>(pObj->Number), static_cast<int>(pLnkPrev->Obj->Number));
 					pLastWarnObj = pLnkPrev->Obj;
 				}
-				pLnk->Obj = pLnkPrev->Obj;
-				pLnkPrev->Obj = pObj;
+				SwapLinkObjects(pLnk, pLnkPrev);
 				pLnkLastUnsorted = pLnkPrev;
 			}
 			else
@@ -836,8 +909,7 @@ void C4GameObjects::FixObjectOrder()
 					DebugLog(spdlog::level::err, "Objects.txt: Wrong object order of #{}-#{}! (up)", static_cast<int>(pObj->Number), static_cast<int>(pLnkPrev->Obj->Number));
 					pLastWarnObj = pLnkPrev->Obj;
 				}
-				pLnk->Obj = pLnkPrev->Obj;
-				pLnkPrev->Obj = pObj;
+				SwapLinkObjects(pLnk, pLnkPrev);
 				pLnk1stUnsorted = pLnkPrev;
 			}
 			else
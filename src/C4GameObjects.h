@@ -23,8 +23,13 @@
 #include <C4FindObject.h>
 #include <C4Sector.h>
 
+#include <vector>
+
 class C4ObjResort;
 
+// margin around the view in which objects are drawn, for facets exceeding the shape
+const int32_t C4DrawViewMargin = 2 * C4LSectorWdt;
+
 // main object list class
 class C4GameObjects : public C4NotifyingObjectList
 {
@@ -38,6 +43,13 @@ public:
 private:
 	uint32_t LastUsedMarker; // last used value for C4Object::Marker
 
+	// culled drawing
+	std::vector<C4Object *> DrawAnywhere; // objects that may draw outside their shape area
+	std::vector<C4Object *> DrawCandidates;
+	uint32_t DrawOrderVersion; // list order version of the C4Object::DrawOrder values
+	int32_t DrawOrderFrame; // frame in which DrawAnywhere was collected
+	void UpdateDrawOrder();
+
 public:
 	C4LSectors Sectors; // section object lists
 	C4ObjectList InactiveObjects; // inactive objects (Status=2)
@@ -79,6 +91,9 @@ public:
 
 	void DeleteObjects(); // delete all objects and links
 
+	// like DrawIfCategory, but only looks at objects in the sectors around the view
+	void DrawVisible(C4FacetEx &cgo, int iPlayer, uint32_t dwCat, bool fInvert);
+
 	bool ValidateOwners();
 	bool AssignInfo();
 };
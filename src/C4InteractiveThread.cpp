@@ -18,31 +18,25 @@
 #include "C4InteractiveThread.h"
 #include "C4Application.h"
 #include "C4Log.h"
+#include "C4Stat.h"
 
 #include <C4Game.h>
 
 #include <cassert>
+#include <iterator>
 
 // *** C4InteractiveThread
 
 C4InteractiveThread::C4InteractiveThread()
 {
-	// Add head-item
-	pFirstEvent = pLastEvent = new Event();
-	pFirstEvent->Type = Ev_None;
-	pFirstEvent->Next = nullptr;
+	EventBatch.reserve(EventBatchSize);
 	// reset event handlers
 	std::fill(pCallbacks, std::end(pCallbacks), nullptr);
 }
 
 C4InteractiveThread::~C4InteractiveThread()
 {
-	CStdLock PushLock(&EventPushCSec), PopLock(&EventPopCSec);
-	// Remove all items. This may leak data, if pData was allocated on the heap.
-	while (PopEvent(nullptr, nullptr));
-	// Delete head-item
-	delete pFirstEvent;
-	pFirstEvent = pLastEvent = nullptr;
+	// Remaining events are dropped with the queue. This may leak data, if it was allocated on the heap.
 }
 
 bool C4InteractiveThread::AddProc(StdSchedulerProc *pProc)
@@ -69,20 +63,16 @@ void C4InteractiveThread::RemoveProc(StdSchedulerProc *pProc)
 
 bool C4InteractiveThread::PushEvent(C4InteractiveEventType eEvent, std::any data)
 {
-	CStdLock PushLock(&EventPushCSec);
-	if (!pLastEvent) return false;
 	// create event
-	Event *pEvent = new Event;
-	pEvent->Type = eEvent;
-	pEvent->Data = std::move(data);
+	Event event{eEvent, std::move(data)};
 #ifndef NDEBUG
-	pEvent->Time = timeGetTime();
+	event.Time = timeGetTime();
 #endif
-	pEvent->Next = nullptr;
 	// add item (at end)
-	pLastEvent->Next = pEvent;
-	pLastEvent = pEvent;
-	PushLock.Clear();
+	Events.Push(std::move(event));
+	// main thread already woken up? It will see this event as well.
+	if (EventSignalPending.exchange(true))
+		return true;
 #ifdef _WIN32
 	// post message to main thread
 	try
@@ -104,45 +94,45 @@ bool C4InteractiveThread::PushEvent(C4InteractiveEventType eEvent, std::any data
 double AvgNetEvDelay = 0;
 #endif
 
-bool C4InteractiveThread::PopEvent(C4InteractiveEventType *pEventType, std::any *data) // (by main thread)
+void C4InteractiveThread::PopEvents() // (by main thread)
 {
-	CStdLock PopLock(&EventPopCSec);
-	if (!pFirstEvent) return false;
-	// get event
-	Event *pEvent = pFirstEvent->Next;
-	if (!pEvent) return false;
-	// return
-	if (pEventType)
-		*pEventType = pEvent->Type;
-	if (data)
-		*data = std::move(pEvent->Data);
-#ifndef NDEBUG
-	if (Game.IsRunning)
-		AvgNetEvDelay += ((timeGetTime() - pEvent->Time) - AvgNetEvDelay) / 100;
-#endif
-	// remove
-	delete pFirstEvent;
-	pFirstEvent = pEvent;
-	pFirstEvent->Type = Ev_None;
-	return true;
+	EventBatch.clear();
+	EventBatchPos = 0;
+	Events.PopBatch(EventBatch, EventBatchSize);
 }
 
 void C4InteractiveThread::ProcessEvents() // by main thread
 {
-	C4InteractiveEventType eEventType; std::any eventData;
-	while (PopEvent(&eEventType, &eventData))
-		switch (eEventType)
+	C4ST_STARTNEW(ProcessEventsStat, "C4InteractiveThread::ProcessEvents")
+	// events pushed from now on need another wakeup
+	EventSignalPending.store(false);
+	for (;;)
+	{
+		// Handlers might process events recursively, so the batch is a member and events are taken out one by one
+		if (EventBatchPos >= EventBatch.size())
+		{
+			PopEvents();
+			if (EventBatch.empty()) break;
+		}
+		Event event{std::move(EventBatch[EventBatchPos++])};
+#ifndef NDEBUG
+		if (Game.IsRunning)
+			AvgNetEvDelay += ((timeGetTime() - event.Time) - AvgNetEvDelay) / 100;
+#endif
+		switch (event.Type)
 		{
 		// Execute in main thread
 		case Ev_ExecuteInMainThread:
-			std::any_cast<const std::function<void()> &>(eventData)();
+			std::any_cast<const std::function<void()> &>(event.Data)();
 			break;
 
 		// Other events: check for a registered handler
 		default:
-			if (eEventType >= Ev_None && eEventType <= Ev_Last)
-				if (pCallbacks[eEventType])
-					pCallbacks[eEventType]->OnThreadEvent(eEventType, eventData);
+			if (event.Type >= Ev_None && event.Type <= Ev_Last)
+				if (pCallbacks[event.Type])
+					pCallbacks[event.Type]->OnThreadEvent(event.Type, event.Data);
 			// Note that memory might leak if the event wasn't processed....
 		}
+	}
+	C4ST_STOP(ProcessEventsStat)
 }
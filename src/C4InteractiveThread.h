@@ -16,11 +16,15 @@
 
 #pragma once
 
+#include "C4EventQueue.h"
 #include "StdScheduler.h"
 #include "StdSync.h"
 
 #include <any>
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <vector>
 
 // Event types
 enum C4InteractiveEventType
@@ -65,15 +69,22 @@ private:
 	// event queue (signals to main thread)
 	struct Event
 	{
-		C4InteractiveEventType Type;
+		C4InteractiveEventType Type{Ev_None};
 		std::any Data;
 #ifndef NDEBUG
 		int Time;
 #endif
-		Event *Next;
 	};
-	Event *pFirstEvent, *pLastEvent;
-	CStdCSec EventPushCSec, EventPopCSec;
+
+	// any thread pushes, the main thread pops
+	static constexpr std::size_t EventRingSize{1024};
+	static constexpr std::size_t EventBatchSize{64};
+	C4EventQueue<Event, EventRingSize> Events;
+	std::atomic<bool> EventSignalPending{false}; // main thread has been woken, but not started processing yet
+
+	// events popped, but not processed yet (by main thread)
+	std::vector<Event> EventBatch;
+	std::size_t EventBatchPos{0};
 
 	// callback objects for events of special types
 	Callback *pCallbacks[Ev_Last + 1];
@@ -106,5 +117,5 @@ public:
 	}
 
 private:
-	bool PopEvent(C4InteractiveEventType *pEventType, std::any *data); // by main thread
+	void PopEvents(); // refill EventBatch (by main thread)
 };
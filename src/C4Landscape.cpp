@@ -27,6 +27,7 @@
 #include <C4Physics.h>
 #include <C4Random.h>
 #include <C4SurfaceFile.h>
+#include <C4Stat.h>
 #include <C4ToolsDlg.h>
 #ifdef DEBUGREC
 #include <C4Record.h>
@@ -39,7 +40,10 @@
 #include <StdBitmap.h>
 #include <StdPNG.h>
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 #include <utility>
@@ -242,13 +246,14 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky)
 	if (fClearMapCreator) { delete pMapCreator; pMapCreator = nullptr; }
 	// clear sky
 	if (fClearSky) Sky.Clear();
+	Renderer.reset();
 	// clear surfaces, if assigned
 	delete Surface32;        Surface32        = nullptr;
 	delete AnimationSurface; AnimationSurface = nullptr;
 	delete Surface8;         Surface8         = nullptr;
 	delete Map;              Map              = nullptr;
 	// clear initial landscape
-	delete[] pInitial;       pInitial         = nullptr;
+	InitialTiles.clear();
 	// clear scan
 	ScanX = 0;
 	Mode = C4LSC_Undefined;
@@ -265,6 +270,8 @@ void C4Landscape::Draw(C4FacetEx &cgo, int32_t iPlayer)
 	// blit landscape
 	if (Game.GraphicsSystem.ShowSolidMask)
 		Application.DDraw->Blit8Fast(Surface8, cgo.TargetX, cgo.TargetY, cgo.Surface, cgo.X, cgo.Y, cgo.Wdt, cgo.Hgt);
+	else if (Renderer)
+		Renderer->Draw(AnimationSurface ? &Game.GraphicsResource.sfcLiquidAnimation : nullptr, cgo.TargetX, cgo.TargetY, cgo.Surface, cgo.X, cgo.Y, cgo.Wdt, cgo.Hgt);
 	else
 		Application.DDraw->BlitLandscape(Surface32, AnimationSurface, &Game.GraphicsResource.sfcLiquidAnimation, cgo.TargetX, cgo.TargetY, cgo.Surface, cgo.X, cgo.Y, cgo.Wdt, cgo.Hgt);
 	if (Modulation) Application.DDraw->DeactivateBlitModulation();
@@ -534,7 +541,7 @@ CSurface8 *C4Landscape::CreateMapS2(C4Group &ScenFile)
 
 	// create map creator
 	if (!pMapCreator)
-		pMapCreator = new C4MapCreatorS2(&Game.C4S.Landscape, &Game.TextureMap, &Game.Material, Game.Parameters.StartupPlayerCount);
+		pMapCreator = new C4MapCreatorS2(&Game.C4S.Landscape, &Game.TextureMap, &Game.Material, Game.Parameters.StartupPlayerCount, &Game.Script);
 
 	// read file
 	pMapCreator->ReadFile(C4CFN_DynLandscape, &ScenFile);
@@ -700,9 +707,16 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 			return false;
 		}
 
+		InitRenderer();
+
 		// Map to landscape
 		if (!MapToLandscape()) return false;
 	}
+	// exact landscapes with their own colors must be drawn from Surface32
+	else if (!hGroup.FindEntry(C4CFN_LandscapePNG))
+	{
+		InitRenderer();
+	}
 	Game.SetInitProgress(87);
 
 #ifdef DEBUGREC
@@ -729,6 +743,9 @@ bool C4Landscape::Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bo
 	// enforce first color to be transparent
 	Surface8->EnforceC0Transparency();
 
+	// new landscape: drop all cached paths
+	Game.PathFinder.ClearGraph();
+
 	// after map/landscape creation, the seed must be fixed again, so there's no difference between clients creating
 	// and not creating the map
 	Game.FixRandom(Game.Parameters.RandomSeed);
@@ -765,6 +782,8 @@ bool C4Landscape::SetPix(int32_t x, int32_t y, uint8_t npix)
 
 bool C4Landscape::SetPixDw(int32_t x, int32_t y, uint32_t dwPix)
 {
+	// custom colors only exist in Surface32
+	ClearRenderer();
 	if (!Surface32->LockForUpdate({x, y, 1, 1}))
 	{
 		return false;
@@ -842,6 +861,14 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 		}
 	}
 
+	// cached paths through here are outdated when solidity changes
+	if (DensitySolid(Pix2Dens[npix]) != DensitySolid(Pix2Dens[opix]))
+		Game.PathFinder.InvalidateRect(x, y, 1, 1);
+
+	// keep initial pixels for the diff
+	if (!InitialTiles.empty() && !InitialTiles[(y / C4LS_DiffTileSize) * InitialTilesPitch + x / C4LS_DiffTileSize])
+		SaveInitialTile(x / C4LS_DiffTileSize, y / C4LS_DiffTileSize);
+
 	// set 8bpp-surface only!
 	Surface8->SetPix(x, y, npix);
 	// success
@@ -1081,12 +1108,24 @@ void C4Landscape::BlastFree(int32_t tx, int32_t ty, int32_t rad, int32_t grade,
 
 void C4Landscape::DrawMaterialRect(int32_t mat, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt)
 {
-	int32_t cx, cy;
-	for (cy = ty; cy < ty + hgt; cy++)
-		for (cx = tx; cx < tx + wdt; cx++)
-			if ((MatDensity(mat) > GetDensity(cx, cy))
-				|| ((MatDensity(mat) == GetDensity(cx, cy)) && (MatDigFree(mat) <= MatDigFree(GetMat(cx, cy)))))
-				SetPix(cx, cy, Mat2PixColDefault(mat) + GBackIFT(cx, cy));
+	// whether a pixel is overdrawn only depends on its own value, so decide once per value
+	// pixels outside the landscape cannot be set anyway
+	uint8_t Target[256];
+	for (int32_t pix = 0; pix < 256; pix++)
+		if ((MatDensity(mat) > Pix2Dens[pix])
+			|| ((MatDensity(mat) == Pix2Dens[pix]) && (MatDigFree(mat) <= MatDigFree(Pix2Mat[pix]))))
+			Target[pix] = Mat2PixColDefault(mat) + PixColIFT(pix);
+		else
+			Target[pix] = pix;
+	// the pixels are still set one by one, as the rect is not cleared of solid masks
+	const int32_t x1 = std::max<int32_t>(tx, 0), x2 = std::min<int32_t>(tx + wdt, Width);
+	for (int32_t cy = std::max<int32_t>(ty, 0); cy < std::min<int32_t>(ty + hgt, Height); cy++)
+	{
+		const uint8_t *const pRow = Surface8->Bits + cy * Surface8->Pitch;
+		for (int32_t cx = x1; cx < x2; cx++)
+			if (Target[pRow[cx]] != pRow[cx])
+				SetPix(cx, cy, Target[pRow[cx]]);
+	}
 }
 
 void C4Landscape::RaiseTerrain(int32_t tx, int32_t ty, int32_t wdt)
@@ -1107,11 +1146,28 @@ void C4Landscape::RaiseTerrain(int32_t tx, int32_t ty, int32_t wdt)
 
 int32_t C4Landscape::AreaSolidCount(int32_t x, int32_t y, int32_t wdt, int32_t hgt)
 {
+	// count the part inside the landscape row by row; pixels outside follow the border rules of GetPix
+	const int32_t x2 = x + wdt;
+	const int32_t ix = BoundBy<int32_t>(x, 0, Width), ix2 = BoundBy<int32_t>(x2, ix, Width);
+	const auto solid = [this](const uint8_t pix) { return DensitySolid(Pix2Dens[pix]); };
 	int32_t cx, cy, ascnt = 0;
 	for (cy = y; cy < y + hgt; cy++)
-		for (cx = x; cx < x + wdt; cx++)
-			if (GBackSolid(cx, cy))
+	{
+		if (cy < 0 || cy >= Height)
+		{
+			for (cx = x; cx < x2; cx++)
+				if (DensitySolid(GetDensity(cx, cy)))
+					ascnt++;
+			continue;
+		}
+		for (cx = x; cx < std::min(ix, x2); cx++)
+			if (DensitySolid(GetDensity(cx, cy)))
 				ascnt++;
+		ascnt += CSurface8::CountRow(Surface8->Bits + cy * Surface8->Pitch + ix, ix2 - ix, solid);
+		for (cx = std::max(ix2, x); cx < x2; cx++)
+			if (DensitySolid(GetDensity(cx, cy)))
+				ascnt++;
+	}
 	return ascnt;
 }
 
@@ -1458,6 +1514,8 @@ bool C4Landscape::Save(C4Group &hGroup)
 
 	SCopy(Config.AtTempPath(C4CFN_TempLandscapePNG), szTempLandscape);
 	MakeTempFilename(szTempLandscape);
+	if (Renderer && !RelightAll())
+		return false;
 	if (!Surface32->SavePNG(szTempLandscape, true, false, false))
 		return false;
 	if (!hGroup.Move(szTempLandscape, C4CFN_LandscapePNG)) return false;
@@ -1473,23 +1531,39 @@ bool C4Landscape::Save(C4Group &hGroup)
 
 bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave)
 {
-	assert(pInitial);
-	if (!pInitial) return false;
+	assert(!InitialTiles.empty());
+	if (InitialTiles.empty()) return false;
 
-	// If it shouldn't be sync-save: Clear all bytes that have not changed
+	// If it shouldn't be sync-save: Save a diff surface in which all bytes that have not changed are 0xff
 	bool fChanged = false;
+	CSurface8 Diff;
 	if (!fSyncSave)
-		for (int y = 0; y < Height; y++)
-			for (int x = 0; x < Width; x++)
-				if (pInitial[y * Width + x] == _GetPix(x, y))
-					Surface8->SetPix(x, y, 0xff);
-				else
+	{
+		C4ST_STARTNEW(SaveDiffStat, "C4Landscape::SaveDiff")
+		if (!Diff.Create(Width, Height)) return false;
+		std::fill_n(Diff.Bits, Diff.Pitch * Height, 0xff);
+		// only tiles that have been modified since the initial landscape can contain changes
+		const int32_t iTilesY = (Height + C4LS_DiffTileSize - 1) / C4LS_DiffTileSize;
+		const auto iSavedTiles = std::ranges::count_if(InitialTiles, [](const auto &pTile) { return pTile != nullptr; });
+		DebugLog(spdlog::level::debug, "Landscape diff: {} of {} tiles modified, {} KiB of initial landscape kept (full copy: {} KiB)",
+			iSavedTiles, InitialTiles.size(), iSavedTiles * C4LS_DiffTileSize * C4LS_DiffTileSize / 1024, Width * Height / 1024);
+		for (int32_t iTileY = 0; iTileY < iTilesY; iTileY++)
+			for (int32_t iTileX = 0; iTileX < InitialTilesPitch; iTileX++)
+			{
+				const uint8_t *const pTile = InitialTiles[iTileY * InitialTilesPitch + iTileX].get();
+				if (!pTile) continue;
+				const int32_t x = iTileX * C4LS_DiffTileSize, y = iTileY * C4LS_DiffTileSize;
+				const int32_t iWdt = std::min(C4LS_DiffTileSize, Width - x), iHgt = std::min(C4LS_DiffTileSize, Height - y);
+				if (CSurface8::DiffRect(Diff.Bits + y * Diff.Pitch + x, Diff.Pitch, Surface8->Bits + y * Surface8->Pitch + x, Surface8->Pitch, pTile, iWdt, iWdt, iHgt, 0xff))
 					fChanged = true;
+			}
+		C4ST_STOP(SaveDiffStat)
+	}
 
 	if (fSyncSave || fChanged)
 	{
-		// Save landscape surface
-		if (!Surface8->Save(Config.AtTempPath(C4CFN_TempLandscape)))
+		// Save landscape or diff surface
+		if (!(fSyncSave ? Surface8->Save(Config.AtTempPath(C4CFN_TempLandscape)) : Diff.Save(Config.AtTempPath(C4CFN_TempLandscape), Surface8->pPal->Colors)))
 			return false;
 
 		// Move temp file to group
@@ -1498,14 +1572,6 @@ bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave)
 			return false;
 	}
 
-	// Restore landscape pixels
-	if (!fSyncSave)
-		if (pInitial)
-			for (int y = 0; y < Height; y++)
-				for (int x = 0; x < Width; x++)
-					if (_GetPix(x, y) == 0xff)
-						Surface8->SetPix(x, y, pInitial[y * Width + x]);
-
 	// Save changed map, too
 	if (fMapChanged && Map)
 		if (!SaveMap(hGroup)) return false;
@@ -1518,16 +1584,33 @@ bool C4Landscape::SaveDiff(C4Group &hGroup, bool fSyncSave)
 
 bool C4Landscape::SaveInitial()
 {
-	// Create array
-	delete[] pInitial;
-	pInitial = new uint8_t[Width * Height];
+	// All tiles are unmodified: their initial pixels are still in the landscape
+	InitialTilesPitch = (Width + C4LS_DiffTileSize - 1) / C4LS_DiffTileSize;
+	InitialTiles.clear();
+	InitialTiles.resize(InitialTilesPitch * ((Height + C4LS_DiffTileSize - 1) / C4LS_DiffTileSize));
+	return true;
+}
 
-	// Save material data
-	for (int y = 0; y < Height; y++)
-		for (int x = 0; x < Width; x++)
-			pInitial[y * Width + x] = _GetPix(x, y);
+void C4Landscape::SaveInitialTiles(C4Rect Rect)
+{
+	if (InitialTiles.empty()) return;
+	Rect.Intersect(C4Rect(0, 0, Width, Height));
+	if (!Rect.Wdt || !Rect.Hgt) return;
+	for (int32_t iTileY = Rect.y / C4LS_DiffTileSize; iTileY <= (Rect.y + Rect.Hgt - 1) / C4LS_DiffTileSize; iTileY++)
+		for (int32_t iTileX = Rect.x / C4LS_DiffTileSize; iTileX <= (Rect.x + Rect.Wdt - 1) / C4LS_DiffTileSize; iTileX++)
+			SaveInitialTile(iTileX, iTileY);
+}
 
-	return true;
+void C4Landscape::SaveInitialTile(const int32_t iTileX, const int32_t iTileY)
+{
+	std::unique_ptr<uint8_t[]> &pTile = InitialTiles[iTileY * InitialTilesPitch + iTileX];
+	if (pTile) return;
+	// Tiles at the right and bottom border are cut off
+	const int32_t x = iTileX * C4LS_DiffTileSize, y = iTileY * C4LS_DiffTileSize;
+	const int32_t iWdt = std::min(C4LS_DiffTileSize, Width - x), iHgt = std::min(C4LS_DiffTileSize, Height - y);
+	pTile = std::make_unique<uint8_t[]>(iWdt * iHgt);
+	for (int32_t i = 0; i < iHgt; i++)
+		std::copy_n(Surface8->Bits + (y + i) * Surface8->Pitch + x, iWdt, pTile.get() + i * iWdt);
 }
 
 bool C4Landscape::Load(C4Group &hGroup, bool fLoadSky, bool fSavegame)
@@ -1629,11 +1712,24 @@ bool C4Landscape::ApplyDiff(C4Group &hGroup)
 	if (!(pDiff = GroupReadSurfaceOwnPal8(hGroup))) return false;
 	// convert all pixels: keep if same material; re-set if different material
 	uint8_t byPix;
-	for (int32_t y = 0; y < Height; ++y) for (int32_t x = 0; x < Width; ++x)
-		if (pDiff->GetPix(x, y) != 0xff)
-			if (Surface8->GetPix(x, y) != (byPix = pDiff->GetPix(x, y)))
-				// material has changed here: readjust with new texture
-				SetPix(x, y, byPix);
+	if (pDiff->Bits && pDiff->Wdt >= Width && pDiff->Hgt >= Height)
+	{
+		// compare row by row
+		for (int32_t y = 0; y < Height; ++y)
+		{
+			const uint8_t *const pDiffRow = pDiff->Bits + y * pDiff->Pitch, *const pRow = Surface8->Bits + y * Surface8->Pitch;
+			for (int32_t x = 0; x < Width; ++x)
+				if ((byPix = pDiffRow[x]) != 0xff && pRow[x] != byPix)
+					// material has changed here: readjust with new texture
+					SetPix(x, y, byPix);
+		}
+	}
+	else
+		for (int32_t y = 0; y < Height; ++y) for (int32_t x = 0; x < Width; ++x)
+			if (pDiff->GetPix(x, y) != 0xff)
+				if (Surface8->GetPix(x, y) != (byPix = pDiff->GetPix(x, y)))
+					// material has changed here: readjust with new texture
+					SetPix(x, y, byPix);
 	// done; clear diff
 	delete pDiff;
 	return true;
@@ -1659,6 +1755,8 @@ void C4Landscape::Default()
 	pMapCreator = nullptr;
 	Modulation = 0;
 	fMapChanged = false;
+	fChangeBackup = false;
+	InitialTilesPitch = 0;
 	ShadeMaterials = true;
 }
 
@@ -2184,13 +2282,16 @@ bool ConstructionCheck(C4ID id, int32_t iX, int32_t iY, C4Object *pByObj)
 void C4Landscape::ClearRect(int32_t iTx, int32_t iTy, int32_t iWdt, int32_t iHgt)
 {
 	C4Rect rt(iTx, iTy, iWdt, iHgt);
-	PrepareChange(rt, false);
+	// clear whole rows, like ClearPix would, and count the changes when finished
+	PrepareChange(rt);
+	const int32_t x1 = std::max<int32_t>(iTx, 0), x2 = std::min<int32_t>(iTx + iWdt, Width);
 	for (int32_t y = iTy; y < iTy + iHgt; y++)
 	{
-		for (int32_t x = iTx; x < iTx + iWdt; x++) ClearPix(x, y);
+		if (y >= 0 && y < Height && x1 < x2)
+			CSurface8::SelectRowByBit(Surface8->Bits + y * Surface8->Pitch + x1, x2 - x1, IFT, Mat2PixColDefault(MTunnel) + IFT, 0);
 		if (Rnd3()) Rnd3();
 	}
-	FinishChange(rt, false);
+	FinishChange(rt);
 }
 
 void C4Landscape::ClearRectDensity(int32_t iTx, int32_t iTy, int32_t iWdt, int32_t iHgt, int32_t iOfDensity)
@@ -2436,11 +2537,12 @@ bool C4Landscape::DrawChunks(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, i
 
 	int32_t iMaterial = Game.Material.Get(szMaterial); if (!MatValid(iMaterial)) return false;
 
-	C4Rect BoundingBox(tx - 5, ty - 5, wdt + 10, hgt + 10);
+	// the clipper includes its right and bottom edge, so the changed area is one pixel larger
+	C4Rect BoundingBox(tx - 5, ty - 5, wdt + 11, hgt + 11);
 	PrepareChange(BoundingBox);
 
 	// assign clipper
-	Surface8->Clip(BoundingBox.x, BoundingBox.y, BoundingBox.x + BoundingBox.Wdt, BoundingBox.y + BoundingBox.Hgt);
+	Surface8->Clip(tx - 5, ty - 5, tx + wdt + 5, ty + hgt + 5);
 	Application.DDraw->NoPrimaryClipper();
 
 	// draw all chunks
@@ -2491,10 +2593,13 @@ bool C4Landscape::DoRelights()
 {
 	if (!Relights[0].Wdt) return true;
 
-	if (!Surface32->Lock()) return false;
-	if (AnimationSurface)
+	if (!Renderer)
 	{
-		AnimationSurface->Lock();
+		if (!Surface32->Lock()) return false;
+		if (AnimationSurface)
+		{
+			AnimationSurface->Lock();
+		}
 	}
 
 	for (int32_t i = 0; i < C4LS_MaxRelights; i++)
@@ -2519,8 +2624,11 @@ bool C4Landscape::DoRelights()
 		C4SolidMask::CheckConsistency();
 	}
 
-	Surface32->Unlock();
-	if (AnimationSurface) AnimationSurface->Unlock();
+	if (!Renderer)
+	{
+		Surface32->Unlock();
+		if (AnimationSurface) AnimationSurface->Unlock();
+	}
 
 	return true;
 }
@@ -2530,10 +2638,109 @@ bool C4Landscape::Relight(C4Rect To)
 	// Enlarge to relight pixels surrounding a changed one
 	To.x -= C4LS_MaxLightDistX; To.y -= C4LS_MaxLightDistY;
 	To.Wdt += 2 * C4LS_MaxLightDistX; To.Hgt += 2 * C4LS_MaxLightDistY;
+	// the renderer lights the landscape itself; the solidmasks are removed here, so it never sees them
+	if (Renderer)
+	{
+		Renderer->Update(To.x, To.y, To.Wdt, To.Hgt);
+		return true;
+	}
 	// Apply lighting
 	return ApplyLighting(To);
 }
 
+bool C4Landscape::RelightAll()
+{
+	const C4Rect All{0, 0, Width, Height};
+	for (C4SolidMask *pSolid = C4SolidMask::Last; pSolid; pSolid = pSolid->Prev)
+	{
+		pSolid->RemoveTemporary(All);
+	}
+	const bool fSuccess{ApplyLighting(All)};
+	for (C4SolidMask *pSolid = C4SolidMask::First; pSolid; pSolid = pSolid->Next)
+	{
+		pSolid->PutTemporary(All);
+	}
+	return fSuccess;
+}
+
+void C4Landscape::GetPixRow(int32_t x, const int32_t y, int32_t wdt, uint8_t *pTarget)
+{
+	// left of the landscape
+	for (; wdt > 0 && x < 0; --wdt, ++x)
+		*pTarget++ = (y < LeftOpen ? 0 : MCVehic);
+	// inside, or above or below it
+	const int32_t iInside{std::clamp<int32_t>(Width - x, 0, wdt)};
+	if (y < 0)
+		std::fill_n(pTarget, iInside, TopOpen ? 0 : MCVehic);
+	else if (y >= Height)
+		std::fill_n(pTarget, iInside, BottomOpen ? 0 : MCVehic);
+	else if (iInside)
+		std::memcpy(pTarget, Surface8->Bits + y * Surface8->Pitch + x, iInside);
+	// right of it
+	std::fill_n(pTarget + iInside, wdt - iInside, y < RightOpen ? 0 : MCVehic);
+}
+
+void C4Landscape::InitRenderer()
+{
+	Renderer.reset();
+	if (!Config.Graphics.ShaderLandscape || !Application.DDraw) return;
+	Renderer = Application.DDraw->CreateLandscapeRenderer(Width, Height, [this](const int x, const int y, const int wdt, uint8_t *const pTarget) { GetPixRow(x, y, wdt, pTarget); });
+	if (Renderer && !UpdateRendererMaterials())
+	{
+		LogNTr(spdlog::level::warn, "Landscape materials cannot be drawn by shader, lighting the landscape as usual");
+		Renderer.reset();
+	}
+}
+
+bool C4Landscape::UpdateRendererMaterials()
+{
+	std::array<CStdLandscapeMaterial, 256> materials;
+	for (int32_t pix = 0; pix < 256; ++pix)
+	{
+		CStdLandscapeMaterial &material{materials[pix]};
+		// see GetClrByTex
+		material.dwClr = Surface8->pPal->GetClr(pix);
+		const C4TexMapEntry *pTex;
+		if (pix && (pTex = Game.TextureMap.GetEntry(PixCol2Tex(pix))))
+		{
+			material.pPattern = &pTex->getPattern();
+			if (pTex->GetMaterial())
+				material.pMatPattern = &pTex->GetMaterial()->MatPattern;
+		}
+		material.iPlacement = Pix2Place[pix];
+		material.fLiquid = DensityLiquid(Pix2Dens[pix]);
+	}
+	return Renderer->SetMaterials(materials, ShadeMaterials);
+}
+
+void C4Landscape::ClearRenderer()
+{
+	if (!Renderer) return;
+	Renderer.reset();
+	RelightAll();
+}
+
+bool C4Landscape::SaveRendererComparison(const char *const szShaderFilename, const char *const szClassicFilename)
+{
+	if (!Renderer) return false;
+	// the same frame, once drawn by the shader and once from the lit Surface32
+	if (!Game.GraphicsSystem.DoSaveScreenshot(true, szShaderFilename)) return false;
+	ClearRenderer();
+	const bool fSuccess{Game.GraphicsSystem.DoSaveScreenshot(true, szClassicFilename)};
+	// back to the shader; it must not see the solid masks
+	const C4Rect All{0, 0, Width, Height};
+	for (C4SolidMask *pSolid = C4SolidMask::Last; pSolid; pSolid = pSolid->Prev)
+	{
+		pSolid->RemoveTemporary(All);
+	}
+	InitRenderer();
+	for (C4SolidMask *pSolid = C4SolidMask::First; pSolid; pSolid = pSolid->Next)
+	{
+		pSolid->PutTemporary(All);
+	}
+	return fSuccess;
+}
+
 bool C4Landscape::ApplyLighting(C4Rect To)
 {
 	// clip to landscape size
@@ -2541,28 +2748,33 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 	// everything clipped?
 	if (To.Wdt <= 0 || To.Hgt <= 0) return true;
 
+	// keep the lit surface in RAM, so only pixels whose color actually changed are uploaded
+	Surface32->SetKeepInRAM(true);
 	if (!Surface32->LockForUpdate(To)) return false;
-	Surface32->ClearBoxDw(To.x, To.y, To.Wdt, To.Hgt);
-	// do lightning
-	for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
+	// density sums above and below the current row, per column
+	std::vector<int> AboveDensity(To.Wdt, 0), BelowDensity(To.Wdt, 0);
+	if (ShadeMaterials)
 	{
-		int AboveDensity = 0, BelowDensity = 0;
-		if (ShadeMaterials)
-		{
+		for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
 			for (int i = 1; i <= 8; ++i)
 			{
-				AboveDensity += GetPlacement(iX, To.y - i - 1);
-				BelowDensity += GetPlacement(iX, To.y + i - 1);
+				AboveDensity[iX - To.x] += GetPlacement(iX, To.y - i - 1);
+				BelowDensity[iX - To.x] += GetPlacement(iX, To.y + i - 1);
 			}
-		}
-
-		for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
+	}
+	// do lightning row by row
+	std::vector<uint32_t> Row(To.Wdt);
+	for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
+	{
+		for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
 		{
+			int &iAboveDensity = AboveDensity[iX - To.x], &iBelowDensity = BelowDensity[iX - To.x];
+			uint32_t &dwClr = Row[iX - To.x];
 			// do not move that code into the if (ShadeMaterials) block, as it needs to be run for sky pixels as well
-			AboveDensity -= GetPlacement(iX, iY - 9);
-			AboveDensity += GetPlacement(iX, iY - 1);
-			BelowDensity -= GetPlacement(iX, iY);
-			BelowDensity += GetPlacement(iX, iY + 8);
+			iAboveDensity -= GetPlacement(iX, iY - 9);
+			iAboveDensity += GetPlacement(iX, iY - 1);
+			iBelowDensity -= GetPlacement(iX, iY);
+			iBelowDensity += GetPlacement(iX, iY + 8);
 
 			// Normal color
 			uint32_t dwBackClr = GetClrByTex(iX, iY);
@@ -2571,38 +2783,45 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 			// Sky
 			if (!pix)
 			{
-				Surface32->SetPixDw(iX, iY, dwBackClr);
-				continue;
+				dwClr = dwBackClr;
 			}
-
-			if (ShadeMaterials)
+			else if (ShadeMaterials && !Pix2Place[pix])
 			{
-				// get density
-				int iOwnDens = Pix2Place[pix];
-				if (!iOwnDens) continue;
-				iOwnDens *= 2;
-				iOwnDens += GetPlacement(iX + 1, iY) + GetPlacement(iX - 1, iY);
-				iOwnDens /= 4;
-				// get density of surrounding materials
-				int iCompareDens = AboveDensity / 8;
-				if (iOwnDens > iCompareDens)
-				{
-					// apply light
-					LightenClrBy(dwBackClr, (std::min)(30, 2 * (iOwnDens - iCompareDens)));
-				}
-				else if (iOwnDens < iCompareDens && iOwnDens < 30)
-				{
-					DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iCompareDens - iOwnDens)));
-				}
-				iCompareDens = BelowDensity / 8;
-				if (iOwnDens > iCompareDens)
+				// cleared to transparent
+				dwClr = 0xff000000;
+			}
+			else
+			{
+				if (ShadeMaterials)
 				{
-					DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iOwnDens - iCompareDens)));
+					// get density
+					int iOwnDens = Pix2Place[pix];
+					iOwnDens *= 2;
+					iOwnDens += GetPlacement(iX + 1, iY) + GetPlacement(iX - 1, iY);
+					iOwnDens /= 4;
+					// get density of surrounding materials
+					int iCompareDens = iAboveDensity / 8;
+					if (iOwnDens > iCompareDens)
+					{
+						// apply light
+						LightenClrBy(dwBackClr, (std::min)(30, 2 * (iOwnDens - iCompareDens)));
+					}
+					else if (iOwnDens < iCompareDens && iOwnDens < 30)
+					{
+						DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iCompareDens - iOwnDens)));
+					}
+					iCompareDens = iBelowDensity / 8;
+					if (iOwnDens > iCompareDens)
+					{
+						DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iOwnDens - iCompareDens)));
+					}
 				}
+				dwClr = dwBackClr;
 			}
-
-			Surface32->SetPixDw(iX, iY, dwBackClr);
+			// if color is fully transparent, ensure it's black
+			if (dwClr >> 24 == 0xff) dwClr = 0xff000000;
 		}
+		Surface32->SetPixRowDw(To.x, iY, Row.data(), To.Wdt);
 	}
 	Surface32->Unlock();
 
@@ -2667,7 +2886,7 @@ bool C4Landscape::DrawMap(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, co
 	}
 	else
 	{
-		mapCreator.emplace(&FakeLS, &Game.TextureMap, &Game.Material, Game.Parameters.StartupPlayerCount);
+		mapCreator.emplace(&FakeLS, &Game.TextureMap, &Game.Material, Game.Parameters.StartupPlayerCount, &Game.Script);
 	}
 	// read file
 	mapCreator->ReadScript(szMapDef);
@@ -2827,6 +3046,8 @@ void C4Landscape::HandleTexMapUpdate()
 	UpdatePixMaps();
 	// Update landscape palette
 	Mat2Pal();
+	if (Renderer && !UpdateRendererMaterials())
+		ClearRenderer();
 }
 
 void C4Landscape::UpdatePixMaps()
@@ -2871,14 +3092,32 @@ void C4Landscape::PrepareChange(C4Rect BoundingBox, const bool updateMatCnt)
 	{
 		pSolid->RemoveTemporary(SolidMaskRect);
 	}
-	if (updateMatCnt) UpdateMatCnt(BoundingBox, false);
+	// the change draws to the surface directly
+	SaveInitialTiles(BoundingBox);
+	if (!updateMatCnt) return;
+	// keep the pixels to count only what has changed when finished
+	assert(!fChangeBackup);
+	BoundingBox.Intersect(C4Rect(0, 0, Width, Height));
+	ChangeBackupRect = BoundingBox;
+	ChangeBackup.resize(BoundingBox.Wdt * BoundingBox.Hgt);
+	for (int32_t y = 0; y < BoundingBox.Hgt; y++)
+		std::copy_n(Surface8->Bits + (BoundingBox.y + y) * Surface8->Pitch + BoundingBox.x, BoundingBox.Wdt, ChangeBackup.data() + y * BoundingBox.Wdt);
+	fChangeBackup = true;
 }
 
 void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt)
 {
 	// relight
 	Relight(BoundingBox);
-	if (updateMatAndPixCnt) UpdateMatCnt(BoundingBox, true);
+	// update counts from the changed pixels while solid masks are still removed; putting them back
+	// below goes through _SetPix, which keeps MatCount and PixCnt up to date for the mask pixels
+	if (updateMatAndPixCnt && fChangeBackup)
+	{
+		UpdateMatCntChanged();
+		fChangeBackup = false;
+	}
+	// drop cached paths
+	Game.PathFinder.InvalidateRect(BoundingBox.x, BoundingBox.y, BoundingBox.Wdt, BoundingBox.Hgt);
 	// Restore Solidmasks
 	C4Rect SolidMaskRect = BoundingBox;
 	SolidMaskRect.x -= 2 * C4LS_MaxLightDistX; SolidMaskRect.y -= 2 * C4LS_MaxLightDistY;
@@ -2887,7 +3126,7 @@ void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt
 	{
 		pSolid->Repair(SolidMaskRect);
 	}
-	if (updateMatAndPixCnt) UpdatePixCnt(BoundingBox);
+	if (updateMatAndPixCnt) CheckMatCount(); // removes the solid masks for the recount
 	C4SolidMask::CheckConsistency();
 }
 
@@ -2897,17 +3136,81 @@ void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 	for (int32_t y = std::max<int32_t>(0, Rect.y / 15); y < std::min<int32_t>(PixCntPitch, (Rect.y + Rect.Hgt + 14) / 15); y++)
 		for (int32_t x = std::max<int32_t>(0, Rect.x / 17); x < std::min<int32_t>(PixCntWidth, (Rect.x + Rect.Wdt + 16) / 17); x++)
 		{
-			int iCnt = 0;
-			for (int32_t x2 = x * 17; x2 < std::min<int32_t>(x * 17 + 17, Width); x2++)
-				for (int32_t y2 = y * 15; y2 < std::min<int32_t>(y * 15 + 15, Height); y2++)
-					if (_GetDensity(x2, y2))
-						iCnt++;
+			const int32_t x2 = x * 17, y2 = y * 15;
+			const int iCnt = CSurface8::CountRect(Surface8->Bits + y2 * Surface8->Pitch + x2, Surface8->Pitch,
+				std::min<int32_t>(x2 + 17, Width) - x2, std::min<int32_t>(y2 + 15, Height) - y2, [this](const uint8_t pix) { return Pix2Dens[pix] != 0; });
 			if (fCheck)
 				assert(iCnt == PixCnt[x * PixCntPitch + y]);
 			PixCnt[x * PixCntPitch + y] = iCnt;
 		}
 }
 
+template<typename GetMatFunc>
+void C4Landscape::UpdateMatCntColumn(const C4Rect &Rect, const int32_t iX, const int32_t iMul, GetMatFunc getMat)
+{
+	int iHgt = 0;
+	int32_t y;
+	for (y = 1; y < Rect.Hgt; y++)
+	{
+		int32_t iMat = getMat(Rect.y + y - 1);
+		// Same material? Count it.
+		if (iMat == getMat(Rect.y + y))
+			iHgt++;
+		else
+		{
+			if (iMat >= 0)
+			{
+				// Normal material counting
+				MatCount[iMat] += iMul * (iHgt + 1);
+				// Effective material counting enabled?
+				if (int32_t iMinHgt = Game.Material.Map[iMat].MinHeightCount)
+				{
+					// First chunk? Add any material above when checking chunk height
+					int iAddedHeight = 0;
+					if (Rect.y && iHgt + 1 == y)
+						iAddedHeight = GetMatHeight(iX, Rect.y - 1, -1, iMat, iMinHgt);
+					// Check the chunk height
+					if (iHgt + 1 + iAddedHeight >= iMinHgt)
+					{
+						EffectiveMatCount[iMat] += iMul * (iHgt + 1);
+						if (iAddedHeight < iMinHgt)
+							EffectiveMatCount[iMat] += iMul * iAddedHeight;
+					}
+				}
+			}
+			// Next chunk of material
+			iHgt = 0;
+		}
+	}
+	// Check last pixel
+	int32_t iMat = getMat(Rect.y + Rect.Hgt - 1);
+	if (iMat >= 0)
+	{
+		// Normal material counting
+		MatCount[iMat] += iMul * (iHgt + 1);
+		// Minimum height counting?
+		if (int32_t iMinHgt = Game.Material.Map[iMat].MinHeightCount)
+		{
+			int iAddedHeight1 = 0, iAddedHeight2 = 0;
+			// Add any material above for chunk size check
+			if (Rect.y && iHgt + 1 == Rect.Hgt)
+				iAddedHeight1 = GetMatHeight(iX, Rect.y - 1, -1, iMat, iMinHgt);
+			// Add any material below for chunk size check
+			if (Rect.y + y < Height)
+				iAddedHeight2 = GetMatHeight(iX, Rect.y + Rect.Hgt, 1, iMat, iMinHgt);
+			// Chunk tall enough?
+			if (iHgt + 1 + iAddedHeight1 + iAddedHeight2 >= Game.Material.Map[iMat].MinHeightCount)
+			{
+				EffectiveMatCount[iMat] += iMul * (iHgt + 1);
+				if (iAddedHeight1 < iMinHgt)
+					EffectiveMatCount[iMat] += iMul * iAddedHeight1;
+				if (iAddedHeight2 < iMinHgt)
+					EffectiveMatCount[iMat] += iMul * iAddedHeight2;
+			}
+		}
+	}
+}
+
 void C4Landscape::UpdateMatCnt(C4Rect Rect, bool fPlus)
 {
 	Rect.Intersect(C4Rect(0, 0, Width, Height));
@@ -2915,72 +3218,79 @@ void C4Landscape::UpdateMatCnt(C4Rect Rect, bool fPlus)
 	// Multiplicator for changes
 	const int32_t iMul = fPlus ? +1 : -1;
 	// Count pixels
-	for (int32_t x = 0; x < Rect.Wdt; x++)
+	for (int32_t x = Rect.x; x < Rect.x + Rect.Wdt; x++)
+		UpdateMatCntColumn(Rect, x, iMul, [this, x](const int32_t y) { return _GetMat(x, y); });
+}
+
+void C4Landscape::UpdateMatCntChanged()
+{
+	const C4Rect &Rect = ChangeBackupRect;
+	for (int32_t x = Rect.x; x < Rect.x + Rect.Wdt; x++)
 	{
-		int iHgt = 0;
-		int32_t y;
-		for (y = 1; y < Rect.Hgt; y++)
+		// count the changed pixels of this column
+		bool fChanged = false, fEffective = false;
+		for (int32_t y = Rect.y; y < Rect.y + Rect.Hgt; y++)
 		{
-			int32_t iMat = _GetMat(Rect.x + x, Rect.y + y - 1);
-			// Same material? Count it.
-			if (iMat == _GetMat(Rect.x + x, Rect.y + y))
-				iHgt++;
+			const uint8_t opix = ChangeBackup[(y - Rect.y) * Rect.Wdt + x - Rect.x], npix = _GetPix(x, y);
+			if (opix == npix) continue;
+			fChanged = true;
+			if (Pix2Dens[npix])
+			{
+				if (!Pix2Dens[opix]) PixCnt[(y / 15) + (x / 17) * PixCntPitch]++;
+			}
 			else
 			{
-				if (iMat >= 0)
-				{
-					// Normal material counting
-					MatCount[iMat] += iMul * (iHgt + 1);
-					// Effective material counting enabled?
-					if (int32_t iMinHgt = Game.Material.Map[iMat].MinHeightCount)
-					{
-						// First chunk? Add any material above when checking chunk height
-						int iAddedHeight = 0;
-						if (Rect.y && iHgt + 1 == y)
-							iAddedHeight = GetMatHeight(Rect.x + x, Rect.y - 1, -1, iMat, iMinHgt);
-						// Check the chunk height
-						if (iHgt + 1 + iAddedHeight >= iMinHgt)
-						{
-							EffectiveMatCount[iMat] += iMul * (iHgt + 1);
-							if (iAddedHeight < iMinHgt)
-								EffectiveMatCount[iMat] += iMul * iAddedHeight;
-						}
-					}
-				}
-				// Next chunk of material
-				iHgt = 0;
+				if (Pix2Dens[opix]) PixCnt[(y / 15) + (x / 17) * PixCntPitch]--;
 			}
+			const int32_t omat = Pix2Mat[opix], nmat = Pix2Mat[npix];
+			if (omat >= 0 && Game.Material.Map[omat].MinHeightCount) fEffective = true;
+			if (nmat >= 0 && Game.Material.Map[nmat].MinHeightCount) fEffective = true;
 		}
-		// Check last pixel
-		int32_t iMat = _GetMat(Rect.x + x, Rect.y + Rect.Hgt - 1);
-		if (iMat >= 0)
+		if (!fChanged) continue;
+		// chunk heights of effective materials changed: recount the column before and after
+		if (fEffective)
 		{
-			// Normal material counting
-			MatCount[iMat] += iMul * (iHgt + 1);
-			// Minimum height counting?
-			if (int32_t iMinHgt = Game.Material.Map[iMat].MinHeightCount)
-			{
-				int iAddedHeight1 = 0, iAddedHeight2 = 0;
-				// Add any material above for chunk size check
-				if (Rect.y && iHgt + 1 == Rect.Hgt)
-					iAddedHeight1 = GetMatHeight(Rect.x + x, Rect.y - 1, -1, iMat, iMinHgt);
-				// Add any material below for chunk size check
-				if (Rect.y + y < Height)
-					iAddedHeight2 = GetMatHeight(Rect.x + x, Rect.y + Rect.Hgt, 1, iMat, iMinHgt);
-				// Chunk tall enough?
-				if (iHgt + 1 + iAddedHeight1 + iAddedHeight2 >= Game.Material.Map[iMat].MinHeightCount)
-				{
-					EffectiveMatCount[iMat] += iMul * (iHgt + 1);
-					if (iAddedHeight1 < iMinHgt)
-						EffectiveMatCount[iMat] += iMul * iAddedHeight1;
-					if (iAddedHeight2 < iMinHgt)
-						EffectiveMatCount[iMat] += iMul * iAddedHeight2;
-				}
-			}
+			UpdateMatCntColumn(Rect, x, -1, [this, &Rect, x](const int32_t y) { return Pix2Mat[ChangeBackup[(y - Rect.y) * Rect.Wdt + x - Rect.x]]; });
+			UpdateMatCntColumn(Rect, x, +1, [this, x](const int32_t y) { return _GetMat(x, y); });
+			continue;
+		}
+		for (int32_t y = Rect.y; y < Rect.y + Rect.Hgt; y++)
+		{
+			const uint8_t opix = ChangeBackup[(y - Rect.y) * Rect.Wdt + x - Rect.x], npix = _GetPix(x, y);
+			if (opix == npix) continue;
+			if (const int32_t omat = Pix2Mat[opix]; omat >= 0) MatCount[omat]--;
+			if (const int32_t nmat = Pix2Mat[npix]; nmat >= 0) MatCount[nmat]++;
 		}
 	}
 }
 
+#ifdef MATCOUNT_DEBUG
+
+void C4Landscape::CheckMatCount()
+{
+	// take out all solid masks: the full recount would include their vehicle pixels
+	const C4Rect LandscapeRect(0, 0, Width, Height);
+	for (C4SolidMask *pSolid = C4SolidMask::Last; pSolid; pSolid = pSolid->Prev)
+		pSolid->RemoveTemporary(LandscapeRect);
+	// compare with a full recount
+	uint32_t OldMatCount[C4MaxMaterial], OldEffectiveMatCount[C4MaxMaterial];
+	std::copy_n(MatCount, C4MaxMaterial, OldMatCount);
+	std::copy_n(EffectiveMatCount, C4MaxMaterial, OldEffectiveMatCount);
+	ClearMatCount();
+	UpdateMatCnt(LandscapeRect, true);
+	for (int32_t iMat = 0; iMat < C4MaxMaterial; iMat++)
+	{
+		assert(MatCount[iMat] == OldMatCount[iMat]);
+		assert(EffectiveMatCount[iMat] == OldEffectiveMatCount[iMat]);
+	}
+	UpdatePixCnt(LandscapeRect, true);
+	// restore solid masks
+	for (C4SolidMask *pSolid = C4SolidMask::First; pSolid; pSolid = pSolid->Next)
+		pSolid->PutTemporary(LandscapeRect);
+}
+
+#endif
+
 void C4Landscape::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(MapSeed,                 "MapSeed",       0));
@@ -25,6 +25,8 @@
 #include <StdSurface8.h>
 
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 const uint8_t GBM        = 128,
               GBM_ColNum = 64,
@@ -41,9 +43,11 @@ const int32_t C4LSC_Undefined = 0,
               C4LSC_Exact = 3;
 
 const int32_t C4LS_MaxRelights = 50;
+const int32_t C4LS_DiffTileSize = 64;
 
 class C4MapCreatorS2;
 class C4Object;
+class CStdLandscapeRenderer;
 
 class C4Landscape
 {
@@ -70,7 +74,6 @@ public:
 	C4Sky Sky;
 	C4MapCreatorS2 *pMapCreator; // map creator for script-generated maps
 	bool fMapChanged;
-	uint8_t *pInitial; // Initial landscape after creation - used for diff
 
 protected:
 	C4Surface *Surface32;
@@ -80,6 +83,12 @@ protected:
 	int32_t PixCntPitch;
 	uint8_t *PixCnt;
 	C4Rect Relights[C4LS_MaxRelights];
+	std::unique_ptr<CStdLandscapeRenderer> Renderer; // draws the landscape from Surface8; Surface32 is only lit when needed then
+	std::vector<std::unique_ptr<uint8_t[]>> InitialTiles; // initial landscape after creation, used for the diff; only kept for tiles modified since
+	int32_t InitialTilesPitch;
+	std::vector<uint8_t> ChangeBackup; // pixels of ChangeBackupRect from PrepareChange, so FinishChange only counts the changed ones
+	C4Rect ChangeBackupRect;
+	bool fChangeBackup;
 
 public:
 	void Default();
@@ -106,8 +115,11 @@ public:
 	bool Load(C4Group &hGroup, bool fLoadSky, bool fSavegame);
 	bool Save(C4Group &hGroup);
 	bool SaveDiff(C4Group &hGroup, bool fSyncSave);
+	bool SaveRendererComparison(const char *szShaderFilename, const char *szClassicFilename); // full screenshots drawn with and without Renderer, see tools/compare_landscape_screenshots.py
 	bool SaveMap(C4Group &hGroup);
 	bool SaveInitial();
+	void SaveInitialTiles(C4Rect Rect); // keep the initial pixels of all tiles overlapping Rect before they are modified
+	void SaveInitialTile(int32_t iTileX, int32_t iTileY);
 	bool SaveTextures(C4Group &hGroup);
 	bool Init(C4Group &hGroup, bool fOverloadCurrent, bool fLoadSky, bool &rfLoaded, bool fSavegame);
 	bool MapToLandscape();
@@ -160,6 +172,8 @@ public:
 						return Surface8->_GetPix(x, y);
 	}
 
+	void GetPixRow(int32_t x, int32_t y, int32_t wdt, uint8_t *pTarget); // copy landscape pixels of one row, bounds checked like GetPix
+
 	inline int32_t _GetMat(int32_t x, int32_t y) // get landscape material (bounds not checked)
 	{
 		return Pix2Mat[_GetPix(x, y)];
@@ -230,6 +244,10 @@ protected:
 	bool Relight(C4Rect To);
 	bool ApplyLighting(C4Rect To);
 	bool UpdateAnimationSurface(C4Rect To);
+	bool RelightAll(); // light all of Surface32, e.g. after Renderer has been drawing the landscape
+	void InitRenderer(); // draw the landscape by Renderer if configured and possible
+	bool UpdateRendererMaterials();
+	void ClearRenderer(); // go back to drawing the lit Surface32
 	uint32_t GetClrByTex(int32_t iX, int32_t iY);
 	bool Mat2Pal(); // assign material colors to landscape palette
 
@@ -241,6 +259,13 @@ protected:
 
 	void UpdatePixCnt(const class C4Rect &Rect, bool fCheck = false);
 	void UpdateMatCnt(C4Rect Rect, bool fPlus);
+	template<typename GetMatFunc> void UpdateMatCntColumn(const C4Rect &Rect, int32_t iX, int32_t iMul, GetMatFunc getMat);
+	void UpdateMatCntChanged(); // count the pixels changed since PrepareChange
+#ifdef MATCOUNT_DEBUG
+	void CheckMatCount(); // assert that the counts match a full recount
+#else
+	void CheckMatCount() {}
+#endif
 	void PrepareChange(C4Rect BoundingBox, bool updateMatCnt = true);
 	void FinishChange(C4Rect BoundingBox, bool updateMatAndPixCnt = true);
 	static bool DrawLineLandscape(int32_t iX, int32_t iY, int32_t iGrade);
@@ -0,0 +1,89 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// layouts of the least recently used texts, as kept by CStdFont
+
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+// The key is the text prefixed with the raw bytes of the other parameters. It is built in a buffer
+// that is kept, and looked up by hash, so finding a layout allocates nothing and compares the text only once.
+template<typename Value, typename... Params>
+class C4LayoutCache
+{
+public:
+	static constexpr std::size_t Capacity{256};
+
+private:
+	using Entry = std::pair<std::string, Value>;
+	std::list<Entry> Entries; // most recently used first
+	std::unordered_map<std::string_view, typename std::list<Entry>::iterator> Index; // views of the keys in Entries
+	std::string KeyBuffer;
+
+public:
+	C4LayoutCache() = default;
+	// copies start empty, as the index refers to the keys of the original
+	C4LayoutCache(const C4LayoutCache &) {}
+	C4LayoutCache &operator=(const C4LayoutCache &) { Clear(); return *this; }
+
+	// the key stays valid until the next call
+	std::string_view MakeKey(const char *szText, const Params &...params)
+	{
+		KeyBuffer.clear();
+		(KeyBuffer.append(reinterpret_cast<const char *>(&params), sizeof(params)), ...);
+		KeyBuffer.append(szText);
+		return KeyBuffer;
+	}
+
+	const Value *Find(const std::string_view key)
+	{
+		const auto it = Index.find(key);
+		if (it == Index.end()) return nullptr;
+		Entries.splice(Entries.begin(), Entries, it->second);
+		return &it->second->second;
+	}
+
+	const Value &Insert(const std::string_view key, Value value)
+	{
+		if (const auto it = Index.find(key); it != Index.end())
+		{
+			Entries.erase(it->second);
+			Index.erase(it);
+		}
+		else if (Entries.size() >= Capacity)
+		{
+			Index.erase(Entries.back().first);
+			Entries.pop_back();
+		}
+		// list nodes don't move, so views of their keys stay valid
+		Entries.emplace_front(std::string{key}, std::move(value));
+		Index.emplace(Entries.front().first, Entries.begin());
+		return Entries.front().second;
+	}
+
+	void Clear()
+	{
+		Index.clear();
+		Entries.clear();
+	}
+
+	std::size_t GetSize() const { return Entries.size(); }
+};
@@ -21,10 +21,35 @@
 #include <C4MapCreatorS2.h>
 #include <C4Random.h>
 
-#include <C4Game.h>
+#include <C4Stat.h>
+#include <C4ThreadPool.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+bool AlgoSolid(C4MCOverlay *pOvrl, int32_t iX, int32_t iY);
+bool AlgoScript(C4MCOverlay *pOvrl, int32_t iX, int32_t iY);
+bool AlgoRndAll(C4MCOverlay *pOvrl, int32_t iX, int32_t iY);
+
+// per-thread buffers for row rendering: active/last set/do set flags for each tree depth
+class C4MCRowScratch
+{
+	std::vector<std::vector<uint8_t>> Buffers;
+
+public:
+	uint8_t *Get(size_t iIndex, int32_t iWdt)
+	{
+		if (Buffers.size() <= iIndex) Buffers.resize(iIndex + 1);
+		if (Buffers[iIndex].size() < static_cast<size_t>(iWdt)) Buffers[iIndex].resize(iWdt);
+		return Buffers[iIndex].data();
+	}
+};
 
 // C4MCCallbackArray
 
@@ -82,8 +107,8 @@ void C4MCCallbackArray::Execute(int32_t iMapZoom)
 		if (pMap[iIndex / 8] & (1 << (iIndex % 8)))
 		{
 			// set pars
-			Pars[0] = C4VInt((iIndex % iWdt) * iMapZoom - (iMapZoom / 2));
-			Pars[1] = C4VInt((iIndex / iWdt) * iMapZoom - (iMapZoom / 2));
+			Pars.Set(0, C4VInt((iIndex % iWdt) * iMapZoom - (iMapZoom / 2)));
+			Pars.Set(1, C4VInt((iIndex / iWdt) * iMapZoom - (iMapZoom / 2)));
 			// call
 			pSF->Exec(nullptr, Pars);
 		}
@@ -370,7 +395,7 @@ bool C4MCOverlay::SetField(C4MCParser *pParser, const char *szField, const char
 			case C4MCV_ScriptFunc:
 			{
 				// get script func of main script
-				C4AulFunc *pSFunc = Game.Script.GetSFunc(StrPar, AA_PROTECTED);
+				C4AulFunc *pSFunc = MapCreator->GetScript() ? MapCreator->GetScript()->GetSFunc(StrPar, AA_PROTECTED) : nullptr;
 				if (!pSFunc) throw C4MCParserErr(pParser, C4MCErr_SFuncNotFound, StrPar);
 				// add to main
 				this->*(pAttr->scriptFunc) = new C4MCCallbackArray(pSFunc, MapCreator);
@@ -445,6 +470,45 @@ C4MCOverlay *C4MCOverlay::FirstOfChain()
 	return pOvrl;
 }
 
+namespace
+{
+	// one turbulence level of CheckMask for iCount independent positions
+	// the steps of different positions are interleaved, so they do not wait for each other
+	template<typename Divisor> void ApplyTurbulenceLevel(C4Fixed *pX, C4Fixed *pY, const int32_t iCount, const C4Fixed SeedX, const C4Fixed SeedY, const Divisor j)
+	{
+		const C4Fixed Rad2Grad = itofix(3754936, 65536);
+		for (C4Fixed d = itofix(2); d < 6; d += FIXED10(15))
+			for (int32_t k = 0; k < iCount; ++k)
+			{
+				pX[k] += Sin(((pX[k] / 7 + SeedX + pY[k]) / j + d) * Rad2Grad) * j / 2;
+				pY[k] += Cos(((pY[k] / 7 + SeedY + pX[k]) / j - d) * Rad2Grad) * j / 2;
+			}
+	}
+}
+
+void C4MCOverlay::ApplyTurbulence(C4Fixed *pX, C4Fixed *pY, int32_t iCount)
+{
+	int32_t j = 3;
+	for (int32_t i = 10; i <= Turbulence; i *= 10)
+	{
+		int32_t Seed2; Seed2 = Seed;
+		for (int32_t l = 0; l <= Lambda; ++l)
+		{
+			// the seed offsets are the same for all steps; the usual levels get a constant divisor
+			const C4Fixed SeedX = itofix(Seed2) / ZoomX, SeedY = itofix(Seed2) / ZoomY;
+			switch (j)
+			{
+			case 3: ApplyTurbulenceLevel(pX, pY, iCount, SeedX, SeedY, std::integral_constant<int32_t, 3>{}); break;
+			case 6: ApplyTurbulenceLevel(pX, pY, iCount, SeedX, SeedY, std::integral_constant<int32_t, 6>{}); break;
+			case 9: ApplyTurbulenceLevel(pX, pY, iCount, SeedX, SeedY, std::integral_constant<int32_t, 9>{}); break;
+			default: ApplyTurbulenceLevel(pX, pY, iCount, SeedX, SeedY, j); break;
+			}
+			Seed2 = (Seed * (Seed2 << 3) + 0x4465) & 0xffff;
+		}
+		j += 3;
+	}
+}
+
 bool C4MCOverlay::CheckMask(int32_t iX, int32_t iY)
 {
 	// bounds match?
@@ -456,25 +520,12 @@ bool C4MCOverlay::CheckMask(int32_t iX, int32_t iY)
 #endif
 	C4Fixed dX = itofix(iX); C4Fixed dY = itofix(iY);
 	// apply turbulence
-	if (Turbulence)
-	{
-		const C4Fixed Rad2Grad = itofix(3754936, 65536);
-		int32_t j = 3;
-		for (int32_t i = 10; i <= Turbulence; i *= 10)
-		{
-			int32_t Seed2; Seed2 = Seed;
-			for (int32_t l = 0; l <= Lambda; ++l)
-			{
-				for (C4Fixed d = itofix(2); d < 6; d += FIXED10(15))
-				{
-					dX += Sin(((dX / 7 + itofix(Seed2) / ZoomX + dY) / j + d) * Rad2Grad) * j / 2;
-					dY += Cos(((dY / 7 + itofix(Seed2) / ZoomY + dX) / j - d) * Rad2Grad) * j / 2;
-				}
-				Seed2 = (Seed * (Seed2 << 3) + 0x4465) & 0xffff;
-			}
-			j += 3;
-		}
-	}
+	if (Turbulence) ApplyTurbulence(&dX, &dY, 1);
+	return CheckMaskAt(iX, iY, dX, dY);
+}
+
+bool C4MCOverlay::CheckMaskAt(int32_t iX, int32_t iY, C4Fixed dX, C4Fixed dY)
+{
 	// apply rotation
 	if (Rotate)
 	{
@@ -503,6 +554,52 @@ bool C4MCOverlay::CheckMask(int32_t iX, int32_t iY)
 	return (Algorithm->Function)(this, iX, iY) ^ Invert;
 }
 
+void C4MCOverlay::CheckMaskRow(int32_t iY, int32_t iX0, int32_t iX1, uint8_t *pResult)
+{
+	// clip span to bounds
+	if (!LooseBounds)
+	{
+		if (iY < Y || iY >= Y + Hgt)
+		{
+			std::fill(pResult + iX0, pResult + iX1, false);
+			return;
+		}
+		const int32_t iIn0{std::clamp(X, iX0, iX1)};
+		const int32_t iIn1{std::max(std::clamp(X + Wdt, iX0, iX1), iIn0)};
+		std::fill(pResult + iX0, pResult + iIn0, false);
+		std::fill(pResult + iIn1, pResult + iX1, false);
+		iX0 = iIn0; iX1 = iIn1;
+	}
+	if (iX0 >= iX1) return;
+	// algorithms that do not depend on the position give the same result for the whole span
+	// (turbulence and rotation only move the position, and loose bounds are checked at the moved position)
+	if (!LooseBounds && (Algorithm->Function == &AlgoSolid || Algorithm->Function == &AlgoRndAll))
+	{
+		std::fill(pResult + iX0, pResult + iX1, CheckMask(iX0, iY));
+		return;
+	}
+	if (!Turbulence)
+	{
+		for (int32_t iX = iX0; iX < iX1; ++iX)
+			pResult[iX] = CheckMask(iX, iY);
+		return;
+	}
+	// turbulence takes most of the time, so displace a batch of positions at once
+	// (strict bounds have been checked for the whole span above)
+	for (int32_t iBatchX = iX0; iBatchX < iX1; iBatchX += C4MC_TurbulenceBatch)
+	{
+		const int32_t iCount{std::min<int32_t>(iX1 - iBatchX, C4MC_TurbulenceBatch)};
+		C4Fixed dX[C4MC_TurbulenceBatch], dY[C4MC_TurbulenceBatch];
+		for (int32_t k = 0; k < iCount; ++k)
+		{
+			dX[k] = itofix(iBatchX + k); dY[k] = itofix(iY);
+		}
+		ApplyTurbulence(dX, dY, iCount);
+		for (int32_t k = 0; k < iCount; ++k)
+			pResult[iBatchX + k] = CheckMaskAt(iBatchX + k, iY, dX[k], dY[k]);
+	}
+}
+
 bool C4MCOverlay::RenderPix(int32_t iX, int32_t iY, uint8_t &rPix, C4MCTokenType eLastOp, bool fLastSet, bool fDraw, C4MCOverlay **ppPixelSetOverlay)
 {
 	// algo match?
@@ -552,6 +649,72 @@ bool C4MCOverlay::RenderPix(int32_t iX, int32_t iY, uint8_t &rPix, C4MCTokenType
 	return DoSet;
 }
 
+void C4MCOverlay::RenderRow(C4MCRowScratch &rScratch, size_t iDepth, int32_t iY, int32_t iWdt, const uint8_t *pActive, const uint8_t *pLastSet, C4MCTokenType eLastOp, bool fDraw, uint8_t *pDoSet, uint8_t *pPix, C4MCOverlay **ppPixelSetOverlay)
+{
+	// algo match, span by span
+	for (int32_t iX0 = 0; iX0 < iWdt; )
+	{
+		if (!pActive[iX0]) { ++iX0; continue; }
+		int32_t iX1 = iX0 + 1;
+		while (iX1 < iWdt && pActive[iX1]) ++iX1;
+		CheckMaskRow(iY, iX0, iX1, pDoSet);
+		iX0 = iX1;
+	}
+	// exec last op
+	switch (eLastOp)
+	{
+	case MCT_AND: // and
+		for (int32_t iX = 0; iX < iWdt; ++iX) if (pActive[iX]) pDoSet[iX] = pDoSet[iX] && pLastSet[iX];
+		break;
+	case MCT_OR: // or
+		for (int32_t iX = 0; iX < iWdt; ++iX) if (pActive[iX]) pDoSet[iX] = pDoSet[iX] || pLastSet[iX];
+		break;
+	case MCT_XOR: // xor
+		for (int32_t iX = 0; iX < iWdt; ++iX) if (pActive[iX]) pDoSet[iX] = pDoSet[iX] != pLastSet[iX];
+		break;
+	default: // no op
+		break;
+	}
+
+	// set pix to local value and exec children, if no operator is following
+	if (!Group && !(fDraw && Op == MCT_NONE)) return;
+	// groups don't set a pixel value, if they're associated with an operator
+	fDraw &= !Group || (Op == MCT_NONE);
+	uint8_t *pChildActive = rScratch.Get(iDepth * 3, iWdt);
+	uint8_t *pChildLastSet = rScratch.Get(iDepth * 3 + 1, iWdt);
+	uint8_t *pChildDoSet = rScratch.Get(iDepth * 3 + 2, iWdt);
+	bool fAnyActive = false;
+	for (int32_t iX = 0; iX < iWdt; ++iX)
+	{
+		pChildActive[iX] = pActive[iX] && (Group || pDoSet[iX]);
+		pChildLastSet[iX] = false;
+		fAnyActive |= !!pChildActive[iX];
+	}
+	if (!fAnyActive) return;
+	if (fDraw && !Mask)
+		for (int32_t iX = 0; iX < iWdt; ++iX)
+			if (pChildActive[iX] && pDoSet[iX])
+			{
+				pPix[iX] = MatClr;
+				ppPixelSetOverlay[iX] = this;
+			}
+	// evaluate children overlays, if this was painted, too
+	eLastOp = MCT_NONE;
+	for (C4MCNode *pChild = Child0; pChild; pChild = pChild->Next)
+		if (C4MCOverlay *pOvrl = pChild->Overlay())
+		{
+			pOvrl->RenderRow(rScratch, iDepth + 1, iY, iWdt, pChildActive, pChildLastSet, eLastOp, fDraw, pChildDoSet, pPix, ppPixelSetOverlay);
+			if (Group && (pOvrl->Op == MCT_NONE))
+				for (int32_t iX = 0; iX < iWdt; ++iX) if (pChildActive[iX]) pDoSet[iX] |= pChildDoSet[iX];
+			std::swap(pChildLastSet, pChildDoSet);
+			eLastOp = pOvrl->Op;
+		}
+	// add evaluation-callback
+	if (pEvaluateFunc && fDraw)
+		for (int32_t iX = 0; iX < iWdt; ++iX)
+			if (pChildActive[iX] && pDoSet[iX]) pEvaluateFunc->EnablePixel(iX, iY);
+}
+
 bool C4MCOverlay::PeekPix(int32_t iX, int32_t iY)
 {
 	// start with this one
@@ -643,10 +806,32 @@ void C4MCMap::Default()
 		Wdt = (std::min)(Wdt * (std::min)(MapCreator->PlayerCount, C4S_MaxMapPlayerExtend), MapCreator->Landscape->MapWdt.Max);
 }
 
+namespace
+{
+	// check whether any overlay in the tree matches
+	template<typename Func> bool AnyOverlay(C4MCNode *pNode, Func f)
+	{
+		if (C4MCOverlay *pOvrl = pNode->Overlay()) if (f(pOvrl)) return true;
+		for (C4MCNode *pChild = pNode->Child0; pChild; pChild = pChild->Next)
+			if (AnyOverlay(pChild, f)) return true;
+		return false;
+	}
+}
+
 bool C4MCMap::RenderTo(uint8_t *pToBuf, int32_t iPitch)
 {
 	// set current render target
 	if (MapCreator) MapCreator->pCurrentMap = this;
+#ifndef DEBUGREC
+	// script algorithms have to be called in pixel order; everything else only depends on the position,
+	// so the map can be evaluated row by row, and rows can be rendered in parallel unless callback arrays are filled
+	if (!AnyOverlay(this, [](C4MCOverlay *pOvrl) { return pOvrl->Algorithm && pOvrl->Algorithm->Function == &AlgoScript; }))
+	{
+		RenderRows(pToBuf, iPitch, !AnyOverlay(this, [](C4MCOverlay *pOvrl) { return pOvrl->pEvaluateFunc || pOvrl->pDrawFunc; }));
+		if (MapCreator) MapCreator->pCurrentMap = nullptr;
+		return true;
+	}
+#endif
 	// draw pixel by pixel
 	for (int32_t iY = 0; iY < Hgt; iY++)
 	{
@@ -673,6 +858,63 @@ bool C4MCMap::RenderTo(uint8_t *pToBuf, int32_t iPitch)
 	return true;
 }
 
+void C4MCMap::RenderRowTo(C4MCRowScratch &rScratch, int32_t iY, uint8_t *pRow, C4MCOverlay **ppPixelSetOverlays)
+{
+	// default to sky
+	std::fill(pRow, pRow + Wdt, 0);
+	std::fill(ppPixelSetOverlays, ppPixelSetOverlays + Wdt, nullptr);
+	// render row, starting with all pixels active
+	uint8_t *pActive = rScratch.Get(0, Wdt);
+	uint8_t *pLastSet = rScratch.Get(1, Wdt);
+	uint8_t *pDoSet = rScratch.Get(2, Wdt);
+	std::fill(pActive, pActive + Wdt, true);
+	std::fill(pLastSet, pLastSet + Wdt, false);
+	RenderRow(rScratch, 1, iY, Wdt, pActive, pLastSet, MCT_NONE, true, pDoSet, pRow, ppPixelSetOverlays);
+	// add draw-callback for rendered overlay
+	for (int32_t iX = 0; iX < Wdt; ++iX)
+		if (ppPixelSetOverlays[iX] && ppPixelSetOverlays[iX]->pDrawFunc)
+			ppPixelSetOverlays[iX]->pDrawFunc->EnablePixel(iX, iY);
+}
+
+void C4MCMap::RenderRows(uint8_t *pToBuf, int32_t iPitch, bool fParallel)
+{
+	C4ST_STARTNEW(MapRenderStat, "C4MCMap::RenderRows")
+	// rows are handed out one by one to all participating threads
+	struct Job
+	{
+		std::atomic<int32_t> NextRow{0};
+		std::atomic<int32_t> RowsDone{0};
+	};
+	const auto job = std::make_shared<Job>();
+	// late helpers may find the map already finished (and gone), so nothing but the job is touched before a row is taken
+	const auto work = [this, pToBuf, iPitch, iWdt{Wdt}, iHgt{Hgt}](Job &job)
+	{
+		int32_t iY{job.NextRow.fetch_add(1, std::memory_order_relaxed)};
+		if (iY >= iHgt) return;
+		C4MCRowScratch scratch;
+		std::vector<C4MCOverlay *> pixelSetOverlays(iWdt);
+		do
+		{
+			RenderRowTo(scratch, iY, pToBuf + iY * iPitch, pixelSetOverlays.data());
+			if (job.RowsDone.fetch_add(1, std::memory_order_release) + 1 == iHgt)
+				job.RowsDone.notify_all();
+		}
+		while ((iY = job.NextRow.fetch_add(1, std::memory_order_relaxed)) < iHgt);
+	};
+	// helpers from the global thread pool; this thread works, too, so it does not matter when they start
+	if (fParallel && C4ThreadPool::Global)
+	{
+		const int32_t iHelpers{std::min<int32_t>(static_cast<int32_t>(std::thread::hardware_concurrency()), Hgt / 16) - 1};
+		for (int32_t i = 0; i < iHelpers; ++i)
+			C4ThreadPool::Global->SubmitCallback([job, work] { work(*job); });
+	}
+	work(*job);
+	// wait for rows still rendered by helpers
+	for (int32_t iDone; (iDone = job->RowsDone.load(std::memory_order_acquire)) < Hgt; )
+		job->RowsDone.wait(iDone, std::memory_order_acquire);
+	C4ST_STOP(MapRenderStat)
+}
+
 void C4MCMap::SetSize(int32_t iWdt, int32_t iHgt)
 {
 	// store new size
@@ -683,12 +925,12 @@ void C4MCMap::SetSize(int32_t iWdt, int32_t iHgt)
 
 // map creator
 
-C4MapCreatorS2::C4MapCreatorS2(C4SLandscape *pLandscape, C4TextureMap *pTexMap, C4MaterialMap *pMatMap, int iPlayerCount) : C4MCNode(nullptr)
+C4MapCreatorS2::C4MapCreatorS2(C4SLandscape *pLandscape, C4TextureMap *pTexMap, C4MaterialMap *pMatMap, int iPlayerCount, C4AulScript *pScript) : C4MCNode(nullptr)
 {
 	// me r b creator
 	MapCreator = this;
 	// store members
-	Landscape = pLandscape; TexMap = pTexMap; MatMap = pMatMap;
+	Landscape = pLandscape; TexMap = pTexMap; MatMap = pMatMap; Script = pScript;
 	PlayerCount = iPlayerCount;
 	// set engine field for default stuff
 	DefaultMap.MapCreator = this;
@@ -703,7 +945,7 @@ C4MapCreatorS2::C4MapCreatorS2(C4MapCreatorS2 &rTemplate, C4SLandscape *pLandsca
 	// me r b creator
 	MapCreator = this;
 	// store members
-	Landscape = pLandscape; TexMap = rTemplate.TexMap; MatMap = rTemplate.MatMap;
+	Landscape = pLandscape; TexMap = rTemplate.TexMap; MatMap = rTemplate.MatMap; Script = rTemplate.Script;
 	PlayerCount = rTemplate.PlayerCount;
 	// set engine field for default stuff
 	DefaultMap.MapCreator = this;
@@ -1449,7 +1691,8 @@ bool AlgoGradient(C4MCOverlay *pOvrl, int32_t iX, int32_t iY)
 bool AlgoScript(C4MCOverlay *pOvrl, int32_t iX, int32_t iY)
 {
 	// get script function
-	C4AulFunc *pFunc = Game.Script.GetSFunc((std::string{"ScriptAlgo"} + pOvrl->Name).c_str());
+	C4AulScript *const pScript{pOvrl->MapCreator->GetScript()};
+	C4AulFunc *pFunc = pScript ? pScript->GetSFunc((std::string{"ScriptAlgo"} + pOvrl->Name).c_str()) : nullptr;
 	// failsafe
 	if (!pFunc) return false;
 	// ok, call func
@@ -28,6 +28,7 @@
 
 #define C4MC_SizeRes 100 // positions in percent
 #define C4MC_ZoomRes 100 // zoom resolution (-100 to +99)
+#define C4MC_TurbulenceBatch 8 // positions displaced at once by CheckMaskRow
 
 // string consts
 #define C4MC_Overlay "overlay" // overlay node
@@ -75,6 +76,7 @@ class C4MCMap;
 class C4MapCreatorS2;
 class C4MCParserErr;
 class C4MCParser;
+class C4MCRowScratch;
 
 struct C4MCAlgorithm
 {
@@ -286,10 +288,17 @@ public:
 	C4MCOverlay *FirstOfChain(); // go backwards in op chain until first overlay of chain
 
 	bool CheckMask(int32_t iX, int32_t iY); // check whether algorithms succeeds at iX/iY
+	void CheckMaskRow(int32_t iY, int32_t iX0, int32_t iX1, uint8_t *pResult); // CheckMask for a span of a row; clipped spans and constant algorithms are filled at once
 	bool RenderPix(int32_t iX, int32_t iY, uint8_t &rPix, C4MCTokenType eLastOp = MCT_NONE, bool fLastSet = false, bool fDraw = true, C4MCOverlay **ppPixelSetOverlay = nullptr); // render this pixel
 	bool PeekPix(int32_t iX, int32_t iY); // check mask; regard operator chain
 	bool InBounds(int32_t iX, int32_t iY) { return iX >= X && iY >= Y && iX < X + Wdt && iY < Y + Hgt; } // return whether point iX/iY is inside bounds
 
+protected:
+	void ApplyTurbulence(C4Fixed *pX, C4Fixed *pY, int32_t iCount); // displace positions like CheckMask does
+	bool CheckMaskAt(int32_t iX, int32_t iY, C4Fixed dX, C4Fixed dY); // CheckMask after turbulence was applied to dX/dY
+	// RenderPix for all pixels of a row that are set in pActive, with per-pixel fLastSet/DoSet
+	void RenderRow(C4MCRowScratch &rScratch, size_t iDepth, int32_t iY, int32_t iWdt, const uint8_t *pActive, const uint8_t *pLastSet, C4MCTokenType eLastOp, bool fDraw, uint8_t *pDoSet, uint8_t *pPix, C4MCOverlay **ppPixelSetOverlay);
+
 public:
 	C4MCNodeType Type() override { return MCN_Overlay; } // get node type
 
@@ -339,6 +348,10 @@ public:
 	bool RenderTo(uint8_t *pToBuf, int32_t iPitch); // render to buffer
 	void SetSize(int32_t iWdt, int32_t iHgt);
 
+protected:
+	void RenderRows(uint8_t *pToBuf, int32_t iPitch, bool fParallel); // render row by row; map must not use script algorithms
+	void RenderRowTo(C4MCRowScratch &rScratch, int32_t iY, uint8_t *pRow, C4MCOverlay **ppPixelSetOverlays);
+
 public:
 	C4MCNodeType Type() override { return MCN_Map; } // get node type
 
@@ -350,7 +363,7 @@ public:
 class C4MapCreatorS2 : public C4MCNode
 {
 public:
-	C4MapCreatorS2(C4SLandscape *pLandscape, C4TextureMap *pTexMap, C4MaterialMap *pMatMap, int iPlayerCount);
+	C4MapCreatorS2(C4SLandscape *pLandscape, C4TextureMap *pTexMap, C4MaterialMap *pMatMap, int iPlayerCount, C4AulScript *pScript);
 	C4MapCreatorS2(C4MapCreatorS2 &rTemplate, C4SLandscape *pLandscape); // construct of template
 	~C4MapCreatorS2();
 
@@ -370,6 +383,7 @@ protected:
 	C4SLandscape  *Landscape; // landsape presets
 	C4TextureMap  *TexMap; // texture map
 	C4MaterialMap *MatMap; // material map
+	C4AulScript   *Script; // script of script algorithms and callbacks; may be nullptr
 	C4MCMap DefaultMap; // default template: landscape
 	C4MCOverlay DefaultOverlay; // default template: overlay
 	C4MCPoint DefaultPoint; // default template: point
@@ -381,6 +395,7 @@ protected:
 
 public:
 	void ExecuteCallbacks(int32_t iMapZoom) { CallbackArrays.Execute(iMapZoom); }
+	C4AulScript *GetScript() const { return Script; }
 
 	friend class C4MCOverlay;
 	friend class C4MCMap;
@@ -33,6 +33,8 @@
 #include <C4Player.h>
 #include <C4GameLobby.h>
 
+#include <string>
+
 // C4ChatInputDialog
 
 // singleton
@@ -616,6 +618,29 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		return true;
 	}
 
+	// debug aid: save the landscape drawn by shader and by the lit surface for tools/compare_landscape_screenshots.py
+	if (SEqual(szCmdName, "landscapecompare"))
+	{
+		if (!Game.IsRunning) return false;
+		const std::string shaderFilename{Config.AtScreenshotPath("LandscapeShader.png")};
+		const std::string classicFilename{Config.AtScreenshotPath("LandscapeClassic.png")};
+		if (!Game.Landscape.SaveRendererComparison(shaderFilename.c_str(), classicFilename.c_str()))
+		{
+			LogNTr(spdlog::level::err, "Could not compare landscape rendering (needs fullscreen and Graphics.ShaderLandscape)");
+			return false;
+		}
+		LogNTr("Landscape rendering saved to {} and {}", Config.AtExeRelativePath(shaderFilename.c_str()), Config.AtExeRelativePath(classicFilename.c_str()));
+		return true;
+	}
+
+	// debug aid: time calls of script functions
+	if (SEqual(szCmdName, "benchcalls"))
+	{
+		if (!Game.IsRunning || Game.Control.isNetwork()) return false;
+		const int32_t iCalls{*pCmdPar ? BoundBy(atoi(pCmdPar), 1, 10000000) : 100000};
+		return C4AulProfiler::BenchmarkCalls(iCalls);
+	}
+
 	if (SEqual(szCmdName, "msgboard"))
 	{
 		if (!Game.IsRunning) return false;
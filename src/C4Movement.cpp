@@ -113,6 +113,14 @@ bool C4Object::Contact(int32_t iCNAT)
 {
 	if (Def->ContactFunctionCalls)
 	{
+		switch (iCNAT)
+		{
+		case CNAT_Left:   return static_cast<bool>(Call(C4DefCallback::ContactLeft));
+		case CNAT_Right:  return static_cast<bool>(Call(C4DefCallback::ContactRight));
+		case CNAT_Top:    return static_cast<bool>(Call(C4DefCallback::ContactTop));
+		case CNAT_Bottom: return static_cast<bool>(Call(C4DefCallback::ContactBottom));
+		case CNAT_Center: return static_cast<bool>(Call(C4DefCallback::ContactCenter));
+		}
 		return static_cast<bool>(Call(std::format(PSF_Contact, CNATName(iCNAT)).c_str()));
 	}
 	return false;
@@ -472,9 +480,9 @@ void C4Object::DoMovement()
 	if (fAnyContact)
 	{
 		C4AulParSet pars(C4VInt(fixtoi(oldxdir, 100)), C4VInt(fixtoi(oldydir, 100)));
-		if (old_ocf & OCF_HitSpeed1) Call(PSF_Hit,  pars);
-		if (old_ocf & OCF_HitSpeed2) Call(PSF_Hit2, pars);
-		if (old_ocf & OCF_HitSpeed3) Call(PSF_Hit3, pars);
+		if (old_ocf & OCF_HitSpeed1) Call(C4DefCallback::Hit,  pars);
+		if (old_ocf & OCF_HitSpeed2) Call(C4DefCallback::Hit2, pars);
+		if (old_ocf & OCF_HitSpeed3) Call(C4DefCallback::Hit3, pars);
 	}
 
 	// Rotation gfx
@@ -67,9 +67,20 @@
 #define IPV6_ADDR_SITELOCAL 0x0040U
 #endif
 
+#ifdef C4NETIOTCP_USE_EPOLL
+#include <sys/epoll.h>
+#endif
+
+#ifdef C4NETIOSIMPLEUDP_USE_MMSG
+#include <sys/uio.h>
+#endif
+
 #include <algorithm>
+#include <array>
 #include <cinttypes>
 #include <functional>
+#include <span>
+#include <unordered_map>
 #include <utility>
 
 // simulate packet loss (loss probability in percent)
@@ -496,6 +507,19 @@ bool C4NetIOTCP::Init(uint16_t iPort)
 		SetError("could not create pipe", true);
 		return false;
 	}
+
+#ifdef C4NETIOTCP_USE_EPOLL
+	// use epoll if available, poll otherwise
+	if ((EpollFD = epoll_create1(EPOLL_CLOEXEC)) != -1)
+	{
+		epoll_event event{.events = EPOLLIN, .data = {.ptr = Pipe}};
+		if (epoll_ctl(EpollFD, EPOLL_CTL_ADD, Pipe[0], &event) == -1)
+		{
+			close(EpollFD);
+			EpollFD = -1;
+		}
+	}
+#endif
 #endif
 
 	// create listen socket (if necessary)
@@ -553,6 +577,14 @@ bool C4NetIOTCP::Close()
 	// close pipe
 	close(Pipe[0]);
 	close(Pipe[1]);
+
+#ifdef C4NETIOTCP_USE_EPOLL
+	if (EpollFD != -1)
+	{
+		close(EpollFD);
+		EpollFD = -1;
+	}
+#endif
 #endif
 
 	// ok
@@ -570,6 +602,11 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 	// security
 	if (!fInit) return false;
 
+#ifdef C4NETIOTCP_USE_EPOLL
+	if (EpollFD != -1)
+		return ExecuteEpoll(iMaxTime);
+#endif
+
 #ifdef _WIN32
 	// wait for something to happen
 	if (WaitForSingleObject(Event, iMaxTime) == WAIT_TIMEOUT)
@@ -583,9 +620,6 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 	std::vector<pollfd> fds;
 	GetFDs(fds);
 
-	// build timeout value
-	timeval to = { iMaxTime / 1000, (iMaxTime % 1000) * 1000 };
-
 	// wait for something to happen
 	int ret = StdSync::Poll(fds, iMaxTime);
 
@@ -606,6 +640,17 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 		char c;
 		::read(Pipe[0], &c, 1);
 	}
+
+	// look up the results by socket instead of searching all of them for every socket
+	std::unordered_map<SOCKET, short> revents;
+	for (const pollfd &fd : fds)
+		if (fd.revents)
+			revents.emplace(fd.fd, fd.revents);
+	const auto getRevents = [&revents](const SOCKET sock) -> short
+	{
+		const auto it = revents.find(sock);
+		return it != revents.end() ? it->second : 0;
+	};
 #endif
 
 	// check sockets for events
@@ -651,15 +696,10 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 				return false;
 
 			if (wsaEvents.lNetworkEvents & FD_CONNECT)
-#else
-			// got connection?
-			if (const auto it = std::ranges::find(fds, pWait->sock, &pollfd::fd); it != std::ranges::end(fds) && it->revents & POLLOUT)
-#endif
 			{
 				// remove from list
 				SOCKET sock = pWait->sock; pWait->sock = INVALID_SOCKET;
 
-#ifdef _WIN32
 				// error?
 				if (wsaEvents.iErrorCode[FD_CONNECT_BIT])
 				{
@@ -667,26 +707,16 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg(wsaEvents.iErrorCode[FD_CONNECT_BIT]));
 				}
 				else
-#else
-				// get error code
-				int iErrCode; socklen_t iErrCodeLen = sizeof(iErrCode);
-				if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&iErrCode), &iErrCodeLen) != 0)
-				{
-					close(sock);
-					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg());
-				}
-				// error?
-				else if (iErrCode)
-				{
-					close(sock);
-					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg(iErrCode));
-				}
-				else
-#endif
 					// accept connection, do callback
 					if (!Accept(sock, pWait->addr))
 						return false;
 			}
+#else
+			// got connection?
+			if (getRevents(pWait->sock) & POLLOUT)
+				if (!OnConnectWaitDone(pWait))
+					return false;
+#endif
 		}
 	}
 
@@ -703,67 +733,13 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 
 			// something to read from socket?
 			if (wsaEvents.lNetworkEvents & FD_READ)
-#else
-			// something to read from socket?
-			const auto it = std::ranges::find(fds, sock, &pollfd::fd);
-			if (it != std::ranges::end(fds) && it->revents & POLLIN)
-#endif
-				for (;;)
-				{
-					// how much?
-#ifdef _WIN32
-					DWORD iBytesToRead;
-#else
-					int iBytesToRead;
-#endif
-					if (::ioctlsocket(sock, FIONREAD, &iBytesToRead) == SOCKET_ERROR)
-					{
-						pPeer->Close();
-						if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
-						break;
-					}
-					// The following two lines of code will make sure that if the variable
-					// "iBytesToRead" is zero, it will be increased by one.
-					// In this case, it will hold the value 1 after the operation.
-					// Note it doesn't do anything for negative values.
-					// (This comment has been sponsored by Sven2)
-					if (!iBytesToRead)
-						++iBytesToRead;
-					// get buffer
-					void *pBuf = pPeer->GetRecvBuf(iBytesToRead);
-					// read a buffer full of data from socket
-					int iBytesRead;
-					if ((iBytesRead = ::recv(sock, reinterpret_cast<char *>(pBuf), iBytesToRead, 0)) == SOCKET_ERROR)
-					{
-						// Would block? Ok, let's try this again later
-						if (HaveWouldBlockError()) { ResetSocketError(); break; }
-						// So he's serious after all...
-						pPeer->Close();
-						if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
-						break;
-					}
-					// nothing? this means the conection was closed, if you trust in linux manpages.
-					if (!iBytesRead)
-					{
-						pPeer->Close();
-						if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, "connection closed");
-						break;
-					}
-					// pass to Peer::OnRecv
-					pPeer->OnRecv(iBytesRead);
-				}
+				Recv(pPeer);
 
-#ifdef _WIN32
 			// socket has become writeable?
 			if (wsaEvents.lNetworkEvents & FD_WRITE)
-#else
-			// socket has become writeable?
-			if (it != std::ranges::end(fds) && it->revents & POLLOUT)
-#endif
 				// send remaining data
 				pPeer->Send();
 
-#ifdef _WIN32
 			// socket was closed?
 			if (wsaEvents.lNetworkEvents & FD_CLOSE)
 			{
@@ -773,6 +749,17 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 				// do callback
 				if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, szReason);
 			}
+#else
+			const short iRevents{getRevents(sock)};
+
+			// something to read from socket?
+			if (iRevents & POLLIN)
+				Recv(pPeer);
+
+			// socket has become writeable?
+			if (iRevents & POLLOUT)
+				// send remaining data
+				pPeer->Send();
 #endif
 		}
 
@@ -780,6 +767,220 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 	return true;
 }
 
+#ifdef C4NETIOTCP_USE_EPOLL
+
+namespace
+{
+	// set in the epoll data of connect waits, which is their socket shifted left; the other targets are aligned pointers
+	constexpr std::uint64_t EpollConnectWaitTag{1};
+}
+
+bool C4NetIOTCP::ExecuteEpoll(int iMaxTime) // (mt-safe)
+{
+	// wait for something to happen (without holding any locks)
+	if (iMaxTime)
+	{
+		std::array<pollfd, 1> fds{{{.fd = EpollFD, .events = POLLIN}}};
+		const int ret{StdSync::Poll(fds, iMaxTime)};
+
+		// error
+		if (ret < 0)
+		{
+			SetError("poll failed");
+			return false;
+		}
+
+		// nothing happened
+		if (ret == 0)
+			return true;
+	}
+
+	// Peers are only deleted when the share lock is free, and closed sockets are removed from the epoll set.
+	// So all targets returned while holding the lock stay valid.
+	CStdShareLock PeerListLock(&PeerListCSec);
+
+	// events that do not fit stay pending and are returned next time
+	std::array<epoll_event, 64> events;
+	int iCnt;
+	while ((iCnt = epoll_wait(EpollFD, events.data(), static_cast<int>(events.size()), 0)) == -1 && errno == EINTR);
+	if (iCnt < 0)
+	{
+		SetError("epoll_wait failed", true);
+		return false;
+	}
+
+	// Peer sockets are edge-triggered, so every event has to be handled, even if an earlier one failed
+	bool fSuccess{true};
+	for (const epoll_event &event : std::span{events.data(), static_cast<std::size_t>(iCnt)})
+	{
+		void *const pTarget{event.data.ptr};
+
+		// flush pipe
+		if (pTarget == Pipe)
+		{
+			char c;
+			::read(Pipe[0], &c, 1);
+			continue;
+		}
+
+		// a connection waiting for accept?
+		if (pTarget == &lsock)
+		{
+			if (lsock != INVALID_SOCKET && !Accept())
+				fSuccess = false;
+			continue;
+		}
+
+		// waited-for connection? it may have been closed since the event was queued
+		if (event.data.u64 & EpollConnectWaitTag)
+		{
+			ConnectWait *pWait{nullptr};
+			{
+				CStdLock ConnectWaitsLock(&EpollConnectWaitsCSec);
+				if (const auto it = EpollConnectWaits.find(static_cast<SOCKET>(event.data.u64 >> 1)); it != EpollConnectWaits.end())
+					pWait = it->second;
+			}
+			if (pWait && pWait->sock != INVALID_SOCKET && !OnConnectWaitDone(pWait))
+				fSuccess = false;
+			continue;
+		}
+
+		// connected socket
+		Peer *const pPeer{static_cast<Peer *>(pTarget)};
+		if (!pPeer->Open()) continue;
+
+		// something to read from socket? (errors and hangups are detected by reading)
+		if (event.events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+			Recv(pPeer);
+
+		// socket has become writeable?
+		if (event.events & EPOLLOUT)
+			// send remaining data
+			pPeer->Send();
+	}
+
+	return fSuccess;
+}
+
+void C4NetIOTCP::EpollAdd(const SOCKET sock, const uint32_t iEvents, void *const pTarget) // (mt-safe)
+{
+	if (EpollFD == -1) return;
+	epoll_event event{.events = iEvents, .data = {.ptr = pTarget}};
+	if (epoll_ctl(EpollFD, EPOLL_CTL_ADD, sock, &event) == -1)
+		SetError("could not add socket to epoll set", true);
+}
+
+void C4NetIOTCP::EpollRemove(const SOCKET sock) // (mt-safe)
+{
+	if (EpollFD != -1)
+		epoll_ctl(EpollFD, EPOLL_CTL_DEL, sock, nullptr);
+}
+
+void C4NetIOTCP::EpollAddConnectWait(ConnectWait *const pWait) // (mt-safe)
+{
+	if (EpollFD == -1) return;
+	{
+		CStdLock ConnectWaitsLock(&EpollConnectWaitsCSec);
+		EpollConnectWaits.insert_or_assign(pWait->sock, pWait);
+	}
+	// wait for it to become writeable
+	epoll_event event{.events = EPOLLOUT, .data = {.u64 = (static_cast<std::uint64_t>(pWait->sock) << 1) | EpollConnectWaitTag}};
+	if (epoll_ctl(EpollFD, EPOLL_CTL_ADD, pWait->sock, &event) == -1)
+		SetError("could not add socket to epoll set", true);
+}
+
+void C4NetIOTCP::EpollRemoveConnectWait(const SOCKET sock) // (mt-safe)
+{
+	EpollRemove(sock);
+	CStdLock ConnectWaitsLock(&EpollConnectWaitsCSec);
+	EpollConnectWaits.erase(sock);
+}
+
+#endif
+
+#ifndef _WIN32
+
+bool C4NetIOTCP::OnConnectWaitDone(ConnectWait *const pWait) // (mt-safe)
+{
+	// remove from list
+	SOCKET sock = pWait->sock; pWait->sock = INVALID_SOCKET;
+
+#ifdef C4NETIOTCP_USE_EPOLL
+	// the wait entry is going to be deleted; Accept registers the socket again for the peer
+	EpollRemoveConnectWait(sock);
+#endif
+
+	// get error code
+	int iErrCode; socklen_t iErrCodeLen = sizeof(iErrCode);
+	if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&iErrCode), &iErrCodeLen) != 0)
+	{
+		close(sock);
+		if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg());
+		return true;
+	}
+	// error?
+	if (iErrCode)
+	{
+		close(sock);
+		if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg(iErrCode));
+		return true;
+	}
+
+	// accept connection, do callback
+	return Accept(sock, pWait->addr) != nullptr;
+}
+
+#endif
+
+void C4NetIOTCP::Recv(Peer *const pPeer) // (mt-safe)
+{
+	const SOCKET sock{pPeer->GetSocket()};
+	for (;;)
+	{
+		// how much?
+#ifdef _WIN32
+		DWORD iBytesToRead;
+#else
+		int iBytesToRead;
+#endif
+		if (::ioctlsocket(sock, FIONREAD, &iBytesToRead) == SOCKET_ERROR)
+		{
+			pPeer->Close();
+			if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
+			break;
+		}
+		// The following two lines of code will make sure that if the variable
+		// "iBytesToRead" is zero, it will be increased by one.
+		// In this case, it will hold the value 1 after the operation.
+		// Note it doesn't do anything for negative values.
+		// (This comment has been sponsored by Sven2)
+		if (!iBytesToRead)
+			++iBytesToRead;
+		// get buffer
+		void *pBuf = pPeer->GetRecvBuf(iBytesToRead);
+		// read a buffer full of data from socket
+		int iBytesRead;
+		if ((iBytesRead = ::recv(sock, reinterpret_cast<char *>(pBuf), iBytesToRead, 0)) == SOCKET_ERROR)
+		{
+			// Would block? Ok, let's try this again later
+			if (HaveWouldBlockError()) { ResetSocketError(); break; }
+			// So he's serious after all...
+			pPeer->Close();
+			if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
+			break;
+		}
+		// nothing? this means the conection was closed, if you trust in linux manpages.
+		if (!iBytesRead)
+		{
+			pPeer->Close();
+			if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, "connection closed");
+			break;
+		}
+		// pass to Peer::OnRecv
+		pPeer->OnRecv(iBytesRead);
+	}
+}
+
 C4NetIOTCP::Socket::~Socket()
 {
 	if (sock != INVALID_SOCKET)
@@ -902,6 +1103,9 @@ bool C4NetIOTCP::Close(const addr_t &addr) // (mt-safe)
 	if (pWait)
 	{
 		// close socket, do callback
+#ifdef C4NETIOTCP_USE_EPOLL
+		EpollRemoveConnectWait(pWait->sock);
+#endif
 		closesocket(pWait->sock); pWait->sock = INVALID_SOCKET;
 		if (pCB) pCB->OnDisconn(pWait->addr, this, "closed");
 	}
@@ -983,6 +1187,15 @@ HANDLE C4NetIOTCP::GetEvent() // (mt-safe)
 
 void C4NetIOTCP::GetFDs(std::vector<pollfd> &fds)
 {
+#ifdef C4NETIOTCP_USE_EPOLL
+	// everything else is in the epoll set, which becomes readable once any of it is ready
+	if (EpollFD != -1)
+	{
+		fds.push_back({.fd = EpollFD, .events = POLLIN});
+		return;
+	}
+#endif
+
 	// add pipe
 	fds.push_back({.fd = Pipe[0], .events = POLLIN});
 
@@ -1123,6 +1336,11 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 	// clear add-lock
 	PeerListAddLock.Clear();
 
+#ifdef C4NETIOTCP_USE_EPOLL
+	// edge-triggered, so writeability does not need to be switched on and off with the output buffer
+	EpollAdd(nsock, EPOLLIN | EPOLLOUT | EPOLLET, pnPeer);
+#endif
+
 	// ask callback if connection should be permitted
 	if (pCB && !pCB->OnConn(addr, caddr, nullptr, this))
 		// close socket immediately (will be deleted later)
@@ -1185,6 +1403,10 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 		return false;
 	}
 
+#ifdef C4NETIOTCP_USE_EPOLL
+	EpollAdd(lsock, EPOLLIN, &lsock);
+#endif
+
 	// ok
 	iListenPort = inListenPort;
 	return true;
@@ -1257,6 +1479,13 @@ void C4NetIOTCP::AddConnectWait(SOCKET sock, const addr_t &addr) // (mt-safe)
 	pnWait->sock = sock; pnWait->addr = addr;
 	pnWait->Next = pConnectWaits;
 	pConnectWaits = pnWait;
+#ifdef C4NETIOTCP_USE_EPOLL
+	if (EpollFD != -1)
+	{
+		EpollAddConnectWait(pnWait);
+		return;
+	}
+#endif
 #ifndef _WIN32
 	// unblock, so new FD can be realized
 	UnBlock();
@@ -1279,6 +1508,9 @@ void C4NetIOTCP::ClearConnectWaits() // (mt-safe)
 	for (ConnectWait *pWait = pConnectWaits; pWait; pWait = pWait->Next)
 		if (pWait->sock != INVALID_SOCKET)
 		{
+#ifdef C4NETIOTCP_USE_EPOLL
+			EpollRemoveConnectWait(pWait->sock);
+#endif
 			closesocket(pWait->sock);
 			pWait->sock = INVALID_SOCKET;
 		}
@@ -1388,7 +1620,11 @@ bool C4NetIOTCP::Peer::Send() // (mt-safe)
 		OBuf.Shrink(iBytesSent);
 #ifndef _WIN32
 		// Unblock parent so the FD-list can be refreshed
-		pParent->UnBlock();
+		// (the epoll set always waits for writeability)
+#ifdef C4NETIOTCP_USE_EPOLL
+		if (pParent->EpollFD == -1)
+#endif
+			pParent->UnBlock();
 #endif
 	}
 	else
@@ -1463,6 +1699,9 @@ void C4NetIOTCP::Peer::Close() // (mt-safe)
 	CStdLock ILock(&ICSec); CStdLock OLock(&OCSec);
 	if (!fOpen) return;
 	// close socket
+#ifdef C4NETIOTCP_USE_EPOLL
+	pParent->EpollRemove(sock);
+#endif
 	closesocket(sock);
 	sock = INVALID_SOCKET;
 	// set flag
@@ -1709,6 +1948,54 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 	if (eWR == WR_Cancelled || eWR == WR_Timeout) return true;
 	assert(eWR == WR_Readable);
 
+#ifdef C4NETIOSIMPLEUDP_USE_MMSG
+	// read packets from socket, several at once
+	constexpr std::size_t BatchSize{16}, MaxMsgSize{65536};
+	// pages that are never written to are not allocated
+	thread_local const std::unique_ptr<char[]> RecvBuf{std::make_unique_for_overwrite<char[]>(BatchSize * MaxMsgSize)};
+	std::array<mmsghdr, BatchSize> Msgs;
+	std::array<iovec, BatchSize> IOVecs;
+	std::array<sockaddr_in6, BatchSize> SrcAddrs;
+	for (;;)
+	{
+		for (std::size_t i{0}; i < BatchSize; ++i)
+		{
+			IOVecs[i] = {.iov_base = RecvBuf.get() + i * MaxMsgSize, .iov_len = MaxMsgSize};
+			Msgs[i] = {.msg_hdr = {.msg_name = &SrcAddrs[i], .msg_namelen = sizeof(SrcAddrs[i]), .msg_iov = &IOVecs[i], .msg_iovlen = 1}};
+		}
+		const int iMsgCnt{::recvmmsg(sock, Msgs.data(), BatchSize, MSG_DONTWAIT, nullptr)};
+		// error?
+		if (iMsgCnt == SOCKET_ERROR)
+		{
+			// nothing left to read
+			if (HaveWouldBlockError()) { ResetSocketError(); break; }
+			if (errno == EINTR) continue;
+			// (unreachable notifications are not reported for unconnected sockets on Linux)
+			SetError("could not receive data from socket", true);
+			return false;
+		}
+		for (int i{0}; i < iMsgCnt; ++i)
+		{
+			// invalid address?
+			addr_t SrcAddr; SrcAddr.SetAddress(reinterpret_cast<sockaddr *>(&SrcAddrs[i]));
+			if ((Msgs[i].msg_hdr.msg_namelen != sizeof(sockaddr_in) && Msgs[i].msg_hdr.msg_namelen != sizeof(sockaddr_in6)) || SrcAddr.GetFamily() == addr_t::UnknownFamily)
+			{
+				SetError("recvmmsg returned an invalid address");
+				return false;
+			}
+			// empty datagram: unlike with the recvfrom loop below, this doesn't stop reading, as recvmmsg
+			// reports errors through its return value; just skip it
+			if (!Msgs[i].msg_len)
+				continue;
+			// callback
+			C4NetIOPacket Pkt(IOVecs[i].iov_base, Msgs[i].msg_len, true, SrcAddr);
+			if (pCB) pCB->OnPacket(Pkt, this);
+		}
+		// socket drained?
+		if (static_cast<std::size_t>(iMsgCnt) < BatchSize)
+			break;
+	}
+#else
 	// read packets from socket
 	for (;;)
 	{
@@ -1765,6 +2052,7 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 		// callback
 		if (pCB) pCB->OnPacket(Pkt, this);
 	}
+#endif
 
 	// ok
 	return true;
@@ -1796,6 +2084,52 @@ bool C4NetIOSimpleUDP::Broadcast(const C4NetIOPacket &rPacket)
 	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), MCAddr));
 }
 
+bool C4NetIOSimpleUDP::SendBatch(const std::span<const C4NetIOPacket> packets)
+{
+#ifdef C4NETIOSIMPLEUDP_USE_MMSG
+	if (!fInit) { SetError("not yet initialized"); return false; }
+
+	constexpr std::size_t BatchSize{64};
+	std::array<mmsghdr, BatchSize> Msgs;
+	std::array<iovec, BatchSize> IOVecs;
+	bool fSuccess = true;
+	for (std::size_t iPos{0}; iPos < packets.size(); )
+	{
+		const std::size_t iCnt{(std::min)(BatchSize, packets.size() - iPos)};
+		for (std::size_t i{0}; i < iCnt; ++i)
+		{
+			const C4NetIOPacket &rPacket{packets[iPos + i]};
+			const C4NetIO::addr_t &addr{rPacket.getAddr()};
+			IOVecs[i] = {.iov_base = const_cast<void *>(rPacket.getData()), .iov_len = rPacket.getSize()};
+			Msgs[i] = {.msg_hdr = {.msg_name = const_cast<sockaddr *>(static_cast<const sockaddr *>(&addr)), .msg_namelen = static_cast<socklen_t>(addr.GetAddrLen()), .msg_iov = &IOVecs[i], .msg_iovlen = 1}};
+		}
+		int iSent{::sendmmsg(sock, Msgs.data(), static_cast<unsigned int>(iCnt), 0)};
+		// error in the first packet?
+		if (iSent == SOCKET_ERROR)
+		{
+			if (errno == EINTR) continue;
+			// like Send, drop the packet and go on
+			if (!HaveWouldBlockError())
+			{
+				SetError("socket sendmmsg failed", true);
+				fSuccess = false;
+			}
+			iSent = 1;
+		}
+		iPos += iSent;
+	}
+
+	// ok
+	if (fSuccess) ResetError();
+	return fSuccess;
+#else
+	bool fSuccess = true;
+	for (const C4NetIOPacket &rPacket : packets)
+		fSuccess &= Send(rPacket);
+	return fSuccess;
+#endif
+}
+
 #ifdef _WIN32
 
 void C4NetIOSimpleUDP::UnBlock() // (mt-safe)
@@ -2647,10 +2981,7 @@ size_t C4NetIOUDP::Packet::FragmentSize(nr_t iFNr) const
 // construction / destruction
 
 C4NetIOUDP::PacketList::PacketList(unsigned int inMaxPacketCnt)
-	: pFront(nullptr),
-	iMaxPacketCnt(inMaxPacketCnt),
-	iPacketCnt(0),
-	pBack(nullptr) {}
+	: iMaxPacketCnt(inMaxPacketCnt) {}
 
 C4NetIOUDP::PacketList::~PacketList()
 {
@@ -2660,58 +2991,48 @@ C4NetIOUDP::PacketList::~PacketList()
 C4NetIOUDP::Packet *C4NetIOUDP::PacketList::GetPacket(unsigned int iNr)
 {
 	CStdShareLock ListLock(&ListCSec);
-	for (Packet *pPkt = pBack; pPkt; pPkt = pPkt->Prev)
-		if (pPkt->GetNr() == iNr)
-			return pPkt;
-		else if (pPkt->GetNr() < iNr)
-			return nullptr;
-	return nullptr;
+	Packet *pPkt = Packets.GetPacketFrgm(iNr);
+	return pPkt && pPkt->GetNr() == iNr ? pPkt : nullptr;
 }
 
 C4NetIOUDP::Packet *C4NetIOUDP::PacketList::GetPacketFrgm(unsigned int iNr)
 {
 	CStdShareLock ListLock(&ListCSec);
-	for (Packet *pPkt = pBack; pPkt; pPkt = pPkt->Prev)
-		if (pPkt->GetNr() <= iNr && pPkt->GetNr() + pPkt->FragmentCnt() > iNr)
-			return pPkt;
-		else if (pPkt->GetNr() < iNr)
-			return nullptr;
-	return nullptr;
+	return Packets.GetPacketFrgm(iNr);
 }
 
 C4NetIOUDP::Packet *C4NetIOUDP::PacketList::GetFirstPacketComplete()
 {
 	CStdShareLock ListLock(&ListCSec);
+	Packet *pFront = Packets.GetFirstPacket();
 	return pFront && pFront->Complete() ? pFront : nullptr;
 }
 
 bool C4NetIOUDP::PacketList::FragmentPresent(unsigned int iNr)
 {
 	CStdShareLock ListLock(&ListCSec);
-	Packet *pPkt = GetPacketFrgm(iNr);
+	Packet *pPkt = Packets.GetPacketFrgm(iNr);
 	return pPkt ? pPkt->FragmentPresent(iNr - pPkt->GetNr()) : false;
 }
 
 bool C4NetIOUDP::PacketList::AddPacket(Packet *pPacket)
 {
 	CStdLock ListLock(&ListCSec);
-	// find insert location
-	Packet *pInsertAfter = pBack, *pInsertBefore = nullptr;
-	for (; pInsertAfter; pInsertBefore = pInsertAfter, pInsertAfter = pInsertAfter->Prev)
-		if (pInsertAfter->GetNr() + pInsertAfter->FragmentCnt() <= pPacket->GetNr())
-			break;
-	// check: enough space?
-	if (pInsertBefore && pInsertBefore->GetNr() < pPacket->GetNr() + pPacket->FragmentCnt())
+	// make room in a backlog; packets before the acknowledged number are only sent after bogus acknowledgements
+	if (iMaxPacketCnt != ~0u && !Packets.InWindow(pPacket))
+	{
+		const unsigned int iEnd{pPacket->GetNr() + pPacket->FragmentCnt()};
+		if (pPacket->GetNr() < Packets.GetAckNr())
+			Clear();
+		if (iEnd > C4NetIOPacketRing<Packet>::MaxWindow)
+			ClearPackets(iEnd - C4NetIOPacketRing<Packet>::MaxWindow);
+	}
+	// overlapping or outside the window?
+	if (!Packets.Add(pPacket))
 		return false;
-	// insert
-	(pInsertAfter ? pInsertAfter->Next : pFront) = pPacket;
-	(pInsertBefore ? pInsertBefore->Prev : pBack) = pPacket;
-	pPacket->Next = pInsertBefore;
-	pPacket->Prev = pInsertAfter;
-	// count packets, check limit
-	++iPacketCnt;
-	while (iPacketCnt > iMaxPacketCnt)
-		DeletePacket(pFront);
+	// check limit
+	while (Packets.GetPacketCnt() > iMaxPacketCnt)
+		DeletePacket(Packets.GetFirstPacket());
 	// ok
 	return true;
 }
@@ -2719,19 +3040,12 @@ bool C4NetIOUDP::PacketList::AddPacket(Packet *pPacket)
 bool C4NetIOUDP::PacketList::DeletePacket(Packet *pPacket)
 {
 	CStdLock ListLock(&ListCSec);
-#ifndef NDEBUG
 	// check: this list?
-	Packet *pPos = pPacket;
-	while (pPos && pPos != pFront) pPos = pPos->Prev;
-	assert(pPos);
-#endif
+	assert(GetPacket(pPacket->GetNr()) == pPacket);
 	// unlink packet
-	(pPacket->Prev ? pPacket->Prev->Next : pFront) = pPacket->Next;
-	(pPacket->Next ? pPacket->Next->Prev : pBack) = pPacket->Prev;
+	Packets.Remove(pPacket);
 	// delete packet
 	delete pPacket;
-	// decrease count
-	--iPacketCnt;
 	// ok
 	return true;
 }
@@ -2739,15 +3053,19 @@ bool C4NetIOUDP::PacketList::DeletePacket(Packet *pPacket)
 void C4NetIOUDP::PacketList::ClearPackets(unsigned int iUntil)
 {
 	CStdLock ListLock(&ListCSec);
-	while (pFront && pFront->GetNr() < iUntil)
-		DeletePacket(pFront);
+	for (Packet *pPkt; (pPkt = Packets.GetFirstPacket()) && pPkt->GetNr() < iUntil; )
+		DeletePacket(pPkt);
+	// acknowledgements may arrive out of order
+	if (iUntil > Packets.GetAckNr())
+		Packets.Acknowledge(iUntil);
 }
 
 void C4NetIOUDP::PacketList::Clear()
 {
 	CStdLock ListLock(&ListCSec);
-	while (iPacketCnt)
-		DeletePacket(pFront);
+	while (Packet *pPkt = Packets.GetFirstPacket())
+		DeletePacket(pPkt);
+	Packets.Acknowledge(0);
 }
 
 // * C4NetIOUDP::Peer
@@ -2898,6 +3216,7 @@ void C4NetIOUDP::Peer::OnRecv(const C4NetIOPacket &rPacket) // (mt-safe)
 			iRIPacketCounter = iIPacketCounter = pPkt->Nr;
 		// clear incoming packets
 		IPackets.Clear(); IMCPackets.Clear(); iNextReCheck = 0;
+		IPackets.ClearPackets(iIPacketCounter); IMCPackets.ClearPackets(iIMCPacketCounter);
 		iLastPacketAsked = iLastMCPacketAsked = 0;
 		// Activate Multicast?
 		if (!pParent->fMultiCast)
@@ -3014,7 +3333,8 @@ void C4NetIOUDP::Peer::OnRecv(const C4NetIOPacket &rPacket) // (mt-safe)
 		OutLock.Clear();
 		// read ask list
 		const int *pAskList = rPacket.getPtr<int>(sizeof(CheckPacketHdr));
-		// send the packets he asks for
+		// collect the packets he asks for, to send them at once
+		std::vector<C4NetIOPacket> Resend, MCResend;
 		unsigned int i;
 		for (i = 0; i < pPkt->AskCount + pPkt->MCAskCount; i++)
 		{
@@ -3023,12 +3343,13 @@ void C4NetIOUDP::Peer::OnRecv(const C4NetIOPacket &rPacket) // (mt-safe)
 			CStdLock OutLock(fMCPacket ? &pParent->OutCSec : &OutCSec);
 			Packet *pPkt2Send = (fMCPacket ? pParent->OPackets : OPackets).GetPacketFrgm(pAskList[i]);
 			if (!pPkt2Send) { Close("starvation"); break; }
-			// send the fragment
-			if (fMCPacket)
-				pParent->BroadcastDirect(*pPkt2Send, pAskList[i]);
-			else
-				SendDirect(*pPkt2Send, pAskList[i]);
+			// get the fragment
+			(fMCPacket ? MCResend : Resend).push_back(pPkt2Send->GetFragment(pAskList[i] - pPkt2Send->GetNr(), fMCPacket));
 		}
+		if (i < pPkt->AskCount + pPkt->MCAskCount) break;
+		// send them
+		if (!Resend.empty()) SendDirect(std::move(Resend));
+		if (!MCResend.empty()) pParent->SendDirect(std::move(MCResend));
 	}
 	break;
 
@@ -3126,11 +3447,14 @@ bool C4NetIOUDP::Peer::SendDirect(const Packet &rPacket, unsigned int iNr)
 	// send one fragment only?
 	if (iNr + 1)
 		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr()));
-	// otherwise: send all fragments
-	bool fSuccess = true;
+	if (rPacket.FragmentCnt() == 1)
+		return SendDirect(rPacket.GetFragment(0));
+	// otherwise: send all fragments at once
+	std::vector<C4NetIOPacket> Fragments;
+	Fragments.reserve(rPacket.FragmentCnt());
 	for (unsigned int i = 0; i < rPacket.FragmentCnt(); i++)
-		fSuccess &= SendDirect(rPacket.GetFragment(i));
-	return fSuccess;
+		Fragments.push_back(rPacket.GetFragment(i));
+	return SendDirect(std::move(Fragments));
 }
 
 bool C4NetIOUDP::Peer::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
@@ -3144,6 +3468,22 @@ bool C4NetIOUDP::Peer::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 	return pParent->SendDirect(std::move(rPacket));
 }
 
+bool C4NetIOUDP::Peer::SendDirect(std::vector<C4NetIOPacket> &&packets) // (mt-safe)
+{
+	// insert correct addr
+	const C4NetIO::addr_t v6Addr{addr.AsIPv6()};
+	int iSize = 0;
+	for (C4NetIOPacket &rPacket : packets)
+	{
+		if (!(rPacket.getStatus() & 0x80)) rPacket.SetAddr(v6Addr);
+		iSize += rPacket.getSize() + iUDPHeaderSize;
+	}
+	// count outgoing
+	{ CStdLock StatLock(&StatCSec); iORate += iSize; }
+	// forward call
+	return pParent->SendDirect(std::move(packets));
+}
+
 void C4NetIOUDP::Peer::OnConn()
 {
 	// reset timeout
@@ -3193,9 +3533,9 @@ void C4NetIOUDP::Peer::CheckCompleteIPackets()
 			pParent->pCB->OnPacket(pPkt->GetData(), pParent);
 		// advance packet counter
 		iIPacketCounter = pPkt->GetNr() + pPkt->FragmentCnt();
-		// remove packet from queue
+		// remove packet from queue, which moves its window on
 		[[maybe_unused]] int iNr = pPkt->GetNr();
-		IPackets.DeletePacket(pPkt);
+		IPackets.ClearPackets(iIPacketCounter);
 		assert(!IPackets.GetPacketFrgm(iNr));
 	}
 	while (pPkt = IMCPackets.GetFirstPacketComplete())
@@ -3207,9 +3547,9 @@ void C4NetIOUDP::Peer::CheckCompleteIPackets()
 			pParent->pCB->OnPacket(pPkt->GetData(), pParent);
 		// advance packet counter
 		iIMCPacketCounter = pPkt->GetNr() + pPkt->FragmentCnt();
-		// remove packet from queue
+		// remove packet from queue, which moves its window on
 		[[maybe_unused]] int iNr = pPkt->GetNr();
-		IMCPackets.DeletePacket(pPkt);
+		IMCPackets.ClearPackets(iIMCPacketCounter);
 		assert(!IMCPackets.GetPacketFrgm(iNr));
 	}
 }
@@ -3251,21 +3591,37 @@ bool C4NetIOUDP::BroadcastDirect(const Packet &rPacket, unsigned int iNr) // (mt
 	// only one fragment?
 	if (iNr + 1)
 		return SendDirect(rPacket.GetFragment(iNr - rPacket.GetNr(), true));
-	// send all fragments
-	bool fSuccess = true;
+	if (rPacket.FragmentCnt() == 1)
+		return SendDirect(rPacket.GetFragment(0, true));
+	// send all fragments at once
+	std::vector<C4NetIOPacket> Fragments;
+	Fragments.reserve(rPacket.FragmentCnt());
 	for (unsigned int iFrgm = 0; iFrgm < rPacket.FragmentCnt(); iFrgm++)
-		fSuccess &= SendDirect(rPacket.GetFragment(iFrgm, true));
-	return fSuccess;
+		Fragments.push_back(rPacket.GetFragment(iFrgm, true));
+	return SendDirect(std::move(Fragments));
 }
 
 bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 {
-	addr_t toaddr = rPacket.getAddr();
+	// send it
+	if (!PrepareSendDirect(rPacket)) return true;
+	return C4NetIOSimpleUDP::Send(rPacket);
+}
+
+bool C4NetIOUDP::SendDirect(std::vector<C4NetIOPacket> &&packets) // (mt-safe)
+{
+	std::erase_if(packets, [this](C4NetIOPacket &rPacket) { return !PrepareSendDirect(rPacket); });
+	// send them all at once
+	return C4NetIOSimpleUDP::SendBatch(packets);
+}
+
+bool C4NetIOUDP::PrepareSendDirect(C4NetIOPacket &rPacket) // (mt-safe)
+{
 	// packet meant to be broadcasted?
 	if (rPacket.getStatus() & 0x80)
 	{
 		// set addr
-		toaddr = C4NetIOSimpleUDP::getMCAddr();
+		rPacket.SetAddr(C4NetIOSimpleUDP::getMCAddr());
 		// statistics
 		CStdLock StatLock(&StatCSec);
 		iBroadcastRate += rPacket.getSize() + iUDPHeaderSize;
@@ -3273,16 +3629,15 @@ bool C4NetIOUDP::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 
 	// debug
 #ifdef C4NETIO_DEBUG
-	{ C4NetIOPacket Pkt2 = rPacket; Pkt2.SetAddr(toaddr); DebugLogPkt(true, Pkt2); }
+	DebugLogPkt(true, rPacket);
 #endif
 
 #ifdef C4NETIO_SIMULATE_PACKETLOSS
 	if ((rPacket.getStatus() & 0x7F) != IPID_Test)
-		if (SafeRandom(100) < C4NETIO_SIMULATE_PACKETLOSS) return true;
+		if (SafeRandom(100) < C4NETIO_SIMULATE_PACKETLOSS) return false;
 #endif
 
-	// send it
-	return C4NetIOSimpleUDP::Send(C4NetIOPacket(rPacket.getRef(), toaddr));
+	return true;
 }
 
 bool C4NetIOUDP::DoLoopbackTest()
@@ -19,6 +19,7 @@
 
 #pragma once
 
+#include "C4NetIOPacketRing.h"
 #include "C4Network2Address.h"
 #include "Standard.h"
 #include "StdSync.h"
@@ -27,8 +28,17 @@
 #include "StdScheduler.h"
 
 #include <memory>
+#include <span>
+#include <unordered_map>
 #include <vector>
 
+#ifdef __linux__
+// C4NetIOTCP registers its sockets once in an epoll set instead of collecting them for every poll
+#define C4NETIOTCP_USE_EPOLL
+// C4NetIOSimpleUDP sends and receives several datagrams per system call
+#define C4NETIOSIMPLEUDP_USE_MMSG
+#endif
+
 
 #include <cstring>
 #include <vector>
@@ -135,6 +145,11 @@ public:
 	// construct from buffer (takes data, if possible)
 	explicit C4NetIOPacket(const StdBuf &Buf, const C4NetIO::addr_t &naddr = C4NetIO::addr_t());
 
+	C4NetIOPacket(const C4NetIOPacket &) = default;
+	C4NetIOPacket(C4NetIOPacket &&) = default; // takes data, if possible
+	C4NetIOPacket &operator=(const C4NetIOPacket &) = default;
+	C4NetIOPacket &operator=(C4NetIOPacket &&) = default;
+
 	~C4NetIOPacket();
 
 protected:
@@ -317,10 +332,32 @@ protected:
 	int Pipe[2];
 #endif
 
+#ifdef C4NETIOTCP_USE_EPOLL
+	// epoll set containing pipe, listener and all sockets; -1 if unavailable (poll is used then)
+	int EpollFD{-1};
+	// connect waits by socket; their epoll events carry the socket instead of a target (see EpollAddConnectWait)
+	std::unordered_map<SOCKET, ConnectWait *> EpollConnectWaits;
+	CStdCSec EpollConnectWaitsCSec;
+#endif
+
 	// *** implementation
 
 	bool Listen(uint16_t inListenPort);
 
+	// read all available data from the peer's socket
+	void Recv(Peer *pPeer);
+#ifndef _WIN32
+	// waited-for connection is writeable: check result and accept it
+	bool OnConnectWaitDone(ConnectWait *pWait);
+#endif
+#ifdef C4NETIOTCP_USE_EPOLL
+	bool ExecuteEpoll(int iMaxTime);
+	void EpollAdd(SOCKET sock, uint32_t iEvents, void *pTarget);
+	void EpollRemove(SOCKET sock); // before closing, as the socket might be shared with child processes
+	void EpollAddConnectWait(ConnectWait *pWait);
+	void EpollRemoveConnectWait(SOCKET sock);
+#endif
+
 	SOCKET CreateSocket(addr_t::AddressFamily family);
 	bool Connect(const addr_t &addr, SOCKET nsock);
 
@@ -360,6 +397,8 @@ public:
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
+	// send several packets, using as few system calls as possible
+	bool SendBatch(std::span<const C4NetIOPacket> packets);
 
 	virtual void UnBlock();
 #ifdef _WIN32
@@ -453,6 +492,7 @@ public:
 
 	virtual bool Send(const C4NetIOPacket &rPacket) override;
 	bool SendDirect(C4NetIOPacket &&packet); // (mt-safe)
+	bool SendDirect(std::vector<C4NetIOPacket> &&packets); // (mt-safe)
 	virtual bool Broadcast(const C4NetIOPacket &rPacket) override;
 	virtual bool SetBroadcast(const addr_t &addr, bool fSet = true) override;
 
@@ -534,8 +574,6 @@ protected:
 
 	protected:
 		::size_t FragmentSize(nr_t iFNr) const;
-		// list
-		Packet *Next, *Prev;
 	};
 
 	friend class Packet;
@@ -547,10 +585,10 @@ protected:
 		~PacketList();
 
 	protected:
-		// packet list
-		Packet *pFront, *pBack;
-		// packet counts
-		unsigned int iPacketCnt, iMaxPacketCnt;
+		C4NetIOPacketRing<Packet> Packets;
+		// packet limit; lists with a limit are send backlogs, which drop their oldest packets to make room,
+		// also when a new packet is outside the window. Others refuse such packets; they are asked for again later.
+		unsigned int iMaxPacketCnt;
 		// critical section
 		CStdCSecEx ListCSec;
 
@@ -562,8 +600,8 @@ protected:
 
 		bool AddPacket(Packet *pPacket);
 		bool DeletePacket(Packet *pPacket);
-		void ClearPackets(unsigned int iUntil);
-		void Clear();
+		void ClearPackets(unsigned int iUntil); // deletes packets before iUntil and acknowledges it
+		void Clear(); // deletes all packets and resets the acknowledged number
 	};
 
 	friend class PacketList;
@@ -682,6 +720,7 @@ protected:
 		// sending
 		bool SendDirect(const Packet &rPacket, unsigned int iNr = ~0);
 		bool SendDirect(C4NetIOPacket &&rPacket);
+		bool SendDirect(std::vector<C4NetIOPacket> &&packets);
 
 		// events
 		void OnConn();
@@ -740,6 +779,7 @@ protected:
 
 	// sending
 	bool BroadcastDirect(const Packet &rPacket, unsigned int iNr = ~0u); // (mt-safe)
+	bool PrepareSendDirect(C4NetIOPacket &rPacket); // set target address; false if the packet should be dropped (mt-safe)
 
 	// multicast related
 	bool DoLoopbackTest();
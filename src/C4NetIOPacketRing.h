@@ -0,0 +1,134 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// packets indexed by fragment number, used by C4NetIOUDP::PacketList
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+// Ring of fragment numbers FirstNr up to (excluding) EndNr, each pointing to the packet containing it
+// or nullptr. Fragment iNr is found at iNr & (Ring.size() - 1). The first one always belongs to a packet.
+// Packets (T::GetNr(), T::FragmentCnt()) must not overlap. They are not owned and not locked.
+// Only packets within MaxWindow fragments after the acknowledged number are taken, which bounds the ring,
+// and the ring shrinks again once the packets fit into a quarter of it.
+template<typename T>
+class C4NetIOPacketRing
+{
+public:
+	// maximum distance between the acknowledged number and the end of a packet
+	static constexpr unsigned int MaxWindow{1u << 16};
+	static constexpr std::size_t MinRingSize{64};
+
+private:
+	std::vector<T *> Ring;
+	unsigned int iFirstNr{0}, iEndNr{0};
+	unsigned int iPacketCnt{0};
+	unsigned int iAckNr{0};
+
+	T *&Slot(const unsigned int iNr) { return Ring[iNr & (Ring.size() - 1)]; }
+	T *Slot(const unsigned int iNr) const { return Ring[iNr & (Ring.size() - 1)]; }
+
+	void Resize(const std::size_t iSize)
+	{
+		std::vector<T *> NewRing(iSize, nullptr);
+		for (unsigned int i = iFirstNr; i < iEndNr; ++i)
+			NewRing[i & (NewRing.size() - 1)] = Slot(i);
+		Ring = std::move(NewRing);
+	}
+
+public:
+	unsigned int GetPacketCnt() const { return iPacketCnt; }
+	unsigned int GetAckNr() const { return iAckNr; }
+	std::size_t GetRingSize() const { return Ring.size(); }
+
+	// packet containing the fragment
+	T *GetPacketFrgm(const unsigned int iNr) const
+	{
+		if (iNr < iFirstNr || iNr >= iEndNr) return nullptr;
+		return Slot(iNr);
+	}
+
+	// packet with the lowest number
+	T *GetFirstPacket() const
+	{
+		return iPacketCnt ? Slot(iFirstNr) : nullptr;
+	}
+
+	// not acknowledged yet and not too far ahead
+	bool InWindow(const T *const pPacket) const
+	{
+		const unsigned int iNr = pPacket->GetNr(), iEnd = iNr + pPacket->FragmentCnt();
+		return iNr >= iAckNr && iEnd >= iNr && iEnd - iAckNr <= MaxWindow;
+	}
+
+	// all fragments before iNr are done with; no packet may contain any of them
+	void Acknowledge(const unsigned int iNr)
+	{
+		assert(!iPacketCnt || iFirstNr >= iNr);
+		iAckNr = iNr;
+	}
+
+	// fails if the packet overlaps another one or is outside the window
+	bool Add(T *const pPacket)
+	{
+		if (!InWindow(pPacket))
+			return false;
+		const unsigned int iNr = pPacket->GetNr(), iEnd = iNr + pPacket->FragmentCnt();
+		// check: enough space?
+		for (unsigned int i = (std::max)(iNr, iFirstNr); i < (std::min)(iEnd, iEndNr); ++i)
+			if (Slot(i))
+				return false;
+		// new range of fragment numbers
+		const unsigned int iNewFirstNr = iPacketCnt ? (std::min)(iFirstNr, iNr) : iNr;
+		const unsigned int iNewEndNr = iPacketCnt ? (std::max)(iEndNr, iEnd) : iEnd;
+		// grow ring
+		if (iNewEndNr - iNewFirstNr > Ring.size())
+			Resize((std::max)(MinRingSize, std::bit_ceil<std::size_t>(iNewEndNr - iNewFirstNr)));
+		// insert
+		iFirstNr = iNewFirstNr; iEndNr = iNewEndNr;
+		for (unsigned int i = iNr; i < iEnd; ++i)
+			Slot(i) = pPacket;
+		++iPacketCnt;
+		return true;
+	}
+
+	// the packet must have been added before
+	void Remove(T *const pPacket)
+	{
+		// unlink packet
+		const unsigned int iNr = pPacket->GetNr(), iEnd = iNr + pPacket->FragmentCnt();
+		for (unsigned int i = iNr; i < iEnd; ++i)
+			Slot(i) = nullptr;
+		// decrease count
+		if (!--iPacketCnt)
+			iFirstNr = iEndNr = 0;
+		else
+		{
+			// shrink range to the remaining packets
+			if (iNr == iFirstNr)
+				while (!Slot(iFirstNr)) ++iFirstNr;
+			if (iEnd == iEndNr)
+				while (!Slot(iEndNr - 1)) --iEndNr;
+		}
+		// shrink ring, leaving room for the range to double before growing again
+		if (Ring.size() > MinRingSize && std::size_t{iEndNr - iFirstNr} * 4 <= Ring.size())
+			Resize((std::max)(MinRingSize, std::bit_ceil<std::size_t>(std::size_t{iEndNr - iFirstNr} * 2)));
+	}
+};
@@ -45,7 +45,10 @@
 #include <arpa/inet.h>
 #endif
 
+#include <C4Thread.h>
+
 #include <cassert>
+#include <chrono>
 #include <format>
 #include <ranges>
 
@@ -694,6 +697,7 @@ void C4Network2::Execute()
 		// remove dynamic
 		if (!ResDynamic.isNull() && Game.Control.ControlTick > iDynamicTick)
 			RemoveDynamic();
+		UpdateDynamicCtrlTick();
 		// Set chase target
 		UpdateChaseTarget();
 		// check for inactive clients and deactivate them
@@ -773,12 +777,15 @@ void C4Network2::Clear()
 	// close net classes
 	NetIO.Clear();
 	// clear ressources
+	StopDynamicPacking();
 	ResList.Clear();
 	// clear password
 	sPassword.Clear();
 	// stuff
 	fAllowJoin = false;
 	iDynamicTick = -1; fDynamicNeeded = false;
+	pDynamicParameters.reset(); DynamicChasingClients.clear();
+	iDynamicCtrlTick.store(-1, std::memory_order_release);
 	iLastActivateRequest = iLastChaseTargetUpdate = iLastReferenceUpdate = iLastLeagueUpdate = 0;
 	fDelayedActivateReq = false;
 	if (Game.pGUI) delete pVoteDialog; pVoteDialog = nullptr;
@@ -1101,21 +1108,26 @@ void C4Network2::OnGameSynchronized()
 	// savegame needed?
 	if (fDynamicNeeded)
 	{
-		// create dynamic
-		bool fSuccess = CreateDynamic(false);
-		// check for clients that still need join-data
-		C4Network2Client *pClient = nullptr;
-		while (pClient = Clients.GetNextClient(pClient))
-			if (!pClient->hasJoinData())
-				if (fSuccess)
-					// now we can provide join data: send it
-					SendJoinData(pClient);
-				else
-					// join data could not be created: emergency kick
-					Game.Clients.CtrlRemove(pClient->getClient(), LoadResStr(C4ResStrTableKey::IDS_ERR_ERRORWHILECREATINGJOINDAT));
+		// create dynamic (join data is sent as soon as it has been packed)
+		if (!CreateDynamic(false))
+			SendJoinDataToWaitingClients(false);
 	}
 }
 
+void C4Network2::SendJoinDataToWaitingClients(bool fSuccess)
+{
+	// check for clients that still need join-data
+	C4Network2Client *pClient = nullptr;
+	while (pClient = Clients.GetNextClient(pClient))
+		if (!pClient->hasJoinData())
+			if (fSuccess)
+				// now we can provide join data: send it
+				SendJoinData(pClient);
+			else
+				// join data could not be created: emergency kick
+				Game.Clients.CtrlRemove(pClient->getClient(), LoadResStr(C4ResStrTableKey::IDS_ERR_ERRORWHILECREATINGJOINDAT));
+}
+
 void C4Network2::DrawStatus(C4FacetEx &cgo)
 {
 	if (!isEnabled()) return;
@@ -1822,8 +1834,10 @@ void C4Network2::SendJoinData(C4Network2Client *pClient)
 	if (pClient->hasJoinData()) return;
 	// host only, scenario must be available
 	assert(isHost());
-	// dynamic available?
-	if (ResDynamic.isNull() || iDynamicTick < Game.Control.ControlTick)
+	// dynamic being packed? join data will be sent when it's done
+	if (iDynamicPackTick >= 0) return;
+	// dynamic available? (a runtime dynamic is behind once it has been packed; the clients that waited for it still get it)
+	if (ResDynamic.isNull() || (iDynamicTick < Game.Control.ControlTick && !pDynamicParameters))
 	{
 		fDynamicNeeded = true;
 		// add synchronization control (will callback, see C4Game::Synchronize)
@@ -1835,8 +1849,8 @@ void C4Network2::SendJoinData(C4Network2Client *pClient)
 	JoinData.SetClientID(pClient->getID());
 	// save status into packet
 	JoinData.SetGameStatus(Status);
-	// parameters
-	JoinData.Parameters = Game.Parameters;
+	// parameters (as they were when the dynamic was taken)
+	JoinData.Parameters = pDynamicParameters ? *pDynamicParameters : Game.Parameters;
 	// core join data
 	JoinData.SetStartCtrlTick(iDynamicTick);
 	JoinData.SetDynamicCore(ResDynamic);
@@ -1847,6 +1861,19 @@ void C4Network2::SendJoinData(C4Network2Client *pClient)
 	// flag client (he will have to accept the network status sent next)
 	pClient->SetStatus(NCS_Chasing);
 	if (!iLastChaseTargetUpdate) iLastChaseTargetUpdate = time(nullptr);
+	// runtime dynamic: the client needs the control since then until it has caught up
+	if (pDynamicParameters) DynamicChasingClients.push_back(pClient->getID());
+}
+
+bool C4Network2::HasDynamicChasingClients()
+{
+	// forget clients that have caught up or left
+	std::erase_if(DynamicChasingClients, [this](const int32_t iClientID)
+	{
+		const C4Network2Client *const pClient{Clients.GetClientByID(iClientID)};
+		return !pClient || !pClient->isChasing();
+	});
+	return !DynamicChasingClients.empty();
 }
 
 C4Network2Res::Ref C4Network2::RetrieveRes(const C4Network2ResCore &Core, int32_t iTimeoutLen, const char *szResName, bool fWaitForCore)
@@ -1947,36 +1974,141 @@ bool C4Network2::CreateDynamic(bool fInit)
 	if (!isHost()) return false;
 	// remove all existing dynamic data
 	RemoveDynamic();
+	// a dynamic still being packed is outdated now
+	StopDynamicPacking();
 	// log
 	Log(C4ResStrTableKey::IDS_NET_SAVING);
+	const auto saveStart = std::chrono::steady_clock::now();
 	// compose file name
 	char szDynamicBase[_MAX_PATH + 1], szDynamicFilename[_MAX_PATH + 1];
 	FormatWithNull(szDynamicBase, "{}Dyn{}", +Config.Network.WorkPath, GetFilename(Game.ScenarioFilename));
 	if (!ResList.FindTempResFileName(szDynamicBase, szDynamicFilename))
 		Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_CREATEDYNFILE);
-	// save dynamic data
+	// save dynamic data into a folder - packing is what takes long, and it doesn't need the game state.
+	// Saving itself still stops the game: the savegame is written from the live game state, which is
+	// neither copied nor serialized incrementally.
+	char szDynamicFolder[_MAX_PATH + 1];
+	SCopy(szDynamicFilename, szDynamicFolder, _MAX_PATH);
+	MakeTempFilename(szDynamicFolder);
+	C4Group *const pSaveGroup{new C4Group};
+	if (!MakeDirectory(szDynamicFolder, nullptr) || !pSaveGroup->Open(szDynamicFolder))
+	{
+		delete pSaveGroup;
+		Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_SAVEDYNFILE); return false;
+	}
 	C4GameSaveNetwork SaveGame(fInit);
-	if (!SaveGame.Save(szDynamicFilename) || !SaveGame.Close())
+	if (!SaveGame.Save(*pSaveGroup, true) || !SaveGame.Close())
 	{
+		SaveGame.Close();
+		EraseItem(szDynamicFolder);
 		Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_SAVEDYNFILE); return false;
 	}
-	// add ressource
-	C4Network2Res::Ref pRes = ResList.AddByFile(szDynamicFilename, true, NRT_Dynamic);
-	if (!pRes) { Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_ADDDYNDATARES); return false; }
-	// save
-	ResDynamic = pRes->getCore();
-	iDynamicTick = Game.Control.getNextControlTick();
+	const int32_t iTick{Game.Control.getNextControlTick()};
+	// initial dynamic: needed right away
+	if (fInit)
+	{
+		if (!PackDynamic(szDynamicFolder, szDynamicFilename))
+		{
+			Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_SAVEDYNFILE); return false;
+		}
+		// add ressource
+		C4Network2Res::Ref pRes = ResList.AddByFile(szDynamicFilename, true, NRT_Dynamic);
+		if (!pRes) { Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_ADDDYNDATARES); return false; }
+		// save
+		ResDynamic = pRes->getCore();
+		iDynamicTick = iTick;
+		fDynamicNeeded = false;
+		// ok
+		return true;
+	}
+	// runtime dynamic: pack and add as ressource in the background while the game goes on.
+	// Joining clients catch up on the control since then, which is kept until they have requested it.
+	iDynamicPackTick = iTick;
+	if (getDynamicCtrlTick() < 0) iDynamicCtrlTick.store(iTick, std::memory_order_release);
+	pDynamicPackParameters = std::make_unique<C4GameParameters>();
+	*pDynamicPackParameters = Game.Parameters;
 	fDynamicNeeded = false;
-	// ok
+	const uint32_t iPackID{++iDynamicPackID};
+	DynamicPackThread = C4Thread::Create({"DynamicPackThread"}, [this, iPackID, folder = std::string{szDynamicFolder}, filename = std::string{szDynamicFilename}]
+	{
+		if (!PackDynamic(folder, filename))
+			Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_SAVEDYNFILE);
+		else if (!(DynamicPackResult = ResList.AddByFile(filename.c_str(), true, NRT_Dynamic)))
+			Log(C4ResStrTableKey::IDS_NET_SAVE_ERR_ADDDYNDATARES);
+		Application.InteractiveThread.ExecuteInMainThread([this, iPackID] { OnDynamicPacked(iPackID); });
+	});
+	Logger->info("Dynamic data saved in {} ms, packing in background",
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - saveStart).count());
 	return true;
 }
 
+bool C4Network2::PackDynamic(const std::string &folder, const std::string &filename) // by both
+{
+	// like C4Group_PackDirectoryTo, but without process callback (the folder only holds the savegame)
+	C4Group Group;
+	if (!Group.Open(filename.c_str(), true, C4Group::OpenFlags::Overwrite))
+		return false;
+	for (DirectoryIterator i(folder.c_str()); *i; ++i)
+		if (!Group.Move(*i, GetFilename(*i)))
+			return false;
+	Group.Sort(C4FLS_Scenario);
+	if (!Group.Close()) return false;
+	return EraseDirectory(folder.c_str());
+}
+
+void C4Network2::OnDynamicPacked(uint32_t iPackID)
+{
+	// cancelled meanwhile?
+	if (iPackID != iDynamicPackID || !DynamicPackThread.joinable()) return;
+	DynamicPackThread.join();
+	C4Network2Res::Ref pRes = DynamicPackResult;
+	DynamicPackResult.Clear();
+	const int32_t iTick{std::exchange(iDynamicPackTick, -1)};
+	std::unique_ptr<C4GameParameters> pParameters{std::move(pDynamicPackParameters)};
+	if (!pRes)
+	{
+		UpdateDynamicCtrlTick();
+		SendJoinDataToWaitingClients(false);
+		return;
+	}
+	// set as current dynamic; it is removed in the next Execute like any other, as its tick has passed already
+	ResDynamic = pRes->getCore();
+	iDynamicTick = iTick;
+	pDynamicParameters = std::move(pParameters);
+	// now we can provide join data
+	SendJoinDataToWaitingClients(true);
+}
+
+void C4Network2::StopDynamicPacking()
+{
+	if (DynamicPackThread.joinable())
+		DynamicPackThread.join();
+	// result is discarded (OnDynamicPacked won't find a matching ID)
+	++iDynamicPackID;
+	iDynamicPackTick = -1;
+	pDynamicPackParameters.reset();
+	if (DynamicPackResult)
+	{
+		DynamicPackResult->Remove();
+		DynamicPackResult.Clear();
+	}
+	UpdateDynamicCtrlTick();
+}
+
 void C4Network2::RemoveDynamic()
 {
 	C4Network2Res::Ref pRes = ResList.getRefRes(ResDynamic.getID());
 	if (pRes) pRes->Remove();
 	ResDynamic.Clear();
 	iDynamicTick = -1;
+	pDynamicParameters.reset();
+}
+
+void C4Network2::UpdateDynamicCtrlTick()
+{
+	// control since a runtime dynamic is kept while it is packed and until all clients that joined by it have caught up
+	if (iDynamicPackTick < 0 && !HasDynamicChasingClients())
+		iDynamicCtrlTick.store(-1, std::memory_order_release);
 }
 
 bool C4Network2::isFrozen() const
@@ -36,8 +36,13 @@
 #include "C4ToastEventHandler.h"
 #endif
 
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <string>
+#include <thread>
+#include <vector>
 
 // lobby predef - no need to include lobby in header just for the class ptr
 namespace C4GameLobby { class MainDlg; class Countdown; }
@@ -180,6 +185,16 @@ protected:
 	// ressources
 	int32_t iDynamicTick;
 	bool fDynamicNeeded;
+	std::unique_ptr<C4GameParameters> pDynamicParameters; // parameters at iDynamicTick, for runtime dynamics
+	std::vector<int32_t> DynamicChasingClients; // clients that got a runtime dynamic and may still need the control since then
+
+	// runtime dynamic being packed in the background
+	std::thread DynamicPackThread;
+	int32_t iDynamicPackTick{-1}; // -1 if none
+	uint32_t iDynamicPackID{0};
+	C4Network2Res::Ref DynamicPackResult; // set by packing thread
+	std::unique_ptr<C4GameParameters> pDynamicPackParameters;
+	std::atomic<int32_t> iDynamicCtrlTick{-1}; // control since this tick must be kept for joining clients
 
 	// game status flags
 	bool fStatusAck, fStatusReached;
@@ -260,6 +275,7 @@ public:
 	bool isFrozen()      const;
 
 	bool isJoinAllowed()      const { return fAllowJoin; }
+	int32_t getDynamicCtrlTick() const { return iDynamicCtrlTick.load(std::memory_order_acquire); } // by both
 
 	class C4GameLobby::MainDlg *GetLobby() const { return pLobby; } // lobby publication
 	const char *GetPassword()              const { return sPassword.getData(); } // Oh noez, now the password is public!
@@ -378,9 +394,15 @@ protected:
 	void OnClientDisconnect(C4Network2Client *pClient);
 
 	void SendJoinData(C4Network2Client *pClient);
+	void SendJoinDataToWaitingClients(bool fSuccess);
+	bool HasDynamicChasingClients();
+	void UpdateDynamicCtrlTick();
 
 	// ressource list
 	bool CreateDynamic(bool fInit);
+	static bool PackDynamic(const std::string &folder, const std::string &filename);
+	void OnDynamicPacked(uint32_t iPackID);
+	void StopDynamicPacking();
 	void RemoveDynamic();
 
 	// status changes
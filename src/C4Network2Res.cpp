@@ -24,6 +24,10 @@
 #include <C4Components.h>
 #include <C4Game.h>
 #include "StdAdaptors.h"
+#include "C4ThreadPool.h"
+
+#include <algorithm>
+#include <format>
 
 #include <fcntl.h>
 #include <sys/types.h>
@@ -145,7 +149,7 @@ void C4Network2ResCore::CompileFunc(StdCompiler *pComp)
 // *** C4Network2ResLoad
 
 C4Network2ResLoad::C4Network2ResLoad(int32_t inChunk, int32_t inByClient)
-	: iChunk(inChunk), iByClient(inByClient), Timestamp(time(nullptr)), pNext(nullptr) {}
+	: iChunk(inChunk), iByClient(inByClient), Timestamp(time(nullptr)), RequestTime(std::chrono::steady_clock::now()), pNext(nullptr) {}
 
 C4Network2ResLoad::~C4Network2ResLoad() {}
 
@@ -154,6 +158,11 @@ bool C4Network2ResLoad::CheckTimeout()
 	return difftime(time(nullptr), Timestamp) >= C4NetResLoadTimeout;
 }
 
+uint32_t C4Network2ResLoad::getRTT() const
+{
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - RequestTime).count());
+}
+
 // *** C4Network2ResChunkData
 
 C4Network2ResChunkData::C4Network2ResChunkData()
@@ -251,7 +260,7 @@ void C4Network2ResChunkData::Clear()
 	}
 }
 
-int32_t C4Network2ResChunkData::GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading) const
+int32_t C4Network2ResChunkData::GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading, const std::vector<int32_t> &Availability) const
 {
 	// (this version is highly calculation-intensitive, yet the most satisfactory
 	//  solution I could find)
@@ -265,10 +274,31 @@ int32_t C4Network2ResChunkData::GetChunkToRetrieve(const C4Network2ResChunkData
 	if (ChData.isComplete()) return -1;
 	// invert to get everything that should be retrieved
 	C4Network2ResChunkData ChData2; ChData.GetNegative(ChData2);
-	// select chunk (random)
-	int32_t iRetrieveChunk = SafeRandom(ChData2.getPresentChunkCnt());
-	// return
-	return ChData2.getPresentChunk(iRetrieveChunk);
+	// select chunk: rarest first, so chunks that only few clients have get spread early
+	// (random among equally rare chunks, so different sources are asked for different chunks)
+	int32_t iRetrieveChunk = -1, iMinAvailability = 0, iCandidateCnt = 0;
+	for (ChunkRange *pRange = ChData2.pChunkRanges; pRange; pRange = pRange->Next)
+		for (int32_t iChunk = pRange->Start; iChunk < pRange->Start + pRange->Length; iChunk++)
+		{
+			const int32_t iAvailability = iChunk < std::ssize(Availability) ? Availability[iChunk] : 0;
+			if (iRetrieveChunk < 0 || iAvailability < iMinAvailability)
+			{
+				iRetrieveChunk = iChunk;
+				iMinAvailability = iAvailability;
+				iCandidateCnt = 1;
+			}
+			else if (iAvailability == iMinAvailability && !SafeRandom(++iCandidateCnt))
+				iRetrieveChunk = iChunk;
+		}
+	return iRetrieveChunk;
+}
+
+void C4Network2ResChunkData::CountPresentChunks(std::vector<int32_t> &Counts) const
+{
+	if (Counts.size() < static_cast<size_t>(iChunkCnt)) Counts.resize(iChunkCnt);
+	for (ChunkRange *pRange = pChunkRanges; pRange; pRange = pRange->Next)
+		for (int32_t iChunk = pRange->Start; iChunk < pRange->Start + pRange->Length; iChunk++)
+			Counts[iChunk]++;
 }
 
 bool C4Network2ResChunkData::MergeRanges(ChunkRange *pRange)
@@ -518,11 +548,44 @@ bool C4Network2Res::SetLoad(const C4Network2ResCore &nCore) // by main thread
 	fRemoved = false;
 	iLastReqTime = time(nullptr);
 	fLoading = true;
+	LoadStartTime = std::chrono::steady_clock::now();
 	// No discovery yet
 	iDiscoverStartTime = 0;
 	return true;
 }
 
+bool C4Network2Res::SetByCache(const C4Network2ResCore &nCore) // by main thread
+{
+	Clear();
+	CStdLock FileLock(&FileCSec);
+	// must be loadable (otherwise, checksums are missing)
+	if (!nCore.isLoadable()) return false;
+	// fill a temporary file from the cache
+	if (!pParent->FindTempResFileName(nCore.getFileName(), szFile))
+		return false;
+	if (!pParent->RetrieveFromCache(nCore, szFile))
+	{
+		remove(szFile); szFile[0] = '\0';
+		return false;
+	}
+#ifdef C4NET2RES_DEBUG_LOG
+	// log
+	pParent->logger->trace("Resource: {}:{} taken from cache to file {}", nCore.getID(), nCore.getFileName(), szFile);
+#endif
+	// same as a completed load
+	Core = nCore;
+	Chunks.SetComplete(Core.getChunkCnt());
+	SCopy(szFile, szStandalone, sizeof(szStandalone) - 1);
+	// set flags
+	fDirty = true;
+	fTempFile = true;
+	fStandaloneFailed = false;
+	fRemoved = false;
+	iLastReqTime = time(nullptr);
+	fLoading = false;
+	return true;
+}
+
 bool C4Network2Res::SetDerived(const char *strName, const char *strFilePath, bool fTemp, C4Network2ResType eType, int32_t iDResID)
 {
 	Clear();
@@ -904,8 +967,9 @@ void C4Network2Res::OnStatus(const C4Network2ResChunkData &rChunkData, C4Network
 	}
 	pChunks->ClientID = pBy->getClientID();
 	pChunks->Chunks = rChunkData;
+	fAvailabilityDirty = true;
 	// load?
-	if (fLoading) StartLoad(pChunks->ClientID, pChunks->Chunks);
+	if (fLoading) StartLoad(*pChunks);
 }
 
 void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
@@ -929,7 +993,10 @@ void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
 		{
 			pNext = pLoad->Next();
 			if (pLoad->getChunk() == rChunk.getChunkNr())
+			{
+				UpdateWindow(pLoad->getByClient(), pLoad->getRTT(), false);
 				RemoveLoad(pLoad);
+			}
 		}
 	}
 	// complete?
@@ -953,6 +1020,7 @@ bool C4Network2Res::DoLoad()
 			pNext = pLoad->Next();
 			if (pLoad->CheckTimeout())
 			{
+				UpdateWindow(pLoad->getByClient(), 0, true);
 				RemoveLoad(pLoad);
 				iLoadsRemoved++;
 			}
@@ -983,6 +1051,8 @@ bool C4Network2Res::NeedsDiscover()
 void C4Network2Res::Clear()
 {
 	CStdLock FileLock(&FileCSec);
+	// files can't be deleted while mapped on some systems
+	StandaloneMapping.Close();
 	// delete files
 	if (fTempFile)
 		if (FileExists(szFile))
@@ -1008,6 +1078,21 @@ int32_t C4Network2Res::OpenFileRead()
 	return open(szStandalone, _O_BINARY | O_RDONLY);
 }
 
+const StdMappedFile *C4Network2Res::GetStandaloneMapping()
+{
+	CStdLock FileLock(&FileCSec);
+	// the file is still being written to while loading
+	if (fLoading) return nullptr;
+	if (!StandaloneMapping.IsOpen())
+	{
+		if (!GetStandalone(nullptr, 0, false, false, true)) return nullptr;
+		if (!StandaloneMapping.Open(szStandalone)) return nullptr;
+	}
+	// must be the file described by the core
+	if (StandaloneMapping.GetSize() != Core.getFileSize()) return nullptr;
+	return &StandaloneMapping;
+}
+
 int32_t C4Network2Res::OpenFileWrite()
 {
 	CStdLock FileLock(&FileCSec);
@@ -1048,7 +1133,7 @@ void C4Network2Res::StartNewLoads()
 			if (pC[i])
 			{
 				// try to start load
-				if (!StartLoad(pC[i]->ClientID, pC[i]->Chunks))
+				if (!StartLoad(*pC[i]))
 				{
 					pC[i] = nullptr; continue;
 				}
@@ -1063,26 +1148,35 @@ void C4Network2Res::StartNewLoads()
 	delete[] pC;
 }
 
-bool C4Network2Res::StartLoad(int32_t iFromClient, const C4Network2ResChunkData &Available)
+bool C4Network2Res::StartLoad(ClientChunks &Client)
 {
 	assert(pParent && pParent->getIOClass());
+	const int32_t iFromClient = Client.ClientID;
 	// all slots used? ignore
 	if (iLoadCnt + 1 >= C4NetResMaxLoad) return true;
 	int32_t loadsAtClient = 0;
-	// are there already enough loads by this client? ignore
+	// is the window of this client full? ignore
 	for (C4Network2ResLoad *pPos = pLoads; pPos; pPos = pPos->Next())
 	{
 		if (pPos->getByClient() == iFromClient)
 		{
-			if (++loadsAtClient >= C4NetResMaxLoadPerPeerPerFile)
+			if (++loadsAtClient >= Client.Window)
 				return true;
 		}
 	}
+	// count sources of each chunk
+	if (fAvailabilityDirty)
+	{
+		ChunkAvailability.assign(Chunks.getChunkCnt(), 0);
+		for (ClientChunks *pChunks = pCChunks; pChunks; pChunks = pChunks->Next)
+			pChunks->Chunks.CountPresentChunks(ChunkAvailability);
+		fAvailabilityDirty = false;
+	}
 	// find chunk to retrieve
 	int32_t iLoads[C4NetResMaxLoad]; int32_t i = 0;
 	for (C4Network2ResLoad *pLoad = pLoads; pLoad; pLoad = pLoad->Next())
 		iLoads[i++] = pLoad->getChunk();
-	int32_t iRetrieveChunk = Chunks.GetChunkToRetrieve(Available, i, iLoads);
+	int32_t iRetrieveChunk = Chunks.GetChunkToRetrieve(Client.Chunks, i, iLoads, ChunkAvailability);
 	// nothing? ignore
 	if (iRetrieveChunk < 0 || static_cast<uint32_t>(iRetrieveChunk) >= Core.getChunkCnt())
 		return true;
@@ -1110,6 +1204,40 @@ bool C4Network2Res::StartLoad(int32_t iFromClient, const C4Network2ResChunkData
 	return true;
 }
 
+void C4Network2Res::UpdateWindow(int32_t iClientID, uint32_t iRTT, bool fTimeout)
+{
+	ClientChunks *pClient;
+	for (pClient = pCChunks; pClient; pClient = pClient->Next)
+		if (pClient->ClientID == iClientID)
+			break;
+	if (!pClient) return;
+	// lost load: back off
+	if (fTimeout)
+	{
+		pClient->Window = std::max(pClient->Window / 2, 1);
+		pClient->SlowStart = false;
+		pClient->WindowAcks = 0;
+		return;
+	}
+	// the minimum round trip time approximates the latency without any queueing
+	pClient->MinRTT = pClient->MinRTT ? std::min(pClient->MinRTT, iRTT) : iRTT;
+	pClient->SmoothRTT = pClient->SmoothRTT ? (pClient->SmoothRTT * 7 + iRTT) / 8 : iRTT;
+	// adjust once per window
+	if (++pClient->WindowAcks < pClient->Window) return;
+	pClient->WindowAcks = 0;
+	// expected throughput is Window / MinRTT, actual throughput is Window / SmoothRTT;
+	// the difference times MinRTT is the number of chunks queued on the way
+	const int32_t iQueued = static_cast<int32_t>(static_cast<int64_t>(pClient->Window) * (pClient->SmoothRTT - pClient->MinRTT) / std::max<uint32_t>(pClient->SmoothRTT, 1));
+	if (iQueued < C4NetResWindowQueueMin)
+		pClient->Window = std::min(pClient->SlowStart ? pClient->Window * 2 : pClient->Window + 1, C4NetResMaxWindow);
+	else
+	{
+		pClient->SlowStart = false;
+		if (iQueued > C4NetResWindowQueueMax)
+			pClient->Window = std::max(pClient->Window - 1, 1);
+	}
+}
+
 void C4Network2Res::EndLoad()
 {
 	// clear loading data
@@ -1163,6 +1291,7 @@ void C4Network2Res::RemoveCChunks(ClientChunks *pChunks)
 	}
 	// delete
 	delete pChunks;
+	fAvailabilityDirty = true;
 }
 
 bool C4Network2Res::OptimizeStandalone(bool fSilent)
@@ -1237,6 +1366,12 @@ bool C4Network2ResChunk::Set(C4Network2Res *pRes, uint32_t inChunk)
 	int32_t iOffset = iChunk * Core.getChunkSize(),
 		iSize = std::min<int32_t>(Core.getFileSize() - iOffset, C4NetResChunkSize);
 	if (iSize < 0) { logger->error("could not get chunk from offset {} from resource file {}: File size is only {}!", iOffset, pRes->getFile(), Core.getFileSize()); return false; }
+	// mapped? saves opening and reading the file for every chunk
+	if (const StdMappedFile *const pMapping{pRes->GetStandaloneMapping()})
+	{
+		Data.Copy(pMapping->GetData() + iOffset, iSize);
+		return true;
+	}
 	// open file
 	int32_t f = pRes->OpenFileRead();
 	if (f == -1) { logger->error("could not open resource file {}!", pRes->getFile()); return false; }
@@ -1354,6 +1489,8 @@ bool C4Network2ResList::Init(std::shared_ptr<spdlog::logger> logger, int32_t inC
 	SetLocalID(inClientID);
 	// create network path
 	if (!CreateNetworkFolder()) return false;
+	// look for ressources of previous sessions
+	Cache.Init(Config.AtNetworkPath(C4CFN_NetResCache), static_cast<uint64_t>(std::max(Config.Network.ResCacheSize, 0)) * 1024 * 1024);
 	// ok
 	return true;
 }
@@ -1507,6 +1644,13 @@ C4Network2Res::Ref C4Network2ResList::AddLoad(const C4Network2ResCore &Core) //
 	}
 	// create new
 	C4Network2Res::Ref pRes = new C4Network2Res(this);
+	// downloaded before?
+	if (pRes->SetByCache(Core))
+	{
+		logger->info("Found {} in cache. Not loading.", Core.getFileName());
+		Add(pRes);
+		return pRes;
+	}
 	// initialize
 	pRes->SetLoad(Core);
 	// log
@@ -1526,6 +1670,8 @@ void C4Network2ResList::RemoveAtClient(int32_t iClientID) // by main thread
 
 void C4Network2ResList::Clear()
 {
+	// the thread pool might still hold references to ressources
+	WaitForCacheStores();
 	CStdShareLock ResListLock(&ResListCSec);
 	for (C4Network2Res *pRes = pFirst; pRes; pRes = pRes->pNext)
 	{
@@ -1709,11 +1855,66 @@ bool C4Network2ResList::SendDiscover(C4Network2IOConnection *pTo) // by both
 void C4Network2ResList::OnResComplete(C4Network2Res *pRes)
 {
 	// log
-	logger->info("{} received.", pRes->getCore().getFileName());
+	const auto loadTime = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - pRes->LoadStartTime);
+	logger->info("{} received ({} KiB in {} ms).", pRes->getCore().getFileName(), pRes->getCore().getFileSize() / 1024, loadTime.count());
+	// keep for the next session (dynamic data won't be asked for again)
+	if (pRes->getType() != NRT_Dynamic)
+		StoreInCache(pRes);
 	// call handler (ctrl might wait for this ressource)
 	Game.Control.Network.OnResComplete(pRes);
 }
 
+std::string C4Network2ResList::GetCacheKey(const C4Network2ResCore &Core)
+{
+	// the file checksum is only known for loadable ressources
+	if (!Core.isLoadable() || !Core.getFileSize()) return {};
+	return std::format("{:08x}{:08x}{:08x}", Core.getFileSize(), Core.getFileCRC(), Core.getContentsCRC());
+}
+
+bool C4Network2ResList::RetrieveFromCache(const C4Network2ResCore &Core, const char *szTarget) // by main thread
+{
+	const std::string key{GetCacheKey(Core)};
+	const std::string path{Cache.GetEntryPath(key)};
+	if (path.empty()) return false;
+	// check contents - the file might have been damaged since
+	uint32_t iCRC32;
+	bool fValid{FileSize(path.c_str()) == Core.getFileSize() && C4Group_GetFileCRC(path.c_str(), &iCRC32) && iCRC32 == Core.getFileCRC()};
+	if (fValid && Core.hasFileSHA())
+	{
+		uint8_t FileSHA[StdSha1::DigestLength];
+		fValid = C4Group_GetFileSHA1(path.c_str(), FileSHA) && !memcmp(FileSHA, Core.getFileSHA(), StdSha1::DigestLength);
+	}
+	if (!fValid)
+	{
+		Cache.Drop(key);
+		return false;
+	}
+	return Cache.Retrieve(key, szTarget);
+}
+
+void C4Network2ResList::StoreInCache(C4Network2Res *const pRes) // by network thread
+{
+	const std::string key{GetCacheKey(pRes->getCore())};
+	if (key.empty() || !Cache.IsEnabled()) return;
+	// Copying takes a while, which would hold up all network traffic. The reference keeps the file.
+	++iPendingCacheStores;
+	C4ThreadPool::Global->SubmitCallback([this, key, ref = C4Network2Res::Ref{pRes}, logger = logger]() mutable
+	{
+		if (!Cache.Store(key, ref->getFile(), ref->getCore().getFileSize()))
+			logger->debug("Could not store {} in ressource cache", ref->getCore().getFileName());
+		// release before signalling, so waiting in Clear() guarantees that no ressource is deleted by this thread afterwards
+		ref.Clear();
+		if (--iPendingCacheStores == 0)
+			iPendingCacheStores.notify_all();
+	});
+}
+
+void C4Network2ResList::WaitForCacheStores()
+{
+	for (int32_t iPending; (iPending = iPendingCacheStores.load()) > 0; )
+		iPendingCacheStores.wait(iPending);
+}
+
 bool C4Network2ResList::CreateNetworkFolder()
 {
 	// get network path without trailing backslash
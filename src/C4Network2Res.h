@@ -19,18 +19,26 @@
 #pragma once
 
 #include "C4ForwardDeclarations.h"
+#include "C4Network2ResCache.h"
+#include <StdFile.h>
 #include <StdSha1.h>
 #include <StdSync.h>
 
 #include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
 
 const uint32_t C4NetResChunkSize = 100U * 1024U;
 
 const int32_t C4NetResDiscoverTimeout = 10, // (s)
               C4NetResDiscoverInterval = 1, // (s)
               C4NetResStatusInterval = 1, // (s)
-              C4NetResMaxLoadPerPeerPerFile = 3,
-              C4NetResMaxLoad = 20,
+              C4NetResInitialWindow = 3, // initial load count per peer and file
+              C4NetResMaxWindow = 48,
+              C4NetResWindowQueueMin = 1, // chunks queued on the way to us: grow window below, shrink above
+              C4NetResWindowQueueMax = 3,
+              C4NetResMaxLoad = 64,
               C4NetResLoadTimeout = 60, // (s)
               C4NetResDeleteTime = 60, // (s)
               C4NetResMaxBigicon = 20; // maximum size, in KB, of bigicon
@@ -81,6 +89,7 @@ public:
 	uint32_t          getContentsCRC() const { return iContentsCRC; }
 	bool              hasFileSHA()     const { return !!fHasFileSHA; }
 	const char       *getFileName()    const { return FileName.getData(); }
+	const uint8_t    *getFileSHA()     const { return FileSHA; }
 	uint32_t          getChunkSize()   const { return iChunkSize; }
 	uint32_t          getChunkCnt()    const { return iFileSize && iChunkSize ? (iFileSize - 1) / iChunkSize + 1 : 0; }
 
@@ -106,6 +115,7 @@ protected:
 	// chunk download data
 	int32_t iChunk;
 	time_t Timestamp;
+	std::chrono::steady_clock::time_point RequestTime; // for round trip measurement
 	int32_t iByClient;
 
 	// list (C4Network2Res)
@@ -114,6 +124,7 @@ protected:
 public:
 	int32_t getChunk()    const { return iChunk; }
 	int32_t getByClient() const { return iByClient; }
+	uint32_t getRTT()     const; // time since request (ms)
 
 	C4Network2ResLoad *Next() const { return pNext; }
 
@@ -152,7 +163,8 @@ public:
 
 	void Clear();
 
-	int32_t GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading) const;
+	int32_t GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading, const std::vector<int32_t> &Availability) const;
+	void CountPresentChunks(std::vector<int32_t> &Counts) const; // increase counts of present chunks
 
 protected:
 	// helpers
@@ -218,9 +230,19 @@ protected:
 
 	// not savable if true
 	bool local{false};
-	struct ClientChunks { C4Network2ResChunkData Chunks; int32_t ClientID; ClientChunks *Next; }
+	struct ClientChunks
+	{
+		C4Network2ResChunkData Chunks; int32_t ClientID; ClientChunks *Next;
+		// request window, adapted to measured round trip times
+		int32_t Window{C4NetResInitialWindow}, WindowAcks{0};
+		bool SlowStart{true};
+		uint32_t MinRTT{0}, SmoothRTT{0}; // (ms)
+	}
 	*pCChunks;
+	std::vector<int32_t> ChunkAvailability; // number of clients having each chunk
+	bool fAvailabilityDirty{true};
 	time_t iDiscoverStartTime;
+	std::chrono::steady_clock::time_point LoadStartTime; // for the load time in the log
 	C4Network2ResLoad *pLoads;
 	int32_t iLoadCnt;
 
@@ -228,6 +250,9 @@ protected:
 	C4Network2Res *pNext;
 	C4Network2ResList *pParent;
 
+	// standalone, mapped for serving chunks
+	StdMappedFile StandaloneMapping;
+
 public:
 	C4Network2ResType getType()                  const { return Core.getType(); }
 	const C4Network2ResCore &getCore()           const { return Core; }
@@ -247,6 +272,7 @@ public:
 	bool SetByGroup(C4Group *pGrp, bool fTemp, C4Network2ResType eType, int32_t iResID, const char *szResName = nullptr, bool fSilent = false);
 	bool SetByCore(const C4Network2ResCore &nCore, bool fSilent = false, const char *szAsFilename = nullptr, int32_t iRecursion = 0);
 	bool SetLoad(const C4Network2ResCore &nCore);
+	bool SetByCache(const C4Network2ResCore &nCore);
 
 	bool SetDerived(const char *strName, const char *strFilePath, bool fTemp, C4Network2ResType eType, int32_t iDResID);
 
@@ -281,9 +307,11 @@ public:
 
 protected:
 	int32_t OpenFileRead(); int32_t OpenFileWrite();
+	const StdMappedFile *GetStandaloneMapping();
 
 	void StartNewLoads();
-	bool StartLoad(int32_t iFromClient, const C4Network2ResChunkData &Chunks);
+	bool StartLoad(ClientChunks &Client);
+	void UpdateWindow(int32_t iClientID, uint32_t iRTT, bool fTimeout);
 	void EndLoad();
 	void ClearLoad();
 
@@ -337,6 +365,10 @@ protected:
 	// object used for network i/o
 	C4Network2IO *pIO;
 
+	// downloads of previous sessions
+	C4Network2ResCache Cache;
+	std::atomic<int32_t> iPendingCacheStores{0}; // copies into the cache still running on the thread pool
+
 	// logger
 	std::shared_ptr<spdlog::logger> logger;
 
@@ -386,6 +418,12 @@ public:
 protected:
 	void OnResComplete(C4Network2Res *pRes);
 
+	// ressource cache
+	static std::string GetCacheKey(const C4Network2ResCore &Core);
+	bool RetrieveFromCache(const C4Network2ResCore &Core, const char *szTarget); // by main thread
+	void StoreInCache(C4Network2Res *pRes); // by network thread
+	void WaitForCacheStores();
+
 	// misc
 	bool CreateNetworkFolder();
 	bool FindTempResFileName(const char *szFilename, char *pTarget);
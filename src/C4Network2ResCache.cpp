@@ -0,0 +1,158 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Network2ResCache.h"
+
+#include "C4Strings.h"
+#include "StdFile.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#include <sys/utime.h>
+#else
+#include <utime.h>
+#endif
+
+void C4Network2ResCache::Init(const char *szPath, const uint64_t iMaxSize) // by main thread
+{
+	CStdLock CacheLock(&CacheCSec);
+	Path = szPath;
+	this->iMaxSize = iMaxSize;
+	Entries.clear();
+	iTotalSize = 0;
+	if (!DirectoryExists(Path.c_str()))
+	{
+		MakeDirectory(Path.c_str(), nullptr);
+		return;
+	}
+	// collect entries; file times are updated on use
+	for (DirectoryIterator i(Path.c_str()); *i; ++i)
+	{
+		if (DirectoryExists(*i)) continue;
+		// remains of an interrupted store
+		if (SEqualNoCase(GetExtension(*i), "tmp"))
+		{
+			EraseFile(*i);
+			continue;
+		}
+		const uint64_t iSize{FileSize(*i)};
+		Entries.push_back({GetFilename(*i), iSize, FileTime(*i)});
+		iTotalSize += iSize;
+	}
+	std::stable_sort(Entries.begin(), Entries.end(), [](const Entry &a, const Entry &b) { return a.LastUse < b.LastUse; });
+	// limit might have been lowered
+	Shrink(iMaxSize);
+}
+
+std::string C4Network2ResCache::GetEntryPath(const std::string &key) // by main thread
+{
+	if (key.empty() || !IsEnabled()) return {};
+	CStdLock CacheLock(&CacheCSec);
+	return FindEntry(key) != Entries.end() ? GetPath(key) : std::string{};
+}
+
+bool C4Network2ResCache::Retrieve(const std::string &key, const char *szTarget) // by main thread
+{
+	CStdLock CacheLock(&CacheCSec);
+	const auto it = FindEntry(key);
+	if (it == Entries.end()) return false;
+	if (!CopyItem(GetPath(key).c_str(), szTarget)) return false;
+	Touch(it);
+	return true;
+}
+
+void C4Network2ResCache::Drop(const std::string &key) // by main thread
+{
+	CStdLock CacheLock(&CacheCSec);
+	const auto it = FindEntry(key);
+	if (it == Entries.end()) return;
+	EraseFile(GetPath(key).c_str());
+	iTotalSize -= it->Size;
+	Entries.erase(it);
+}
+
+bool C4Network2ResCache::Store(const std::string &key, const char *szFile, const uint64_t iSize) // by any thread
+{
+	std::string path, tempPath;
+	{
+		CStdLock CacheLock(&CacheCSec);
+		if (key.empty() || iSize > iMaxSize) return false;
+		// already present?
+		const auto it = FindEntry(key);
+		if (it != Entries.end())
+		{
+			Touch(it);
+			return true;
+		}
+		// the same file may complete twice (e.g. as a definition and in a scenario)
+		if (std::find(Storing.begin(), Storing.end(), key) != Storing.end()) return true;
+		Storing.push_back(key);
+		path = GetPath(key);
+		tempPath = path + ".tmp";
+	}
+	// Copy to a temporary file first, so no incomplete entry is left behind.
+	// The cache stays usable meanwhile, as the entry is only added afterwards.
+	const bool fSuccess{CopyItem(szFile, tempPath.c_str()) && RenameFile(tempPath.c_str(), path.c_str())};
+	if (!fSuccess) EraseFile(tempPath.c_str());
+	CStdLock CacheLock(&CacheCSec);
+	Storing.erase(std::find(Storing.begin(), Storing.end(), key));
+	if (!fSuccess) return false;
+	// make room
+	Shrink(iMaxSize - iSize);
+	Entries.push_back({key, iSize, time(nullptr)});
+	iTotalSize += iSize;
+	return true;
+}
+
+uint64_t C4Network2ResCache::GetTotalSize()
+{
+	CStdLock CacheLock(&CacheCSec);
+	return iTotalSize;
+}
+
+size_t C4Network2ResCache::GetEntryCount()
+{
+	CStdLock CacheLock(&CacheCSec);
+	return Entries.size();
+}
+
+std::string C4Network2ResCache::GetPath(const std::string &key) const
+{
+	return Path + DirSep + key;
+}
+
+std::vector<C4Network2ResCache::Entry>::iterator C4Network2ResCache::FindEntry(const std::string &key)
+{
+	return std::find_if(Entries.begin(), Entries.end(), [&key](const Entry &entry) { return entry.Key == key; });
+}
+
+void C4Network2ResCache::Touch(const std::vector<Entry>::iterator it)
+{
+	it->LastUse = time(nullptr);
+	utime(GetPath(it->Key).c_str(), nullptr);
+	// file times only have a resolution of seconds, so the position decides between entries used in the same second
+	std::rotate(it, it + 1, Entries.end());
+}
+
+void C4Network2ResCache::Shrink(const uint64_t iLimit)
+{
+	while (iTotalSize > iLimit && !Entries.empty())
+	{
+		EraseFile(GetPath(Entries.front().Key).c_str());
+		iTotalSize -= Entries.front().Size;
+		Entries.erase(Entries.begin());
+	}
+}
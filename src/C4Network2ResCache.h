@@ -0,0 +1,66 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// persistent cache of downloaded network ressources
+
+#pragma once
+
+#include "StdSync.h"
+
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+// Files in a directory, named after a key built from the ressource checksums,
+// evicted least recently used first when the size limit is reached.
+// Use times are kept as file times, so the order survives restarts.
+// Checking the contents of an entry against the checksums is up to the caller.
+class C4Network2ResCache
+{
+protected:
+	struct Entry
+	{
+		std::string Key;
+		uint64_t Size;
+		time_t LastUse;
+	};
+
+	CStdCSec CacheCSec;
+	std::string Path;
+	uint64_t iMaxSize{0};
+	std::vector<Entry> Entries; // least recently used first
+	std::vector<std::string> Storing; // keys currently copied into the cache
+	uint64_t iTotalSize{0};
+
+public:
+	void Init(const char *szPath, uint64_t iMaxSize); // by main thread
+	bool IsEnabled() const { return iMaxSize > 0; }
+
+	std::string GetEntryPath(const std::string &key); // by main thread; empty if there is no entry
+	bool Retrieve(const std::string &key, const char *szTarget); // by main thread
+	void Drop(const std::string &key); // by main thread
+	// Copies the file, so it takes a while: don't call it from the network thread. (by any thread)
+	bool Store(const std::string &key, const char *szFile, uint64_t iSize);
+
+	uint64_t GetTotalSize();
+	size_t GetEntryCount();
+
+protected:
+	std::string GetPath(const std::string &key) const;
+	std::vector<Entry>::iterator FindEntry(const std::string &key);
+	void Touch(std::vector<Entry>::iterator it); // moves the entry to the end
+	void Shrink(uint64_t iLimit); // evict least recently used entries
+};
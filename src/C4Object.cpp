@@ -33,10 +33,12 @@
 #include <C4Wrappers.h>
 #include <C4Player.h>
 #include <C4ObjectMenu.h>
+#include <C4Pool.h>
 
 #include <cstring>
 #include <format>
 #include <limits>
+#include <unordered_set>
 #include <utility>
 
 void DrawVertex(C4Facet &cgo, int32_t tx, int32_t ty, int32_t col, int32_t contact)
@@ -70,9 +72,34 @@ void C4Action::GetBridgeData(int32_t &riBridgeTime, bool &rfMoveClonk, bool &rfW
 	if (riBridgeMaterial == 0xff) riBridgeMaterial = -1;
 }
 
+namespace
+{
+	std::unordered_set<const C4Object *> AliveObjects;
+	C4Pool ObjectPool{"C4Object", sizeof(C4Object)};
+}
+
 C4Object::C4Object()
 {
 	Default();
+	Action.Target.SetOwner(this);
+	Action.Target2.SetOwner(this);
+	pLayer.SetOwner(this);
+	AliveObjects.insert(this);
+}
+
+void *C4Object::operator new(const std::size_t size)
+{
+	return ObjectPool.Allocate(size);
+}
+
+void C4Object::operator delete(void *const ptr, const std::size_t size)
+{
+	ObjectPool.Deallocate(ptr, size);
+}
+
+bool C4Object::IsAlive(const C4Object *const pObj)
+{
+	return pObj && AliveObjects.contains(pObj);
 }
 
 void C4Object::Default()
@@ -136,6 +163,7 @@ void C4Object::Default()
 	Visibility = VIS_All;
 	LocalNamed.Reset();
 	Marker = 0;
+	DrawOrder = -1;
 	ColorMod = BlitMode = 0;
 	CrewDisabled = false;
 	pLayer = nullptr;
@@ -144,6 +172,8 @@ void C4Object::Default()
 	pDrawTransform = nullptr;
 	pEffects = nullptr;
 	FirstRef = nullptr;
+	FirstLink = nullptr;
+	FirstTrackedPtr = nullptr;
 	pGfxOverlay = nullptr;
 	iLastAttachMovementFrame = -1;
 }
@@ -233,6 +263,11 @@ C4Object::~C4Object()
 	assert(!Game.Objects.InactiveObjects.ObjectNumber(this));
 	Game.Objects.Sectors.AssertObjectNotInList(this);
 #endif
+
+	// lists and pointers that still refer to this object must not touch it anymore
+	C4ObjectList::DetachLinks(this);
+	C4TrackedObjectPtr::Detach(this);
+	AliveObjects.erase(this);
 }
 
 void C4Object::AssignRemoval(bool fExitContents)
@@ -249,11 +284,11 @@ void C4Object::AssignRemoval(bool fExitContents)
 	// Destruction call in container
 	if (Contained)
 	{
-		Contained->Call(PSF_ContentsDestruction, {C4VObj(this)});
+		Contained->Call(C4DefCallback::ContentsDestruction, {C4VObj(this)});
 		if (!Status) return;
 	}
 	// Destruction call
-	Call(PSF_Destruction);
+	Call(C4DefCallback::Destruction);
 	// Destruction-callback might have deleted the object already
 	if (!Status) return;
 	// remove all effects (extinguishes as well)
@@ -343,6 +378,10 @@ void C4Object::UpdateShape(bool bUpdateVertices)
 
 void C4Object::UpdatePos()
 {
+	// keep FoW-repellers at the right place in the players' visibility grids
+	if (PlrViewRange)
+		for (C4Player *pPlr = Game.Players.First; pPlr; pPlr = pPlr->Next)
+			pPlr->FoWGrid.Update(this, x, y, PlrViewRange);
 	// get new area covered
 	// do *NOT* do this while initializing, because object cannot be sorted by main list
 	if (!Initializing && Status == C4OS_NORMAL)
@@ -913,7 +952,7 @@ bool C4Object::ExecLife()
 				// Take breath
 				int32_t takebreath = GetPhysical()->Breath - Breath;
 				if (takebreath > GetPhysical()->Breath / 2)
-					Call(PSF_DeepBreath);
+					Call(C4DefCallback::DeepBreath);
 				Breath += takebreath;
 			}
 		}
@@ -1170,7 +1209,7 @@ void C4Object::AssignDeath(bool fForced)
 	if (!pPlr || !(Category & C4D_Living) || !pPlr->FoWViewObjs.IsContained(this))
 		SetPlrViewRange(0);
 	// Engine script call
-	Call(PSF_Death, {C4VInt(iDeathCausingPlayer)});
+	Call(C4DefCallback::Death, {C4VInt(iDeathCausingPlayer)});
 	// Update OCF. Done here because previously it would have been done in the next frame
 	// Whats worse: Having the OCF change because of some unrelated script-call like
 	// SetCategory, or slightly breaking compatibility?
@@ -1285,7 +1324,7 @@ void C4Object::DoDamage(int32_t iChange, int32_t iCausedBy, int32_t iCause)
 	// Change value
 	Damage = std::max<int32_t>(Damage + iChange, 0);
 	// Engine script call
-	Call(PSF_Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
+	Call(C4DefCallback::Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
 }
 
 // returns x * y, but returns std::numeric_limits<T>::min() or std::numeric_limits<T>::max() in case of a negative or positive overflow respectively
@@ -1479,8 +1518,8 @@ void C4Object::DoCon(int32_t iChange, bool fInitial, bool fNoComponentChange)
 	// Completion (after bottom y-adjust for correct position)
 	if (!fWasFull && (Con >= FullCon))
 	{
-		Call(PSF_Completion);
-		Call(PSF_Initialize);
+		Call(C4DefCallback::Completion);
+		Call(C4DefCallback::Initialize);
 	}
 
 	// Con Zero Removal
@@ -1530,8 +1569,8 @@ bool C4Object::Exit(int32_t iX, int32_t iY, int32_t iR, C4Fixed iXDir, C4Fixed i
 	UpdateFace(true);
 	SetOCF();
 	// Engine calls
-	if (fCalls) pContainer->Call(PSF_Ejection, {C4VObj(this)});
-	if (fCalls) Call(PSF_Departure, {C4VObj(pContainer)});
+	if (fCalls) pContainer->Call(C4DefCallback::Ejection, {C4VObj(this)});
+	if (fCalls) Call(C4DefCallback::Departure, {C4VObj(pContainer)});
 	// Success (if the obj wasn't "re-entered" by script)
 	return !Contained;
 }
@@ -1548,14 +1587,14 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	// No target or target is self
 	if (!pTarget || (pTarget == this)) return false;
 	// check if entrance is allowed
-	if (Call(PSF_RejectEntrance, {C4VObj(pTarget)})) return false;
+	if (Call(C4DefCallback::RejectEntrance, {C4VObj(pTarget)})) return false;
 	// check if we end up in an endless container-recursion
 	for (C4Object *pCnt = pTarget->Contained; pCnt; pCnt = pCnt->Contained)
 		if (pCnt == this) return false;
 	// Check RejectCollect, if desired
 	if (pfRejectCollect)
 	{
-		if (pTarget->Call(PSF_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
+		if (pTarget->Call(C4DefCallback::RejectCollection, {C4VID(Def->id), C4VObj(this)}))
 		{
 			*pfRejectCollect = true;
 			return false;
@@ -1596,10 +1635,10 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	Contained->UpdateMass();
 	Contained->SetOCF();
 	// Collection call
-	if (fCalls) pTarget->Call(PSF_Collection2, {C4VObj(this)});
+	if (fCalls) pTarget->Call(C4DefCallback::Collection2, {C4VObj(this)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Entrance call
-	if (fCalls) Call(PSF_Entrance, {C4VObj(Contained)});
+	if (fCalls) Call(C4DefCallback::Entrance, {C4VObj(Contained)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Base auto sell contents
 	if (ValidPlr(Contained->Base))
@@ -1637,7 +1676,7 @@ bool C4Object::ActivateEntrance(int32_t by_plr, C4Object *by_obj)
 	}
 	// Try entrance activation
 	if (OCF & OCF_Entrance)
-		if (Call(PSF_ActivateEntrance, {C4VObj(by_obj)}))
+		if (Call(C4DefCallback::ActivateEntrance, {C4VObj(by_obj)}))
 			return true;
 	// Failure
 	return false;
@@ -1707,7 +1746,7 @@ bool C4Object::Build(int32_t iLevel, C4Object *pBuilder)
 	if (NeededMaterialCount)
 	{
 		// BuildNeedsMaterial call to builder script...
-		if (!pBuilder->Call(PSF_BuildNeedsMaterial, {C4VID(NeededMaterial), C4VInt(NeededMaterialCount)}))
+		if (!pBuilder->Call(C4DefCallback::BuildNeedsMaterial, {C4VID(NeededMaterial), C4VInt(NeededMaterialCount)}))
 		{
 			// Builder is a crew member...
 			if (pBuilder->OCF & OCF_CrewMember)
@@ -1801,7 +1840,7 @@ bool C4Object::Push(C4Fixed txdir, C4Fixed dforce, bool fStraighten)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_STUCK, GetName()).c_str(), this);
-			Call(PSF_Stuck);
+			Call(C4DefCallback::Stuck);
 		}
 
 	return true;
@@ -1831,7 +1870,7 @@ bool C4Object::Lift(C4Fixed tydir, C4Fixed dforce)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(LoadResStr(C4ResStrTableKey::IDS_OBJ_STUCK, GetName()).c_str(), this);
-			Call(PSF_Stuck);
+			Call(C4DefCallback::Stuck);
 		}
 	return true;
 }
@@ -1877,7 +1916,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified: use own container as target
 		if (!pTarget) if (!(pTarget = Contained)) break;
 		// Opening contents menu blocked by RejectContents
-		if (pTarget->Call(PSF_RejectContents)) return false;
+		if (pTarget->Call(C4DefCallback::RejectContents)) return false;
 		// Create symbol
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -1920,7 +1959,7 @@ bool C4Object::ActivateMenu(int32_t iMenu, int32_t iMenuSelect,
 		// No target specified
 		if (!pTarget) break;
 		// Opening contents menu blocked by RejectContents
-		if (pTarget->Call(PSF_RejectContents)) return false;
+		if (pTarget->Call(C4DefCallback::RejectContents)) return false;
 		// Create symbol & init
 		fctSymbol.Create(C4SymbolSize, C4SymbolSize);
 		pTarget->Def->Draw(fctSymbol, false, pTarget->Color, pTarget);
@@ -2194,12 +2233,32 @@ void C4Object::ClearPointers(C4Object *pObj)
 	}
 }
 
+#ifdef OBJECTREF_DEBUG
+bool C4Object::HasPointersTo(C4Object *pObj)
+{
+	if (Action.Target == pObj || Action.Target2 == pObj || pLayer == pObj) return true;
+	for (C4Command *cCom = Command; cCom; cCom = cCom->Next)
+		if (cCom->Target == pObj || cCom->Target2 == pObj) return true;
+	for (C4Effect *pEff = pEffects; pEff; pEff = pEff->pNext)
+		if (pEff->pCommandTarget == pObj) return true;
+	for (C4GraphicsOverlay *pGfxOvrl = pGfxOverlay; pGfxOvrl; pGfxOvrl = pGfxOvrl->GetNext())
+		if (pGfxOvrl->GetOverlayObject() == pObj) return true;
+	return false;
+}
+#endif
+
 C4Value C4Object::Call(const char *szFunctionCall, const C4AulParSet &pPars, bool fPassError, bool convertNilToIntBool)
 {
 	if (!Status || !Def || !szFunctionCall[0]) return C4VNull;
 	return Def->Script.ObjectCall(this, this, szFunctionCall, pPars, fPassError, convertNilToIntBool);
 }
 
+C4Value C4Object::Call(const C4DefCallback callback, const C4AulParSet &pPars, bool fPassError, bool convertNilToIntBool)
+{
+	if (!Status || !Def) return C4VNull;
+	return Def->Script.CallbackCall(this, callback, pPars, fPassError, convertNilToIntBool);
+}
+
 bool C4Object::SetPhase(int32_t iPhase)
 {
 	if (Action.Act <= ActIdle) return false;
@@ -2779,8 +2838,8 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(OCF,                                     "OCF",                0u));
 	pComp->Value(Action);
 	pComp->Value(mkNamingAdapt(Contained,                               "Contained",          C4EnumeratedObjectPtr{}));
-	pComp->Value(mkNamingAdapt(Action.Target,                           "ActionTarget1",      C4EnumeratedObjectPtr{}));
-	pComp->Value(mkNamingAdapt(Action.Target2,                          "ActionTarget2",      C4EnumeratedObjectPtr{}));
+	pComp->Value(mkNamingAdapt(Action.Target,                           "ActionTarget1",      C4TrackedObjectPtr{}));
+	pComp->Value(mkNamingAdapt(Action.Target2,                          "ActionTarget2",      C4TrackedObjectPtr{}));
 	pComp->Value(mkNamingAdapt(Component,                               "Component"));
 	pComp->Value(mkNamingAdapt(Contents,                                "Contents"));
 	pComp->Value(mkNamingAdapt(PlrViewRange,                            "PlrViewRange",       0));
@@ -2789,7 +2848,7 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(ColorMod,                                "ColorMod",           0u));
 	pComp->Value(mkNamingAdapt(BlitMode,                                "BlitMode",           0u));
 	pComp->Value(mkNamingAdapt(CrewDisabled,                            "CrewDisabled",       false));
-	pComp->Value(mkNamingAdapt(pLayer,                                  "Layer",              C4EnumeratedObjectPtr{}));
+	pComp->Value(mkNamingAdapt(pLayer,                                  "Layer",              C4TrackedObjectPtr{}));
 	pComp->Value(mkNamingAdapt(C4DefGraphicsAdapt(pGraphics),           "Graphics",           &Def->Graphics));
 	pComp->Value(mkNamingPtrAdapt(pDrawTransform,                       "DrawTransform"));
 	pComp->Value(mkNamingPtrAdapt(pEffects,                             "Effects"));
@@ -2816,6 +2875,8 @@ void C4Object::CompileFunc(StdCompiler *pComp)
 				if (!pCmd)
 					break;
 				pCmd->cObj = this;
+				pCmd->Target.SetOwner(this);
+				pCmd->Target2.SetOwner(this);
 			}
 		}
 		else
@@ -2900,12 +2961,20 @@ void C4Object::DenumeratePointers()
 		pCom->DenumeratePointers();
 
 	// effects
-	if (pEffects) pEffects->DenumeratePointers();
+	if (pEffects)
+	{
+		pEffects->DenumeratePointers();
+		for (C4Effect *pEff = pEffects; pEff; pEff = pEff->pNext)
+			pEff->pCommandTarget.SetOwner(this);
+	}
 
 	// gfx overlays
 	if (pGfxOverlay)
 		for (C4GraphicsOverlay *pGfxOvrl = pGfxOverlay; pGfxOvrl; pGfxOvrl = pGfxOvrl->GetNext())
+		{
 			pGfxOvrl->DenumeratePointers();
+			pGfxOvrl->SetOwner(this);
+		}
 }
 
 bool DrawCommandQuery(int32_t controller, C4ScriptHost &scripthost, int32_t *mask, int com)
@@ -3231,7 +3300,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 		if (Contained && !(byCom & (COM_Single | COM_Double)) && pPlr->ControlStyle)
 		{
 			int32_t PressedComs = pPlr->PressedComs;
-			Contained->Call(PSF_ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
+			Contained->Call(C4DefCallback::ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
 				C4VBool(!!(PressedComs & (1 << COM_Dig))), C4VBool(!!(PressedComs & (1 << COM_Throw)))});
 		}
 	}
@@ -3273,7 +3342,7 @@ bool C4Object::ContainedControl(uint8_t byCom)
 		if (Contained && !(byCom & (COM_Single | COM_Double)) && pPlr->ControlStyle)
 		{
 			int32_t PressedComs = pPlr->PressedComs;
-			Contained->Call(PSF_ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
+			Contained->Call(C4DefCallback::ContainedControlUpdate, {C4VObj(this), C4VInt(Coms2ComDir(PressedComs)),
 				C4VBool(!!(PressedComs & (1 << COM_Dig))), C4VBool(!!(PressedComs & (1 << COM_Throw)))});
 		}
 	}
@@ -3301,7 +3370,7 @@ bool C4Object::CallControl(C4Player *pPlr, uint8_t byCom, const C4AulParSet &pPa
 	if (pPlr->ControlStyle)
 	{
 		int32_t PressedComs = pPlr->PressedComs;
-		Call(PSF_ControlUpdate, {pPars[0]._getBool() ? pPars[0] : C4VObj(this),
+		Call(C4DefCallback::ControlUpdate, {pPars[0]._getBool() ? pPars[0] : C4VObj(this),
 			C4VInt(Coms2ComDir(PressedComs)),
 			C4VBool(!!(PressedComs & (1 << COM_Dig))),
 			C4VBool(!!(PressedComs & (1 << COM_Throw))),
@@ -3760,7 +3829,7 @@ C4Object *C4Object::ComposeContents(C4ID id)
 	if (fInsufficient)
 	{
 		// BuildNeedsMaterial call to object...
-		if (!Call(PSF_BuildNeedsMaterial, {C4VID(idNeeded), C4VInt(iNeeded)}))
+		if (!Call(C4DefCallback::BuildNeedsMaterial, {C4VID(idNeeded), C4VInt(iNeeded)}))
 			// ...game message if not overloaded
 			GameMsgObject(needs.c_str(), this);
 		// Return
@@ -3920,7 +3989,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (!CloseMenu(false)) return;
 	// Script overload
 	if (fControl)
-		if (Call(PSF_ControlCommand, {C4VString(CommandName(iCommand)),
+		if (Call(C4DefCallback::ControlCommand, {C4VString(CommandName(iCommand)),
 			C4VObj(pTarget),
 			iTx,
 			C4VInt(iTy),
@@ -3932,7 +4001,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (Contained->Def->VehicleControl & C4D_VehicleControl_Inside)
 		{
 			Contained->Controller = Controller;
-			if (Contained->Call(PSF_ControlCommand, {C4VString(CommandName(iCommand)),
+			if (Contained->Call(C4DefCallback::ControlCommand, {C4VString(CommandName(iCommand)),
 				C4VObj(pTarget),
 				iTx,
 				C4VInt(iTy),
@@ -3946,7 +4015,7 @@ void C4Object::SetCommand(int32_t iCommand, C4Object *pTarget, C4Value iTx, int3
 		if (Action.Target) if (Action.Target->Def->VehicleControl & C4D_VehicleControl_Outside)
 		{
 			Action.Target->Controller = Controller;
-			if (Action.Target->Call(PSF_ControlCommand, {C4VString(CommandName(iCommand)),
+			if (Action.Target->Call(C4DefCallback::ControlCommand, {C4VString(CommandName(iCommand)),
 				C4VObj(pTarget),
 				iTx,
 				C4VInt(iTy),
@@ -3973,7 +4042,7 @@ bool C4Object::ExecuteCommand()
 	if (Command) Command->Execute();
 	// Command finished: engine call
 	if (Command && Command->Finished)
-		Call(PSF_ControlCommandFinished, {C4VString(CommandName(Command->Command)), C4VObj(Command->Target), Command->Tx, C4VInt(Command->Ty), C4VObj(Command->Target2), C4Value(Command->Data, C4V_Any)});
+		Call(C4DefCallback::ControlCommandFinished, {C4VString(CommandName(Command->Command)), C4VObj(Command->Target), Command->Tx, C4VInt(Command->Ty), C4VObj(Command->Target2), C4Value(Command->Data, C4V_Any)});
 	// Clear finished commands
 	while (Command && Command->Finished) ClearCommand(Command);
 	// Done
@@ -4251,7 +4320,7 @@ int32_t C4Object::GetProcedure()
 void GrabLost(C4Object *cObj)
 {
 	// Grab lost script call on target (quite hacky stuff...)
-	cObj->Action.Target->Call(PSF_GrabLost);
+	cObj->Action.Target->Call(C4DefCallback::GrabLost);
 	// Clear commands down to first PushTo (if any) in command stack
 	for (C4Command *pCom = cObj->Command; pCom; pCom = pCom->Next)
 		if (pCom->Next && pCom->Next->Command == C4CMD_PushTo)
@@ -5260,7 +5329,7 @@ void C4Object::ExecAction()
 		if (Def->LiftTop)
 			if (Action.Target->y <= (y + Def->LiftTop))
 				if (Action.ComDir == COMD_Up)
-					Call(PSF_LiftTop);
+					Call(C4DefCallback::LiftTop);
 		// General
 		DoGravity(this);
 		break;
@@ -5296,7 +5365,7 @@ void C4Object::ExecAction()
 			if (Status)
 			{
 				SetAction(ActIdle);
-				Call(PSF_AttachTargetLost);
+				Call(C4DefCallback::AttachTargetLost);
 			}
 			return;
 		}
@@ -5321,7 +5390,7 @@ void C4Object::ExecAction()
 				if (Status)
 				{
 					SetAction(ActIdle);
-					Call(PSF_AttachTargetLost);
+					Call(C4DefCallback::AttachTargetLost);
 				}
 				return;
 			}
@@ -5347,7 +5416,7 @@ void C4Object::ExecAction()
 		if (!Action.Target2 || (Action.Target2->Con < FullCon)) fBroke = true;
 		if (fBroke)
 		{
-			Call(PSF_LineBreak, {C4VBool(true)});
+			Call(C4DefCallback::LineBreak, {C4VBool(true)});
 			AssignRemoval();
 			return;
 		}
@@ -5412,7 +5481,7 @@ void C4Object::ExecAction()
 		// Line fBroke
 		if (fBroke)
 		{
-			Call(PSF_LineBreak);
+			Call(C4DefCallback::LineBreak);
 			AssignRemoval();
 			return;
 		}
@@ -5485,11 +5554,11 @@ bool C4Object::SetOwner(int32_t iOwner)
 	if (ValidPlr(Owner))
 	{
 		pPlr = Game.Players.Get(Owner);
-		while (pPlr->FoWViewObjs.Remove(this));
+		pPlr->RemoveFoWViewObj(this);
 	}
 	else
 		for (pPlr = Game.Players.First; pPlr; pPlr = pPlr->Next)
-			while (pPlr->FoWViewObjs.Remove(this));
+			pPlr->RemoveFoWViewObj(this);
 	// set new owner
 	int32_t iOldOwner = Owner;
 	Owner = iOwner;
@@ -5505,7 +5574,7 @@ bool C4Object::SetOwner(int32_t iOwner)
 			Action.Target->Base = Owner;
 		}
 	// script callback
-	Call(PSF_OnOwnerChanged, {C4VInt(Owner), C4VInt(iOldOwner)});
+	Call(C4DefCallback::OnOwnerChanged, {C4VInt(Owner), C4VInt(iOldOwner)});
 	// done
 	return true;
 }
@@ -5528,8 +5597,8 @@ void C4Object::PlrFoWActualize()
 	{
 		// single player's FoW-list
 		pPlr = Game.Players.Get(Owner);
-		while (pPlr->FoWViewObjs.Remove(this));
-		if (PlrViewRange) pPlr->FoWViewObjs.Add(this, C4ObjectList::stNone);
+		pPlr->RemoveFoWViewObj(this);
+		if (PlrViewRange) pPlr->AddFoWViewObj(this);
 	}
 	// no owner?
 	else
@@ -5537,8 +5606,8 @@ void C4Object::PlrFoWActualize()
 		// all players!
 		for (pPlr = Game.Players.First; pPlr; pPlr = pPlr->Next)
 		{
-			while (pPlr->FoWViewObjs.Remove(this));
-			if (PlrViewRange) pPlr->FoWViewObjs.Add(this, C4ObjectList::stNone);
+			pPlr->RemoveFoWViewObj(this);
+			if (PlrViewRange) pPlr->AddFoWViewObj(this);
 		}
 	}
 }
@@ -5682,11 +5751,11 @@ bool C4Object::Collect(C4Object *pObj)
 	// Cancel attach (hacky)
 	ObjectComCancelAttach(pObj);
 	// Container Collection call
-	Call(PSF_Collection, {C4VObj(pObj)});
+	Call(C4DefCallback::Collection, {C4VObj(pObj)});
 	// Object Hit call
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSF_Hit);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSF_Hit2);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSF_Hit3);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(C4DefCallback::Hit);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(C4DefCallback::Hit2);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(C4DefCallback::Hit3);
 	// post-copy the motion of the new container
 	if (pObj->Contained == this) pObj->CopyMotion(this);
 	// done, success
@@ -5796,7 +5865,7 @@ bool C4Object::DoSelect(bool fCursor)
 	// select
 	if (!fCursor) Select = 1;
 	// do callback
-	Call(PSF_CrewSelection, {C4VBool(false), C4VBool(fCursor)});
+	Call(C4DefCallback::CrewSelection, {C4VBool(false), C4VBool(fCursor)});
 	// done
 	return true;
 }
@@ -5806,7 +5875,7 @@ void C4Object::UnSelect(bool fCursor)
 	// unselect
 	if (!fCursor) Select = 0;
 	// do callback
-	Call(PSF_CrewSelection, {C4VBool(true), C4VBool(fCursor)});
+	Call(C4DefCallback::CrewSelection, {C4VBool(true), C4VBool(fCursor)});
 }
 
 void C4Object::GetViewPosPar(int32_t &riX, int32_t &riY, int32_t tx, int32_t ty, const C4Facet &fctViewport)
@@ -5908,6 +5977,7 @@ C4GraphicsOverlay *C4Object::GetGraphicsOverlay(int32_t iForID, bool fCreate)
 	if (!fCreate) return nullptr;
 	C4GraphicsOverlay *pNewOverlay = new C4GraphicsOverlay();
 	pNewOverlay->SetID(iForID);
+	pNewOverlay->SetOwner(this);
 	pNewOverlay->SetNext(pOverlay);
 	if (pPrevOverlay) pPrevOverlay->SetNext(pNewOverlay); else pGfxOverlay = pNewOverlay;
 	// return newly created overlay
@@ -5956,7 +6026,7 @@ bool C4Object::StatusActivate()
 	UpdateGraphics(false);
 	UpdateFace(true);
 	UpdatePos();
-	Call(PSF_UpdateTransferZone);
+	Call(C4DefCallback::UpdateTransferZone);
 	// done, success
 	return true;
 }
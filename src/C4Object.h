@@ -27,7 +27,9 @@
 #include "C4ObjectInfo.h"
 #include "C4Particles.h"
 #include "C4Player.h"
+#include "C4Script.h"
 #include "C4Sector.h"
+#include "C4TrackedObjectPtr.h"
 #include "C4Value.h"
 #include "C4ValueList.h"
 
@@ -101,7 +103,7 @@ public:
 	int32_t Data;
 	int32_t Phase, PhaseDelay;
 	int32_t t_attach; // SyncClearance-NoSave //
-	C4EnumeratedObjectPtr Target, Target2;
+	C4TrackedObjectPtr Target, Target2;
 	C4Facet Facet; // NoSave //
 	int32_t FacetX, FacetY; // NoSave //
 
@@ -119,6 +121,11 @@ class C4Object
 public:
 	C4Object();
 	~C4Object();
+
+	static void *operator new(std::size_t size); // from the object pool
+	static void operator delete(void *ptr, std::size_t size);
+
+	static bool IsAlive(const C4Object *pObj); // whether pObj points to an existing object; for checking wild pointers
 	int32_t Number; // int32_t, for sync safety on all machines
 	C4ID id;
 	int32_t Status; // NoSave //
@@ -160,7 +167,8 @@ public:
 	uint32_t OCF;
 	int32_t Visibility;
 	uint32_t Marker; // state var used by Objects::CrossCheck and C4FindObject - NoSave
-	C4EnumeratedObjectPtr pLayer; // layer-object containing this object
+	int32_t DrawOrder; // position in the main object list, for drawing objects found through the sectors in list order - NoSave
+	C4TrackedObjectPtr pLayer; // layer-object containing this object
 	C4DrawTransform *pDrawTransform; // assigned drawing transformation
 
 	// Menu
@@ -197,6 +205,8 @@ public:
 	StdStrBuf nInfo;
 
 	C4Value *FirstRef; // No-Save
+	C4ObjectLink *FirstLink; // links of all object lists containing this object - No-Save
+	C4TrackedObjectPtr *FirstTrackedPtr; // engine pointers to this object - No-Save
 
 	class C4GraphicsOverlay *pGfxOverlay; // singly linked list of overlay graphics
 
@@ -238,6 +248,7 @@ public:
 
 	bool CallControl(C4Player *pPlr, uint8_t byCom, const C4AulParSet &pPars = C4AulParSet{});
 	C4Value Call(const char *szFunctionCall, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true);
+	C4Value Call(C4DefCallback callback, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true);
 
 	bool ContainedControl(uint8_t byCom);
 
@@ -272,6 +283,9 @@ public:
 	void DrawFace(C4FacetEx &cgo, int32_t cgoX, int32_t cgoY, int32_t iPhaseX = 0, int32_t iPhaseY = 0);
 	void Execute();
 	void ClearPointers(C4Object *ptr);
+#ifdef OBJECTREF_DEBUG
+	bool HasPointersTo(C4Object *pObj); // whether ClearPointers(pObj) would clear anything tracked
+#endif
 	bool ExecMovement();
 	bool ExecFire(int32_t iIndex, int32_t iCausedByPlr);
 	void ExecAction();
@@ -366,6 +380,11 @@ public:
 	int32_t GetAudiblePan();
 	void ResetAudibility() { Audible = -1; AudiblePan = 0; }
 	bool IsVisible(int32_t iForPlr, bool fAsOverlay); // return whether an object is visible for the given player
+	bool FacetExceedsShape(int32_t iMargin) const // return whether the action facet reaches further than iMargin outside the shape
+	{
+		return Action.FacetX < -iMargin || Action.FacetY < -iMargin
+			|| Action.FacetX + Action.Facet.Wdt > Shape.Wdt + iMargin || Action.FacetY + Action.Facet.Hgt > Shape.Hgt + iMargin;
+	}
 	void SetRotation(int32_t nr);
 	void PrepareDrawing(); // set blit modulation and/or additive blitting
 	void FinishedDrawing(); // reset any modulation
@@ -22,8 +22,25 @@
 #include <C4Object.h>
 #include <C4Wrappers.h>
 #include <C4Application.h>
+#include <C4Pool.h>
 
 #include <format>
+#include <utility>
+
+namespace
+{
+	C4Pool LinkPool{"C4ObjectLink", sizeof(C4ObjectLink)};
+}
+
+void *C4ObjectLink::operator new(const std::size_t size)
+{
+	return LinkPool.Allocate(size);
+}
+
+void C4ObjectLink::operator delete(void *const ptr, const std::size_t size)
+{
+	LinkPool.Deallocate(ptr, size);
+}
 
 C4ObjectList::C4ObjectList() : FirstIter(nullptr)
 {
@@ -46,10 +63,12 @@ void C4ObjectList::Clear()
 	C4ObjectLink *cLnk, *nextLnk;
 	for (cLnk = First; cLnk; cLnk = nextLnk)
 	{
-		nextLnk = cLnk->Next; delete cLnk;
+		nextLnk = cLnk->Next; UnchainLink(cLnk); delete cLnk;
 	}
 	First = Last = nullptr;
+	++OrderVersion;
 	pEnumerated.reset();
+	if (pNumberIndex) pNumberIndex->Clear();
 }
 
 const int MaxTempListID = 500;
@@ -130,6 +149,7 @@ bool C4ObjectList::Add(C4Object *nObj, SortType eSort, C4ObjectList *pLstSorted)
 	auto newLink = std::make_unique<C4ObjectLink>();
 	// Set link
 	newLink->Obj = nObj;
+	newLink->List = this;
 
 	// Search insert position (default: end of list)
 	C4ObjectLink *cLnk = nullptr, *cPrev = Last;
@@ -219,7 +239,7 @@ bool C4ObjectList::Add(C4Object *nObj, SortType eSort, C4ObjectList *pLstSorted)
 
 	// Insert new link after predecessor
 	InsertLink(newLink.get(), cPrev);
-	newLink.release();
+	ChainLink(newLink.release());
 
 #ifndef NDEBUG
 	// Debug: Check sort
@@ -239,11 +259,8 @@ bool C4ObjectList::Add(C4Object *nObj, SortType eSort, C4ObjectList *pLstSorted)
 
 bool C4ObjectList::Remove(C4Object *pObj)
 {
-	C4ObjectLink *cLnk;
-
 	// Find link
-	for (cLnk = First; cLnk; cLnk = cLnk->Next)
-		if (cLnk->Obj == pObj) break;
+	C4ObjectLink *const cLnk{GetLink(pObj)};
 	if (!cLnk) return false;
 
 	// Fix iterators
@@ -254,6 +271,7 @@ bool C4ObjectList::Remove(C4Object *pObj)
 
 	// Remove link from list
 	RemoveLink(cLnk);
+	UnchainLink(cLnk);
 
 	// Deallocate link
 	delete cLnk;
@@ -310,9 +328,9 @@ C4Object *C4ObjectList::GetObject(int Index)
 C4ObjectLink *C4ObjectList::GetLink(C4Object *pObj)
 {
 	if (!pObj) return nullptr;
-	C4ObjectLink *cLnk;
-	for (cLnk = First; cLnk; cLnk = cLnk->Next)
-		if (cLnk->Obj == pObj)
+	// objects are in few lists at a time
+	for (C4ObjectLink *cLnk = pObj->FirstLink; cLnk; cLnk = cLnk->ObjNext)
+		if (cLnk->List == this)
 			return cLnk;
 	return nullptr;
 }
@@ -432,21 +450,15 @@ void C4ObjectList::Enumerate()
 
 int32_t C4ObjectList::ObjectNumber(C4Object *pObj)
 {
-	C4ObjectLink *cLnk;
-	if (!pObj) return 0;
-	for (cLnk = First; cLnk; cLnk = cLnk->Next)
-		if (cLnk->Obj == pObj)
-			return cLnk->Obj->Number;
-	return 0;
+	// used to check pointers, so don't touch dead objects
+	if (!C4Object::IsAlive(pObj)) return 0;
+	C4ObjectLink *const cLnk{GetLink(pObj)};
+	return cLnk ? cLnk->Obj->Number : 0;
 }
 
 bool C4ObjectList::IsContained(C4Object *pObj)
 {
-	C4ObjectLink *cLnk;
-	for (cLnk = First; cLnk; cLnk = cLnk->Next)
-		if (cLnk->Obj == pObj)
-			return true;
-	return false;
+	return C4Object::IsAlive(pObj) && GetLink(pObj);
 }
 
 bool C4ObjectList::IsClear() const
@@ -543,6 +555,8 @@ void C4ObjectList::CompileFunc(StdCompiler *pComp, bool fSaveRefs, bool fSkipPla
 
 C4Object *C4ObjectList::ObjectPointer(int32_t iNumber)
 {
+	if (C4Object *pObj; pNumberIndex && pNumberIndex->Find(iNumber, pObj))
+		return pObj;
 	C4ObjectLink *cLnk;
 	for (cLnk = First; cLnk; cLnk = cLnk->Next)
 		if (cLnk->Obj->Number == iNumber)
@@ -550,6 +564,21 @@ C4Object *C4ObjectList::ObjectPointer(int32_t iNumber)
 	return nullptr;
 }
 
+void C4ObjectList::EnableNumberIndex(bool fEnable)
+{
+	if (!fEnable)
+	{
+		pNumberIndex.reset();
+		return;
+	}
+	if (!pNumberIndex)
+		pNumberIndex = std::make_unique<C4ObjectNumberIndex>();
+	else
+		pNumberIndex->Clear();
+	for (C4ObjectLink *cLnk = First; cLnk; cLnk = cLnk->Next)
+		pNumberIndex->Add(cLnk->Obj->Number, cLnk->Obj);
+}
+
 C4Object *C4ObjectList::SafeObjectPointer(int32_t iNumber)
 {
 	C4Object *pObj = ObjectPointer(iNumber);
@@ -615,6 +644,49 @@ void C4ObjectList::RemoveLink(C4ObjectLink *pLnk)
 {
 	if (pLnk->Prev) pLnk->Prev->Next = pLnk->Next; else First = pLnk->Next;
 	if (pLnk->Next) pLnk->Next->Prev = pLnk->Prev; else Last = pLnk->Prev;
+	++OrderVersion;
+	if (pNumberIndex) pNumberIndex->Remove(pLnk->Obj->Number, pLnk->Obj);
+}
+
+void C4ObjectList::IndexLink(C4ObjectLink *pLnk)
+{
+	if (pNumberIndex) pNumberIndex->Add(pLnk->Obj->Number, pLnk->Obj);
+}
+
+void C4ObjectList::ChainLink(C4ObjectLink *pLnk)
+{
+	C4Object *const pObj{pLnk->Obj};
+	if ((pLnk->ObjNext = pObj->FirstLink)) pLnk->ObjNext->ObjPrevNext = &pLnk->ObjNext;
+	pLnk->ObjPrevNext = &pObj->FirstLink;
+	pObj->FirstLink = pLnk;
+}
+
+void C4ObjectList::UnchainLink(C4ObjectLink *pLnk)
+{
+	// object already deleted?
+	if (!pLnk->ObjPrevNext) return;
+	if ((*pLnk->ObjPrevNext = pLnk->ObjNext)) pLnk->ObjNext->ObjPrevNext = pLnk->ObjPrevNext;
+	pLnk->ObjNext = nullptr; pLnk->ObjPrevNext = nullptr;
+}
+
+void C4ObjectList::SwapLinkObjects(C4ObjectLink *const pLnk1, C4ObjectLink *const pLnk2)
+{
+	// the links must stay chained to the objects they hold
+	UnchainLink(pLnk1); UnchainLink(pLnk2);
+	std::swap(pLnk1->Obj, pLnk2->Obj);
+	ChainLink(pLnk1); ChainLink(pLnk2);
+	++OrderVersion;
+}
+
+void C4ObjectList::DetachLinks(C4Object *pObj)
+{
+	C4ObjectLink *pLnk{pObj->FirstLink}, *pNext;
+	for (; pLnk; pLnk = pNext)
+	{
+		pNext = pLnk->ObjNext;
+		pLnk->ObjNext = nullptr; pLnk->ObjPrevNext = nullptr;
+	}
+	pObj->FirstLink = nullptr;
 }
 
 void C4ObjectList::InsertLink(C4ObjectLink *pLnk, C4ObjectLink *pAfter)
@@ -633,6 +705,8 @@ void C4ObjectList::InsertLink(C4ObjectLink *pLnk, C4ObjectLink *pAfter)
 		if (First) First->Prev = pLnk; else Last = pLnk;
 		First = pLnk;
 	}
+	++OrderVersion;
+	IndexLink(pLnk);
 }
 
 void C4ObjectList::InsertLinkBefore(C4ObjectLink *pLnk, C4ObjectLink *pBefore)
@@ -651,6 +725,8 @@ void C4ObjectList::InsertLinkBefore(C4ObjectLink *pLnk, C4ObjectLink *pBefore)
 		if (Last) Last->Next = pLnk; else First = pLnk;
 		Last = pLnk;
 	}
+	++OrderVersion;
+	IndexLink(pLnk);
 }
 
 void C4NotifyingObjectList::InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore)
@@ -727,15 +803,17 @@ void C4ObjectList::Copy(const C4ObjectList &rList)
 void C4ObjectList::Default()
 {
 	First = Last = nullptr;
+	++OrderVersion;
 	Mass = 0;
 	pEnumerated.reset();
+	if (pNumberIndex) pNumberIndex->Clear();
 }
 
 void C4ObjectList::UpdateTransferZones()
 {
 	C4Object *cobj; C4ObjectLink *clnk;
 	for (clnk = First; clnk && (cobj = clnk->Obj); clnk = clnk->Next)
-		cobj->Call(PSF_UpdateTransferZone);
+		cobj->Call(C4DefCallback::UpdateTransferZone);
 }
 
 void C4ObjectList::ResetAudibility()
@@ -785,6 +863,7 @@ bool C4ObjectList::OrderObjectBefore(C4Object *pObj1, C4Object *pObj2)
 	// relink into new one
 	if (pLnk1->Prev = pLnk2->Prev) pLnk2->Prev->Next = pLnk1; else First = pLnk1;
 	pLnk1->Next = pLnk2; pLnk2->Prev = pLnk1;
+	++OrderVersion;
 	// done, success
 	return true;
 }
@@ -808,6 +887,7 @@ bool C4ObjectList::OrderObjectAfter(C4Object *pObj1, C4Object *pObj2)
 	// relink into new one
 	if (pLnk1->Next = pLnk2->Next) pLnk2->Next->Prev = pLnk1; else Last = pLnk1;
 	pLnk1->Prev = pLnk2; pLnk2->Next = pLnk1;
+	++OrderVersion;
 	// done, success
 	return true;
 }
@@ -827,6 +907,7 @@ bool C4ObjectList::ShiftContents(C4Object *pNewFirst)
 	Last = pNewFirstLnk->Prev;
 	// 3. Uncycle list
 	First->Prev = Last->Next = nullptr;
+	++OrderVersion;
 	// done, success
 	return true;
 }
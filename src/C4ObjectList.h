@@ -24,6 +24,7 @@
 #include "C4Id.h"
 #include "C4Def.h"
 #include "C4ObjectInfo.h"
+#include "C4ObjectNumberIndex.h"
 #include "C4Region.h"
 
 class C4Object;
@@ -38,11 +39,21 @@ class C4ObjectLink
 public:
 	C4Object *Obj;
 	C4ObjectLink *Prev, *Next;
+
+	// chain of all links of Obj, so a list finds its link without walking itself
+	C4ObjectList *List;
+	C4ObjectLink *ObjNext;
+	C4ObjectLink **ObjPrevNext; // nullptr if not (or no longer) chained to Obj
+
+	static void *operator new(std::size_t size); // from the link pool
+	static void operator delete(void *ptr, std::size_t size);
 };
 
 class C4ObjectList
 {
 	std::unique_ptr<std::vector<int32_t>> pEnumerated;
+	std::unique_ptr<C4ObjectNumberIndex> pNumberIndex; // for ObjectPointer, if enabled
+	uint32_t OrderVersion{0}; // changes whenever links are added, removed or reordered
 
 public:
 	C4ObjectList();
@@ -115,20 +126,22 @@ public:
 	bool DenumerateRead();
 	void CompileFunc(StdCompiler *pComp, bool fSaveRefs = true, bool fSkipPlayerObjects = false);
 
-	int32_t ObjectNumber(C4Object *pObj);
-	bool IsContained(C4Object *pObj);
+	int32_t ObjectNumber(C4Object *pObj); // pObj may be a wild pointer
+	bool IsContained(C4Object *pObj); // pObj may be a wild pointer
 	int ClearPointers(C4Object *pObj);
 	int ObjectCount(C4ID id = C4ID_None, int32_t dwCategory = C4D_All) const;
 	int MassCount();
 	int ListIDCount(int32_t dwCategory);
 
 	virtual C4Object *ObjectPointer(int32_t iNumber);
+	void EnableNumberIndex(bool fEnable); // index objects by number for ObjectPointer; rebuilds the index. Objects must not be renumbered while indexed.
 	C4Object *SafeObjectPointer(int32_t iNumber);
 	C4Object *GetObject(int Index = 0);
 	C4Object *Find(C4ID id, int iOwner = ANY_OWNER, uint32_t dwOCF = OCF_All);
 	C4Object *FindOther(C4ID id, int iOwner = ANY_OWNER);
 
-	C4ObjectLink *GetLink(C4Object *pObj);
+	C4ObjectLink *GetLink(C4Object *pObj); // pObj must be a living object (or nullptr)
+	uint32_t GetOrderVersion() const { return OrderVersion; }
 
 	C4ID GetListID(int32_t dwCategory, int Index);
 
@@ -141,6 +154,8 @@ public:
 
 	void UpdateScriptPointers(); // update pointers to C4AulScript *
 
+	static void DetachLinks(C4Object *pObj); // object is being deleted: unchain all links still pointing to it
+
 	bool CheckSort(C4ObjectList *pList); // check that all objects of this list appear in the other list in the same order
 	void CheckCategorySort(); // assertwhether sorting by category is done right
 
@@ -148,6 +163,10 @@ protected:
 	virtual void InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore);
 	virtual void InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter);
 	virtual void RemoveLink(C4ObjectLink *pLnk);
+	void IndexLink(C4ObjectLink *pLnk);
+	static void ChainLink(C4ObjectLink *pLnk);
+	static void UnchainLink(C4ObjectLink *pLnk);
+	void SwapLinkObjects(C4ObjectLink *pLnk1, C4ObjectLink *pLnk2); // exchange the objects of two links of this list
 	iterator *FirstIter;
 	iterator *AddIter(iterator *iter);
 	void RemoveIter(iterator *iter);
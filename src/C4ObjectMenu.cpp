@@ -26,24 +26,40 @@
 #include <C4Player.h>
 #include <C4Viewport.h>
 
+#include <algorithm>
 #include <cassert>
 #include <format>
+#include <vector>
+
+namespace
+{
+	// object menus hold untracked object pointers, so they are cleared directly on object removal
+	std::vector<C4ObjectMenu *> ObjectMenus;
+}
 
 // C4ObjectMenu
 
 C4ObjectMenu::C4ObjectMenu() : C4Menu()
 {
 	Default();
+	ObjectMenus.push_back(this);
 }
 
 C4ObjectMenu::~C4ObjectMenu()
 {
+	std::erase(ObjectMenus, this);
 	if (ClearObjectPtr)
 	{
 		*ClearObjectPtr = nullptr;
 	}
 }
 
+void C4ObjectMenu::ClearPointersInAll(C4Object *pObj)
+{
+	for (C4ObjectMenu *const pMenu : ObjectMenus)
+		pMenu->ClearPointers(pObj);
+}
+
 void C4ObjectMenu::Default()
 {
 	C4Menu::Default();
@@ -64,7 +80,7 @@ bool C4ObjectMenu::IsCloseDenied()
 		C4AulParSet pars(C4VInt(Selection), C4VObj(ParentObject));
 		if (eCallbackType == CB_Object)
 		{
-			if (Object) fResult = static_cast<bool>(Object->Call(PSF_MenuQueryCancel, pars));
+			if (Object) fResult = static_cast<bool>(Object->Call(C4DefCallback::MenuQueryCancel, pars));
 		}
 		else if (eCallbackType == CB_Scenario)
 			fResult = static_cast<bool>(Game.Script.Call(PSF_MenuQueryCancel, pars));
@@ -97,7 +113,7 @@ void C4ObjectMenu::OnSelectionChanged(int32_t iNewSelection)
 	{
 		C4AulParSet pars(C4VInt(iNewSelection), C4VObj(ParentObject));
 		if (eCallbackType == CB_Object && Object)
-			Object->Call(PSF_MenuSelection, pars);
+			Object->Call(C4DefCallback::MenuSelection, pars);
 		else if (eCallbackType == CB_Scenario)
 			Game.Script.Call(PSF_MenuSelection, pars);
 	}
@@ -303,7 +319,7 @@ bool C4ObjectMenu::DoRefillInternal(bool &rfRefilled)
 				if (Identification == C4MN_Contents)
 				{
 					if (Object && Object->Def->CollectionLimit && (Object->Contents.ObjectCount() >= Object->Def->CollectionLimit)) fGet = false; // collection limit reached
-					if (Object && Object->Call(PSF_RejectCollection, {C4VID(pObj->Def->id), C4VObj(pObj)})) fGet = false; // collection rejected
+					if (Object && Object->Call(C4DefCallback::RejectCollection, {C4VID(pObj->Def->id), C4VObj(pObj)})) fGet = false; // collection rejected
 				}
 				if (!(pTarget->OCF & OCF_Entrance)) fGet = true; // target object has no entrance: cannot activate - force get
 				// Caption
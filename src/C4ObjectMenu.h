@@ -70,6 +70,7 @@ protected:
 public:
 	void SetRefillObject(C4Object *pObj);
 	void ClearPointers(C4Object *pObj);
+	static void ClearPointersInAll(C4Object *pObj);
 	bool Init(C4FacetExSurface &fctSymbol, const char *szEmpty, C4Object *pObject, int32_t iExtra = C4MN_Extra_None, int32_t iExtraData = 0, int32_t iId = 0, int32_t iStyle = C4MN_Style_Normal, bool fUserMenu = false);
 	void Execute();
 
@@ -0,0 +1,64 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// object number -> object index of a C4ObjectList
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+
+class C4Object;
+
+// Objects of a list may share a number, for example while a savegame is loaded. The list returns the first of them
+// in list order, which the index cannot tell, so lookups are left to the list as long as any number is shared.
+class C4ObjectNumberIndex
+{
+	std::unordered_map<int32_t, C4Object *> Objects;
+	int32_t Collisions{0}; // objects that were not indexed, as their number was taken already
+
+public:
+	void Clear()
+	{
+		Objects.clear();
+		Collisions = 0;
+	}
+
+	void Add(const int32_t iNumber, C4Object *const pObj)
+	{
+		if (!Objects.try_emplace(iNumber, pObj).second)
+			++Collisions;
+	}
+
+	void Remove(const int32_t iNumber, C4Object *const pObj)
+	{
+		if (const auto it = Objects.find(iNumber); it != Objects.end() && it->second == pObj)
+			Objects.erase(it);
+		else if (Collisions)
+			--Collisions;
+	}
+
+	// false if the list has to be searched instead
+	bool Find(const int32_t iNumber, C4Object *&rpObj) const
+	{
+		if (Collisions) return false;
+		const auto it = Objects.find(iNumber);
+		rpObj = (it != Objects.end() ? it->second : nullptr);
+		return true;
+	}
+
+	int32_t GetCollisions() const { return Collisions; }
+	std::size_t GetSize() const { return Objects.size(); }
+};
@@ -39,13 +39,25 @@
    SetCompletePath don't set move-to waypoint if setting use-zone waypoint (is
    done by C4Command::Transfer on demand and would only cause no-good-entry-point
    move-to's on crawl-zone-entries).
+
+   Find first asks the cached navigation graph (C4PathFinderGraph) and only
+   launches rays if the graph has no path or its path crosses a transfer zone.
 */
 
 #include <C4Include.h>
 #include <C4PathFinder.h>
 
+#include <C4Application.h>
 #include <C4FacetEx.h>
 #include <C4Game.h>
+#include <C4Stat.h>
+#include <C4Wrappers.h>
+
+#include <chrono>
+#include <format>
+#include <functional>
+#include <queue>
+#include <unordered_map>
 
 const int32_t C4PF_MaxDepth  = 35,
               C4PF_MaxCrawl  = 800,
@@ -68,7 +80,10 @@ const int32_t C4PF_MaxDepth  = 35,
               C4PF_Crawl_Bottom   = 3,
               C4PF_Crawl_Left     = 4,
 
-              C4PF_Draw_Rate = 10;
+              C4PF_Draw_Rate = 10,
+
+              C4PF_Graph_MaxNodes = 1000, // node expansions per pathfinder level
+              C4PF_Graph_ProbeNodes = 100; // nodes explored around the target per pathfinder level, to find closed pockets early
 
 // C4PathFinderRay
 
@@ -510,6 +525,440 @@ bool C4PathFinderRay::CheckBackRayShorten()
 	return false;
 }
 
+// C4PathFinderGraph
+
+void C4PathFinderGraph::Clear()
+{
+	Width = Height = TilesX = TilesY = 0;
+	Tiles.clear();
+}
+
+void C4PathFinderGraph::Prepare()
+{
+	// (Re)create tiles for the current landscape size
+	if (Width == GBackWdt && Height == GBackHgt) return;
+	Width = GBackWdt; Height = GBackHgt;
+	TilesX = (Width + TileSize - 1) / TileSize;
+	TilesY = (Height + TileSize - 1) / TileSize;
+	Tiles.assign(TilesX * TilesY, Tile{});
+}
+
+void C4PathFinderGraph::InvalidateRect(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt)
+{
+	if (Tiles.empty()) return;
+	// Pixels next to a tile border change the portals of the neighbouring tile, too
+	const int32_t x1{std::max<int32_t>(iX - 1, 0)}, y1{std::max<int32_t>(iY - 1, 0)};
+	const int32_t x2{std::min<int32_t>(iX + iWdt, Width - 1)}, y2{std::min<int32_t>(iY + iHgt, Height - 1)};
+	if (x1 > x2 || y1 > y2) return;
+	for (int32_t ty = y1 / TileSize; ty <= y2 / TileSize; ++ty)
+		for (int32_t tx = x1 / TileSize; tx <= x2 / TileSize; ++tx)
+		{
+			Tile &tile{Tiles[ty * TilesX + tx]};
+			tile.BordersValid = tile.EdgesValid = false;
+		}
+}
+
+void C4PathFinderGraph::GetNodePos(std::int64_t iNode, int32_t &rX, int32_t &rY) const
+{
+	const std::int64_t pos{iNode / 2};
+	rX = static_cast<int32_t>(pos % Width);
+	rY = static_cast<int32_t>(pos / Width);
+}
+
+void C4PathFinderGraph::GetNodeTiles(std::int64_t iNode, int32_t &rTile1, int32_t &rTile2) const
+{
+	// Nodes are stored at the pixel left of/above the border
+	int32_t x, y; GetNodePos(iNode, x, y);
+	rTile1 = GetTile(x, y);
+	rTile2 = (iNode & 1) ? rTile1 + 1 : rTile1 + TilesX;
+}
+
+void C4PathFinderGraph::GetTileRect(int32_t iTile, int32_t &rX, int32_t &rY, int32_t &rWdt, int32_t &rHgt) const
+{
+	rX = (iTile % TilesX) * TileSize; rY = (iTile / TilesX) * TileSize;
+	rWdt = std::min<int32_t>(TileSize, Width - rX);
+	rHgt = std::min<int32_t>(TileSize, Height - rY);
+}
+
+void C4PathFinderGraph::BuildBorders(int32_t iTile)
+{
+	Tile &tile{Tiles[iTile]};
+	if (tile.BordersValid) return;
+	tile.RightPortals.clear();
+	tile.BottomPortals.clear();
+	int32_t x, y, wdt, hgt; GetTileRect(iTile, x, y, wdt, hgt);
+	// Right border: one portal per run of free pixel pairs, at the lowest pair (where walkers stand)
+	if (x + wdt < Width)
+	{
+		const int32_t x0{x + wdt - 1};
+		bool fRun{false};
+		for (int32_t i = y; i <= y + hgt; ++i)
+		{
+			const bool fFree{i < y + hgt && pPathFinder->PointFree(x0, i) && pPathFinder->PointFree(x0 + 1, i)};
+			if (fRun && !fFree) tile.RightPortals.push_back(i - 1);
+			fRun = fFree;
+		}
+	}
+	// Bottom border: one portal per run of free pixel pairs, in the middle of the run
+	if (y + hgt < Height)
+	{
+		const int32_t y0{y + hgt - 1};
+		int32_t iRunStart{-1};
+		for (int32_t i = x; i <= x + wdt; ++i)
+		{
+			const bool fFree{i < x + wdt && pPathFinder->PointFree(i, y0) && pPathFinder->PointFree(i, y0 + 1)};
+			if (fFree && iRunStart < 0) iRunStart = i;
+			if (!fFree && iRunStart >= 0)
+			{
+				tile.BottomPortals.push_back((iRunStart + i - 1) / 2);
+				iRunStart = -1;
+			}
+		}
+	}
+	tile.BordersValid = true;
+}
+
+C4PathFinderGraph::Tile &C4PathFinderGraph::GetTileEdges(int32_t iTile)
+{
+	Tile &tile{Tiles[iTile]};
+	if (tile.EdgesValid) return tile;
+	int32_t x, y, wdt, hgt; GetTileRect(iTile, x, y, wdt, hgt);
+	// Collect portals in fixed order: top, left, right, bottom
+	BuildBorders(iTile);
+	tile.Ports.clear();
+	if (y > 0)
+	{
+		BuildBorders(iTile - TilesX);
+		for (const int32_t px : Tiles[iTile - TilesX].BottomPortals)
+			tile.Ports.push_back({GetNode(px, y - 1, false), px, y, 1});
+	}
+	if (x > 0)
+	{
+		BuildBorders(iTile - 1);
+		for (const int32_t py : Tiles[iTile - 1].RightPortals)
+			tile.Ports.push_back({GetNode(x - 1, py, true), x, py, 1});
+	}
+	for (const int32_t py : tile.RightPortals)
+		tile.Ports.push_back({GetNode(x + wdt - 1, py, true), x + wdt - 1, py, 0});
+	for (const int32_t px : tile.BottomPortals)
+		tile.Ports.push_back({GetNode(px, y + hgt - 1, false), px, y + hgt - 1, 0});
+	// Crawl distances between all portals
+	const std::size_t count{tile.Ports.size()};
+	tile.Costs.assign(count * count, -1);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		CrawlTile(iTile, tile.Ports[i].X, tile.Ports[i].Y);
+		for (std::size_t j = 0; j < count; ++j)
+			if (const int32_t iDist{GetCrawlDistance(iTile, tile.Ports[j].X, tile.Ports[j].Y)}; iDist >= 0)
+				tile.Costs[i * count + j] = tile.Ports[i].Enter + iDist + tile.Ports[j].Enter;
+	}
+	tile.EdgesValid = true;
+	++pPathFinder->FrameStats.TilesBuilt;
+	return tile;
+}
+
+void C4PathFinderGraph::CrawlTile(int32_t iTile, int32_t iFromX, int32_t iFromY)
+{
+	int32_t x, y, wdt, hgt; GetTileRect(iTile, x, y, wdt, hgt);
+	// Free pixel map
+	FreeMap.resize(wdt * hgt);
+	for (int32_t py = 0; py < hgt; ++py)
+		for (int32_t px = 0; px < wdt; ++px)
+			FreeMap[py * wdt + px] = pPathFinder->PointFree(x + px, y + py);
+	// Breadth-first crawl from the given pixel
+	Distance.assign(wdt * hgt, -1);
+	Queue.clear();
+	const int32_t iStart{(iFromY - y) * wdt + iFromX - x};
+	if (!FreeMap[iStart]) return;
+	Distance[iStart] = 0;
+	Queue.push_back(iStart);
+	for (std::size_t i = 0; i < Queue.size(); ++i)
+	{
+		const int32_t pos{Queue[i]}, px{pos % wdt}, py{pos / wdt}, iDist{Distance[pos] + 1};
+		const auto visit = [&](const int32_t next)
+		{
+			if (FreeMap[next] && Distance[next] < 0)
+			{
+				Distance[next] = iDist;
+				Queue.push_back(next);
+			}
+		};
+		if (px > 0) visit(pos - 1);
+		if (px < wdt - 1) visit(pos + 1);
+		if (py > 0) visit(pos - wdt);
+		if (py < hgt - 1) visit(pos + wdt);
+	}
+}
+
+int32_t C4PathFinderGraph::GetCrawlDistance(int32_t iTile, int32_t iX, int32_t iY) const
+{
+	int32_t x, y, wdt, hgt; GetTileRect(iTile, x, y, wdt, hgt);
+	return Distance[(iY - y) * wdt + iX - x];
+}
+
+bool C4PathFinderGraph::TraceCrawl(int32_t iTile, int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, std::vector<int32_t> &rPath)
+{
+	// Crawl from the target, then follow decreasing distances from the start
+	CrawlTile(iTile, iToX, iToY);
+	int32_t x, y, wdt, hgt; GetTileRect(iTile, x, y, wdt, hgt);
+	int32_t px{iFromX - x}, py{iFromY - y};
+	int32_t iDist{Distance[py * wdt + px]};
+	if (iDist < 0) return false;
+	static constexpr int32_t DirX[4]{-1, +1, 0, 0}, DirY[4]{0, 0, -1, +1};
+	int32_t iDir{-1};
+	while (iDist > 0)
+	{
+		// Keep the direction if possible, so only corners become waypoints
+		int32_t iNewDir{-1};
+		for (int32_t i = -1; i < 4 && iNewDir < 0; ++i)
+		{
+			const int32_t d{i < 0 ? iDir : i};
+			if (d < 0) continue;
+			const int32_t nx{px + DirX[d]}, ny{py + DirY[d]};
+			if (Inside<int32_t>(nx, 0, wdt - 1) && Inside<int32_t>(ny, 0, hgt - 1) && Distance[ny * wdt + nx] == iDist - 1)
+				iNewDir = d;
+		}
+		assert(iNewDir >= 0);
+		if (iDir >= 0 && iNewDir != iDir)
+		{
+			rPath.push_back(x + px); rPath.push_back(y + py);
+		}
+		iDir = iNewDir;
+		px += DirX[iDir]; py += DirY[iDir];
+		--iDist;
+	}
+	rPath.push_back(iToX); rPath.push_back(iToY);
+	return true;
+}
+
+bool C4PathFinderGraph::LineFree(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool &rfZoneHit)
+{
+	C4TransferZones *const pZones{pPathFinder->TransferZonesEnabled ? pPathFinder->TransferZones : nullptr};
+	const int32_t dx{Abs(iToX - iFromX)}, dy{-Abs(iToY - iFromY)};
+	const int32_t sx{iFromX < iToX ? +1 : -1}, sy{iFromY < iToY ? +1 : -1};
+	int32_t iErr{dx + dy}, x{iFromX}, y{iFromY};
+	for (;;)
+	{
+		if (!pPathFinder->PointFree(x, y)) return false;
+		if (pZones && pZones->Find(x, y)) rfZoneHit = true;
+		if (x == iToX && y == iToY) return true;
+		const int32_t iErr2{2 * iErr};
+		if (iErr2 >= dy) { iErr += dy; x += sx; }
+		if (iErr2 <= dx) { iErr += dx; y += sy; }
+	}
+}
+
+bool C4PathFinderGraph::IsSeparated(const std::vector<std::int64_t> &from, const std::vector<std::int64_t> &to, int32_t iMaxNodes)
+{
+	// explore the component breadth-first; it is complete if it runs out of nodes before the limit
+	std::vector<std::int64_t> component{from}, queue{from};
+	std::sort(component.begin(), component.end());
+	for (std::size_t i = 0; i < queue.size(); ++i)
+	{
+		const std::int64_t iNode{queue[i]};
+		if (std::find(to.begin(), to.end(), iNode) != to.end()) return false;
+		if (static_cast<int32_t>(i) >= iMaxNodes) return false;
+		int32_t tiles[2]; GetNodeTiles(iNode, tiles[0], tiles[1]);
+		for (const int32_t iTile : tiles)
+		{
+			const Tile &tile{GetTileEdges(iTile)};
+			const std::size_t count{tile.Ports.size()};
+			const std::size_t j{static_cast<std::size_t>(std::find_if(tile.Ports.begin(), tile.Ports.end(), [iNode](const Port &port) { return port.Node == iNode; }) - tile.Ports.begin())};
+			assert(j < count);
+			for (std::size_t k = 0; k < count; ++k)
+				if (k != j && tile.Costs[j * count + k] >= 0)
+				{
+					const std::int64_t iNext{tile.Ports[k].Node};
+					const auto it = std::lower_bound(component.begin(), component.end(), iNext);
+					if (it != component.end() && *it == iNext) continue;
+					component.insert(it, iNext);
+					queue.push_back(iNext);
+				}
+		}
+	}
+	return true;
+}
+
+bool C4PathFinderGraph::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iMaxNodes, std::vector<int32_t> &rPath, bool &rfZoneHit, bool &rfUnreachable)
+{
+	rPath.clear();
+	rfZoneHit = false;
+	rfUnreachable = false;
+	Prepare();
+	if (Tiles.empty()) return false;
+
+	constexpr std::int64_t StartNode{-1}, GoalNode{-2};
+	const int32_t iStartTile{GetTile(iFromX, iFromY)}, iGoalTile{GetTile(iToX, iToY)};
+
+	// Connect start and target to the portals of their tiles
+	std::vector<std::pair<std::int64_t, int32_t>> startEdges, goalEdges;
+	int32_t iDirect{-1};
+	{
+		const Tile &tile{GetTileEdges(iStartTile)};
+		CrawlTile(iStartTile, iFromX, iFromY);
+		for (const auto &port : tile.Ports)
+			if (const int32_t iDist{GetCrawlDistance(iStartTile, port.X, port.Y)}; iDist >= 0)
+				startEdges.emplace_back(port.Node, iDist + port.Enter);
+		if (iGoalTile == iStartTile) iDirect = GetCrawlDistance(iStartTile, iToX, iToY);
+	}
+	{
+		const Tile &tile{GetTileEdges(iGoalTile)};
+		CrawlTile(iGoalTile, iToX, iToY);
+		for (const auto &port : tile.Ports)
+			if (const int32_t iDist{GetCrawlDistance(iGoalTile, port.X, port.Y)}; iDist >= 0)
+				goalEdges.emplace_back(port.Node, iDist + port.Enter);
+	}
+
+	// Fail fast if start and target are in different parts of the landscape. Nothing of this is kept
+	// between queries, so the answer only depends on the landscape and the pathfinder level, which
+	// are the same for all clients, no matter when they joined.
+	if (iDirect < 0)
+	{
+		std::vector<std::int64_t> startNodes, goalNodes;
+		for (const auto &edge : startEdges) startNodes.push_back(edge.first);
+		for (const auto &edge : goalEdges) goalNodes.push_back(edge.first);
+		// A closed pocket around the target is the common case, so look there first; a pocket
+		// around the start is found by the search itself.
+		if (startNodes.empty() || goalNodes.empty()
+			|| IsSeparated(goalNodes, startNodes, C4PF_Graph_ProbeNodes * iMaxNodes / C4PF_Graph_MaxNodes))
+		{
+			rfUnreachable = true;
+			return false;
+		}
+	}
+
+	// A* over the portals; ties are broken by node, so the result only depends on the landscape
+	struct NodeState
+	{
+		int32_t Cost;
+		std::int64_t Parent;
+		int32_t ParentTile; // tile crossed to reach this node
+		bool Closed;
+	};
+	std::unordered_map<std::int64_t, NodeState> nodes;
+	using OpenEntry = std::pair<int32_t, std::int64_t>;
+	std::priority_queue<OpenEntry, std::vector<OpenEntry>, std::greater<>> open;
+	const auto relax = [&](const std::int64_t iNode, const int32_t iCost, const std::int64_t iParent, const int32_t iTile)
+	{
+		const auto [it, fInserted] = nodes.try_emplace(iNode, NodeState{iCost, iParent, iTile, false});
+		if (!fInserted)
+		{
+			if (it->second.Closed || it->second.Cost <= iCost) return;
+			it->second = {iCost, iParent, iTile, false};
+		}
+		int32_t iEstimate{0};
+		if (iNode != GoalNode)
+		{
+			int32_t x, y; GetNodePos(iNode, x, y);
+			iEstimate = Abs(x - iToX) + Abs(y - iToY);
+		}
+		open.emplace(iCost + iEstimate, iNode);
+	};
+
+	nodes.try_emplace(StartNode, NodeState{0, StartNode, iStartTile, true});
+	if (iDirect >= 0) relax(GoalNode, iDirect, StartNode, iStartTile);
+	for (const auto &[iNode, iCost] : startEdges) relax(iNode, iCost, StartNode, iStartTile);
+
+	bool fFound{false}, fOutOfNodes{false};
+	int32_t iExpanded{0};
+	while (!open.empty())
+	{
+		const std::int64_t iNode{open.top().second};
+		open.pop();
+		NodeState &state{nodes.at(iNode)};
+		if (state.Closed) continue;
+		state.Closed = true;
+		if (iNode == GoalNode) { fFound = true; break; }
+		if (++iExpanded > iMaxNodes) { fOutOfNodes = true; break; }
+		const int32_t iCost{state.Cost};
+
+		int32_t tiles[2]; GetNodeTiles(iNode, tiles[0], tiles[1]);
+		for (const int32_t iTile : tiles)
+		{
+			const Tile &tile{GetTileEdges(iTile)};
+			const std::size_t count{tile.Ports.size()};
+			const auto port = std::find_if(tile.Ports.begin(), tile.Ports.end(), [iNode](const Port &port) { return port.Node == iNode; });
+			assert(port != tile.Ports.end());
+			const std::size_t i{static_cast<std::size_t>(port - tile.Ports.begin())};
+			for (std::size_t j = 0; j < count; ++j)
+				if (j != i && tile.Costs[i * count + j] >= 0)
+					relax(tile.Ports[j].Node, iCost + tile.Costs[i * count + j], iNode, iTile);
+			if (iTile == iGoalTile)
+				for (const auto &[iGoalEdgeNode, iGoalEdgeCost] : goalEdges)
+					if (iGoalEdgeNode == iNode)
+						relax(GoalNode, iCost + iGoalEdgeCost, iNode, iTile);
+		}
+	}
+	if (!fFound)
+	{
+		// Nothing left to search: all nodes reachable from the start have been visited
+		if (!fOutOfNodes) rfUnreachable = true;
+		return false;
+	}
+
+	// Collect nodes from the start
+	std::vector<std::int64_t> route;
+	for (std::int64_t iNode = GoalNode; iNode != StartNode; iNode = nodes.at(iNode).Parent)
+		route.push_back(iNode);
+	std::reverse(route.begin(), route.end());
+
+	// Expand to a pixel path of free straight segments
+	std::vector<int32_t> points{iFromX, iFromY};
+	const auto getLocal = [&](const std::int64_t iNode, const int32_t iTile, int32_t &rX, int32_t &rY)
+	{
+		if (iNode == StartNode) { rX = iFromX; rY = iFromY; return; }
+		if (iNode == GoalNode) { rX = iToX; rY = iToY; return; }
+		for (const auto &port : Tiles[iTile].Ports)
+			if (port.Node == iNode) { rX = port.X; rY = port.Y; return; }
+		assert(false);
+	};
+	std::int64_t iPrev{StartNode};
+	for (const std::int64_t iNode : route)
+	{
+		const int32_t iTile{nodes.at(iNode).ParentTile};
+		int32_t iPrevX, iPrevY, x, y;
+		getLocal(iPrev, iTile, iPrevX, iPrevY);
+		getLocal(iNode, iTile, x, y);
+		// Step into the tile
+		if (iPrevX != points[points.size() - 2] || iPrevY != points.back())
+		{
+			points.push_back(iPrevX); points.push_back(iPrevY);
+		}
+		bool fZoneHit{false};
+		if (!LineFree(iPrevX, iPrevY, x, y, fZoneHit))
+			if (!TraceCrawl(iTile, iPrevX, iPrevY, x, y, points))
+				return false;
+		if (points[points.size() - 2] != x || points.back() != y)
+		{
+			points.push_back(x); points.push_back(y);
+		}
+		// Step out of the tile to the node pixel
+		if (iNode != GoalNode)
+		{
+			int32_t iNodeX, iNodeY; GetNodePos(iNode, iNodeX, iNodeY);
+			if (iNodeX != x || iNodeY != y)
+			{
+				points.push_back(iNodeX); points.push_back(iNodeY);
+			}
+		}
+		iPrev = iNode;
+	}
+
+	// Shorten: skip points as long as the line stays free
+	const std::size_t count{points.size() / 2};
+	rPath.push_back(iFromX); rPath.push_back(iFromY);
+	for (std::size_t i = 0; i + 1 < count;)
+	{
+		std::size_t j{i + 1};
+		bool fIgnore{false};
+		while (j + 1 < count && LineFree(points[2 * i], points[2 * i + 1], points[2 * j + 2], points[2 * j + 3], fIgnore)) ++j;
+		LineFree(points[2 * i], points[2 * i + 1], points[2 * j], points[2 * j + 1], rfZoneHit);
+		rPath.push_back(points[2 * j]); rPath.push_back(points[2 * j + 1]);
+		i = j;
+	}
+	return true;
+}
+
 // C4PathFinder
 
 C4PathFinder::C4PathFinder()
@@ -532,6 +981,10 @@ void C4PathFinder::Default()
 	TransferZones = nullptr;
 	TransferZonesEnabled = true;
 	Level = 1;
+	Graph.pPathFinder = this;
+	Graph.Clear();
+	GraphPath.clear();
+	FrameStats = LastFrameStats = {};
 }
 
 void C4PathFinder::Clear()
@@ -546,6 +999,7 @@ void C4PathFinder::Init(bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *p
 	// Set data
 	PointFree = fnPointFree;
 	TransferZones = pTransferZones;
+	Graph.Clear();
 }
 
 void C4PathFinder::EnableTransferZones(bool fEnabled)
@@ -558,10 +1012,27 @@ void C4PathFinder::SetLevel(int iLevel)
 	Level = BoundBy(iLevel, 1, 10);
 }
 
+void C4PathFinder::NextFrame()
+{
+	LastFrameStats = FrameStats;
+	FrameStats = {};
+}
+
 void C4PathFinder::Draw(C4FacetEx &cgo)
 {
 	if (TransferZones) TransferZones->Draw(cgo);
 	for (C4PathFinderRay *pRay = FirstRay; pRay; pRay = pRay->Next) pRay->Draw(cgo);
+	// Last graph path
+	for (std::size_t i = 2; i + 1 < GraphPath.size(); i += 2)
+		lpDDraw->DrawLine(cgo.Surface,
+			cgo.X + GraphPath[i - 2] - cgo.TargetX, cgo.Y + GraphPath[i - 1] - cgo.TargetY,
+			cgo.X + GraphPath[i] - cgo.TargetX, cgo.Y + GraphPath[i + 1] - cgo.TargetY,
+			CGreen);
+	// Query counters of the last frame
+	const auto &stats = LastFrameStats;
+	Application.DDraw->TextOut(std::format("Path queries: {} (graph: {}, rays: {}, unreachable: {}), {} us, tiles built: {}",
+		stats.Queries, stats.GraphPaths, stats.RayPaths, stats.Unreachable, stats.Time, stats.TilesBuilt).c_str(),
+		Game.GraphicsResource.FontRegular, 1.0, cgo.Surface, cgo.X + 4, cgo.Y + 4, CStdDDraw::DEFAULT_MESSAGE_COLOR, ALeft);
 }
 
 void C4PathFinder::Run()
@@ -602,6 +1073,7 @@ bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iT
 {
 	// Prepare
 	Clear();
+	Success = false;
 
 	// Parameter safety
 	if (!fnSetWaypoint) return false;
@@ -611,6 +1083,42 @@ bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iT
 	// Start & target coordinates must be free
 	if (!PointFree(iFromX, iFromY) || !PointFree(iToX, iToY)) return false;
 
+	C4ST_STARTNEW(FindStat, "C4PathFinder::Find")
+	const auto start = std::chrono::steady_clock::now();
+	++FrameStats.Queries;
+
+	// Cached navigation graph first; paths through transfer zones are left to the rays
+	bool fZoneHit{false}, fUnreachable{false};
+	if (Graph.Find(iFromX, iFromY, iToX, iToY, C4PF_Graph_MaxNodes * Level, GraphPath, fZoneHit, fUnreachable) && !fZoneHit)
+	{
+		// Set waypoints from the target backwards like SetCompletePath does
+		for (auto i = static_cast<std::ptrdiff_t>(GraphPath.size() / 2) - 2; i > 0; --i)
+			SetWaypoint(GraphPath[2 * i], GraphPath[2 * i + 1], 0, WaypointParameter);
+		Success = true;
+		++FrameStats.GraphPaths;
+	}
+	// No free path at all: only transfer zones could help, so don't send out rays in vain
+	// (rays could still slip through diagonal gaps between two solid pixels, which no object fits through anyway)
+	else if (fUnreachable && !(TransferZonesEnabled && TransferZones && !TransferZones->IsEmpty()))
+	{
+		GraphPath.clear();
+		++FrameStats.Unreachable;
+	}
+	else
+	{
+		GraphPath.clear();
+		if (FindRays(iFromX, iFromY, iToX, iToY)) ++FrameStats.RayPaths;
+	}
+
+	FrameStats.Time += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+	C4ST_STOP(FindStat)
+
+	// Success
+	return Success;
+}
+
+bool C4PathFinder::FindRays(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY)
+{
 	// Add the first two rays
 	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Left, nullptr)) return false;
 	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Right, nullptr)) return false;
@@ -618,7 +1126,6 @@ bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iT
 	// Run
 	Run();
 
-	// Success
 	return Success;
 }
 
@@ -21,6 +21,9 @@
 #include "C4ForwardDeclarations.h"
 #include <C4TransferZone.h>
 
+#include <cstdint>
+#include <vector>
+
 class C4PathFinderRay
 {
 	friend class C4PathFinder;
@@ -60,9 +63,86 @@ protected:
 	bool PathFree(int32_t &rX, int32_t &rY, int32_t iToX, int32_t iToY, C4TransferZone **ppZone = nullptr);
 };
 
+// Persistent navigation graph over the landscape
+// The landscape is split into tiles; every run of free pixels crossing the border
+// between two tiles is a portal node, and the crawl distances between the portals
+// of a tile are cached as its edges. Tiles are built on demand and dropped per region
+// whenever landscape pixels change, so the graph always equals one built from scratch
+// and query results never depend on what a client happened to have cached.
+// Paths found in the graph differ from those of the ray search, so games recorded with
+// engines before the graph desync on replay (network games already require the same build).
+class C4PathFinderGraph
+{
+	friend class C4PathFinder;
+
+public:
+	static constexpr int32_t TileSize = 32;
+
+	struct Stats
+	{
+		int32_t Queries{0}; // calls to C4PathFinder::Find
+		int32_t GraphPaths{0}; // answered from the graph
+		int32_t RayPaths{0}; // answered by the ray search
+		int32_t Unreachable{0}; // refused, as start and target are not connected
+		int32_t TilesBuilt{0};
+		std::uint64_t Time{0}; // microseconds
+	};
+
+protected:
+	struct Port
+	{
+		std::int64_t Node; // see GetNode
+		int32_t X, Y; // pixel inside the tile
+		int32_t Enter; // cost to step from the node pixel into the tile
+	};
+
+	struct Tile
+	{
+		bool BordersValid{false};
+		bool EdgesValid{false};
+		std::vector<int32_t> RightPortals; // y of free pixel pairs crossing the right border
+		std::vector<int32_t> BottomPortals; // x of free pixel pairs crossing the bottom border
+		std::vector<Port> Ports; // portals on all four borders
+		std::vector<int32_t> Costs; // Ports.size() squared; -1 if not connected within the tile
+	};
+
+	C4PathFinder *pPathFinder{nullptr};
+	int32_t Width{0}, Height{0}, TilesX{0}, TilesY{0};
+	std::vector<Tile> Tiles;
+
+	// scratch buffers for crawling inside a tile
+	std::vector<uint8_t> FreeMap;
+	std::vector<int32_t> Distance;
+	std::vector<int32_t> Queue;
+
+public:
+	void Clear();
+	void InvalidateRect(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt);
+	// Sets the complete path on success; the path may still cross a transfer zone if rfZoneHit is set.
+	// On failure, rfUnreachable tells whether no free path exists at all (except through transfer zones).
+	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iMaxNodes, std::vector<int32_t> &rPath, bool &rfZoneHit, bool &rfUnreachable);
+
+protected:
+	std::int64_t GetNode(int32_t iX, int32_t iY, bool fVertical) const { return (static_cast<std::int64_t>(iY) * Width + iX) * 2 + fVertical; }
+	void GetNodePos(std::int64_t iNode, int32_t &rX, int32_t &rY) const;
+	void GetNodeTiles(std::int64_t iNode, int32_t &rTile1, int32_t &rTile2) const;
+	int32_t GetTile(int32_t iX, int32_t iY) const { return (iY / TileSize) * TilesX + iX / TileSize; }
+	void GetTileRect(int32_t iTile, int32_t &rX, int32_t &rY, int32_t &rWdt, int32_t &rHgt) const;
+	void Prepare();
+	void BuildBorders(int32_t iTile);
+	Tile &GetTileEdges(int32_t iTile);
+	void CrawlTile(int32_t iTile, int32_t iFromX, int32_t iFromY);
+	int32_t GetCrawlDistance(int32_t iTile, int32_t iX, int32_t iY) const;
+	bool TraceCrawl(int32_t iTile, int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, std::vector<int32_t> &rPath);
+	bool LineFree(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool &rfZoneHit);
+	// Whether the component of the from nodes contains none of the to nodes, exploring at most iMaxNodes nodes
+	bool IsSeparated(const std::vector<std::int64_t> &from, const std::vector<std::int64_t> &to, int32_t iMaxNodes);
+};
+
 class C4PathFinder
 {
 	friend class C4PathFinderRay;
+	friend class C4PathFinderGraph;
 
 public:
 	C4PathFinder();
@@ -79,6 +159,9 @@ protected:
 	C4TransferZones *TransferZones;
 	bool TransferZonesEnabled;
 	int Level;
+	C4PathFinderGraph Graph;
+	std::vector<int32_t> GraphPath; // last path found in the graph, for drawing
+	C4PathFinderGraph::Stats FrameStats, LastFrameStats;
 
 public:
 	void Draw(C4FacetEx &cgo);
@@ -88,10 +171,15 @@ public:
 	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter);
 	void EnableTransferZones(bool fEnabled);
 	void SetLevel(int iLevel);
+	void InvalidateRect(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt) { Graph.InvalidateRect(iX, iY, iWdt, iHgt); }
+	void ClearGraph() { Graph.Clear(); }
+	void NextFrame(); // per-frame query counters
+	const C4PathFinderGraph::Stats &GetLastFrameStats() const { return LastFrameStats; }
 
 protected:
 	void Run();
 	bool AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone = nullptr);
 	bool SplitRay(C4PathFinderRay *pRay, int32_t iAtX, int32_t iAtY);
 	bool Execute();
+	bool FindRays(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY);
 };
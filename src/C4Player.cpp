@@ -34,6 +34,7 @@
 #include <C4ObjectMenu.h>
 
 static constexpr std::int32_t C4FOW_Def_View_RangeX{500};
+static constexpr std::int32_t C4FOW_GeneratorFade{200}; // distance over which FoW-generators fade off
 
 C4Player::C4Player() : C4PlayerInfoCore()
 {
@@ -74,7 +75,7 @@ void C4Player::ClearPointers(C4Object *pObj, bool fDeath)
 	// (do not clear locals!)
 	// no clear when death to do normal decay
 	if (!fDeath)
-		while (FoWViewObjs.Remove(pObj));
+		RemoveFoWViewObj(pObj);
 	// Menu
 	Menu.ClearPointers(pObj);
 	// messageboard-queries
@@ -221,7 +222,7 @@ void C4Player::Execute()
 		{
 			pDeadClonk->PlrViewRange -= 10;
 			if (pDeadClonk->PlrViewRange <= 0)
-				FoWViewObjs.Remove(pDeadClonk);
+				RemoveFoWViewObj(pDeadClonk);
 		}
 	}
 
@@ -520,7 +521,7 @@ void C4Player::PlaceReadyCrew(int32_t tx1, int32_t tx2, int32_t ty, C4Object *Fi
 #ifndef DEBUGREC_RECRUITMENT
 				C4DebugRecOff DBGRECOFF;
 #endif
-				nobj->Call(PSF_OnJoinCrew, {C4VInt(Number)});
+				nobj->Call(C4DefCallback::OnJoinCrew, {C4VInt(Number)});
 			}
 		}
 	}
@@ -561,7 +562,7 @@ void C4Player::PlaceReadyCrew(int32_t tx1, int32_t tx2, int32_t ty, C4Object *Fi
 #ifndef DEBUGREC_RECRUITMENT
 						C4DebugRecOff DbgRecOff;
 #endif
-						nobj->Call(PSF_OnJoinCrew, {C4VInt(Number)});
+						nobj->Call(C4DefCallback::OnJoinCrew, {C4VInt(Number)});
 					}
 				}
 			}
@@ -858,7 +859,7 @@ C4Object *C4Player::Buy(C4ID id, bool fShowErrors, int32_t iForPlr, C4Object *pB
 	if (pDef->CrewMember) if (ValidPlr(iForPlr))
 		Game.Players.Get(iForPlr)->MakeCrewMember(pThing);
 	// success
-	pThing->Call(PSF_Purchase, {C4VInt(Number), C4VObj(pBuyObj)});
+	pThing->Call(C4DefCallback::Purchase, {C4VInt(Number), C4VObj(pBuyObj)});
 	if (!pThing->Status) return nullptr;
 	return pThing;
 }
@@ -891,7 +892,7 @@ bool C4Player::Sell2Home(C4Object *pObj)
 	}
 	// Remove object, eject any crew members
 	if (pObj->Contained) pObj->Exit();
-	pObj->Call(PSF_Sale, {C4VInt(Number)});
+	pObj->Call(C4DefCallback::Sale, {C4VInt(Number)});
 	pObj->AssignRemoval(true);
 	// Done
 	return true;
@@ -1042,6 +1043,7 @@ void C4Player::Clear()
 	BigIcon.Clear();
 	fFogOfWar = false; bForceFogOfWar = false;
 	FoWViewObjs.Clear();
+	FoWGrid.Clear();
 	fFogOfWarInitialized = false;
 	while (pMsgBoardQuery)
 	{
@@ -1071,6 +1073,7 @@ void C4Player::Default()
 	fFogOfWar = false; fFogOfWarInitialized = false;
 	bForceFogOfWar = false;
 	FoWViewObjs.Default();
+	FoWGrid.Clear();
 	LeagueEvaluated = false;
 	GameJoinTime = 0; // overwritten in Init
 	pstatControls = pstatActions = nullptr;
@@ -1204,7 +1207,7 @@ bool C4Player::MakeCrewMember(C4Object *pObj, bool fForceInfo, bool fDoCalls)
 	// OnJoinCrew callback
 	if (fDoCalls)
 	{
-		pObj->Call(PSF_OnJoinCrew, {C4VInt(Number)});
+		pObj->Call(C4DefCallback::OnJoinCrew, {C4VInt(Number)});
 	}
 
 	return true;
@@ -1924,9 +1927,13 @@ void C4Player::FoW2Map(CClrModAddMap &rMap, int iOffX, int iOffY)
 	// Add view for all FoW-repellers - keep track of FoW-generators, which should be avaluated finally
 	// so they override repellers
 	bool fAnyGenerators = false;
+	// only objects near the map can change it; generators fade off beyond their view range
+	int iMapX0, iMapY0, iMapX1, iMapY1;
+	rMap.GetBounds(iMapX0, iMapY0, iMapX1, iMapY1);
+	FoWGrid.MarkInRect(iMapX0 - iOffX, iMapY0 - iOffY, iMapX1 - iOffX, iMapY1 - iOffY, C4FOW_GeneratorFade);
 	C4Object *cobj; C4ObjectLink *clnk;
 	for (clnk = FoWViewObjs.First; clnk && (cobj = clnk->Obj); clnk = clnk->Next)
-		if (!cobj->Contained || cobj->Contained->Def->ClosedContainer != 1)
+		if (FoWGrid.IsMarked(cobj) && (!cobj->Contained || cobj->Contained->Def->ClosedContainer != 1))
 			if (cobj->PlrViewRange > 0)
 				rMap.ReduceModulation(cobj->x + iOffX, cobj->y + iOffY, cobj->PlrViewRange * 2 / 3, cobj->PlrViewRange);
 			else
@@ -1949,14 +1956,58 @@ void C4Player::FoW2Map(CClrModAddMap &rMap, int iOffX, int iOffY)
 void C4Player::FoWGenerators2Map(CClrModAddMap &rMap, int iOffX, int iOffY)
 {
 	// add fog to any generator pos (view range
+	// (objects away from the map have not been marked by FoW2Map)
 	C4Object *cobj; C4ObjectLink *clnk;
 	for (clnk = FoWViewObjs.First; clnk && (cobj = clnk->Obj); clnk = clnk->Next)
-		if (!cobj->Contained || cobj->Contained->Def->ClosedContainer != 1)
+		if (FoWGrid.IsMarked(cobj) && (!cobj->Contained || cobj->Contained->Def->ClosedContainer != 1))
 			if (cobj->PlrViewRange < 0)
-				rMap.AddModulation(cobj->x + iOffX, cobj->y + iOffY, -cobj->PlrViewRange, -cobj->PlrViewRange + 200, cobj->ColorMod >> 24);
+				rMap.AddModulation(cobj->x + iOffX, cobj->y + iOffY, -cobj->PlrViewRange, -cobj->PlrViewRange + C4FOW_GeneratorFade, cobj->ColorMod >> 24);
 }
 
 bool C4Player::FoWIsVisible(int32_t x, int32_t y)
+{
+	// check repellers and generators near the point, and ViewTarget
+	bool fSeen = false, fShadowed = false;
+	const auto check = [&](C4Object *cobj, int32_t iRange)
+	{
+		if (!cobj->Contained || cobj->Contained->Def->ClosedContainer != 1)
+			if (Distance(cobj->x, cobj->y, x, y) < Abs(iRange))
+				if (iRange < 0)
+				{
+					if (!(cobj->ColorMod & 0xff000000)) // faded generators generate darkness only; no FoW blocking
+						fShadowed = true; // shadowed by FoW-generator
+				}
+				else
+					fSeen = true; // made visible by FoW-repeller
+		return !fShadowed;
+	};
+	FoWGrid.ForEachAt(x, y, [&](C4Object *cobj) { return check(cobj, cobj->PlrViewRange); });
+	if (!fShadowed && ViewMode == C4PVM_Target && ViewTarget)
+	{
+		int32_t iRange = ViewTarget->PlrViewRange;
+		if (!iRange && Cursor) iRange = Cursor->PlrViewRange;
+		if (!iRange) iRange = C4FOW_Def_View_RangeX;
+		check(ViewTarget, iRange);
+	}
+	const bool fVisible{fSeen && !fShadowed};
+	assert(fVisible == FoWIsVisibleLinear(x, y));
+	return fVisible;
+}
+
+void C4Player::AddFoWViewObj(C4Object *pObj)
+{
+	FoWViewObjs.Add(pObj, C4ObjectList::stNone);
+	FoWGrid.Add(pObj, pObj->x, pObj->y, pObj->PlrViewRange);
+}
+
+void C4Player::RemoveFoWViewObj(C4Object *pObj)
+{
+	while (FoWViewObjs.Remove(pObj));
+	FoWGrid.Remove(pObj);
+}
+
+#ifndef NDEBUG
+bool C4Player::FoWIsVisibleLinear(int32_t x, int32_t y)
 {
 	// check repellers and generators and ViewTarget
 	bool fSeen = false;
@@ -1992,6 +2043,7 @@ bool C4Player::FoWIsVisible(int32_t x, int32_t y)
 	}
 	return fSeen;
 }
+#endif
 
 void C4Player::SelectCrew(C4Object *pObj, bool fSelect)
 {
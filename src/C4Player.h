@@ -19,6 +19,7 @@
 #pragma once
 
 #include "C4EnumeratedObjectPtr.h"
+#include "C4FoWGrid.h"
 #include "C4MainMenu.h"
 #include <C4ObjectInfoList.h>
 #include <C4InfoCore.h>
@@ -95,6 +96,7 @@ public:
 	bool bForceFogOfWar;
 	bool fFogOfWarInitialized; // No Save //
 	C4ObjectList FoWViewObjs; // No Save //
+	C4FoWGrid FoWGrid; // No Save // - FoWViewObjs by position, for visibility checks
 	// Game
 	int32_t Wealth, Points;
 	int32_t Value, InitialValue, ValueGain;
@@ -232,6 +234,11 @@ public:
 	void FoW2Map(CClrModAddMap &rMap, int iOffX, int iOffY);
 	void FoWGenerators2Map(CClrModAddMap &rMap, int iOffX, int iOffY);
 	bool FoWIsVisible(int32_t x, int32_t y); // check whether a point in the landscape is visible
+	void AddFoWViewObj(C4Object *pObj);
+	void RemoveFoWViewObj(C4Object *pObj);
+#ifndef NDEBUG
+	bool FoWIsVisibleLinear(int32_t x, int32_t y); // check against all view objects, to verify FoWIsVisible
+#endif
 
 	// runtime statistics
 	void CreateGraphs();
@@ -0,0 +1,101 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// slab allocator for engine objects of one type that are created and deleted all the time
+
+#include <C4Include.h>
+#include <C4Pool.h>
+
+#include <algorithm>
+#include <new>
+
+void *C4Pool::Allocate(const std::size_t size)
+{
+	// derived classes that do not fit take the usual way
+	if (size > BlockSize) return ::operator new(size);
+	if (!Registered)
+	{
+		Next = First;
+		First = this;
+		Registered = true;
+	}
+	if (!FirstFree) AddSlab();
+	Block *const block{FirstFree};
+	FirstFree = block->Next;
+	++Live;
+	++Allocations;
+	++FrameAllocations;
+	return block;
+}
+
+void C4Pool::Deallocate(void *const ptr, const std::size_t size) noexcept
+{
+	if (!ptr) return;
+	if (size > BlockSize)
+	{
+		::operator delete(ptr);
+		return;
+	}
+	// keep the block until the frame is over
+	Block *const block{static_cast<Block *>(ptr)};
+	block->Next = nullptr;
+	if (LastPending)
+		LastPending->Next = block;
+	else
+		FirstPending = block;
+	LastPending = block;
+	--Live;
+}
+
+void C4Pool::AddSlab()
+{
+	const std::size_t headerSize{RoundUp(sizeof(Slab))};
+	const std::size_t blockCount{std::max(MinSlabBlocks, SlabSize / BlockSize)};
+	auto *const mem = static_cast<std::byte *>(::operator new(headerSize + blockCount * BlockSize));
+	Slab *const slab{new (mem) Slab{FirstSlab}};
+	FirstSlab = slab;
+	++SlabCount;
+	// chain the new blocks in address order
+	for (std::size_t i{blockCount}; i--; )
+		FirstFree = new (mem + headerSize + i * BlockSize) Block{FirstFree};
+}
+
+void C4Pool::FlushPending() noexcept
+{
+	if (!FirstPending) return;
+	LastPending->Next = FirstFree;
+	FirstFree = FirstPending;
+	FirstPending = LastPending = nullptr;
+}
+
+void C4Pool::EndFrame()
+{
+	for (C4Pool *pool{First}; pool; pool = pool->Next)
+	{
+		pool->FlushPending();
+		pool->LastFrameAllocations = pool->FrameAllocations;
+		pool->FrameAllocations = 0;
+		++pool->Frames;
+	}
+}
+
+void C4Pool::ResetStats()
+{
+	for (C4Pool *pool{First}; pool; pool = pool->Next)
+	{
+		pool->Allocations = 0;
+		pool->Frames = 0;
+	}
+}
@@ -0,0 +1,83 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// slab allocator for engine objects of one type that are created and deleted all the time
+// classes hook it in through their own operator new/delete; main thread only
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+class C4Pool
+{
+private:
+	struct Block { Block *Next; };
+	struct Slab { Slab *Next; };
+
+	static constexpr std::size_t Alignment{alignof(std::max_align_t)};
+	static constexpr std::size_t SlabSize{64 * 1024}; // slabs are at least this big...
+	static constexpr std::size_t MinSlabBlocks{8}; // ...and hold at least this many blocks
+
+	const char *Name;
+	std::size_t BlockSize;
+
+	Slab *FirstSlab{nullptr};
+	Block *FirstFree{nullptr};
+	// blocks deleted during the current frame; they are not handed out again before EndFrame,
+	// so pointers to objects deleted this frame never see a new object at the same address
+	Block *FirstPending{nullptr}, *LastPending{nullptr};
+
+	// counters
+	std::size_t SlabCount{0};
+	std::size_t Live{0};
+	std::uint64_t Allocations{0}; // since last ResetStats
+	std::uint32_t Frames{0}; // since last ResetStats
+	std::uint32_t FrameAllocations{0}, LastFrameAllocations{0};
+
+	// registered pools, for EndFrame and statistics
+	C4Pool *Next{nullptr};
+	bool Registered{false};
+	static inline C4Pool *First{nullptr};
+
+public:
+	// constant initialization and no destructor, so objects may be deleted during static destruction;
+	// the slabs are never given back
+	constexpr C4Pool(const char *name, std::size_t blockSize) noexcept
+		: Name{name}, BlockSize{RoundUp(blockSize < sizeof(Block) ? sizeof(Block) : blockSize)} {}
+	C4Pool(const C4Pool &) = delete;
+	C4Pool &operator=(const C4Pool &) = delete;
+
+	void *Allocate(std::size_t size);
+	void Deallocate(void *ptr, std::size_t size) noexcept;
+
+	const char *GetName() const { return Name; }
+	std::size_t GetLive() const { return Live; }
+	std::size_t GetSlabCount() const { return SlabCount; }
+	std::uint64_t GetAllocations() const { return Allocations; }
+	std::uint32_t GetFrames() const { return Frames; }
+	std::uint32_t GetLastFrameAllocations() const { return LastFrameAllocations; }
+
+	static C4Pool *GetFirst() { return First; }
+	C4Pool *GetNext() const { return Next; }
+
+	static void EndFrame(); // make the blocks of all pools deleted until now available again
+	static void ResetStats();
+
+private:
+	static constexpr std::size_t RoundUp(std::size_t size) { return (size + Alignment - 1) / Alignment * Alignment; }
+	void AddSlab();
+	void FlushPending() noexcept;
+};
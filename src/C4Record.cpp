@@ -110,8 +110,67 @@ void C4RecordChunk::CompileFunc(StdCompiler *pComp)
 	}
 }
 
+std::string C4RecordSnapshot::GetFilename() const
+{
+	return std::format(C4CFN_RecSnapshot, Frame);
+}
+
+void C4RecordSnapshot::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Frame,     "Frame"));
+	pComp->Value(mkNamingAdapt(Packets,   "Packets",   0));
+	pComp->Value(mkNamingAdapt(DebugRecs, "DebugRecs", 0));
+	pComp->Value(mkNamingAdapt(SaveTime,  "SaveTime",  0));
+	pComp->Value(mkNamingAdapt(Size,      "Size",      0));
+#ifdef DEBUGREC
+	pComp->Value(mkNamingAdapt(HasSyncCheck, "HasSyncCheck", false));
+	if (HasSyncCheck) pComp->Value(mkNamingAdapt(SyncCheck, "SyncCheck"));
+#endif
+}
+
+const C4RecordSnapshot *C4RecordSnapshotList::FindNearest(int32_t iFrame) const
+{
+	const auto it = std::upper_bound(Snapshots.begin(), Snapshots.end(), iFrame,
+		[](int32_t frame, const C4RecordSnapshot &snapshot) { return frame < snapshot.Frame; });
+	return it != Snapshots.begin() ? &*std::prev(it) : nullptr;
+}
+
+bool C4RecordSnapshotList::Load(C4Group &hGroup)
+{
+	Snapshots.clear();
+	StdStrBuf Buf;
+	if (!hGroup.LoadEntryString(C4CFN_RecSnapshots, Buf)) return false;
+	if (!CompileFromBuf_LogWarn<StdCompilerINIRead>(mkNamingAdapt(*this, "Snapshots"), Buf, C4CFN_RecSnapshots)) return false;
+	// lookup relies on frame order
+	std::sort(Snapshots.begin(), Snapshots.end(), [](const C4RecordSnapshot &a, const C4RecordSnapshot &b) { return a.Frame < b.Frame; });
+	return true;
+}
+
+bool C4RecordSnapshotList::Save(C4Group &hGroup)
+{
+	// remove previous entry from group
+	hGroup.DeleteEntry(C4CFN_RecSnapshots);
+	// anything to save?
+	if (Snapshots.empty()) return true;
+	try
+	{
+		const std::string buf{DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(*this, "Snapshots"))};
+		StdStrBuf copy{buf.c_str(), buf.size()};
+		return hGroup.Add(C4CFN_RecSnapshots, copy, false, true);
+	}
+	catch (const StdCompiler::Exception &)
+	{
+		return false;
+	}
+}
+
+void C4RecordSnapshotList::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Snapshots), "Snapshot"));
+}
+
 C4Record::C4Record()
-	: fRecording(false), fStreaming(false) {}
+	: fRecording(false), fStreaming(false), iNextSnapshotFrame(0) {}
 
 C4Record::~C4Record() {}
 
@@ -171,6 +230,9 @@ bool C4Record::Start(bool fInitial)
 	fStreaming = false;
 	fRecording = true;
 	iLastFrame = 0;
+	// first keyframe snapshot is due one interval after record start
+	Snapshots.Snapshots.clear();
+	iNextSnapshotFrame = Config.General.RecordSnapshotInterval > 0 ? Game.FrameCounter + Config.General.RecordSnapshotInterval : 0;
 	return true;
 }
 
@@ -189,6 +251,19 @@ bool C4Record::Stop(StdStrBuf *pRecordName, uint8_t *pRecordSHA1)
 
 	// save end player infos into record group
 	Game.PlayerInfos.Save(RecordGrp, C4CFN_RecPlayerInfos);
+
+	// save snapshot index into record group
+	if (!Snapshots.Snapshots.empty())
+	{
+		Snapshots.Save(RecordGrp);
+		int32_t iTotalTime = 0, iTotalSize = 0;
+		for (const auto &snapshot : Snapshots.Snapshots)
+		{
+			iTotalTime += snapshot.SaveTime;
+			iTotalSize += snapshot.Size;
+		}
+		LogNTr("Record: {} snapshots, {} ms, {} KiB", Snapshots.Snapshots.size(), iTotalTime, iTotalSize / 1024);
+	}
 	RecordGrp.Close();
 
 	// write last entry and close
@@ -314,6 +389,52 @@ bool C4Record::AddFile(const char *szLocalFilename, const char *szAddAs, bool fD
 	return true;
 }
 
+bool C4Record::Snapshot(int32_t iPackets, int32_t iDebugRecs)
+{
+	if (!fRecording) return false;
+	// next one is due one interval later, even if this one fails
+	iNextSnapshotFrame = Game.FrameCounter + std::max<int32_t>(Config.General.RecordSnapshotInterval, 1);
+
+	const auto iStartTime = timeGetTime();
+	C4RecordSnapshot snapshot;
+	snapshot.Frame = Game.FrameCounter;
+	snapshot.Packets = iPackets;
+	snapshot.DebugRecs = iDebugRecs;
+#ifdef DEBUGREC
+	snapshot.HasSyncCheck = true;
+	snapshot.SyncCheck.Set();
+#endif
+	// a linear replay doesn't save anything here, so nothing of the saving may go into the debugrec
+	C4DebugRecOff DBGRECOFF;
+
+	// save the game the same way a runtime record start would, so the snapshot can be replayed on its own
+	StdStrBuf sTempFilename(sFilename);
+	MakeTempFilename(&sTempFilename);
+	C4GameSaveRecord saveRec(false, Index, Game.Parameters.isLeague());
+	if (!saveRec.Save(sTempFilename.getData()))
+	{
+		spdlog::error("Record: Could not save snapshot at frame {}", snapshot.Frame);
+		EraseItem(sTempFilename.getData());
+		return false;
+	}
+	saveRec.Close();
+	snapshot.Size = static_cast<int32_t>(FileSize(sTempFilename.getData()));
+
+	// move it into the record group
+	const std::string snapshotFilename{snapshot.GetFilename()};
+	if (!RecordGrp.Move(sTempFilename.getData(), snapshotFilename.c_str()))
+	{
+		spdlog::error("Record: Could not add snapshot {} to record", snapshotFilename);
+		EraseItem(sTempFilename.getData());
+		return false;
+	}
+
+	snapshot.SaveTime = static_cast<int32_t>(timeGetTime() - iStartTime);
+	Snapshots.Add(snapshot);
+	spdlog::debug("Record: Snapshot at frame {} ({} ms, {} KiB)", snapshot.Frame, snapshot.SaveTime, snapshot.Size / 1024);
+	return true;
+}
+
 bool C4Record::StartStreaming(bool fInitial)
 {
 	if (!fRecording) return false;
@@ -377,7 +498,7 @@ bool C4Record::StreamFile(const char *szLocalFilename, const char *szAddAs)
 }
 
 // set defaults
-C4Playback::C4Playback(std::shared_ptr<spdlog::logger> logger) : logger{std::move(logger)}, Finished(true),fLoadSequential(false)
+C4Playback::C4Playback(std::shared_ptr<spdlog::logger> logger) : logger{std::move(logger)}, Finished(true),fLoadSequential(false), SkipFrame(-1), SkipPackets(0), SkipDebugRecs(0)
 {
 #ifdef DEBUGREC
 	loggerDebugRec = logger->clone("DbgRec");
@@ -811,18 +932,43 @@ bool C4Playback::ExecuteControl(C4Control *pCtrl, int iFrame)
 	if (DebugRec.firstPkt())
 		DebugRecError("Debug rec overflow!");
 	DebugRec.Clear();
+#endif
+#ifdef DEBUGREC
+	// continuing from a snapshot: its game state must be the one it was taken of
+	if (SnapshotSyncCheck && iFrame == SkipFrame)
+	{
+		C4ControlSyncCheck syncCheck;
+		syncCheck.Set();
+		if (!syncCheck.IsSameState(*SnapshotSyncCheck, false))
+			DebugRecError(std::format("Snapshot state differs! Record: {} Here: {}",
+				DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(*SnapshotSyncCheck, "SyncCheck")),
+				DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(syncCheck, "SyncCheck"))));
+		SnapshotSyncCheck.reset();
+	}
 #endif
 	// return all control until this frame
 	while (currChunk != chunks.end() && currChunk->Frame <= iFrame)
 	{
+		// snapshot frame: leave out what ran before the snapshot was taken
+		const bool fSkip{currChunk->Frame == SkipFrame};
 		switch (currChunk->Type)
 		{
 		case RCT_Ctrl:
+			while (fSkip && SkipPackets && currChunk->pCtrl->firstPkt())
+			{
+				currChunk->pCtrl->Delete(currChunk->pCtrl->firstPkt());
+				--SkipPackets;
+			}
 			pCtrl->Append(*currChunk->pCtrl);
 			break;
 
 		case RCT_CtrlPkt:
 		{
+			if (fSkip && SkipPackets)
+			{
+				--SkipPackets;
+				break;
+			}
 			C4IDPacket Packet(*currChunk->pPkt);
 			pCtrl->Add(Packet.getPktType(), static_cast<C4ControlPacket *>(Packet.getPkt()));
 			Packet.Default();
@@ -837,7 +983,11 @@ bool C4Playback::ExecuteControl(C4Control *pCtrl, int iFrame)
 #ifdef DEBUGREC
 		default: // expect it to be debug rec
 			// append to debug rec buffer
-			if (currChunk->pDbg)
+			if (currChunk->pDbg && fSkip && SkipDebugRecs)
+			{
+				--SkipDebugRecs;
+			}
+			else if (currChunk->pDbg)
 			{
 				DebugRec.Add(CID_DebugRec, currChunk->pDbg);
 				// the debugrec buffer is now responsible for deleting the packet
@@ -852,6 +1002,20 @@ bool C4Playback::ExecuteControl(C4Control *pCtrl, int iFrame)
 	return true;
 }
 
+void C4Playback::SkipTo(const C4RecordSnapshot &snapshot)
+{
+	// control before the snapshot frame has been applied to the snapshot's game state completely
+	while (currChunk != chunks.end() && currChunk->Frame < snapshot.Frame)
+		NextChunk();
+	// control of the snapshot frame only up to the synchronize-call that took it: ExecuteControl leaves that out
+	SkipFrame = snapshot.Frame;
+	SkipPackets = snapshot.Packets;
+	SkipDebugRecs = snapshot.DebugRecs;
+#ifdef DEBUGREC
+	if (snapshot.HasSyncCheck) SnapshotSyncCheck = snapshot.SyncCheck;
+#endif
+}
+
 void C4Playback::Finish()
 {
 	Clear();
@@ -877,7 +1041,10 @@ void C4Playback::Clear()
 	playbackFile.Close();
 	sequentialBuffer.Clear();
 	fLoadSequential = false;
+	SkipFrame = -1;
+	SkipPackets = SkipDebugRecs = 0;
 #ifdef DEBUGREC
+	SnapshotSyncCheck.reset();
 	C4IDPacket *pkt;
 	while (pkt = DebugRec.firstPkt()) DebugRec.Delete(pkt);
 #ifdef DEBUGREC_EXTFILE
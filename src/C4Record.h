@@ -28,6 +28,9 @@ class C4Record;
 #include "Fixed.h"
 
 #include <list>
+#include <optional>
+#include <string>
+#include <vector>
 
 #ifdef DEBUGREC
 extern int DoNoDebugRec; // debugrec disable counter in C4Record.cpp
@@ -251,6 +254,36 @@ public:
 	virtual void CompileFunc(StdCompiler *pComp) override;
 };
 
+// keyframe snapshot of a running record: a record savegame stored in the record group
+struct C4RecordSnapshot
+{
+	int32_t Frame{0}; // game frame the snapshot was taken at
+	int32_t Packets{0}; // control packets of that frame executed before, up to and including the synchronize-call it was taken in
+	int32_t DebugRecs{0}; // debug chunks of that frame recorded before
+	int32_t SaveTime{0}; // time needed to create the snapshot (ms)
+	int32_t Size{0}; // snapshot file size (bytes)
+#ifdef DEBUGREC
+	bool HasSyncCheck{false};
+	C4ControlSyncCheck SyncCheck; // game state the snapshot was taken of, for checking seeks against it
+#endif
+
+	std::string GetFilename() const;
+	void CompileFunc(StdCompiler *pComp);
+};
+
+// frame index of all snapshots in a record
+class C4RecordSnapshotList
+{
+public:
+	std::vector<C4RecordSnapshot> Snapshots; // sorted by frame
+
+	void Add(const C4RecordSnapshot &snapshot) { Snapshots.push_back(snapshot); }
+	const C4RecordSnapshot *FindNearest(int32_t iFrame) const; // last snapshot at or before the given frame
+	bool Load(C4Group &hGroup);
+	bool Save(C4Group &hGroup);
+	void CompileFunc(StdCompiler *pComp);
+};
+
 class C4Record // demo recording
 {
 private:
@@ -262,6 +295,8 @@ private:
 	bool fStreaming; // perdiodically sent new control to server
 	unsigned int iStreamingPos; // Position of current buffer in stream
 	StdBuf StreamingData; // accumulated control data since last stream sync
+	C4RecordSnapshotList Snapshots; // keyframe snapshots taken so far
+	int32_t iNextSnapshotFrame; // frame at which the next snapshot is due; 0 if snapshots are disabled
 
 public:
 	C4Record(); // creates control file etc
@@ -280,6 +315,9 @@ public:
 
 	bool AddFile(const char *szLocalFilename, const char *szAddAs, bool fDelete = false);
 
+	bool IsSnapshotDue(int32_t iFrame) const { return fRecording && iNextSnapshotFrame && iFrame >= iNextSnapshotFrame; }
+	bool Snapshot(int32_t iPackets, int32_t iDebugRecs); // save keyframe snapshot of the current (synchronized) game state into the record
+
 	bool StartStreaming(bool fInitial);
 	void ClearStreamingBuf(unsigned int iAmount);
 	void StopStreaming();
@@ -302,10 +340,13 @@ private:
 	bool fLoadSequential; // used for debugrecs: Sequential reading of files
 	StdBuf sequentialBuffer; // buffer to manage sequential reads
 	uint32_t iLastSequentialFrame; // frame number of last chunk read
+	// playback from a snapshot: control packets and debug chunks at the start of its frame that it already contains
+	int32_t SkipFrame, SkipPackets, SkipDebugRecs;
 	void Finish(); // end playback
 #ifdef DEBUGREC
 	std::shared_ptr<spdlog::logger> loggerDebugRec;
 	C4PacketList DebugRec;
+	std::optional<C4ControlSyncCheck> SnapshotSyncCheck; // state of the snapshot a seek started from; compared when its control continues
 #endif
 
 public:
@@ -321,6 +362,7 @@ public:
 	StdBuf ReWriteBinary();
 	void Strip();
 	bool ExecuteControl(C4Control *pCtrl, int iFrame); // assign control
+	void SkipTo(const C4RecordSnapshot &snapshot); // drop all control the snapshot already contains (playback from snapshots)
 	void Clear();
 #ifdef DEBUGREC
 	void Check(C4RecordChunkType eType, const uint8_t *pData, int iSize); // compare with debugrec
@@ -5121,8 +5121,8 @@ static bool FnFightWith(C4AulContext *ctx, C4Object *pTarget, C4Object *pClonk)
 	// check OCF
 	if (~(pTarget->OCF & pClonk->OCF) & OCF_FightReady) return false;
 	// RejectFight callback
-	if (pTarget->Call(PSF_RejectFight, {C4VObj(pTarget)}, true).getBool()) return false;
-	if (pClonk->Call(PSF_RejectFight, {C4VObj(pClonk)}, true).getBool()) return false;
+	if (pTarget->Call(C4DefCallback::RejectFight, {C4VObj(pTarget)}, true).getBool()) return false;
+	if (pClonk->Call(C4DefCallback::RejectFight, {C4VObj(pClonk)}, true).getBool()) return false;
 	// begin fighting
 	ObjectActionFight(pClonk, pTarget);
 	ObjectActionFight(pTarget, pClonk);
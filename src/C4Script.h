@@ -132,3 +132,75 @@ void InitFunctionMap(C4AulScriptEngine *pEngine); // add functions to engine
 // an additional callback for Construct.
 #define PSF_ControlCommandAcquire      "~ControlCommandAcquire" // C4Object *pTarget (unused), int iRangeX, int iRangeY, C4Object *pExcludeContainer, C4ID idAcquireDef
 #define PSF_ControlCommandConstruction "~ControlCommandConstruction" // C4Object *pTarget (unused), int iRangeX, int iRangeY, C4Object *pTarget2 (unused), C4ID idConstructDef
+
+// object callbacks that are looked up once per definition when linking (see C4DefScriptHost::AfterLink)
+#define C4DEF_CALLBACKS(X) \
+	X(Construction,               PSF_Construction) \
+	X(Destruction,                PSF_Destruction) \
+	X(ContentsDestruction,        PSF_ContentsDestruction) \
+	X(Initialize,                 PSF_Initialize) \
+	X(Completion,                 PSF_Completion) \
+	X(Hit,                        PSF_Hit) \
+	X(Hit2,                       PSF_Hit2) \
+	X(Hit3,                       PSF_Hit3) \
+	X(Grab,                       PSF_Grab) \
+	X(Grabbed,                    PSF_Grabbed) \
+	X(RejectGrabbed,              PSF_RejectGrabbed) \
+	X(GrabLost,                   PSF_GrabLost) \
+	X(Get,                        PSF_Get) \
+	X(Put,                        PSF_Put) \
+	X(Collection,                 PSF_Collection) \
+	X(Collection2,                PSF_Collection2) \
+	X(RejectCollection,           PSF_RejectCollection) \
+	X(RejectContents,             PSF_RejectContents) \
+	X(Ejection,                   PSF_Ejection) \
+	X(Entrance,                   PSF_Entrance) \
+	X(Departure,                  PSF_Departure) \
+	X(RejectEntrance,             PSF_RejectEntrance) \
+	X(ActivateEntrance,           PSF_ActivateEntrance) \
+	X(Activate,                   PSF_Activate) \
+	X(Purchase,                   PSF_Purchase) \
+	X(Sale,                       PSF_Sale) \
+	X(Damage,                     PSF_Damage) \
+	X(Incineration,               PSF_Incineration) \
+	X(IncinerationEx,             PSF_IncinerationEx) \
+	X(FireMode,                   PSF_FireMode) \
+	X(Death,                      PSF_Death) \
+	X(DeepBreath,                 PSF_DeepBreath) \
+	X(Stuck,                      PSF_Stuck) \
+	X(LiftTop,                    PSF_LiftTop) \
+	X(LineBreak,                  PSF_LineBreak) \
+	X(AttachTargetLost,           PSF_AttachTargetLost) \
+	X(UpdateTransferZone,         PSF_UpdateTransferZone) \
+	X(BuildNeedsMaterial,         PSF_BuildNeedsMaterial) \
+	X(ControlUpdate,              PSF_ControlUpdate) \
+	X(ContainedControlUpdate,     PSF_ContainedControlUpdate) \
+	X(ControlCommand,             PSF_ControlCommand) \
+	X(ControlCommandFinished,     PSF_ControlCommandFinished) \
+	X(ControlCommandAcquire,      PSF_ControlCommandAcquire) \
+	X(ControlCommandConstruction, PSF_ControlCommandConstruction) \
+	X(OnActionJump,               PSF_OnActionJump) \
+	X(CatchBlow,                  PSF_CatchBlow) \
+	X(QueryCatchBlow,             PSF_QueryCatchBlow) \
+	X(RejectFight,                PSF_RejectFight) \
+	X(CrewSelection,              PSF_CrewSelection) \
+	X(MouseSelection,             PSF_MouseSelection) \
+	X(OnJoinCrew,                 PSF_OnJoinCrew) \
+	X(OnOwnerChanged,             PSF_OnOwnerChanged) \
+	X(MenuQueryCancel,            PSF_MenuQueryCancel) \
+	X(MenuSelection,              PSF_MenuSelection) \
+	X(IsFulfilled,                PSF_IsFulfilled) \
+	X(IsFulfilledforPlr,          PSF_IsFulfilledforPlr) \
+	X(ContactLeft,                "~ContactLeft") \
+	X(ContactRight,               "~ContactRight") \
+	X(ContactTop,                 "~ContactTop") \
+	X(ContactBottom,              "~ContactBottom") \
+	X(ContactCenter,              "~ContactCenter")
+
+enum class C4DefCallback
+{
+#define C4DEF_CALLBACK_ENUM(name, function) name,
+	C4DEF_CALLBACKS(C4DEF_CALLBACK_ENUM)
+#undef C4DEF_CALLBACK_ENUM
+	Count
+};
@@ -22,8 +22,11 @@
 #include <C4Console.h>
 #include <C4ObjectCom.h>
 #include <C4Object.h>
+#include <C4Stat.h>
 #include <C4Wrappers.h>
 
+#include <iterator>
+
 // C4ScriptHost
 
 C4ScriptHost::C4ScriptHost() { Default(); }
@@ -172,10 +175,42 @@ const char *C4ScriptHost::GetControlDesc(const char *szFunctionFormat, int32_t i
 
 // C4DefScriptHost
 
+namespace
+{
+	constexpr const char *CallbackNames[]
+	{
+#define C4DEF_CALLBACK_NAME(name, function) function,
+		C4DEF_CALLBACKS(C4DEF_CALLBACK_NAME)
+#undef C4DEF_CALLBACK_NAME
+	};
+	static_assert(std::size(CallbackNames) == static_cast<std::size_t>(C4DefCallback::Count));
+
+#ifdef USE_STAT
+	// per-callback call count and time over all definitions
+	C4Stat CallbackStats[]
+	{
+#define C4DEF_CALLBACK_STAT(name, function) C4Stat{"C4DefCallback::" #name},
+		C4DEF_CALLBACKS(C4DEF_CALLBACK_STAT)
+#undef C4DEF_CALLBACK_STAT
+	};
+
+	class CallbackStatTimer
+	{
+	public:
+		CallbackStatTimer(C4Stat &stat) : stat{stat} { stat.Start(); }
+		~CallbackStatTimer() { stat.Stop(); }
+
+	private:
+		C4Stat &stat;
+	};
+#endif
+}
+
 void C4DefScriptHost::Default()
 {
 	C4ScriptHost::Default();
 	SFn_CalcValue = SFn_SellTo = SFn_ControlTransfer = SFn_CustomComponents = nullptr;
+	Callbacks.fill(nullptr);
 	ControlMethod[0] = ControlMethod[1] = ContainedControlMethod[0] = ContainedControlMethod[1] = ActivationControlMethod[0] = ActivationControlMethod[1] = 0;
 }
 
@@ -188,6 +223,8 @@ void C4DefScriptHost::AfterLink()
 	SFn_SellTo           = GetSFunc(PSF_SellTo,              AA_PROTECTED);
 	SFn_ControlTransfer  = GetSFunc(PSF_ControlTransfer,     AA_PROTECTED);
 	SFn_CustomComponents = GetSFunc(PSF_GetCustomComponents, AA_PROTECTED);
+	for (std::size_t i{0}; i < Callbacks.size(); ++i)
+		Callbacks[i] = GetSFunc(CallbackNames[i]);
 	if (Def)
 	{
 		C4AulAccess CallAccess = AA_PRIVATE;
@@ -207,6 +244,17 @@ void C4DefScriptHost::AfterLink()
 	GetControlMethodMask(PSF_Activate,         ActivationControlMethod[0], ActivationControlMethod[1]);
 }
 
+C4Value C4DefScriptHost::CallbackCall(C4Object *pObj, C4DefCallback callback, const C4AulParSet &pPars, bool fPassError, bool convertNilToIntBool)
+{
+	// cached function; called by the object itself, so no access check is needed
+	C4AulScriptFunc *const pFn{GetCallback(callback)};
+	if (!pFn) return C4VNull;
+#ifdef USE_STAT
+	CallbackStatTimer timer{CallbackStats[static_cast<std::size_t>(callback)]};
+#endif
+	return pFn->Exec(pObj, pPars, fPassError, true, convertNilToIntBool);
+}
+
 // C4GameScriptHost
 
 C4GameScriptHost::C4GameScriptHost() : Counter(0), Go(false) {}
@@ -21,6 +21,9 @@
 #include <C4ComponentHost.h>
 
 #include <C4Aul.h>
+#include <C4Script.h>
+
+#include <array>
 
 // generic script host for objects
 class C4ScriptHost : public C4AulScript, public C4ComponentHost
@@ -69,9 +72,14 @@ public:
 
 	bool Delete() override { return false; } // do NOT delete this - it's just a class member!
 
+	C4Value CallbackCall(C4Object *pObj, C4DefCallback callback, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false, bool convertNilToIntBool = true); // call cached callback in object context
+	C4AulScriptFunc *GetCallback(C4DefCallback callback) const { return Callbacks[static_cast<std::size_t>(callback)]; }
+
 protected:
 	void AfterLink() override; // get common funcs
 
+	std::array<C4AulScriptFunc *, static_cast<std::size_t>(C4DefCallback::Count)> Callbacks; // engine callbacks, resolved on (re)link
+
 public:
 	C4AulScriptFunc *SFn_CalcValue; // get object value
 	C4AulScriptFunc *SFn_SellTo; // player par(0) sold the object
@@ -23,9 +23,13 @@
 #include <C4Log.h>
 #include <C4Config.h>
 #include <C4Application.h>
+#include <C4Group.h>
+#include <C4Stat.h>
 
 #include <algorithm>
+#include <cctype>
 #include <iterator>
+#include <stdexcept>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -107,6 +111,11 @@ void C4SoundSystem::LoadEffects(C4Group &group)
 {
 	if (!Application.AudioSystem) return;
 
+	C4ST_STARTNEW(LoadEffectsStat, "C4SoundSystem::LoadEffects")
+	const auto start = std::chrono::steady_clock::now();
+	const std::string groupPath{group.GetFullName().getData()};
+	std::size_t count{0}, size{0};
+
 	// Process segmented list of file types
 	for (const auto fileType : { "*.wav", "*.ogg", "*.mp3" })
 	{
@@ -115,24 +124,29 @@ void C4SoundSystem::LoadEffects(C4Group &group)
 		group.ResetSearch();
 		while (group.FindNextEntry(fileType, filename))
 		{
-			// Try to find existing sample of the same name
-			const auto existingSample = std::find_if(samples.cbegin(), samples.cend(),
-				[&](const auto &sample) { return SEqualNoCase(filename, sample.name.c_str()); });
-			// Load sample
+			// Load file data only; decoding is deferred until the sample is played
 			StdBuf buf;
 			if (!group.LoadEntry(filename, buf)) continue;
-			try
-			{
-				samples.emplace_back(filename, buf.getData(), buf.getSize());
-				// Overload (i.e. remove) existing sample of the same name
-				if (existingSample != samples.cend()) samples.erase(existingSample);
-			}
-			catch (const std::runtime_error &e)
+			size += buf.getSize();
+			++count;
+
+			encodedSize += buf.getSize();
+			auto &sample = samples.emplace_back(filename, std::move(buf));
+			// Overload (i.e. remove) existing sample of the same name
+			auto &indexEntry = sampleIndex[GetIndexKey(filename)];
+			if (indexEntry)
 			{
-				LogNTr(spdlog::level::err, "Could not load sound effect \"{}/{}\": {}", group.GetFullName().getData(), +filename, e.what());
+				encodedSize -= indexEntry->data.getSize();
+				decodedSize -= indexEntry->GetDecodedSize();
+				samples.remove_if([existing = indexEntry](const auto &sample) { return &sample == existing; });
 			}
+			indexEntry = &sample;
 		}
 	}
+
+	spdlog::debug("Loaded {} sound effects ({} bytes) from {} in {} ms", count, size, groupPath,
+		std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count());
+	C4ST_STOP(LoadEffectsStat)
 }
 
 bool C4SoundSystem::ToggleOnOff()
@@ -141,8 +155,21 @@ bool C4SoundSystem::ToggleOnOff()
 	return enabled = !enabled;
 }
 
-C4SoundSystem::Sample::Sample(const char *const name, const void *const buf, const std::size_t size)
-	: name{name}, sample{Application.AudioSystem->CreateSoundFile(buf, size)}, duration{sample->GetDuration()} {}
+C4SoundSystem::Sample::Sample(const char *const name, StdBuf &&data)
+	: name{name}, data{std::move(data)} {}
+
+void C4SoundSystem::Sample::Decode()
+{
+	if (sample) return;
+	sample.reset(Application.AudioSystem->CreateSoundFile(data.getData(), data.getSize()));
+	duration = sample->GetDuration();
+}
+
+void C4SoundSystem::Sample::Unload()
+{
+	assert(instances.empty());
+	sample.reset();
+}
 
 void C4SoundSystem::Sample::Execute()
 {
@@ -273,14 +300,27 @@ auto C4SoundSystem::FindInst(const char *wildcard, const C4Object *const obj) ->
 	const auto wildcardStr = PrepareFilename(wildcard);
 	wildcard = wildcardStr.c_str();
 
-	for (auto &sample : samples)
+	const auto findInSample = [obj](Sample &sample) -> std::optional<decltype(Sample::instances)::iterator>
 	{
-		// Skip samples whose names do not match the wildcard
-		if (!WildcardMatch(wildcard, sample.name.c_str())) continue;
-		// Try to find an instance that is bound to obj
 		auto it = std::find_if(sample.instances.begin(), sample.instances.end(),
 			[&](const auto &inst) { return inst.GetObj() == obj; });
 		if (it != sample.instances.end()) return it;
+		return {};
+	};
+
+	// Exact name: Look up directly
+	if (!HasWildcard(wildcardStr))
+	{
+		if (const auto sample = FindSample(wildcard)) return findInSample(*sample);
+		return {};
+	}
+
+	for (auto &sample : samples)
+	{
+		// Skip samples whose names do not match the wildcard
+		if (sample.instances.empty() || !WildcardMatch(wildcard, sample.name.c_str())) continue;
+		// Try to find an instance that is bound to obj
+		if (const auto it = findInSample(sample)) return it;
 	}
 
 	// Not found
@@ -309,15 +349,11 @@ auto C4SoundSystem::NewInstance(const char *filename, const bool loop,
 
 	Sample *sample;
 	// Search for matching file if name contains no wildcard
-	if (filenameStr.find('?') == std::string::npos)
+	if (!HasWildcard(filenameStr))
 	{
-		const auto end = samples.end();
-		const auto it = std::find_if(samples.begin(), end,
-			[&](const auto &sample) { return SEqualNoCase(filename, sample.name.c_str()); });
+		sample = FindSample(filename);
 		// File not found
-		if (it == end) return nullptr;
-		// Success: Found the file
-		sample = &*it;
+		if (!sample) return nullptr;
 	}
 	// Randomly select any matching file if name contains wildcard
 	else
@@ -347,6 +383,9 @@ auto C4SoundSystem::NewInstance(const char *filename, const bool loop,
 			[](const auto &inst) { return !inst.GetObj(); });
 	if (nearIt != sample->instances.cend()) return nullptr;
 
+	// Decode on first use
+	if (!PrepareSample(*sample)) return nullptr;
+
 	// Create instance
 	auto &inst = sample->instances.emplace_back(*sample, loop, volume, obj, falloffDistance);
 	if (!inst.Execute(true))
@@ -358,6 +397,66 @@ auto C4SoundSystem::NewInstance(const char *filename, const bool loop,
 	return &inst;
 }
 
+auto C4SoundSystem::FindSample(const char *const name) -> Sample *
+{
+	const auto it = sampleIndex.find(GetIndexKey(name));
+	return it != sampleIndex.end() ? it->second : nullptr;
+}
+
+bool C4SoundSystem::PrepareSample(Sample &sample)
+{
+	sample.lastUsed = ++useCounter;
+	if (sample.sample) return true;
+	if (sample.failed) return false;
+
+	try
+	{
+		sample.Decode();
+	}
+	catch (const std::runtime_error &e)
+	{
+		LogNTr(spdlog::level::err, "Could not load sound effect \"{}\": {}", sample.name, e.what());
+		// Don't log and decode again whenever it is played
+		sample.failed = true;
+		encodedSize -= sample.data.getSize();
+		sample.data.Clear();
+		return false;
+	}
+
+	decodedSize += sample.GetDecodedSize();
+	FreeDecodedSamples(&sample);
+	return true;
+}
+
+void C4SoundSystem::FreeDecodedSamples(const Sample *const keep)
+{
+	const auto limit = static_cast<std::size_t>(std::max(Config.Sound.MaxDecodedSoundMemory, 0)) * 1024;
+	while (decodedSize > limit)
+	{
+		// Free the least recently used sample that is not playing
+		Sample *oldest{nullptr};
+		for (auto &sample : samples)
+		{
+			if (&sample != keep && sample.sample && sample.instances.empty() && (!oldest || sample.lastUsed < oldest->lastUsed))
+			{
+				oldest = &sample;
+			}
+		}
+
+		if (!oldest) break;
+
+		decodedSize -= oldest->GetDecodedSize();
+		oldest->Unload();
+	}
+}
+
+std::string C4SoundSystem::GetIndexKey(const char *const name)
+{
+	std::string key{name};
+	std::transform(key.begin(), key.end(), key.begin(), [](const unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return key;
+}
+
 std::string C4SoundSystem::PrepareFilename(const char *const filename)
 {
 	auto result = *GetExtension(filename) ?
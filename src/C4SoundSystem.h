@@ -20,6 +20,7 @@
 
 #include <C4AudioSystem.h>
 #include <C4Object.h>
+#include <StdBuf.h>
 
 #include <chrono>
 #include <cstddef>
@@ -27,6 +28,7 @@
 #include <list>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <variant>
 
 bool IsSoundPlaying(const char *name, const C4Object *obj);
@@ -56,18 +58,29 @@ public:
 	void LoadEffects(C4Group &group);
 	// Call whenever the user wants to toggle sound playback
 	bool ToggleOnOff();
+	// Memory held by encoded file data of all samples
+	std::size_t GetEncodedSize() const { return encodedSize; }
+	// Memory held by decoded sample data
+	std::size_t GetDecodedSize() const { return decodedSize; }
 
 private:
 	struct Instance;
 
+	// Samples keep their encoded file data and are only decoded when they are played.
+	// Decoded data of samples that are not playing is freed least recently used first
+	// once the decoded size exceeds Config.Sound.MaxDecodedSoundMemory; such samples are
+	// decoded from their file data again when they are played next, as their group may be gone by then.
 	struct Sample
 	{
 		const std::string name;
-		const std::unique_ptr<C4AudioSystem::SoundFile> sample;
-		const std::uint32_t duration;
+		StdBuf data;
+		std::unique_ptr<C4AudioSystem::SoundFile> sample;
+		std::uint32_t duration{0};
+		std::uint64_t lastUsed{0};
+		bool failed{false}; // could not be decoded; its file data is dropped and it is not tried again
 		std::list<Instance> instances;
 
-		Sample(const char *const name, const void *const buf, const std::size_t size);
+		Sample(const char *const name, StdBuf &&data);
 		Sample(const Sample &) = delete;
 		Sample(Sample &&) = delete;
 		~Sample() = default;
@@ -75,6 +88,10 @@ private:
 		Sample &operator=(Sample &&) = delete;
 
 		void Execute();
+		// Decodes the sample if necessary. Throws on failure.
+		void Decode();
+		void Unload();
+		std::size_t GetDecodedSize() const { return sample ? sample->GetSize() : 0; }
 	};
 
 	struct Instance
@@ -124,6 +141,20 @@ private:
 
 	static constexpr std::int32_t MaxSoundInstances = 20;
 	std::list<Sample> samples;
+	// Case-insensitive index for lookups by exact name; wildcards still scan samples
+	std::unordered_map<std::string, Sample *> sampleIndex;
+	std::size_t encodedSize{0};
+	std::size_t decodedSize{0};
+	std::uint64_t useCounter{0};
+
+	// Returns the sample with exactly the specified name (case-insensitive)
+	Sample *FindSample(const char *name);
+	// Decodes the sample if necessary and frees decoded data of unused samples if over budget
+	bool PrepareSample(Sample &sample);
+	void FreeDecodedSamples(const Sample *keep);
+	static std::string GetIndexKey(const char *name);
+	// Only after PrepareFilename, which replaces "*" with "?"
+	static bool HasWildcard(const std::string &name) { return name.find('?') != std::string::npos; }
 
 	// Returns a sound instance that matches the specified name and object.
 	std::optional<decltype(Sample::instances)::iterator> FindInst(
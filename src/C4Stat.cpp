@@ -20,7 +20,10 @@
 #include <C4Include.h>
 #include <C4Stat.h>
 
+#include <C4Application.h>
 #include <C4Game.h>
+#include <C4Surface.h>
+#include <C4Pool.h>
 
 // ** implemetation of C4MainStat
 
@@ -78,6 +81,7 @@ void C4MainStat::Reset()
 	CloseStatFile();
 	for (C4Stat *pAkt = pFirst; pAkt; pAkt = pAkt->pNext)
 		pAkt->Reset();
+	C4Pool::ResetStats();
 }
 
 void C4MainStat::ResetPart()
@@ -143,14 +147,31 @@ void C4MainStat::Show()
 
 		// output it!
 		if (pAkt->iCount)
-			fprintf(StatFile, "%s: n = %d, t = %d, td = %.2f\n",
-				pAkt->strName, pAkt->iCount, pAkt->iTimeSum,
-				double(pAkt->iTimeSum) / std::max<int>(1, pAkt->iCount - 100) * 1000);
+			fprintf(StatFile, "%s: n = %d, t = %llu, td = %.2f\n",
+				pAkt->strName, pAkt->iCount, static_cast<unsigned long long>(pAkt->iTimeSum / 1000),
+				double(pAkt->iTimeSum) / std::max<int>(1, static_cast<int>(pAkt->iCount) - static_cast<int>(C4Stat::WarmUpCalls)));
 	}
 
 	// delete...
 	delete[] StatArray;
 
+	// texture upload statistics
+	if (pTexMgr)
+		fprintf(StatFile, "Texture uploads: n = %llu, rects = %llu, bytes = %llu\n",
+			static_cast<unsigned long long>(pTexMgr->UploadCalls), static_cast<unsigned long long>(pTexMgr->UploadedRects),
+			static_cast<unsigned long long>(pTexMgr->UploadedBytes));
+
+	// sound effect memory
+	if (Application.SoundSystem)
+		fprintf(StatFile, "Sound effects: encoded = %zu bytes, decoded = %zu bytes\n",
+			Application.SoundSystem->GetEncodedSize(), Application.SoundSystem->GetDecodedSize());
+
+	// engine object pools
+	for (C4Pool *pPool = C4Pool::GetFirst(); pPool; pPool = pPool->GetNext())
+		fprintf(StatFile, "Pool %s: live = %zu, slabs = %zu, allocs = %llu, allocs/frame = %.2f\n",
+			pPool->GetName(), pPool->GetLive(), pPool->GetSlabCount(), static_cast<unsigned long long>(pPool->GetAllocations()),
+			double(pPool->GetAllocations()) / std::max<std::uint32_t>(1, pPool->GetFrames()));
+
 	// ok. job done
 	fputs("** Stat end\n", StatFile);
 	fflush(StatFile);
@@ -169,7 +190,11 @@ void C4MainStat::ShowPart()
 
 	// insert all stats
 	for (pAkt = pFirst; pAkt; pAkt = pAkt->pNext)
-		fprintf(StatFile, "%s: n=%d, t=%d\n", pAkt->strName, pAkt->iCountPart, pAkt->iTimeSumPart);
+		fprintf(StatFile, "%s: n=%d, t=%llu\n", pAkt->strName, pAkt->iCountPart, static_cast<unsigned long long>(pAkt->iTimeSumPart / 1000));
+	for (C4Pool *pPool = C4Pool::GetFirst(); pPool; pPool = pPool->GetNext())
+		fprintf(StatFile, "Pool %s: live=%zu, lastframe=%u\n", pPool->GetName(), pPool->GetLive(), pPool->GetLastFrameAllocations());
+	if (Application.SoundSystem)
+		fprintf(StatFile, "Sound effects: encoded=%zu, decoded=%zu\n", Application.SoundSystem->GetEncodedSize(), Application.SoundSystem->GetDecodedSize());
 
 	// insert part stat end idtf
 	fprintf(StatFile, "** PartStat end\n");
@@ -22,6 +22,8 @@
 #include "Standard.h"
 
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
 
 class C4Stat;
@@ -45,6 +47,8 @@ public:
 	void OpenStatFile();
 	void CloseStatFile();
 
+	C4Stat *GetFirst() const { return pFirst; }
+
 	FILE *StatFile;
 	bool bStatFileOpen;
 
@@ -69,7 +73,7 @@ public:
 	inline void Start()
 	{
 		if (!iStartCalled)
-			iStartTick = timeGetTime();
+			iStartTick = std::chrono::steady_clock::now();
 		iCount++;
 		iCountPart++;
 		iStartCalled++;
@@ -79,9 +83,9 @@ public:
 	{
 		assert(iStartCalled);
 		iStartCalled--;
-		if (!iStartCalled && iCount >= 100)
+		if (!iStartCalled && iCount >= WarmUpCalls)
 		{
-			unsigned int iTime = timeGetTime() - iStartTick;
+			const auto iTime = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - iStartTick).count());
 
 			iTimeSum += iTime;
 			iTimeSumPart += iTime;
@@ -91,31 +95,39 @@ public:
 	void Reset();
 	void ResetPart();
 
+	const char *GetName() const { return strName; }
+	unsigned int GetCount() const { return iCount; }
+	std::uint64_t GetTimeSum() const { return iTimeSum; } // microseconds
+	C4Stat *GetNext() const { return pNext; }
+
 	static C4MainStat *getMainStat();
 
+	// calls after a reset that are counted, but not timed, so rare cold starts don't distort the times
+	static inline unsigned int WarmUpCalls{100};
+
 protected:
 	// used by C4MainStat
 	C4Stat *pNext;
 	C4Stat *pPrev;
 
 	// start tick
-	unsigned int iStartTick;
+	std::chrono::steady_clock::time_point iStartTick;
 
 	// start-call depth
 	unsigned int iStartCalled;
 
 	// ** statistic data
 
-	// sum of times
-	unsigned int iTimeSum;
+	// sum of times (microseconds)
+	std::uint64_t iTimeSum;
 
 	// number of starts called
 	unsigned int iCount;
 
 	// ** statistic data (partial stat)
 
-	// sum of times
-	unsigned int iTimeSumPart;
+	// sum of times (microseconds)
+	std::uint64_t iTimeSumPart;
 
 	// number of starts called
 	unsigned int iCountPart;
@@ -151,6 +163,9 @@ protected:
 // resets the partial statistic
 #define C4ST_RESETPART C4Stat::getMainStat()->ResetPart();
 
+// sets the number of calls not timed after a reset
+#define C4ST_SETWARMUP(iCalls) C4Stat::WarmUpCalls = (iCalls);
+
 #else
 
 #define C4ST_STARTNEW(StatName, strName)
@@ -161,5 +176,6 @@ protected:
 #define C4ST_SHOWPARTSTAT
 #define C4ST_RESET
 #define C4ST_RESETPART
+#define C4ST_SETWARMUP(iCalls)
 
 #endif
@@ -20,6 +20,7 @@
 #include <C4Group.h>
 #include <C4GroupSet.h>
 #include <C4Log.h>
+#include <C4Stat.h>
 #include <C4Surface.h>
 
 #include <Bitmap256.h>
@@ -33,6 +34,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <stdexcept>
 
@@ -739,6 +741,35 @@ bool C4Surface::SetPixDw(int iX, int iY, uint32_t dwClr)
 	return true;
 }
 
+bool C4Surface::SetPixRowDw(int iX, const int iY, const uint32_t *pRow, int iWdt)
+{
+	// clip
+	if (iY < ClipY || iY > ClipY2) return true;
+	if (iX < ClipX) { pRow += ClipX - iX; iWdt -= ClipX - iX; iX = ClipX; }
+	if (iX + iWdt > ClipX2 + 1) iWdt = ClipX2 + 1 - iX;
+	if (iWdt <= 0) return true;
+	if (!ppTex) return false;
+	// write the parts of the row in each texture
+	while (iWdt > 0)
+	{
+		C4TexRef *pTexRef;
+		int iTexX = iX, iTexY = iY;
+		if (!GetLockTexAt(&pTexRef, iTexX, iTexY)) return false;
+		const int iPartWdt{(std::min)(iWdt, iTexSize - iTexX)};
+		pTexRef->SetPixRow(iTexX, iTexY, pRow, iPartWdt);
+		iX += iPartWdt; pRow += iPartWdt; iWdt -= iPartWdt;
+	}
+	// success
+	return true;
+}
+
+void C4Surface::SetKeepInRAM(const bool fKeep)
+{
+	if (!ppTex) return;
+	for (int i = 0; i < iTexX * iTexY; ++i)
+		ppTex[i]->fKeepInRAM = fKeep;
+}
+
 bool C4Surface::BltPix(int iX, int iY, C4Surface *sfcSource, int iSrcX, int iSrcY, bool fTransparency)
 {
 	// lock target
@@ -761,6 +792,7 @@ bool C4Surface::BltPix(int iX, int iY, C4Surface *sfcSource, int iSrcX, int iSrc
 		else
 			BltAlpha(*pPix, srcPix);
 	}
+	pTexRef->MarkDirty(iX, iY);
 	// done
 	return true;
 }
@@ -835,6 +867,7 @@ bool C4Surface::CopyBytes(uint8_t *pImageData)
 				pSource += iSrcPitch;
 				pTarget += pTex->iSize * 4;
 			}
+			pTex->MarkDirty({0, 0, iCpyNum / 4, iYMax});
 			pSource += iCpyNum - iSrcPitch * iYMax;
 			iXImgPos += pTex->iSize;
 		}
@@ -986,6 +1019,7 @@ bool C4Surface::ReadPNG(C4Group &hGroup)
 				}
 			}
 		}
+		pTexRef->MarkDirty({0, 0, maxX, maxY});
 		pTexRef->Unlock();
 	}
 	// unlock
@@ -1072,7 +1106,7 @@ bool C4Surface::ReadJPEG(C4Group &hGroup)
 	return true;
 }
 
-C4TexRef::C4TexRef(int iSize, bool fSingle) : LockCount{0}
+C4TexRef::C4TexRef(int iSize, bool fSingle) : fKeepInRAM{false}, LockCount{0}, fLockMirrorsTexture{false}, DirtySpans(iSize, DirtySpan{iSize, 0}), DirtyTop{iSize}, DirtyBottom{0}
 {
 	// zero fields
 #ifndef USE_CONSOLE
@@ -1113,6 +1147,9 @@ C4TexRef::C4TexRef(int iSize, bool fSingle) : LockCount{0}
 	memset(texLock.pBits, 0xff, texLock.Pitch * iSize);
 	// Always locked
 	LockSize = {0, 0, iSize, iSize};
+	// the initial contents need to be uploaded completely
+	MarkDirty(LockSize);
+	fLockMirrorsTexture = true;
 }
 
 C4TexRef::~C4TexRef()
@@ -1149,6 +1186,8 @@ bool C4TexRef::LockForUpdate(const C4Rect rect)
 			Unlock();
 		}
 	}
+	// textures kept in RAM are locked completely once, so later writes can be compared against their content
+	if (fKeepInRAM) return Lock();
 	// lock
 #ifndef USE_CONSOLE
 	if (pGL)
@@ -1157,6 +1196,9 @@ bool C4TexRef::LockForUpdate(const C4Rect rect)
 		texLock.pBits = new unsigned char[rect.Wdt * rect.Hgt * 4];
 		texLock.Pitch = rect.Wdt * 4;
 		LockSize = rect;
+		// the content is discarded: only pixels actually written are uploaded
+		ClearDirty();
+		fLockMirrorsTexture = false;
 		return true;
 	}
 	else
@@ -1184,6 +1226,9 @@ bool C4TexRef::Lock()
 		texLock.Pitch = iSize * 4;
 		glBindTexture(GL_TEXTURE_2D, texName);
 		glGetTexImage(GL_TEXTURE_2D, 0, GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texLock.pBits);
+		// the lock mirrors the texture now, so nothing needs to be uploaded yet
+		ClearDirty();
+		fLockMirrorsTexture = true;
 		++LockCount;
 		return true;
 	}
@@ -1207,15 +1252,17 @@ void C4TexRef::Unlock([[maybe_unused]] bool noUpload)
 		{
 			// select context, if not already done
 			if (!pGL->pCurrCtx) if (!pGL->MainCtx.Select()) return;
-			glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-			glBindTexture(GL_TEXTURE_2D, texName);
-			glTexSubImage2D(GL_TEXTURE_2D, 0,
-				LockSize.x, LockSize.y, LockSize.Wdt, LockSize.Hgt,
-				GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, texLock.pBits);
+			Upload();
+		}
+		if (fKeepInRAM && fLockMirrorsTexture)
+		{
+			// keep the data: it still mirrors the texture after the upload
 		}
-		if (!noUpload || Config.Graphics.CacheTexturesInRAM == -1 || LockCount < Config.Graphics.CacheTexturesInRAM)
+		else if (!noUpload || Config.Graphics.CacheTexturesInRAM == -1 || LockCount < Config.Graphics.CacheTexturesInRAM)
 		{
 			delete[] texLock.pBits; texLock.pBits = nullptr;
+			// pending changes are lost with the data
+			ClearDirty();
 		}
 		// switch back to original context
 	}
@@ -1226,6 +1273,157 @@ void C4TexRef::Unlock([[maybe_unused]] bool noUpload)
 	}
 }
 
+void C4TexRef::MarkDirty(C4Rect rect)
+{
+	rect.Intersect(C4Rect{0, 0, iSize, iSize});
+	if (rect.Wdt <= 0 || rect.Hgt <= 0) return;
+
+	for (int32_t y{rect.y}; y < rect.y + rect.Hgt; ++y)
+	{
+		DirtySpan &span{DirtySpans[y]};
+		span.Left = std::min(span.Left, rect.x);
+		span.Right = std::max(span.Right, rect.x + rect.Wdt);
+	}
+
+	DirtyTop = std::min(DirtyTop, rect.y);
+	DirtyBottom = std::max(DirtyBottom, rect.y + rect.Hgt);
+}
+
+void C4TexRef::SetPixRow(const int iX, const int iY, const uint32_t *const pRow, const int iWdt)
+{
+	uint32_t *const pTarget{reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(texLock.pBits) + (iY - LockSize.y) * texLock.Pitch) + iX - LockSize.x};
+	if (!fLockMirrorsTexture)
+	{
+		// the previous content is unknown, so the whole row has to be uploaded
+		std::copy_n(pRow, iWdt, pTarget);
+		MarkDirty({iX, iY, iWdt, 1});
+		return;
+	}
+
+	// skip unchanged pixels at both ends
+	int iLeft{0}, iRight{iWdt};
+	while (iLeft < iRight && pTarget[iLeft] == pRow[iLeft]) ++iLeft;
+	while (iRight > iLeft && pTarget[iRight - 1] == pRow[iRight - 1]) --iRight;
+	if (iLeft == iRight) return;
+	std::copy(pRow + iLeft, pRow + iRight, pTarget + iLeft);
+	MarkDirty({iX + iLeft, iY, iRight - iLeft, 1});
+}
+
+void C4TexRef::ClearDirty()
+{
+	for (int32_t y{DirtyTop}; y < DirtyBottom; ++y)
+	{
+		DirtySpans[y] = {iSize, 0};
+	}
+
+	DirtyTop = iSize;
+	DirtyBottom = 0;
+}
+
+void C4TexRef::Upload()
+{
+#ifndef USE_CONSOLE
+	if (!IsDirty()) return;
+
+	C4ST_STARTNEW(UploadStat, "C4TexRef::Upload")
+
+	// Coalesce consecutive dirty rows into rects spanning the union of their column ranges.
+	// Typical landscape changes (digging, blasting) are convex, so the overhead over exact spans is small,
+	// while the number of separate uploads stays low.
+	std::vector<C4Rect> rects;
+	std::size_t size{0};
+	for (int32_t y{DirtyTop}; y < DirtyBottom; ++y)
+	{
+		const DirtySpan &span{DirtySpans[y]};
+		if (span.Left >= span.Right) continue;
+
+		if (!rects.empty())
+		{
+			C4Rect &last{rects.back()};
+			if (last.y + last.Hgt == y)
+			{
+				size -= static_cast<std::size_t>(last.Wdt) * last.Hgt * 4;
+				const int32_t left{std::min(last.x, span.Left)};
+				last.Wdt = std::max(last.x + last.Wdt, span.Right) - left;
+				last.x = left;
+				++last.Hgt;
+				size += static_cast<std::size_t>(last.Wdt) * last.Hgt * 4;
+				continue;
+			}
+		}
+
+		rects.emplace_back(span.Left, y, span.Right - span.Left, 1);
+		size += static_cast<std::size_t>(span.Right - span.Left) * 4;
+	}
+
+	ClearDirty();
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glBindTexture(GL_TEXTURE_2D, texName);
+
+	const auto source = [this](const C4Rect &rect, const int32_t row)
+	{
+		assert(LockSize.Contains(rect));
+		return texLock.pBits + (rect.y + row - LockSize.y) * texLock.Pitch + (rect.x - LockSize.x) * 4;
+	};
+
+	bool uploaded{false};
+	if (pGL->TexUploadBuffer)
+	{
+		// stream the spans through a pixel buffer object, so the driver can transfer them asynchronously
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pGL->TexUploadBuffer);
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+		if (auto *const buffer = static_cast<std::uint8_t *>(glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY)))
+		{
+			std::size_t offset{0};
+			for (const auto &rect : rects)
+			{
+				const std::size_t rowSize{static_cast<std::size_t>(rect.Wdt) * 4};
+				for (int32_t row{0}; row < rect.Hgt; ++row)
+				{
+					std::memcpy(buffer + offset + row * rowSize, source(rect, row), rowSize);
+				}
+
+				offset += rowSize * rect.Hgt;
+			}
+
+			if (glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER))
+			{
+				offset = 0;
+				for (const auto &rect : rects)
+				{
+					glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.Wdt, rect.Hgt,
+						GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, reinterpret_cast<const void *>(offset));
+					offset += static_cast<std::size_t>(rect.Wdt) * rect.Hgt * 4;
+				}
+
+				uploaded = true;
+			}
+		}
+
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	if (!uploaded)
+	{
+		// upload directly from the lock data
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, LockSize.Wdt);
+		for (const auto &rect : rects)
+		{
+			glTexSubImage2D(GL_TEXTURE_2D, 0, rect.x, rect.y, rect.Wdt, rect.Hgt,
+				GL_BGRA, GL_UNSIGNED_INT_8_8_8_8_REV, source(rect, 0));
+		}
+		glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+	}
+
+	pTexMgr->UploadedBytes += size;
+	pTexMgr->UploadedRects += rects.size();
+	++pTexMgr->UploadCalls;
+
+	C4ST_STOP(UploadStat)
+#endif
+}
+
 bool C4TexRef::ClearRect(const C4Rect rect)
 {
 	// ensure locked
@@ -1246,6 +1444,7 @@ bool C4TexRef::FillBlack()
 	if (!Lock()) return false;
 	// clear pixels
 	std::fill_n(reinterpret_cast<std::uint32_t *>(texLock.pBits), iSize * iSize, 0);
+	MarkDirty(LockSize);
 	// success
 	return true;
 }
@@ -27,6 +27,7 @@
 #endif
 
 #include <list>
+#include <vector>
 
 // config settings
 #define C4GFXCFG_NO_ALPHA_ADD    1
@@ -94,6 +95,8 @@ public:
 	uint32_t GetPixDw(int iX, int iY, bool fApplyModulation, float scale = 1.0); // get 32bit-px
 	bool IsPixTransparent(int iX, int iY); // is pixel's alpha value 0xff?
 	bool SetPixDw(int iX, int iY, uint32_t dwCol); // set pix in surface only
+	bool SetPixRowDw(int iX, int iY, const uint32_t *pRow, int iWdt); // set row of pixels in surface only
+	void SetKeepInRAM(bool fKeep); // keep texture data in RAM, so rewriting unchanged pixels uploads nothing
 	bool BltPix(int iX, int iY, C4Surface *sfcSource, int iSrcX, int iSrcY, bool fTransparency); // blit pixel from source to this surface (assumes clipped coordinates!)
 	bool Create(int iWdt, int iHgt, bool fOwnPal = false, bool fIsRenderTarget = false);
 	bool CreateColorByOwner(C4Surface *pBySurface); // create ColorByOwner-surface
@@ -168,6 +171,7 @@ public:
 #endif
 	int iSize;
 	bool fIntLock; // if set, texref is locked internally only
+	bool fKeepInRAM; // if set, the lock data is kept after uploading it, so writes can be compared against the texture
 	C4Rect LockSize;
 
 	C4TexRef(int iSize, bool fAsRenderTarget); // create texture with given size
@@ -183,10 +187,41 @@ public:
 	void SetPix(int iX, int iY, uint32_t v)
 	{
 		*reinterpret_cast<uint32_t *>(reinterpret_cast<uint8_t *>(texLock.pBits) + (iY - LockSize.y) * texLock.Pitch + (iX - LockSize.x) * 4) = v;
+		MarkDirty(iX, iY);
 	}
 
+	// dirty tracking: only changed spans of the locked data are uploaded on Unlock
+	// callers writing to texLock.pBits directly must mark the written area themselves
+	void MarkDirty(int iX, int iY)
+	{
+		DirtySpan &span{DirtySpans[iY]};
+		if (iX < span.Left) span.Left = iX;
+		if (iX >= span.Right) span.Right = iX + 1;
+		if (iY < DirtyTop) DirtyTop = iY;
+		if (iY >= DirtyBottom) DirtyBottom = iY + 1;
+	}
+
+	void MarkDirty(C4Rect rect);
+	bool IsDirty() const { return DirtyTop < DirtyBottom; }
+
+	// write a row of pixels; if the lock data mirrors the texture, only the changed span is marked dirty
+	void SetPixRow(int iX, int iY, const uint32_t *pRow, int iWdt);
+
 private:
+	void ClearDirty();
+	void Upload(); // send dirty spans of the locked data to the texture
+
+private:
+	struct DirtySpan
+	{
+		int32_t Left;
+		int32_t Right;
+	};
+
 	int32_t LockCount;
+	bool fLockMirrorsTexture; // lock data holds the texture contents, not just the pixels written since LockForUpdate
+	std::vector<DirtySpan> DirtySpans; // changed column range per texture row
+	int32_t DirtyTop, DirtyBottom; // changed row range
 };
 
 // texture management
@@ -204,6 +239,12 @@ public:
 
 	void IntLock(); // do an internal lock
 	void IntUnlock(); // undo internal lock
+
+public:
+	// upload statistics
+	std::uint64_t UploadedBytes{0};
+	std::uint64_t UploadedRects{0};
+	std::uint64_t UploadCalls{0};
 };
 
 extern C4TexMgr *pTexMgr;
@@ -0,0 +1,92 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4TrackedObjectPtr.h"
+
+#include "C4Object.h"
+
+#include <algorithm>
+
+C4TrackedObjectPtr &C4TrackedObjectPtr::operator=(const C4TrackedObjectPtr &other)
+{
+	if (this != &other)
+	{
+		Untrack();
+		ptr = other.ptr;
+		Track();
+	}
+	return *this;
+}
+
+C4TrackedObjectPtr &C4TrackedObjectPtr::operator=(C4Object *const obj)
+{
+	if (obj != ptr.Object())
+	{
+		Untrack();
+		ptr = obj;
+		Track();
+	}
+	return *this;
+}
+
+void C4TrackedObjectPtr::Reset()
+{
+	Untrack();
+	ptr.Reset();
+}
+
+void C4TrackedObjectPtr::Denumerate()
+{
+	Untrack();
+	ptr.Denumerate();
+	Track();
+}
+
+void C4TrackedObjectPtr::Track()
+{
+	C4Object *const obj{ptr.Object()};
+	if (!obj) return;
+	if ((nextRef = obj->FirstTrackedPtr)) nextRef->prevRefNext = &nextRef;
+	prevRefNext = &obj->FirstTrackedPtr;
+	obj->FirstTrackedPtr = this;
+}
+
+void C4TrackedObjectPtr::Untrack()
+{
+	if (!prevRefNext) return;
+	if ((*prevRefNext = nextRef)) nextRef->prevRefNext = prevRefNext;
+	nextRef = nullptr; prevRefNext = nullptr;
+}
+
+void C4TrackedObjectPtr::GetReferrers(C4Object *const target, std::vector<C4Object *> &referrers)
+{
+	referrers.clear();
+	for (C4TrackedObjectPtr *ref{target->FirstTrackedPtr}; ref; ref = ref->nextRef)
+		if (ref->owner)
+			referrers.push_back(ref->owner);
+	std::sort(referrers.begin(), referrers.end());
+	referrers.erase(std::unique(referrers.begin(), referrers.end()), referrers.end());
+}
+
+void C4TrackedObjectPtr::Detach(C4Object *const target)
+{
+	C4TrackedObjectPtr *ref{target->FirstTrackedPtr}, *next;
+	for (; ref; ref = next)
+	{
+		next = ref->nextRef;
+		ref->nextRef = nullptr; ref->prevRefNext = nullptr;
+	}
+	target->FirstTrackedPtr = nullptr;
+}
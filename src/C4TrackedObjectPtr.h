@@ -0,0 +1,66 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// object pointer of an object's engine data that registers with the target object,
+// so removing the target only needs to clear the objects actually pointing to it
+
+#pragma once
+
+#include "C4EnumeratedObjectPtr.h"
+
+#include <cstddef>
+#include <vector>
+
+class C4TrackedObjectPtr
+{
+private:
+	C4EnumeratedObjectPtr ptr;
+	C4Object *owner{}; // object whose ClearPointers clears this pointer; nullptr if cleared elsewhere
+	C4TrackedObjectPtr *nextRef{};
+	C4TrackedObjectPtr **prevRefNext{}; // nullptr if not registered
+
+public:
+	C4TrackedObjectPtr() = default;
+	C4TrackedObjectPtr(const C4TrackedObjectPtr &other) : ptr{other.ptr}, owner{other.owner} { Track(); }
+	~C4TrackedObjectPtr() { Untrack(); }
+
+	C4Object *operator->() const noexcept { return Object(); }
+	C4Object *operator*() const noexcept { return Object(); }
+	C4Object *Object() const noexcept { return ptr.Object(); }
+	C4EnumeratedObjectPtr::Enumerated Number() const noexcept { return ptr.Number(); }
+	operator C4Object *() const noexcept { return Object(); }
+
+	C4TrackedObjectPtr &operator=(const C4TrackedObjectPtr &other); // keeps the owner
+	C4TrackedObjectPtr &operator=(C4Object *obj);
+	C4TrackedObjectPtr &operator=(std::nullptr_t) { Reset(); return *this; }
+
+	void Reset();
+	void SetNumber(C4EnumeratedObjectPtr::Enumerated enumerated) noexcept { ptr.SetNumber(enumerated); }
+
+	void SetOwner(C4Object *newOwner) noexcept { owner = newOwner; }
+	C4Object *GetOwner() const noexcept { return owner; }
+
+	void Enumerate() { ptr.Enumerate(); }
+	void Denumerate();
+
+	void CompileFunc(StdCompiler *compiler, bool intPack = false) { ptr.CompileFunc(compiler, intPack); }
+
+	static void GetReferrers(C4Object *target, std::vector<C4Object *> &referrers); // owners of all pointers to target, without duplicates
+	static void Detach(C4Object *target); // target is being deleted: unregister all pointers to it
+
+private:
+	void Track();
+	void Untrack();
+};
@@ -67,6 +67,7 @@ public:
 	void Synchronize();
 	C4TransferZone *Find(C4Object *pObj);
 	C4TransferZone *Find(int32_t iX, int32_t iY);
+	bool IsEmpty() const { return !First; }
 	bool Add(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
 	bool Set(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
 };
@@ -1056,7 +1056,10 @@ void C4Viewport::Draw(C4FacetEx &cgo, bool fDrawOverlay)
 	C4ST_STARTNEW(SkyStat, "C4Viewport::Draw: Sky")
 	Game.Landscape.Sky.Draw(cgo);
 	C4ST_STOP(SkyStat)
-	Game.BackObjects.DrawAll(cgo, Player);
+	// background objects (BackObjects, in main list order)
+	C4ST_STARTNEW(BackObjStat, "C4Viewport::Draw: BackObjects")
+	Game.Objects.DrawVisible(cgo, Player, C4D_Background, false);
+	C4ST_STOP(BackObjStat)
 
 	// Draw Landscape
 	C4ST_STARTNEW(LandStat, "C4Viewport::Draw: Landscape")
@@ -1070,7 +1073,7 @@ void C4Viewport::Draw(C4FacetEx &cgo, bool fDrawOverlay)
 
 	// draw objects
 	C4ST_STARTNEW(ObjStat, "C4Viewport::Draw: Objects")
-	Game.Objects.Draw(cgo, Player);
+	Game.Objects.DrawVisible(cgo, Player, C4D_BackgroundOrForeground, true);
 	C4ST_STOP(ObjStat)
 
 	// draw global particles
@@ -154,7 +154,7 @@ bool C4Weather::LaunchLightning(int32_t x, int32_t y, int32_t xdir, int32_t xran
 {
 	C4Object *pObj;
 	if (pObj = Game.CreateObject(C4Id("FXL1"), nullptr))
-		pObj->Call(PSF_Activate, {C4VInt(x),
+		pObj->Call(C4DefCallback::Activate, {C4VInt(x),
 			C4VInt(y),
 			C4VInt(xdir),
 			C4VInt(xrange),
@@ -179,7 +179,7 @@ bool C4Weather::LaunchVolcano(int32_t mat, int32_t x, int32_t y, int32_t size)
 {
 	C4Object *pObj;
 	if (pObj = Game.CreateObject(C4Id("FXV1"), nullptr))
-		pObj->Call(PSF_Activate, {C4VInt(x), C4VInt(y), C4VInt(size), C4VInt(mat)});
+		pObj->Call(C4DefCallback::Activate, {C4VInt(x), C4VInt(y), C4VInt(size), C4VInt(mat)});
 	return true;
 }
 
@@ -197,7 +197,7 @@ bool C4Weather::LaunchEarthquake(int32_t iX, int32_t iY)
 {
 	C4Object *pObj;
 	if (pObj = Game.CreateObject(C4Id("FXQ1"), nullptr, NO_OWNER, iX, iY))
-		if (pObj->Call(PSF_Activate))
+		if (pObj->Call(C4DefCallback::Activate))
 			return true;
 	return false;
 }
@@ -207,7 +207,7 @@ bool C4Weather::LaunchCloud(int32_t iX, int32_t iY, int32_t iWidth, int32_t iStr
 	if (Game.Material.Get(szPrecipitation) == MNone) return false;
 	C4Object *pObj;
 	if (pObj = Game.CreateObject(C4Id("FXP1"), nullptr, NO_OWNER, iX, iY))
-		if (pObj->Call(PSF_Activate, {C4VInt(Game.Material.Get(szPrecipitation)),
+		if (pObj->Call(C4DefCallback::Activate, {C4VInt(Game.Material.Get(szPrecipitation)),
 			C4VInt(iWidth),
 			C4VInt(iStrength)}))
 			return true;
@@ -387,6 +387,11 @@ public:
 	void AddModulation(int cx, int cy, int iRadius1, int iRadius2, uint8_t byTransparency); // hide all within iRadius1; fade off until iRadius2
 
 	uint32_t GetModAt(int x, int y) const;
+	void GetBounds(int &x0, int &y0, int &x1, int &y1) const // bounding box of all sample points in drawing positions
+	{
+		x0 = iOffX; y0 = iOffY;
+		x1 = iOffX + (iWdt - 1) * iResolutionX; y1 = iOffY + (iHgt - 1) * iResolutionY;
+	}
 	int GetResolutionX() const { return iResolutionX; }
 	int GetResolutionY() const { return iResolutionY; }
 };
@@ -30,6 +30,7 @@
 
 #include <stdio.h>
 #include <limits.h>
+#include <algorithm>
 #include <cmath>
 #include <numbers>
 
@@ -229,6 +230,39 @@ bool CPattern::PatternClr(int iX, int iY, uint8_t &byClr, uint32_t &dwClr, CStdP
 	return true;
 }
 
+CPattern::Mode CPattern::GetMode() const
+{
+	if (CachedPattern) return Monochrome ? Mode::ModulateMono : Mode::Modulate;
+	if (sfcPattern8) return pClrs ? Mode::Replace : Mode::PaletteShift;
+	return Mode::None;
+}
+
+void CPattern::GetPixels(uint8_t byClr, uint32_t *const pdwPixels) const
+{
+	// same as PatternClr for every pattern position
+	if (CachedPattern)
+	{
+		std::copy_n(CachedPattern, Wdt * Hgt, pdwPixels);
+	}
+	else if (sfcPattern8 && pClrs)
+	{
+		const int iAShift{(byClr & 0xf0) ? 3 : 0};
+		for (int y = 0; y < Hgt; ++y)
+			for (int x = 0; x < Wdt; ++x)
+			{
+				const uint8_t byShift{sfcPattern8->GetPix(x, y)};
+				pdwPixels[y * Wdt + x] = RGB(pClrs[byShift * 3 + 2], pClrs[byShift * 3 + 1], pClrs[byShift * 3]) + (pAlpha[byShift + iAShift] << 24);
+			}
+	}
+}
+
+std::tuple<const void *, const void *, const void *> CPattern::GetPixelsKey(const uint8_t byClr) const
+{
+	if (CachedPattern) return {sfcPattern32, nullptr, nullptr};
+	// old-style patterns: the colors differ by material, the alpha values by IFT
+	return {sfcPattern8, pClrs, pAlpha ? pAlpha + ((byClr & 0xf0) ? 3 : 0) : nullptr};
+}
+
 CGammaControl::~CGammaControl()
 {
 	delete[] red;
@@ -25,6 +25,9 @@
 #include <StdBuf.h>
 
 #include <array>
+#include <functional>
+#include <memory>
+#include <tuple>
 #include <unordered_map>
 #include <vector>
 
@@ -140,6 +143,39 @@ public:
 	void Clear(); // clear pattern
 	CPattern();
 	~CPattern() { Clear(); }
+
+	// for renderers applying the pattern themselves (see CStdLandscapeRenderer)
+	enum class Mode { None, Modulate, ModulateMono, Replace, PaletteShift };
+	Mode GetMode() const;
+	// pattern colors as PatternClr combines them with the color of a pixel of value byClr; Wdt * Hgt values
+	void GetPixels(uint8_t byClr, uint32_t *pdwPixels) const;
+	// equal keys mean equal pixels
+	std::tuple<const void *, const void *, const void *> GetPixelsKey(uint8_t byClr) const;
+	int GetWdt() const { return Wdt; }
+	int GetHgt() const { return Hgt; }
+	int GetZoom() const { return Zoom; }
+};
+
+// what one 8 bit landscape pixel value looks like, for CStdLandscapeRenderer
+struct CStdLandscapeMaterial
+{
+	uint32_t dwClr{0}; // palette color
+	const CPattern *pPattern{nullptr}, *pMatPattern{nullptr}; // texture and material pattern, applied in this order
+	int32_t iPlacement{0}; // for material shading
+	bool fLiquid{false}; // for color animation
+};
+
+// draws the landscape from the 8 bit landscape and the material patterns, replacing the lit 32 bit landscape surface
+class CStdLandscapeRenderer
+{
+public:
+	virtual ~CStdLandscapeRenderer() = default;
+
+	// must be called again when the palette or the texture map changes; false if the materials cannot be drawn this way
+	virtual bool SetMaterials(const std::array<CStdLandscapeMaterial, 256> &materials, bool fShadeMaterials) = 0;
+	// landscape pixels changed
+	virtual void Update(int iX, int iY, int iWdt, int iHgt) = 0;
+	virtual void Draw(C4Surface *sfcLiquidAnimation, int fx, int fy, C4Surface *sfcTarget, int tx, int ty, int wdt, int hgt) = 0;
 };
 
 // blit position on screen
@@ -337,6 +373,8 @@ public:
 	// Blit
 	virtual void BlitLandscape(C4Surface *sfcSource, C4Surface *sfcSource2, C4Surface *sfcLiquidAnimation, int fx, int fy,
 		C4Surface *sfcTarget, int tx, int ty, int wdt, int hgt);
+	// nullptr if the landscape cannot be drawn from the 8 bit landscape; getPix must be bounds checked
+	virtual std::unique_ptr<CStdLandscapeRenderer> CreateLandscapeRenderer(int, int, std::function<void(int, int, int, uint8_t *)>) { return nullptr; }
 	void Blit8Fast(CSurface8 *sfcSource, int fx, int fy,
 		C4Surface *sfcTarget, int tx, int ty, int wdt, int hgt);
 	bool Blit(C4Surface *sfcSource, float fx, float fy, float fwdt, float fhgt,
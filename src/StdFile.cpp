@@ -26,7 +26,10 @@
 #ifdef _WIN32
 #include <direct.h>
 #endif
-#ifndef _WIN32
+#ifdef _WIN32
+#include "C4Windows.h"
+#else
+#include <sys/mman.h>
 #include <unistd.h>
 #endif
 #include <errno.h>
@@ -887,6 +890,56 @@ int ForEachFile(const char *szDirName, bool(*fnCallback)(const char *))
 
 // Text Files
 
+bool StdMappedFile::Open(const char *szFilename)
+{
+	Close();
+#ifdef _WIN32
+	const HANDLE hFile{CreateFileA(szFilename, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr)};
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(hFile, &size) || !size.QuadPart)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+	// the mapping keeps the file open
+	hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(hFile);
+	if (!hMapping) return false;
+	pData = MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!pData)
+	{
+		CloseHandle(hMapping); hMapping = nullptr;
+		return false;
+	}
+	iSize = static_cast<size_t>(size.QuadPart);
+#else
+	const int fd{open(szFilename, O_RDONLY)};
+	if (fd == -1) return false;
+	const size_t size{FileSize(fd)};
+	void *const data{size ? mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0) : MAP_FAILED};
+	// the mapping stays valid after closing
+	close(fd);
+	if (data == MAP_FAILED) return false;
+	pData = data;
+	iSize = size;
+#endif
+	return true;
+}
+
+void StdMappedFile::Close()
+{
+	if (!pData) return;
+#ifdef _WIN32
+	UnmapViewOfFile(pData);
+	CloseHandle(hMapping); hMapping = nullptr;
+#else
+	munmap(pData, iSize);
+#endif
+	pData = nullptr;
+	iSize = 0;
+}
+
 bool ReadFileLine(FILE *fhnd, char *tobuf, int maxlen)
 {
 	int cread;
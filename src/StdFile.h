@@ -125,5 +125,28 @@ protected:
 #endif
 };
 
+// read-only mapping of a whole file into memory
+class StdMappedFile
+{
+public:
+	StdMappedFile() = default;
+	~StdMappedFile() { Close(); }
+	StdMappedFile(const StdMappedFile &) = delete;
+	StdMappedFile &operator=(const StdMappedFile &) = delete;
+
+	bool Open(const char *szFilename); // fails for empty files
+	void Close();
+	bool IsOpen() const { return pData != nullptr; }
+	const char *GetData() const { return static_cast<const char *>(pData); }
+	size_t GetSize() const { return iSize; }
+
+protected:
+	void *pData{nullptr};
+	size_t iSize{0};
+#ifdef _WIN32
+	void *hMapping{nullptr};
+#endif
+};
+
 bool ReadFileLine(FILE *fhnd, char *tobuf, int maxlen);
 void AdvanceFileLine(FILE *fhnd);
@@ -24,11 +24,14 @@
 #include "StdFont.h"
 #include <StdDDraw2.h>
 #include <C4Surface.h>
+#include <C4Stat.h>
 #include <StdMarkup.h>
 
 #include <cmath>
+#include <cstring>
 #include <stdexcept>
 #include <string>
+#include <tuple>
 
 #ifdef _WIN32
 #include <tchar.h>
@@ -552,6 +555,7 @@ void CStdFont::Clear()
 	iNumFontSfcs = 0;
 	for (int c = ' '; c < 256; ++c) fctAsciiTexCoords[c - ' '].Default();
 	fctUnicodeMap.clear();
+	ClearLayoutCaches();
 	// set default values
 	dwDefFontHeight = iLineHgt = 10;
 	iFontZoom = 1; // default: no internal font zooming - likely no antialiasing either...
@@ -566,17 +570,40 @@ void CStdFont::Clear()
 	id = 0;
 }
 
+void CStdFont::ClearLayoutCaches()
+{
+	ExtentCache.Clear();
+	BreakCache.Clear();
+	GlyphRunCache.Clear();
+}
+
 /* Text size measurement */
 
 bool CStdFont::GetTextExtent(const char *szText, int32_t &rsx, int32_t &rsy, bool fCheckMarkup, bool ignoreScale)
 {
-	float realScale = 1.f;
-	if (!ignoreScale)
-	{
-		realScale = scale;
-	}
 	// safety
 	if (!szText) return false;
+	C4ST_STARTNEW(TextExtentStat, "CStdFont::GetTextExtent")
+	// texts with custom images are not cached, because the images may change
+	if (std::strstr(szText, "{{"))
+		MeasureText(szText, rsx, rsy, fCheckMarkup, ignoreScale ? 1.f : scale);
+	else
+	{
+		const std::string_view key{ExtentCache.MakeKey(szText, fCheckMarkup, ignoreScale)};
+		if (const auto *const extent = ExtentCache.Find(key))
+			std::tie(rsx, rsy) = *extent;
+		else
+		{
+			MeasureText(szText, rsx, rsy, fCheckMarkup, ignoreScale ? 1.f : scale);
+			ExtentCache.Insert(key, {rsx, rsy});
+		}
+	}
+	C4ST_STOP(TextExtentStat)
+	return true;
+}
+
+void CStdFont::MeasureText(const char *szText, int32_t &rsx, int32_t &rsy, bool fCheckMarkup, float realScale)
+{
 	// keep track of each row's size
 	int lineStepHeight = static_cast<int>(std::ceil(iLineHgt / realScale));
 	float iRowWdt = 0, iWdt = 0;
@@ -633,14 +660,37 @@ bool CStdFont::GetTextExtent(const char *szText, int32_t &rsx, int32_t &rsy, boo
 	}
 	// store output
 	rsx = static_cast<int>(iWdt); rsy = iHgt;
-	// done, success
-	return true;
 }
 
 int CStdFont::BreakMessage(const char *szMsg, int iWdt, StdStrBuf *pOut, bool fCheckMarkup, float fZoom, size_t maxLines)
 {
 	// safety
 	if (!szMsg || !pOut) return 0;
+	C4ST_STARTNEW(BreakMessageStat, "CStdFont::BreakMessage")
+	int iHgt;
+	// texts with custom images are not cached, because the images may change
+	if (std::strstr(szMsg, "{{"))
+		iHgt = LayoutMessage(szMsg, iWdt, pOut, fCheckMarkup, fZoom, maxLines);
+	else
+	{
+		const std::string_view key{BreakCache.MakeKey(szMsg, iWdt, fCheckMarkup, fZoom, maxLines)};
+		if (const auto *const broken = BreakCache.Find(key))
+		{
+			pOut->Copy(broken->Text.c_str(), broken->Text.size());
+			iHgt = broken->iHgt;
+		}
+		else
+		{
+			iHgt = LayoutMessage(szMsg, iWdt, pOut, fCheckMarkup, fZoom, maxLines);
+			BreakCache.Insert(key, {pOut->getLength() ? std::string{pOut->getData(), pOut->getLength()} : std::string{}, iHgt});
+		}
+	}
+	C4ST_STOP(BreakMessageStat)
+	return iHgt;
+}
+
+int CStdFont::LayoutMessage(const char *szMsg, int iWdt, StdStrBuf *pOut, bool fCheckMarkup, float fZoom, size_t maxLines)
+{
 	pOut->Clear();
 	uint32_t c;
 	const char *szPos = szMsg, // current parse position in the text
@@ -843,36 +893,35 @@ void CStdFont::DrawText(C4Surface *sfcDest, int iX, int iY, uint32_t dwColor, co
 	// set start markup transformation
 	if (!Markup.Clean()) pbt = &bt;
 	// output text
-	uint32_t c;
+	const std::vector<Glyph> &glyphs{GetGlyphRun(szText, !(dwFlags & STDFONT_NOMARKUP))};
+	std::size_t iTagEnd{0}; // text up to here has been consumed by a markup tag
 	C4Facet fctFromBlt; // source facet
-	while (c = GetNextCharacter(&szText))
+	for (const Glyph &glyph : glyphs)
 	{
-		// ignore system characters
-		if (c < _T(' ')) continue;
+		if (glyph.iOffset < iTagEnd) continue;
 		// apply markup
-		if (c == '<' && (~dwFlags & STDFONT_NOMARKUP))
+		if (glyph.eType == Glyph::Type::Tag)
 		{
 			// get tag
-			if (Markup.Read(&--szText))
+			const char *szTag{szText + glyph.iOffset};
+			if (Markup.Read(&szTag))
 			{
 				// mark transform to be done
 				// (done only if tag was found, so most normal blits don't init a trasnformation matrix)
 				pbt = &bt;
 				// skip the tag
+				iTagEnd = szTag - szText;
 				continue;
 			}
 			// invalid tag: render it as text
-			++szText;
 		}
 		float w2, h2; // dst width/height
 		// custom image?
-		int iImgLgt;
-		if (c == '{' && szText[0] == '{' && szText[1] != '{' && (iImgLgt = SCharPos('}', szText + 1)) > 0 && szText[iImgLgt + 2] == '}' && !(dwFlags & STDFONT_NOMARKUP))
+		if (glyph.eType == Glyph::Type::Image)
 		{
 			fctFromBlt.Default();
 			char imgbuf[101];
-			SCopy(szText + 1, imgbuf, (std::min)(iImgLgt, 100));
-			szText += iImgLgt + 3;
+			SCopy(szText + glyph.iOffset, imgbuf, (std::min<uint32_t>)(glyph.iLength, 100));
 			// image renderer initialized?
 			if (pCustomImages)
 				// try to get an image then
@@ -898,8 +947,8 @@ void CStdFont::DrawText(C4Surface *sfcDest, int iX, int iY, uint32_t dwColor, co
 		else
 		{
 			// regular char
-			// get texture coordinates
-			fctFromBlt = GetCharacterFacet(c);
+			// texture coordinates have been looked up with the glyph run
+			fctFromBlt = glyph.fct;
 			w2 = fctFromBlt.Wdt * fZoom; h2 = fctFromBlt.Hgt * fZoom;
 			lpDDraw->ActivateBlitModulation(dwColor);
 		}
@@ -933,6 +982,39 @@ void CStdFont::DrawText(C4Surface *sfcDest, int iX, int iY, uint32_t dwColor, co
 		lpDDraw->DeactivateBlitModulation();
 }
 
+const std::vector<CStdFont::Glyph> &CStdFont::GetGlyphRun(const char *const szText, const bool fMarkup)
+{
+	const std::string_view key{GlyphRunCache.MakeKey(szText, fMarkup)};
+	if (const auto *const glyphs = GlyphRunCache.Find(key)) return *glyphs;
+	std::vector<Glyph> glyphs;
+	const char *szPos{szText};
+	for (;;)
+	{
+		const char *const szChar{szPos};
+		const uint32_t c{GetNextCharacter(&szPos)};
+		if (!c) break;
+		// ignore system characters
+		if (c < ' ') continue;
+		const auto iOffset = static_cast<uint32_t>(szChar - szText);
+		// markup tags can only be told from text by the markup state when drawing
+		if (fMarkup && c == '<')
+		{
+			glyphs.push_back({Glyph::Type::Tag, iOffset, 0, GetCharacterFacet(c)});
+			continue;
+		}
+		// custom image? the image itself is looked up when drawing
+		int iImgLgt;
+		if (fMarkup && c == '{' && szPos[0] == '{' && szPos[1] != '{' && (iImgLgt = SCharPos('}', szPos + 1)) > 0 && szPos[iImgLgt + 2] == '}')
+		{
+			glyphs.push_back({Glyph::Type::Image, static_cast<uint32_t>(szPos + 1 - szText), static_cast<uint32_t>(iImgLgt), {}});
+			szPos += iImgLgt + 3;
+			continue;
+		}
+		glyphs.push_back({Glyph::Type::Char, iOffset, 0, GetCharacterFacet(c)});
+	}
+	return GlyphRunCache.Insert(key, std::move(glyphs));
+}
+
 int CStdFont::GetLineHeight() const
 {
 	return static_cast<int>(iLineHgt / scale);
@@ -21,10 +21,14 @@
 
 #include "C4Facet.h"
 #include "C4ForwardDeclarations.h"
+#include "C4LayoutCache.h"
 #include "C4Strings.h"
 
 #include <cstdint>
 #include <map>
+#include <string>
+#include <utility>
+#include <vector>
 
 // Font rendering flags
 #define STDFONT_CENTERED  0x0001
@@ -109,6 +113,38 @@ protected:
 	int iLineHgt; // height of one line of font (in pixels)
 	float scale = 1.f;
 
+	// most texts are measured, broken and drawn again every frame, so their layouts are kept
+	// for the least recently used texts; texts with custom images are not cached for extent and breaking,
+	// because the images may change
+	template<typename Value, typename... Params>
+	using LayoutCache = C4LayoutCache<Value, Params...>;
+
+	struct BrokenMessage
+	{
+		std::string Text;
+		int iHgt;
+	};
+
+	// text prepared for DrawText: character facets, markup tag candidates and custom images in text order
+	struct Glyph
+	{
+		enum class Type : uint8_t { Char, Tag, Image };
+
+		Type eType;
+		uint32_t iOffset; // position in the text; for images, of the image name
+		uint32_t iLength; // image name length
+		C4Facet fct; // character facet; for tags the facet of '<', drawn if the tag is invalid
+	};
+
+	LayoutCache<std::pair<int32_t, int32_t>, bool, bool> ExtentCache; // by markup flag and ignoreScale
+	LayoutCache<BrokenMessage, int, bool, float, size_t> BreakCache; // by width, markup flag, zoom and line limit
+	LayoutCache<std::vector<Glyph>, bool> GlyphRunCache; // by markup flag
+
+	void ClearLayoutCaches();
+	void MeasureText(const char *szText, int32_t &rsx, int32_t &rsy, bool fCheckMarkup, float realScale);
+	int LayoutMessage(const char *szMsg, int iWdt, StdStrBuf *pOut, bool fCheckMarkup, float fZoom, size_t maxLines);
+	const std::vector<Glyph> &GetGlyphRun(const char *szText, bool fMarkup);
+
 public:
 	// draw ine line of text
 	void DrawText(C4Surface *sfcDest, int iX, int iY, uint32_t dwColor, const char *szText, uint32_t dwFlags, CMarkup &Markup, float fZoom);
@@ -152,5 +188,6 @@ public:
 	void SetCustomImages(CustomImages *pHandler)
 	{
 		pCustomImages = pHandler;
+		ClearLayoutCaches();
 	}
 };
@@ -29,7 +29,10 @@
 
 #ifndef USE_CONSOLE
 
+#include <algorithm>
 #include <array>
+#include <map>
+#include <numeric>
 
 #include <stdio.h>
 #include <math.h>
@@ -624,17 +627,7 @@ void CStdGL::BlitLandscape(C4Surface *const sfcSource, C4Surface *const sfcSourc
 
 		if (sfcSource2)
 		{
-			static GLfloat value[4] = { -0.6f / 3, 0.0f, 0.6f / 3, 0.0f };
-			value[0] += 0.05f; value[1] += 0.05f; value[2] += 0.05f;
-			GLfloat mod[4];
-			for (int i = 0; i < 3; ++i)
-			{
-				if (value[i] > 0.9f) value[i] = -0.3f;
-				mod[i] = (value[i] > 0.3f ? 0.6f - value[i] : value[i]) / 3.0f;
-			}
-			mod[3] = 0;
-
-			LandscapeShader.SetUniform("modulation", glUniform4fv, 1, mod);
+			LandscapeShader.SetUniform("modulation", glUniform4fv, 1, NextLiquidModulation().data());
 		}
 	}
 	// texture environment
@@ -781,6 +774,314 @@ void CStdGL::BlitLandscape(C4Surface *const sfcSource, C4Surface *const sfcSourc
 	ResetTexture();
 }
 
+std::array<GLfloat, 4> CStdGL::NextLiquidModulation()
+{
+	static GLfloat value[4] = { -0.6f / 3, 0.0f, 0.6f / 3, 0.0f };
+	value[0] += 0.05f; value[1] += 0.05f; value[2] += 0.05f;
+	std::array<GLfloat, 4> mod;
+	for (int i = 0; i < 3; ++i)
+	{
+		if (value[i] > 0.9f) value[i] = -0.3f;
+		mod[i] = (value[i] > 0.3f ? 0.6f - value[i] : value[i]) / 3.0f;
+	}
+	mod[3] = 0;
+	return mod;
+}
+
+std::unique_ptr<CStdLandscapeRenderer> CStdGL::CreateLandscapeRenderer(const int iWdt, const int iHgt, std::function<void(int, int, int, uint8_t *)> getPixRow)
+{
+	if (!LandscapeMaterialShader) return nullptr;
+	try
+	{
+		return std::make_unique<CStdGLLandscapeRenderer>(*this, iWdt, iHgt, std::move(getPixRow));
+	}
+	catch (const CStdRenderException &e)
+	{
+		logger->error("Could not create landscape textures: {}", e.what());
+		return nullptr;
+	}
+}
+
+CStdGLLandscapeRenderer::CStdGLLandscapeRenderer(CStdGL &gl, const int iWdt, const int iHgt, std::function<void(int, int, int, uint8_t *)> getPixRow)
+	: gl{gl}, Wdt{iWdt}, Hgt{iHgt},
+	TilesX{(iWdt + TileSize - 1) / TileSize}, TilesY{(iHgt + TileSize - 1) / TileSize},
+	GetPixRow{std::move(getPixRow)}
+{
+	Tiles.reserve(TilesX * TilesY);
+	for (int i = 0; i < TilesX * TilesY; ++i)
+		Tiles.emplace_back(CreateTexture(TileTexSize, TileTexSize, GL_LUMINANCE8, GL_LUMINANCE, nullptr));
+	Update(-TileBorder, -TileBorder, Wdt + 2 * TileBorder, Hgt + 2 * TileBorder);
+}
+
+CStdGLLandscapeRenderer::Texture CStdGLLandscapeRenderer::CreateTexture(const int iWdt, const int iHgt, const GLenum internalFormat, const GLenum format, const void *const pData)
+{
+	Texture texture{{iWdt, iHgt}, internalFormat, format, GL_UNSIGNED_BYTE};
+	texture.Bind(0);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+	texture.SetData(pData);
+	return texture;
+}
+
+bool CStdGLLandscapeRenderer::SetMaterials(const std::array<CStdLandscapeMaterial, 256> &materials, const bool fShadeMaterials)
+{
+	ShadeMaterials = fShadeMaterials;
+
+	// collect the different patterns; most pixel values share them
+	struct AtlasEntry
+	{
+		const CPattern *pPattern;
+		uint8_t byClr;
+		int iX{0}, iY{0};
+	};
+	std::vector<AtlasEntry> entries;
+	std::map<std::tuple<const void *, const void *, const void *>, std::size_t> entryIndices;
+	std::array<std::array<std::size_t, 2>, 256> pixEntries;
+	constexpr auto NoEntry = static_cast<std::size_t>(-1);
+
+	for (std::size_t pix{0}; pix < materials.size(); ++pix)
+	{
+		const std::array<const CPattern *, 2> patterns{materials[pix].pPattern, materials[pix].pMatPattern};
+		for (std::size_t i{0}; i < patterns.size(); ++i)
+		{
+			pixEntries[pix][i] = NoEntry;
+			// the sky is never patterned
+			if (!pix || !patterns[i]) continue;
+			switch (patterns[i]->GetMode())
+			{
+			case CPattern::Mode::None:
+				continue;
+			case CPattern::Mode::PaletteShift:
+				return false;
+			default:
+				break;
+			}
+			const auto [it, inserted] = entryIndices.try_emplace(patterns[i]->GetPixelsKey(static_cast<uint8_t>(pix)), entries.size());
+			if (inserted) entries.push_back({patterns[i], static_cast<uint8_t>(pix)});
+			pixEntries[pix][i] = it->second;
+		}
+	}
+
+	// pack them in shelves, highest first
+	GLint iMaxSize{0};
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &iMaxSize);
+	const int iMaxWdt{std::min<int>(iMaxSize, 4096)};
+	std::vector<std::size_t> order(entries.size());
+	std::iota(order.begin(), order.end(), std::size_t{0});
+	std::stable_sort(order.begin(), order.end(), [&entries](const std::size_t a, const std::size_t b) { return entries[a].pPattern->GetHgt() > entries[b].pPattern->GetHgt(); });
+	int iX{0}, iY{0}, iShelfHgt{0};
+	AtlasWdt = AtlasHgt = 1;
+	for (const std::size_t index : order)
+	{
+		AtlasEntry &entry{entries[index]};
+		const int iPatternWdt{entry.pPattern->GetWdt()};
+		if (iPatternWdt > iMaxWdt) return false;
+		if (iX + iPatternWdt > iMaxWdt)
+		{
+			iY += iShelfHgt;
+			iX = iShelfHgt = 0;
+		}
+		entry.iX = iX; entry.iY = iY;
+		iX += iPatternWdt;
+		iShelfHgt = std::max(iShelfHgt, entry.pPattern->GetHgt());
+		AtlasWdt = std::max(AtlasWdt, iX);
+		AtlasHgt = std::max(AtlasHgt, iY + iShelfHgt);
+	}
+	if (AtlasHgt > iMaxSize) return false;
+
+	const auto putClr = [](uint8_t *const pTarget, const uint32_t dwClr)
+	{
+		pTarget[0] = static_cast<uint8_t>(dwClr >> 16);
+		pTarget[1] = static_cast<uint8_t>(dwClr >> 8);
+		pTarget[2] = static_cast<uint8_t>(dwClr);
+		pTarget[3] = static_cast<uint8_t>(dwClr >> 24);
+	};
+
+	std::vector<uint8_t> atlas(AtlasWdt * AtlasHgt * 4);
+	std::vector<uint32_t> pixels;
+	for (const AtlasEntry &entry : entries)
+	{
+		const int iPatternWdt{entry.pPattern->GetWdt()}, iPatternHgt{entry.pPattern->GetHgt()};
+		pixels.resize(iPatternWdt * iPatternHgt);
+		entry.pPattern->GetPixels(entry.byClr, pixels.data());
+		for (int y = 0; y < iPatternHgt; ++y)
+			for (int x = 0; x < iPatternWdt; ++x)
+				putClr(&atlas[((entry.iY + y) * AtlasWdt + entry.iX + x) * 4], pixels[y * iPatternWdt + x]);
+	}
+
+	// material table
+	std::vector<uint8_t> table(materials.size() * MaterialRows * 4);
+	const auto tableAt = [&table](const std::size_t pix, const int iRow) { return &table[(iRow * 256 + pix) * 4]; };
+	const auto putShorts = [](uint8_t *const pTarget, const int iFirst, const int iSecond)
+	{
+		pTarget[0] = static_cast<uint8_t>(iFirst); pTarget[1] = static_cast<uint8_t>(iFirst >> 8);
+		pTarget[2] = static_cast<uint8_t>(iSecond); pTarget[3] = static_cast<uint8_t>(iSecond >> 8);
+	};
+	for (std::size_t pix{0}; pix < materials.size(); ++pix)
+	{
+		const CStdLandscapeMaterial &material{materials[pix]};
+		putClr(tableAt(pix, 0), material.dwClr);
+		for (std::size_t i{0}; i < 2; ++i)
+		{
+			if (pixEntries[pix][i] == NoEntry) continue;
+			const AtlasEntry &entry{entries[pixEntries[pix][i]]};
+			const int iRow{1 + 3 * static_cast<int>(i)};
+			putShorts(tableAt(pix, iRow), entry.iX, entry.iY);
+			putShorts(tableAt(pix, iRow + 1), entry.pPattern->GetWdt(), entry.pPattern->GetHgt());
+			putShorts(tableAt(pix, iRow + 2), entry.pPattern->GetZoom(), 0);
+			// mode as the shader knows it
+			switch (entry.pPattern->GetMode())
+			{
+			case CPattern::Mode::Modulate: tableAt(pix, iRow + 2)[2] = 1; break;
+			case CPattern::Mode::ModulateMono: tableAt(pix, iRow + 2)[2] = 2; break;
+			case CPattern::Mode::Replace: tableAt(pix, iRow + 2)[2] = 3; break;
+			default: break;
+			}
+		}
+		uint8_t *const pFlags{tableAt(pix, 7)};
+		pFlags[0] = static_cast<uint8_t>(BoundBy<int32_t>(material.iPlacement, 0, 255));
+		pFlags[1] = material.fLiquid ? 255 : 0;
+	}
+
+	try
+	{
+		PatternAtlas = CreateTexture(AtlasWdt, AtlasHgt, GL_RGBA8, GL_RGBA, atlas.data());
+		MaterialTable = CreateTexture(256, MaterialRows, GL_RGBA8, GL_RGBA, table.data());
+	}
+	catch (const CStdRenderException &e)
+	{
+		gl.logger->error("Could not create landscape material textures: {}", e.what());
+		MaterialTable.Clear();
+		return false;
+	}
+	return true;
+}
+
+void CStdGLLandscapeRenderer::Update(int iX, int iY, const int iWdt, const int iHgt)
+{
+	// clip to the landscape and its border
+	const int iX2{std::min(iX + iWdt, Wdt + TileBorder)}, iY2{std::min(iY + iHgt, Hgt + TileBorder)};
+	iX = std::max(iX, -TileBorder); iY = std::max(iY, -TileBorder);
+	if (iX >= iX2 || iY >= iY2) return;
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	// neighbouring tiles hold the changed pixels in their borders as well
+	for (int iTileY = 0; iTileY < TilesY; ++iTileY)
+		for (int iTileX = 0; iTileX < TilesX; ++iTileX)
+		{
+			const int iTexX{iTileX * TileSize - TileBorder}, iTexY{iTileY * TileSize - TileBorder};
+			const int x1{std::max(iX, iTexX)}, y1{std::max(iY, iTexY)};
+			const int x2{std::min(iX2, iTexX + TileTexSize)}, y2{std::min(iY2, iTexY + TileTexSize)};
+			if (x1 >= x2 || y1 >= y2) continue;
+			UploadBuffer.resize((x2 - x1) * (y2 - y1));
+			for (int y = y1; y < y2; ++y)
+				GetPixRow(x1, y, x2 - x1, UploadBuffer.data() + (y - y1) * (x2 - x1));
+			Tiles[iTileY * TilesX + iTileX].Bind(0);
+			glTexSubImage2D(GL_TEXTURE_2D, 0, x1 - iTexX, y1 - iTexY, x2 - x1, y2 - y1, GL_LUMINANCE, GL_UNSIGNED_BYTE, UploadBuffer.data());
+		}
+}
+
+void CStdGLLandscapeRenderer::Draw(C4Surface *const sfcLiquidAnimation, const int fx, const int fy,
+	C4Surface *const sfcTarget, const int tx, const int ty, const int wdt, const int hgt)
+{
+	// safety
+	if (!sfcTarget || wdt <= 0 || hgt <= 0) return;
+	assert(sfcTarget->IsRenderTarget());
+	auto &shader = gl.LandscapeMaterialShader;
+	if (!shader || !MaterialTable) return;
+	// bound
+	if (gl.ClipAll) return;
+	// prepare rendering to surface
+	if (!gl.PrepareRendering(sfcTarget)) return;
+
+	gl.SetTexture();
+	PatternAtlas.Bind(1);
+	MaterialTable.Bind(6);
+	const bool fLiquid{sfcLiquidAnimation && sfcLiquidAnimation->ppTex};
+	if (fLiquid)
+	{
+		glActiveTexture(GL_TEXTURE2);
+		glBindTexture(GL_TEXTURE_2D, (*sfcLiquidAnimation->ppTex)->texName);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	}
+	if (gl.GammaRedTexture)
+	{
+		gl.BindGammaTextures();
+	}
+	glActiveTexture(GL_TEXTURE0);
+
+	shader.Select();
+	shader.SetUniform("tileSize", glUniform2f, static_cast<GLfloat>(TileTexSize), static_cast<GLfloat>(TileTexSize));
+	shader.SetUniform("patternAtlasSize", glUniform2f, static_cast<GLfloat>(AtlasWdt), static_cast<GLfloat>(AtlasHgt));
+	shader.SetUniform("shadeMaterials", glUniform1i, ShadeMaterials ? 1 : 0);
+	std::array<GLfloat, 4> modulation{};
+	if (fLiquid) modulation = gl.NextLiquidModulation();
+	shader.SetUniform("modulation", glUniform4fv, 1, modulation.data());
+
+	// set texture+modes
+	glShadeModel((gl.fUseClrModMap && !Config.Graphics.NoBoxFades) ? GL_SMOOTH : GL_FLAT);
+	glMatrixMode(GL_MODELVIEW);
+	glLoadIdentity();
+	glMatrixMode(GL_TEXTURE);
+	glLoadIdentity();
+
+	const uint32_t dwModClr{gl.BlitModulated ? gl.BlitModulateClr : 0xffffff};
+	const bool fClrModMap{gl.fUseClrModMap && dwModClr};
+	// the color modulation map needs more vertices
+	const int chunkSize{fClrModMap ? 64 : TileSize};
+	const float fLiquidSize{fLiquid ? static_cast<float>(sfcLiquidAnimation->iTexSize) : 1.0f};
+
+	const int iTileX1{std::max(fx / TileSize, 0)}, iTileY1{std::max(fy / TileSize, 0)};
+	const int iTileX2{std::min((fx + wdt - 1) / TileSize + 1, TilesX)}, iTileY2{std::min((fy + hgt - 1) / TileSize + 1, TilesY)};
+	for (int iTileY = iTileY1; iTileY < iTileY2; ++iTileY)
+		for (int iTileX = iTileX1; iTileX < iTileX2; ++iTileX)
+		{
+			Tiles[iTileY * TilesX + iTileX].Bind(0);
+			shader.SetUniform("tileOrigin", glUniform2f, static_cast<GLfloat>(iTileX * TileSize - TileBorder), static_cast<GLfloat>(iTileY * TileSize - TileBorder));
+
+			// landscape rect to draw from this tile
+			const int x1{std::max(fx, iTileX * TileSize)}, y1{std::max(fy, iTileY * TileSize)};
+			const int x2{std::min({fx + wdt, (iTileX + 1) * TileSize, Wdt})}, y2{std::min({fy + hgt, (iTileY + 1) * TileSize, Hgt})};
+			for (int y = y1; y < y2; y = (y / chunkSize + 1) * chunkSize)
+				for (int x = x1; x < x2; x = (x / chunkSize + 1) * chunkSize)
+				{
+					const auto fLeft = static_cast<float>(x), fTop = static_cast<float>(y);
+					const auto fRight = static_cast<float>(std::min(x2, (x / chunkSize + 1) * chunkSize));
+					const auto fBottom = static_cast<float>(std::min(y2, (y / chunkSize + 1) * chunkSize));
+					const std::array<float, 4>
+						lx{fLeft, fRight, fLeft, fRight},
+						ly{fTop, fTop, fBottom, fBottom};
+
+					glBegin(GL_TRIANGLE_STRIP);
+					for (int i = 0; i < 4; ++i)
+					{
+						const float ftx{lx[i] - fx + tx}, fty{ly[i] - fy + ty};
+						uint32_t dwClr{dwModClr};
+						// global modulation map
+						if (fClrModMap)
+						{
+							dwClr = gl.pClrModMap->GetModAt(static_cast<int>(ftx), static_cast<int>(fty));
+							ModulateClr(dwClr, dwModClr);
+						}
+						glColorDw(dwClr);
+						glTexCoord2f(lx[i] + gl.texIndent, ly[i] + gl.texIndent);
+						if (fLiquid)
+						{
+							glMultiTexCoord2f(GL_TEXTURE2_ARB, (lx[i] + gl.texIndent) / fLiquidSize, (ly[i] + gl.texIndent) / fLiquidSize);
+						}
+						glVertex2f(ftx + gl.blitOffset, fty + gl.blitOffset);
+					}
+					glEnd();
+				}
+		}
+
+	CStdShaderProgram::Deselect();
+	// reset texture
+	gl.ResetTexture();
+}
+
 bool CStdGL::CreateDirectDraw()
 {
 	logger->info("Using OpenGL...");
@@ -1030,6 +1331,11 @@ bool CStdGL::RestoreDeviceObjects()
 	texIndent = static_cast<float>(Config.Graphics.TexIndent) / 1000;
 	gammaDisabled = Config.Graphics.DisableGamma;
 
+	if (fSuccess && Config.Graphics.PixelBufferUpload && !TexUploadBuffer && (GLEW_VERSION_2_1 || GLEW_ARB_pixel_buffer_object))
+	{
+		glGenBuffers(1, &TexUploadBuffer);
+	}
+
 	if (Config.Graphics.Shader && !BlitShader)
 	{
 		try
@@ -1167,6 +1473,167 @@ bool CStdGL::RestoreDeviceObjects()
 			LandscapeShader.AddShader(&landscapeFragmentShader);
 			LandscapeShader.Link();
 
+			if (Config.Graphics.ShaderLandscape)
+			{
+				// optional: the landscape can still be drawn from the lit 32 bit surface
+				try
+				{
+					CStdGLShader landscapeMaterialFragmentShader{CStdShader::Type::Fragment,
+						R"(
+						#version 120
+
+						uniform sampler2D textureSampler; // 8 bit landscape tile with borders
+						uniform sampler2D patternSampler;
+						uniform sampler2D materialSampler;
+						uniform vec2 tileOrigin; // landscape position of the first texel of the tile texture
+						uniform vec2 tileSize;
+						uniform vec2 patternAtlasSize;
+						uniform bool shadeMaterials;
+						#ifdef LC_COLOR_ANIMATION
+						uniform sampler2D liquidSampler;
+						uniform vec4 modulation;
+						#endif
+
+						#ifdef LC_GAMMA
+						uniform sampler1D gammaRed;
+						uniform sampler1D gammaGreen;
+						uniform sampler1D gammaBlue;
+						#endif
+
+						// all values are bytes as on the CPU, so the results match C4Landscape::ApplyLighting exactly
+
+						float pixAt(vec2 pos)
+						{
+							return floor(texture2D(textureSampler, (pos - tileOrigin + 0.5) / tileSize).r * 255.0 + 0.5);
+						}
+
+						// rows: 0 color; 1-3 and 4-6 pattern position, size and zoom/mode; 7 placement and liquid flag
+						vec4 materialAt(float pix, float row)
+						{
+							return floor(texture2D(materialSampler, vec2((pix + 0.5) / 256.0, (row + 0.5) / 8.0)) * 255.0 + 0.5);
+						}
+
+						float placementAt(vec2 pos)
+						{
+							return materialAt(pixAt(pos), 7.0).r;
+						}
+
+						vec2 unpack(vec2 low, vec2 high)
+						{
+							return low + high * 256.0;
+						}
+
+						// CPattern::PatternClr
+						vec4 applyPattern(vec4 color, float pix, float row, vec2 pos)
+						{
+							vec4 params = materialAt(pix, row + 2.0);
+							float mode = params.b;
+							if (mode == 0.0) return color;
+							float zoom = params.r + params.g * 256.0;
+							if (zoom > 0.0) pos = floor((pos + 0.5) / zoom);
+							vec4 size = materialAt(pix, row + 1.0);
+							vec2 wh = unpack(size.rb, size.ga);
+							pos -= wh * floor((pos + 0.5) / wh);
+							vec4 origin = materialAt(pix, row);
+							vec4 patternClr = floor(texture2D(patternSampler, (unpack(origin.rb, origin.ga) + pos + 0.5) / patternAtlasSize) * 255.0 + 0.5);
+							// replace
+							if (mode == 3.0) return patternClr;
+							// monochrome modulation uses the blue channel
+							if (mode == 2.0) patternClr.rgb = patternClr.bbb;
+							color.rgb = min(floor(color.rgb * patternClr.rgb / 256.0) * 2.0, 255.0);
+							color.a = min(color.a + patternClr.a, 255.0);
+							return color;
+						}
+
+						void main()
+						{
+							vec2 pos = floor(gl_TexCoord[0].st);
+							float pix = pixAt(pos);
+							vec4 color = materialAt(pix, 0.0);
+							if (pix > 0.0)
+							{
+								color = applyPattern(color, pix, 1.0, pos);
+								color = applyPattern(color, pix, 4.0, pos);
+								if (shadeMaterials)
+								{
+									float ownDens = materialAt(pix, 7.0).r;
+									if (ownDens == 0.0)
+									{
+										color = vec4(0.0, 0.0, 0.0, 255.0);
+									}
+									else
+									{
+										ownDens = floor((ownDens * 2.0 + placementAt(pos + vec2(1.0, 0.0)) + placementAt(pos - vec2(1.0, 0.0))) / 4.0);
+										float aboveDens = 0.0;
+										float belowDens = 0.0;
+										for (int i = 1; i <= 8; ++i)
+										{
+											aboveDens += placementAt(pos - vec2(0.0, float(i)));
+											belowDens += placementAt(pos + vec2(0.0, float(i)));
+										}
+										float compareDens = floor(aboveDens / 8.0);
+										if (ownDens > compareDens)
+										{
+											color.rgb = min(color.rgb + min(30.0, 2.0 * (ownDens - compareDens)), 255.0);
+										}
+										else if (ownDens < compareDens && ownDens < 30.0)
+										{
+											color.rgb = max(color.rgb - min(30.0, 2.0 * (compareDens - ownDens)), 0.0);
+										}
+										compareDens = floor(belowDens / 8.0);
+										if (ownDens > compareDens)
+										{
+											color.rgb = max(color.rgb - min(30.0, 2.0 * (ownDens - compareDens)), 0.0);
+										}
+									}
+								}
+							}
+
+							vec4 fragColor = color / 255.0;
+						#ifdef LC_COLOR_ANIMATION
+							float mask = materialAt(pix, 7.0).g / 255.0;
+							vec3 liquid = texture2D(liquidSampler,  gl_TexCoord[2].st).rgb;
+							liquid -= vec3(0.5, 0.5, 0.5);
+							liquid = vec3(dot(liquid, modulation.rgb));
+							liquid *= mask;
+							fragColor.rgb = fragColor.rgb + liquid;
+						#endif
+							fragColor.rgb = clamp(fragColor.rgb, 0.0, 1.0) * gl_Color.rgb;
+							fragColor.a = clamp(fragColor.a + gl_Color.a, 0.0, 1.0);
+
+						#ifdef LC_GAMMA
+							fragColor.r = texture1D(gammaRed, fragColor.r).r;
+							fragColor.g = texture1D(gammaGreen, fragColor.g).r;
+							fragColor.b = texture1D(gammaBlue, fragColor.b).r;
+						#endif
+
+							gl_FragColor = fragColor;
+						}
+						)"};
+
+					if (Config.Graphics.ColorAnimation)
+					{
+						landscapeMaterialFragmentShader.SetMacro("LC_COLOR_ANIMATION", "1");
+					}
+
+					if (Config.Graphics.UseShaderGamma && !gammaDisabled)
+					{
+						landscapeMaterialFragmentShader.SetMacro("LC_GAMMA", "1");
+					}
+
+					landscapeMaterialFragmentShader.Compile();
+
+					LandscapeMaterialShader.AddShader(&vertexShader);
+					LandscapeMaterialShader.AddShader(&landscapeMaterialFragmentShader);
+					LandscapeMaterialShader.Link();
+				}
+				catch (const CStdRenderException &e)
+				{
+					logger->error("Could not create landscape material shader: {}", e.what());
+					LandscapeMaterialShader.Clear();
+				}
+			}
+
 			if (Config.Graphics.UseShaderGamma && !gammaDisabled)
 			{
 				CStdGLShader dummyVertexShader{CStdShader::Type::Vertex,
@@ -1234,6 +1701,15 @@ bool CStdGL::RestoreDeviceObjects()
 				DummyShader.Validate();
 			}
 
+			if (LandscapeMaterialShader)
+			{
+				setUniforms(LandscapeMaterialShader);
+				LandscapeMaterialShader.SetUniform("patternSampler", glUniform1i, 1);
+				LandscapeMaterialShader.SetUniform("liquidSampler", glUniform1i, 2);
+				LandscapeMaterialShader.SetUniform("materialSampler", glUniform1i, 6);
+				LandscapeMaterialShader.Validate();
+			}
+
 			setUniforms(LandscapeShader); // Last so that the shader is selected for the subsequent calls
 
 			LandscapeShader.SetUniform("maskSampler", glUniform1i, 1);
@@ -1294,9 +1770,16 @@ bool CStdGL::InvalidateDeviceObjects()
 		BlitShader.Clear();
 		BlitShaderMod2.Clear();
 		LandscapeShader.Clear();
+		LandscapeMaterialShader.Clear();
 		DummyShader.Clear();
 	}
 
+	if (TexUploadBuffer)
+	{
+		glDeleteBuffers(1, &TexUploadBuffer);
+		TexUploadBuffer = GL_NONE;
+	}
+
 	if (GammaRedTexture)
 	{
 		GammaRedTexture.Clear();
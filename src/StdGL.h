@@ -209,6 +209,44 @@ private:
 	}
 };
 
+class CStdGL;
+
+// draws the landscape from the 8 bit landscape in CStdGL::LandscapeMaterialShader, which does what
+// C4Landscape::ApplyLighting does on the CPU; only changed landscape pixels are uploaded
+class CStdGLLandscapeRenderer : public CStdLandscapeRenderer
+{
+public:
+	// getPixRow(x, y, wdt, target) copies a row of landscape pixels, including the border around the landscape
+	CStdGLLandscapeRenderer(CStdGL &gl, int iWdt, int iHgt, std::function<void(int, int, int, uint8_t *)> getPixRow);
+
+	bool SetMaterials(const std::array<CStdLandscapeMaterial, 256> &materials, bool fShadeMaterials) override;
+	void Update(int iX, int iY, int iWdt, int iHgt) override;
+	void Draw(C4Surface *sfcLiquidAnimation, int fx, int fy, C4Surface *sfcTarget, int tx, int ty, int wdt, int hgt) override;
+
+private:
+	using Texture = CStdGLTexture<GL_TEXTURE_2D, 2>;
+
+	// landscape pixels per tile; the tile textures additionally hold a border of the neighbouring pixels the shading looks at
+	static constexpr int TileSize{512};
+	static constexpr int TileBorder{8};
+	static constexpr int TileTexSize{TileSize + 2 * TileBorder};
+	// rows of the material table
+	static constexpr int MaterialRows{8};
+
+	CStdGL &gl;
+	int Wdt, Hgt;
+	int TilesX, TilesY;
+	std::function<void(int, int, int, uint8_t *)> GetPixRow;
+	std::vector<Texture> Tiles;
+	Texture MaterialTable; // 256 x MaterialRows: color, two patterns and placement/liquid flag of each pixel value
+	Texture PatternAtlas;
+	int AtlasWdt{0}, AtlasHgt{0};
+	bool ShadeMaterials{true};
+	std::vector<uint8_t> UploadBuffer;
+
+	Texture CreateTexture(int iWdt, int iHgt, GLenum internalFormat, GLenum format, const void *pData);
+};
+
 // one OpenGL context
 class CStdGLCtx
 {
@@ -265,10 +303,12 @@ protected:
 	CStdGLShaderProgram BlitShader;
 	CStdGLShaderProgram BlitShaderMod2;
 	CStdGLShaderProgram LandscapeShader;
+	CStdGLShaderProgram LandscapeMaterialShader; // see CStdGLLandscapeRenderer; only built if Config.Graphics.ShaderLandscape
 	CStdGLShaderProgram DummyShader;
 	CStdGLTexture<GL_TEXTURE_1D, 1> GammaRedTexture;
 	CStdGLTexture<GL_TEXTURE_1D, 1> GammaGreenTexture;
 	CStdGLTexture<GL_TEXTURE_1D, 1> GammaBlueTexture;
+	GLuint TexUploadBuffer{GL_NONE}; // pixel buffer object for streaming texture uploads
 	bool gammaDisabled{false};
 
 public:
@@ -294,6 +334,7 @@ public:
 	void PerformBlt(CBltData &rBltData, C4TexRef *pTex, uint32_t dwModClr, bool fMod2, bool fExact) override;
 	virtual void BlitLandscape(C4Surface *sfcSource, C4Surface *sfcSource2, C4Surface *sfcLiquidAnimation, int fx, int fy,
 		C4Surface *sfcTarget, int tx, int ty, int wdt, int hgt) override;
+	std::unique_ptr<CStdLandscapeRenderer> CreateLandscapeRenderer(int iWdt, int iHgt, std::function<void(int, int, int, uint8_t *)> getPixRow) override;
 	void FillBG(uint32_t dwClr = 0) override;
 
 	// Drawing
@@ -333,6 +374,7 @@ private:
 	bool ApplyGammaRampToMonitor(CGammaControl &ramp, bool force);
 	bool SaveDefaultGammaRampToMonitor(CStdWindow *window);
 	void BindGammaTextures();
+	std::array<GLfloat, 4> NextLiquidModulation(); // color animation step of liquids
 
 	friend class C4Surface;
 	friend class C4TexRef;
@@ -341,6 +383,7 @@ private:
 	friend class C4StartupOptionsDlg;
 	friend class C4FullScreen;
 	friend class CStdWindow;
+	friend class CStdGLLandscapeRenderer;
 };
 
 // Global access pointer
@@ -34,7 +34,6 @@
 
 #ifndef _WIN32
 #include <ranges>
-#include <unordered_map>
 
 // For pipe()
 #include <unistd.h>
@@ -120,14 +119,7 @@ bool StdScheduler::Execute(int iTimeout)
 
 #else
 	fds.resize(1);
-
-	struct FdRange
-	{
-		std::size_t Offset;
-		std::size_t Size;
-	};
-
-	std::unordered_map<StdSchedulerProc *, FdRange> fdMap;
+	fdRanges.clear();
 
 	for (auto *const proc : procs)
 	{
@@ -138,7 +130,7 @@ bool StdScheduler::Execute(int iTimeout)
 
 		if (fds.size() != oldSize)
 		{
-			fdMap.emplace(std::piecewise_construct, std::forward_as_tuple(proc), std::forward_as_tuple(oldSize, fds.size() - oldSize));
+			fdRanges.push_back({proc, oldSize, fds.size() - oldSize});
 		}
 	}
 
@@ -157,9 +149,9 @@ bool StdScheduler::Execute(int iTimeout)
 
 		const std::span<pollfd> fdSpan{fds};
 
-		for (const auto &[proc, range] : fdMap)
+		for (const auto &[proc, offset, size] : fdRanges)
 		{
-			if (std::ranges::any_of(fdSpan.subspan(range.Offset, range.Size), std::identity{}, &pollfd::revents))
+			if (std::ranges::any_of(fdSpan.subspan(offset, size), std::identity{}, &pollfd::revents))
 			{
 				if (!proc->Execute(0))
 				{
@@ -80,6 +80,15 @@ private:
 #else
 	CStdEvent unblocker;
 	std::vector<pollfd> fds{{.fd = unblocker.GetFD(), .events = POLLIN}};
+
+	// part of fds belonging to each proc (preserved to reduce allocs)
+	struct FdRange
+	{
+		StdSchedulerProc *Proc;
+		std::size_t Offset;
+		std::size_t Size;
+	};
+	std::vector<FdRange> fdRanges;
 #endif
 
 public:
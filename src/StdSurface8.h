@@ -23,6 +23,17 @@
 #include <Standard.h>
 #include <StdColors.h>
 
+#include <algorithm>
+
+// the row kernels use SSE2 on x86-64 and NEON on ARM, which every CPU of these architectures has, so no runtime check is needed
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define STDSURFACE8_SSE2
+#	include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#	define STDSURFACE8_NEON
+#	include <arm_neon.h>
+#endif
+
 class CSurface8
 {
 public:
@@ -70,4 +81,106 @@ public:
 	void GetSurfaceSize(int &irX, int &irY); // get surface size
 	void EnforceC0Transparency() { pPal->EnforceC0Transparency(); }
 	void AllowColor(uint8_t iRngLo, uint8_t iRngHi, bool fAllowZero = false);
+
+	// bulk operations on rows of pixels
+	// Rows are processed 16 pixels at a time with SSE2 or NEON where available; the rest of a row and other
+	// architectures use the scalar versions, which are public to check the vector ones against.
+	// Counting takes a predicate, usually a lookup of pixel properties, which SSE2 and NEON cannot do for 256 entries,
+	// so it stays a plain loop for the compiler to unroll.
+
+	template<typename Pred>
+	static int CountRow(const uint8_t *pRow, int iLen, Pred pred) // count pixels for which pred is true
+	{
+		int iCnt = 0;
+		for (int i = 0; i < iLen; ++i) iCnt += pred(pRow[i]) ? 1 : 0;
+		return iCnt;
+	}
+
+	template<typename Pred>
+	static int CountRect(const uint8_t *pBits, int iPitch, int iWdt, int iHgt, Pred pred) // count pixels for which pred is true in a rect starting at pBits
+	{
+		int iCnt = 0;
+		for (int y = 0; y < iHgt; ++y) iCnt += CountRow(pBits + y * iPitch, iWdt, pred);
+		return iCnt;
+	}
+
+	static bool MaskRowEqualScalar(uint8_t *pRow, const uint8_t *pRef, int iLen, uint8_t byMask)
+	{
+		uint8_t byDiff = 0;
+		for (int i = 0; i < iLen; ++i)
+		{
+			const uint8_t byPix = pRow[i];
+			byDiff |= byPix ^ pRef[i];
+			pRow[i] = (byPix == pRef[i]) ? byMask : byPix;
+		}
+		return byDiff != 0;
+	}
+
+	static bool MaskRowEqual(uint8_t *pRow, const uint8_t *pRef, int iLen, uint8_t byMask) // replace pixels equal to the reference by byMask; returns whether any pixel differs
+	{
+		int i = 0;
+#if defined(STDSURFACE8_SSE2)
+		const __m128i mask = _mm_set1_epi8(static_cast<char>(byMask));
+		int iEqual = 0xffff;
+		for (; i + 16 <= iLen; i += 16)
+		{
+			const __m128i pix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow + i));
+			const __m128i equal = _mm_cmpeq_epi8(pix, _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRef + i)));
+			iEqual &= _mm_movemask_epi8(equal);
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pRow + i), _mm_or_si128(_mm_and_si128(equal, mask), _mm_andnot_si128(equal, pix)));
+		}
+		const bool fDiff = iEqual != 0xffff;
+#elif defined(STDSURFACE8_NEON)
+		const uint8x16_t mask = vdupq_n_u8(byMask);
+		uint8x16_t diff = vdupq_n_u8(0);
+		for (; i + 16 <= iLen; i += 16)
+		{
+			const uint8x16_t pix = vld1q_u8(pRow + i);
+			const uint8x16_t equal = vceqq_u8(pix, vld1q_u8(pRef + i));
+			diff = vorrq_u8(diff, vmvnq_u8(equal));
+			vst1q_u8(pRow + i, vbslq_u8(equal, mask, pix));
+		}
+		const uint64x2_t diff64 = vreinterpretq_u64_u8(diff);
+		const bool fDiff = (vgetq_lane_u64(diff64, 0) | vgetq_lane_u64(diff64, 1)) != 0;
+#else
+		const bool fDiff = false;
+#endif
+		return MaskRowEqualScalar(pRow + i, pRef + i, iLen - i, byMask) || fDiff;
+	}
+
+	static void SelectRowByBitScalar(uint8_t *pRow, int iLen, uint8_t byBit, uint8_t bySet, uint8_t byClear)
+	{
+		for (int i = 0; i < iLen; ++i) pRow[i] = (pRow[i] & byBit) ? bySet : byClear;
+	}
+
+	static void SelectRowByBit(uint8_t *pRow, int iLen, uint8_t byBit, uint8_t bySet, uint8_t byClear) // replace pixels by bySet if they have byBit, by byClear otherwise
+	{
+		int i = 0;
+#if defined(STDSURFACE8_SSE2)
+		const __m128i bit = _mm_set1_epi8(static_cast<char>(byBit)), set = _mm_set1_epi8(static_cast<char>(bySet)), clear = _mm_set1_epi8(static_cast<char>(byClear));
+		for (; i + 16 <= iLen; i += 16)
+		{
+			const __m128i pix = _mm_loadu_si128(reinterpret_cast<const __m128i *>(pRow + i));
+			const __m128i cleared = _mm_cmpeq_epi8(_mm_and_si128(pix, bit), _mm_setzero_si128());
+			_mm_storeu_si128(reinterpret_cast<__m128i *>(pRow + i), _mm_or_si128(_mm_and_si128(cleared, clear), _mm_andnot_si128(cleared, set)));
+		}
+#elif defined(STDSURFACE8_NEON)
+		const uint8x16_t bit = vdupq_n_u8(byBit), set = vdupq_n_u8(bySet), clear = vdupq_n_u8(byClear);
+		for (; i + 16 <= iLen; i += 16)
+			vst1q_u8(pRow + i, vbslq_u8(vtstq_u8(vld1q_u8(pRow + i), bit), set, clear));
+#endif
+		SelectRowByBitScalar(pRow + i, iLen - i, byBit, bySet, byClear);
+	}
+
+	static bool DiffRect(uint8_t *pDst, int iDstPitch, const uint8_t *pSrc, int iSrcPitch, const uint8_t *pRef, int iRefPitch, int iWdt, int iHgt, uint8_t byMask) // copy a rect, masking pixels equal to the reference; returns whether any pixel differs
+	{
+		bool fChanged = false;
+		for (int y = 0; y < iHgt; ++y)
+		{
+			uint8_t *const pRow = pDst + y * iDstPitch;
+			std::copy_n(pSrc + y * iSrcPitch, iWdt, pRow);
+			if (MaskRowEqual(pRow, pRef + y * iRefPitch, iWdt, byMask)) fChanged = true;
+		}
+		return fChanged;
+	}
 };
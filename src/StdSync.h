@@ -20,6 +20,7 @@
 
 #include "C4Windows.h"
 
+#include <algorithm>
 #include <atomic>
 #include <array>
 #include <limits>
@@ -0,0 +1,226 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4EventQueue.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	struct Item
+	{
+		int32_t Producer{-1};
+		int32_t Seq{-1};
+	};
+
+	// the queue C4InteractiveThread used before: a linked list behind a head item, with a lock for each end
+	// and one allocation per item
+	class LockedListQueue
+	{
+		struct Node
+		{
+			Item Data;
+			Node *Next{nullptr};
+		};
+
+		Node *pFirst, *pLast;
+		CStdCSec PushCSec, PopCSec;
+
+	public:
+		LockedListQueue() { pFirst = pLast = new Node; }
+
+		~LockedListQueue()
+		{
+			while (pFirst)
+				delete std::exchange(pFirst, pFirst->Next);
+		}
+
+		void Push(Item item)
+		{
+			CStdLock PushLock(&PushCSec);
+			Node *const pNode{new Node{item}};
+			pLast->Next = pNode;
+			pLast = pNode;
+		}
+
+		void PopBatch(std::vector<Item> &batch, const std::size_t iMaxCount)
+		{
+			// items were popped one by one, each under the lock
+			for (std::size_t i{0}; i < iMaxCount; ++i)
+			{
+				CStdLock PopLock(&PopCSec);
+				Node *const pNode{pFirst->Next};
+				if (!pNode) return;
+				batch.push_back(pNode->Data);
+				delete pFirst;
+				pFirst = pNode;
+			}
+		}
+	};
+
+	// pushes iItems items from each of iProducers threads while consuming them; returns the number of items received
+	template<typename Queue>
+	std::size_t ProduceAndConsume(Queue &queue, const int32_t iProducers, const int32_t iItems)
+	{
+		std::vector<std::thread> producers;
+		for (int32_t iProducer = 0; iProducer < iProducers; ++iProducer)
+			producers.emplace_back([&queue, iProducer, iItems]
+			{
+				for (int32_t i = 0; i < iItems; ++i)
+					queue.Push({iProducer, i});
+			});
+
+		std::vector<Item> batch;
+		std::size_t iReceived{0};
+		while (iReceived < static_cast<std::size_t>(iProducers) * iItems)
+		{
+			batch.clear();
+			queue.PopBatch(batch, 64);
+			if (batch.empty()) std::this_thread::yield();
+			iReceived += batch.size();
+		}
+		for (auto &producer : producers) producer.join();
+		return iReceived;
+	}
+}
+
+TEST_CASE("C4EventQueue keeps items in order across the overflow list", "[C4EventQueue]")
+{
+	C4EventQueue<Item, 8> queue;
+	std::vector<Item> batch;
+
+	// more than the ring can hold, so the rest goes to the overflow list
+	for (int32_t i = 0; i < 20; ++i) queue.Push({0, i});
+
+	// the ring is drained first, in batches
+	queue.PopBatch(batch, 5);
+	REQUIRE(batch.size() == 5);
+	// items pushed now must queue up behind the overflow list, even though there is room in the ring
+	queue.Push({0, 20});
+	// the rest of the ring, then the whole overflow list at once
+	queue.PopBatch(batch, 5);
+	REQUIRE(batch.size() == 21);
+	for (int32_t i = 0; i < 21; ++i) REQUIRE(batch[i].Seq == i);
+
+	// afterwards, the ring is used again
+	batch.clear();
+	for (int32_t i = 21; i < 29; ++i) queue.Push({0, i});
+	queue.PopBatch(batch, 64);
+	REQUIRE(batch.size() == 8);
+	for (int32_t i = 0; i < 8; ++i) REQUIRE(batch[i].Seq == 21 + i);
+	queue.PopBatch(batch, 64);
+	REQUIRE(batch.size() == 8);
+}
+
+TEST_CASE("C4EventQueue frees the items it has handed out", "[C4EventQueue]")
+{
+	C4EventQueue<std::shared_ptr<int>, 4> queue;
+	const auto data = std::make_shared<int>(42);
+	for (int i = 0; i < 6; ++i) queue.Push(data);
+	REQUIRE(data.use_count() == 7);
+
+	std::vector<std::shared_ptr<int>> batch;
+	queue.PopBatch(batch, 64);
+	queue.PopBatch(batch, 64);
+	REQUIRE(batch.size() == 6);
+	batch.clear();
+	// no copies may stay behind in the ring slots
+	REQUIRE(data.use_count() == 1);
+}
+
+TEST_CASE("C4EventQueue delivers the items of multiple producers", "[C4EventQueue]")
+{
+	constexpr int32_t iProducers{6}, iItems{100000};
+	// a small ring, so that the producers keep switching to the overflow list and back
+	C4EventQueue<Item, 64> queue;
+	std::atomic<int32_t> iStarted{0};
+
+	std::vector<std::thread> producers;
+	for (int32_t iProducer = 0; iProducer < iProducers; ++iProducer)
+		producers.emplace_back([&queue, &iStarted, iProducer]
+		{
+			++iStarted;
+			while (iStarted.load() < iProducers) std::this_thread::yield();
+			for (int32_t i = 0; i < iItems; ++i)
+				queue.Push({iProducer, i});
+		});
+
+	// consume concurrently, like the main thread does
+	std::vector<int32_t> nextSeq(iProducers, 0);
+	std::vector<Item> batch;
+	std::size_t iReceived{0}, iBatches{0};
+	bool fInOrder{true}, fValid{true};
+	while (iReceived < static_cast<std::size_t>(iProducers) * iItems)
+	{
+		batch.clear();
+		queue.PopBatch(batch, 64);
+		if (batch.empty())
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		++iBatches;
+		for (const auto &item : batch)
+		{
+			if (item.Producer < 0 || item.Producer >= iProducers)
+			{
+				fValid = false;
+				continue;
+			}
+			// the items of each producer have to arrive in the order they were pushed
+			if (item.Seq != nextSeq[item.Producer]) fInOrder = false;
+			nextSeq[item.Producer] = item.Seq + 1;
+		}
+		iReceived += batch.size();
+	}
+	for (auto &producer : producers) producer.join();
+	INFO(iBatches << " batches");
+
+	REQUIRE(fValid);
+	REQUIRE(fInOrder);
+	REQUIRE(iReceived == static_cast<std::size_t>(iProducers) * iItems);
+	for (const int32_t iSeq : nextSeq) REQUIRE(iSeq == iItems);
+
+	// nothing left over
+	batch.clear();
+	queue.PopBatch(batch, 64);
+	queue.PopBatch(batch, 64);
+	REQUIRE(batch.empty());
+}
+
+TEST_CASE("C4EventQueue benchmark", "[.][benchmark][C4EventQueue]")
+{
+	// 400000 events per run, so events/s = 400000 / time per run
+	constexpr int32_t iProducers{4}, iItems{100000};
+	BENCHMARK("locked list: 4 producers, 400000 events")
+	{
+		LockedListQueue queue;
+		return ProduceAndConsume(queue, iProducers, iItems);
+	};
+	BENCHMARK("ring: 4 producers, 400000 events")
+	{
+		C4EventQueue<Item, 1024> queue;
+		return ProduceAndConsume(queue, iProducers, iItems);
+	};
+}
@@ -0,0 +1,175 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4FoWGrid.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// the grid only uses objects as keys, so they never have to be real objects
+	struct ViewObject
+	{
+		int32_t X, Y, Range;
+		bool Registered{false};
+	};
+
+	C4Object *AsObject(ViewObject &obj) { return reinterpret_cast<C4Object *>(&obj); }
+
+	bool Covers(const ViewObject &obj, const int32_t iX, const int32_t iY)
+	{
+		const int64_t iDX{obj.X - iX}, iDY{obj.Y - iY}, iRange{std::abs(obj.Range)};
+		return iDX * iDX + iDY * iDY < iRange * iRange;
+	}
+
+	// all registered objects covering the point, found by the grid
+	std::vector<C4Object *> FindByGrid(const C4FoWGrid &grid, std::vector<ViewObject> &objects, const int32_t iX, const int32_t iY)
+	{
+		std::vector<C4Object *> result;
+		grid.ForEachAt(iX, iY, [&](C4Object *const pObj)
+		{
+			if (Covers(*reinterpret_cast<ViewObject *>(pObj), iX, iY))
+				result.push_back(pObj);
+			return true;
+		});
+		std::ranges::sort(result);
+		return result;
+	}
+
+	// the same by checking every object, like C4Player::FoWIsVisibleLinear
+	std::vector<C4Object *> FindLinear(std::vector<ViewObject> &objects, const int32_t iX, const int32_t iY)
+	{
+		std::vector<C4Object *> result;
+		for (auto &obj : objects)
+			if (obj.Registered && Covers(obj, iX, iY))
+				result.push_back(AsObject(obj));
+		std::ranges::sort(result);
+		return result;
+	}
+
+	void CheckAgainstLinear(const C4FoWGrid &grid, std::vector<ViewObject> &objects, std::mt19937 &rng)
+	{
+		std::uniform_int_distribution<int32_t> coord{-200, 3000};
+		for (int i = 0; i < 500; ++i)
+		{
+			const int32_t iX{coord(rng)}, iY{coord(rng)};
+			REQUIRE(FindByGrid(grid, objects, iX, iY) == FindLinear(objects, iX, iY));
+		}
+	}
+}
+
+TEST_CASE("C4FoWGrid finds the same view objects as a linear scan", "[C4FoWGrid]")
+{
+	std::mt19937 rng{42};
+	std::uniform_int_distribution<int32_t> coord{0, 2800}, range{-300, 400}, step{-150, 150};
+	std::vector<ViewObject> objects(200);
+	for (auto &obj : objects)
+		obj = {coord(rng), coord(rng), range(rng)};
+	// a few objects seeing (almost) everything end up in the global list
+	objects[0].Range = 5000;
+	objects[1].Range = -4000;
+
+	C4FoWGrid grid;
+
+	SECTION("insert")
+	{
+		for (auto &obj : objects)
+		{
+			grid.Add(AsObject(obj), obj.X, obj.Y, obj.Range);
+			obj.Registered = true;
+		}
+		CheckAgainstLinear(grid, objects, rng);
+	}
+
+	SECTION("move")
+	{
+		for (auto &obj : objects)
+		{
+			grid.Add(AsObject(obj), obj.X, obj.Y, obj.Range);
+			obj.Registered = true;
+		}
+		for (int iRound = 0; iRound < 5; ++iRound)
+		{
+			for (auto &obj : objects)
+			{
+				obj.X += step(rng);
+				obj.Y += step(rng);
+				if (iRound == 2) obj.Range = range(rng);
+				grid.Update(AsObject(obj), obj.X, obj.Y, obj.Range);
+			}
+			CheckAgainstLinear(grid, objects, rng);
+		}
+		// adding an object again moves it as well
+		objects[5].X += 1000;
+		grid.Add(AsObject(objects[5]), objects[5].X, objects[5].Y, objects[5].Range);
+		CheckAgainstLinear(grid, objects, rng);
+	}
+
+	SECTION("remove")
+	{
+		for (auto &obj : objects)
+		{
+			grid.Add(AsObject(obj), obj.X, obj.Y, obj.Range);
+			obj.Registered = true;
+		}
+		for (std::size_t i = 0; i < objects.size(); i += 2)
+		{
+			grid.Remove(AsObject(objects[i]));
+			objects[i].Registered = false;
+		}
+		CheckAgainstLinear(grid, objects, rng);
+		// updating removed objects must not bring them back
+		for (std::size_t i = 0; i < objects.size(); i += 2)
+			grid.Update(AsObject(objects[i]), objects[i].X + 10, objects[i].Y, objects[i].Range);
+		CheckAgainstLinear(grid, objects, rng);
+		grid.Clear();
+		for (auto &obj : objects) obj.Registered = false;
+		CheckAgainstLinear(grid, objects, rng);
+	}
+}
+
+TEST_CASE("C4FoWGrid marks all view objects near a rectangle", "[C4FoWGrid]")
+{
+	std::mt19937 rng{7};
+	std::uniform_int_distribution<int32_t> coord{0, 2800}, range{-300, 400}, size{1, 1500};
+	std::vector<ViewObject> objects(150);
+	C4FoWGrid grid;
+	for (auto &obj : objects)
+	{
+		obj = {coord(rng), coord(rng), range(rng), true};
+		grid.Add(AsObject(obj), obj.X, obj.Y, obj.Range);
+	}
+
+	constexpr int32_t iMargin{50};
+	for (int i = 0; i < 200; ++i)
+	{
+		const int32_t iX0{coord(rng)}, iY0{coord(rng)}, iX1{iX0 + size(rng)}, iY1{iY0 + size(rng)};
+		grid.MarkInRect(iX0, iY0, iX1, iY1, iMargin);
+		for (auto &obj : objects)
+		{
+			// marking may be coarse, but must not miss any object whose range reaches the enlarged rectangle
+			const int32_t iRange{std::abs(obj.Range)};
+			const bool fNear{obj.X + iRange >= iX0 - iMargin && obj.X - iRange <= iX1 + iMargin
+				&& obj.Y + iRange >= iY0 - iMargin && obj.Y - iRange <= iY1 + iMargin};
+			if (fNear) REQUIRE(grid.IsMarked(AsObject(obj)));
+		}
+	}
+}
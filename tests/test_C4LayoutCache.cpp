@@ -0,0 +1,129 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4LayoutCache.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+	// like CStdFont::ExtentCache: extents by markup flag and ignoreScale
+	using ExtentCache = C4LayoutCache<std::pair<int32_t, int32_t>, bool, bool>;
+
+	void InsertText(ExtentCache &cache, const std::string &text, const int32_t iWdt)
+	{
+		cache.Insert(cache.MakeKey(text.c_str(), true, false), {iWdt, 10});
+	}
+
+	bool HasText(ExtentCache &cache, const std::string &text)
+	{
+		return cache.Find(cache.MakeKey(text.c_str(), true, false)) != nullptr;
+	}
+}
+
+TEST_CASE("C4LayoutCache keys contain all parameters", "[C4LayoutCache]")
+{
+	C4LayoutCache<int, int, bool, float> cache;
+	const std::string key{cache.MakeKey("Hello", 100, true, 1.5f)};
+	// the parameters come first, with their raw bytes, then the text
+	REQUIRE(key.size() == sizeof(int) + sizeof(bool) + sizeof(float) + 5);
+	REQUIRE(key.ends_with("Hello"));
+
+	// the key changes with every parameter and the text
+	REQUIRE(std::string{cache.MakeKey("Hello", 101, true, 1.5f)} != key);
+	REQUIRE(std::string{cache.MakeKey("Hello", 100, false, 1.5f)} != key);
+	REQUIRE(std::string{cache.MakeKey("Hello", 100, true, 2.0f)} != key);
+	REQUIRE(std::string{cache.MakeKey("Hellp", 100, true, 1.5f)} != key);
+	REQUIRE(std::string{cache.MakeKey("Hello", 100, true, 1.5f)} == key);
+
+	// keys view a buffer that the next key reuses
+	const std::string_view view{cache.MakeKey("Hello", 100, true, 1.5f)};
+	cache.MakeKey("World", 100, true, 1.5f);
+	REQUIRE(view.ends_with("World"));
+
+	// parameters have a fixed size, so a text cannot be mistaken for the bytes of a parameter
+	C4LayoutCache<int, bool> flagCache;
+	const std::string flagKey{flagCache.MakeKey("\x01", false)};
+	REQUIRE(std::string{flagCache.MakeKey("", true)} != flagKey);
+	REQUIRE(std::string{flagCache.MakeKey("\x01", false)} == flagKey);
+
+	cache.Insert(cache.MakeKey("Hello", 100, true, 1.5f), 3);
+	REQUIRE(cache.Find(cache.MakeKey("Hello", 100, false, 1.5f)) == nullptr);
+	const int *const pValue{cache.Find(cache.MakeKey("Hello", 100, true, 1.5f))};
+	REQUIRE(pValue);
+	REQUIRE(*pValue == 3);
+}
+
+TEST_CASE("C4LayoutCache drops the least recently used layout", "[C4LayoutCache]")
+{
+	ExtentCache cache;
+	for (std::size_t i = 0; i < ExtentCache::Capacity; ++i)
+		InsertText(cache, "Text " + std::to_string(i), static_cast<int32_t>(i));
+	REQUIRE(cache.GetSize() == ExtentCache::Capacity);
+
+	// using the oldest text keeps it, so the second oldest is dropped for a new one
+	REQUIRE(HasText(cache, "Text 0"));
+	InsertText(cache, "New", 1000);
+	REQUIRE(cache.GetSize() == ExtentCache::Capacity);
+	REQUIRE(HasText(cache, "Text 0"));
+	REQUIRE_FALSE(HasText(cache, "Text 1"));
+	REQUIRE(HasText(cache, "New"));
+	REQUIRE(HasText(cache, "Text 2"));
+
+	// inserting a text again replaces its layout without dropping another one
+	InsertText(cache, "Text 3", 3000);
+	REQUIRE(cache.GetSize() == ExtentCache::Capacity);
+	const auto *const pExtent{cache.Find(cache.MakeKey("Text 3", true, false))};
+	REQUIRE(pExtent);
+	REQUIRE(pExtent->first == 3000);
+	// it is the most recently used now: the next insertions drop the texts after it
+	InsertText(cache, "New 2", 0);
+	REQUIRE_FALSE(HasText(cache, "Text 4"));
+	REQUIRE(HasText(cache, "Text 3"));
+
+	cache.Clear();
+	REQUIRE(cache.GetSize() == 0);
+	REQUIRE_FALSE(HasText(cache, "Text 0"));
+}
+
+TEST_CASE("C4LayoutCache copies start empty", "[C4LayoutCache]")
+{
+	ExtentCache cache;
+	InsertText(cache, "Hello", 5);
+
+	// the index of a copy would refer to the keys of the original
+	ExtentCache copy{cache};
+	REQUIRE(copy.GetSize() == 0);
+	REQUIRE_FALSE(HasText(copy, "Hello"));
+	InsertText(copy, "Copy", 7);
+	REQUIRE(HasText(copy, "Copy"));
+
+	ExtentCache assigned;
+	InsertText(assigned, "World", 6);
+	assigned = cache;
+	REQUIRE(assigned.GetSize() == 0);
+	REQUIRE_FALSE(HasText(assigned, "World"));
+	REQUIRE_FALSE(HasText(assigned, "Hello"));
+
+	// the original is unaffected
+	REQUIRE(HasText(cache, "Hello"));
+	REQUIRE_FALSE(HasText(cache, "Copy"));
+}
@@ -0,0 +1,257 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include <C4Include.h>
+#include <C4Aul.h>
+#include <C4Group.h>
+#include <C4Log.h>
+#include <C4MapCreatorS2.h>
+#include <C4Material.h>
+#include <C4Random.h>
+#include <C4Scenario.h>
+#include <C4Texture.h>
+#include <C4ThreadPool.h>
+#include <C4Value.h>
+#include <StdSurface8.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	// materials of the test maps; the texture map index of a material is its index + 1
+	constexpr std::array MaterialNames{"Earth", "Rock", "Granite", "Gold", "Coal", "Ore", "Water", "Tunnel", "Sand", "Ashes", "Sulphur", "Crystal", "Acid", "Lava", "Snow", "Ice"};
+
+	// in the style of the Landscape.txt files of the original scenarios
+	constexpr auto Hills = R"(
+overlay Caves { algo=bozo; turbulence=100; zoomX=-30; zoomY=-30; a=6; b=6; };
+map Hills {
+	overlay { algo=solid; mat=Earth; tex=earth; y=40; hgt=60; turbulence=1000; loosebounds=1;
+		overlay { algo=bozo; mat=Rock; tex=rock; a=10; b=10; turbulence=100; zoomX=-20; zoomY=-20; };
+		overlay { algo=rndchecker; mat=Gold; a=8; zoomX=-60; zoomY=-60; turbulence=100; };
+		overlay { algo=rndchecker; mat=Coal; a=6; zoomX=-50; zoomY=-50; turbulence=100; seed=7; };
+		overlay { algo=rndchecker; mat=Ore; a=10; zoomX=-40; zoomY=-40; turbulence=1000; };
+		Caves { mat=Tunnel; tex=smooth; } & overlay { algo=sin; ox=12; a=6; zoomY=-30; turbulence=100; };
+		overlay { algo=solid; y=80; mat=Granite; tex=rough; turbulence=1000; loosebounds=1; };
+	};
+	overlay { algo=solid; mat=Water; tex=smooth; y=45; hgt=10; } ^ overlay { algo=bozo; a=20; b=20; turbulence=100; };
+};
+)";
+
+	// deep nesting, masks and operator chains
+	constexpr auto Caverns = R"(
+map Caverns {
+	overlay { algo=solid; mat=Rock; tex=rough;
+		overlay { algo=boxes; a=14; b=12; zoomX=20; mat=Earth; tex=earth; turbulence=100;
+			overlay { algo=bozo; mat=Tunnel; tex=smooth; a=10; b=8; turbulence=1000; zoomX=-30;
+				overlay { algo=random; mat=Sand; a=4; zoomX=-80; zoomY=-80;
+					overlay { algo=checker; mat=Crystal; a=3; b=3; turbulence=100; };
+				};
+				overlay { algo=lines; a=3; b=11; rotate=30; mat=Ashes; turbulence=10; } | overlay { algo=mandel; a=200; mat=Sulphur; };
+			};
+			overlay { algo=rndchecker; mat=Gold; a=7; zoomX=-50; zoomY=-50; turbulence=100; invert=1; mask=1;
+				overlay { algo=gradient; mat=Ore; };
+			};
+		};
+		overlay { algo=border; a=4; b=4; mat=Granite; tex=rough; };
+		overlay { algo=bozo; y=60; mat=Water; a=15; b=15; turbulence=100; } & overlay { algo=sin; a=4; ox=10; zoomY=-40; };
+	};
+	overlay { algo=solid; hgt=8; mat=Lava; tex=smooth; } | overlay { algo=solid; y=92; mat=Acid; tex=smooth; };
+};
+)";
+
+	// mostly solid layers, where the row renderer fills whole runs
+	constexpr auto Layers = R"(
+map Layers {
+	overlay { algo=solid; y=30; hgt=20; mat=Earth; tex=earth; };
+	overlay { algo=solid; y=50; hgt=20; mat=Rock; tex=rough; };
+	overlay { algo=solid; y=70; hgt=30; mat=Granite; tex=rough; };
+	overlay { algo=rndall; a=5; y=40; hgt=50; mat=Gold; };
+	overlay { algo=solid; y=20; hgt=10; mat=Snow; tex=smooth; } | overlay { algo=solid; y=25; hgt=10; mat=Ice; tex=smooth; };
+};
+)";
+
+	struct Environment
+	{
+		C4SLandscape Landscape;
+		C4MaterialMap MaterialMap;
+		C4TextureMap TextureMap;
+
+		Environment(const int32_t iWdt, const int32_t iHgt)
+		{
+			Landscape.MapWdt.Std = Landscape.MapWdt.Max = iWdt;
+			Landscape.MapHgt.Std = Landscape.MapHgt.Max = iHgt;
+			Landscape.MapPlayerExtend = false;
+
+			MaterialMap.Num = static_cast<int32_t>(MaterialNames.size());
+			MaterialMap.Map = new C4Material[MaterialNames.size()];
+			for (int32_t i = 0; i < MaterialMap.Num; ++i)
+				SCopy(MaterialNames[i], MaterialMap.Map[i].Name, C4M_MaxName);
+		}
+	};
+
+	// the random based algorithms draw their seeds from the engine random generator, so every map has to be
+	// created in the same order from the same seed to be comparable
+	std::unique_ptr<C4MapCreatorS2> CreateMap(Environment &env, const char *const szScript)
+	{
+		FixedRandom(1234);
+		auto creator = std::make_unique<C4MapCreatorS2>(&env.Landscape, &env.TextureMap, &env.MaterialMap, 1, nullptr);
+		REQUIRE(creator->ReadScript(szScript));
+		return creator;
+	}
+
+	std::vector<uint8_t> Render(C4MCMap &map)
+	{
+		std::vector<uint8_t> pixels(map.Wdt * map.Hgt);
+		REQUIRE(map.RenderTo(pixels.data(), map.Wdt));
+		return pixels;
+	}
+
+	// the pixel order renderer, which maps with script algorithms still use
+	std::vector<uint8_t> RenderPixelByPixel(C4MCMap &map)
+	{
+		std::vector<uint8_t> pixels(map.Wdt * map.Hgt);
+		for (int32_t iY = 0; iY < map.Hgt; ++iY)
+			for (int32_t iX = 0; iX < map.Wdt; ++iX)
+				map.RenderPix(iX, iY, pixels[iY * map.Wdt + iX]);
+		return pixels;
+	}
+
+	struct ThreadPoolGuard
+	{
+		ThreadPoolGuard(const std::uint32_t iThreads) { C4ThreadPool::Global = std::make_shared<C4ThreadPool>(iThreads, iThreads); }
+		~ThreadPoolGuard() { C4ThreadPool::Global.reset(); }
+	};
+}
+
+TEST_CASE("C4MCMap renders rows like pixel by pixel", "[C4MapCreatorS2]")
+{
+	const auto [szName, szScript] = GENERATE(table<const char *, const char *>({{"Hills", Hills}, {"Caverns", Caverns}, {"Layers", Layers}}));
+	INFO(szName);
+	Environment env{200, 120};
+
+	const auto creator = CreateMap(env, szScript);
+	C4MCMap *const pMap{creator->GetMap(szName)};
+	REQUIRE(pMap);
+	const auto rows = Render(*pMap);
+	REQUIRE(rows == RenderPixelByPixel(*pMap));
+	// the map is not all sky
+	REQUIRE(std::count(rows.begin(), rows.end(), 0) < static_cast<std::ptrdiff_t>(rows.size()));
+
+	// a map created again from the same seed does not depend on where its rows are rendered
+	ThreadPoolGuard threadPool{3};
+	const auto parallelCreator = CreateMap(env, szScript);
+	REQUIRE(Render(*parallelCreator->GetMap(szName)) == rows);
+}
+
+TEST_CASE("C4MCMap benchmark", "[.][benchmark][C4MapCreatorS2]")
+{
+	Environment env{400, 250};
+	Environment largeEnv{1200, 600};
+	const auto hillsCreator = CreateMap(env, Hills);
+	const auto cavernsCreator = CreateMap(env, Caverns);
+	const auto layersCreator = CreateMap(env, Layers);
+	const auto largeCavernsCreator = CreateMap(largeEnv, Caverns);
+	C4MCMap &hills{*hillsCreator->GetMap("Hills")};
+	C4MCMap &caverns{*cavernsCreator->GetMap("Caverns")};
+	C4MCMap &layers{*layersCreator->GetMap("Layers")};
+	C4MCMap &largeCaverns{*largeCavernsCreator->GetMap("Caverns")};
+
+	SECTION("single thread")
+	{
+		BENCHMARK("Hills 400x250") { return Render(hills); };
+		BENCHMARK("Caverns 400x250") { return Render(caverns); };
+		BENCHMARK("Layers 400x250") { return Render(layers); };
+		BENCHMARK("Caverns 1200x600") { return Render(largeCaverns); };
+		BENCHMARK("Caverns 400x250 pixel by pixel") { return RenderPixelByPixel(caverns); };
+	}
+
+	SECTION("thread pool")
+	{
+		ThreadPoolGuard threadPool{std::thread::hardware_concurrency()};
+		BENCHMARK("Hills 400x250") { return Render(hills); };
+		BENCHMARK("Caverns 1200x600") { return Render(largeCaverns); };
+	}
+}
+
+// C4MapCreatorS2.cpp is linked on its own; these stand in for the parts of the engine it refers to,
+// as far as maps without script algorithms, callbacks and map files need them
+
+C4SVal::C4SVal(const int32_t std, const int32_t rnd, const int32_t min, const int32_t max) : Std{std}, Rnd{rnd}, Min{min}, Max{max} {}
+int32_t C4SVal::Evaluate() { return Std; }
+C4NameList::C4NameList() {}
+
+C4MaterialCore::C4MaterialCore() { Name[0] = '\0'; }
+void C4MaterialCore::Clear() {}
+C4Material::C4Material() {}
+C4Facet::C4Facet() : Surface{nullptr}, X{0}, Y{0}, Wdt{0}, Hgt{0} {}
+CPattern::CPattern() {}
+void CPattern::Clear() {}
+
+C4MaterialMap::C4MaterialMap()
+	: Num{0}, Map{nullptr}, ppReactionMap{nullptr},
+	DefReactConvert{nullptr}, DefReactPoof{nullptr}, DefReactCorrode{nullptr}, DefReactIncinerate{nullptr}, DefReactInsert{nullptr} {}
+C4MaterialMap::~C4MaterialMap() { delete[] Map; }
+
+int32_t C4MaterialMap::Get(const char *const szMaterial)
+{
+	for (int32_t i = 0; i < Num; ++i)
+		if (SEqual(Map[i].Name, szMaterial)) return i;
+	return MNone;
+}
+
+C4TexMapEntry::C4TexMapEntry() : iMaterialIndex{MNone}, pMaterial{nullptr} {}
+C4TextureMap::C4TextureMap() : FirstTexture{nullptr}, fOverloadMaterials{false}, fOverloadTextures{false}, fInitialized{false}, fEntriesAdded{false} {}
+C4TextureMap::~C4TextureMap() {}
+bool C4TextureMap::CheckTexture(const char *) { return true; }
+
+int32_t C4TextureMap::GetIndexMatTex(const char *const szMaterialTexture, const char *, bool, const char *)
+{
+	const auto it = std::find_if(MaterialNames.begin(), MaterialNames.end(), [szMaterialTexture](const char *const szName) { return SEqual(szName, szMaterialTexture); });
+	return it != MaterialNames.end() ? static_cast<int32_t>(it - MaterialNames.begin()) + 1 : 0;
+}
+
+C4AulScriptFunc *C4AulScript::GetSFunc(const char *, C4AulAccess, bool) { return nullptr; }
+C4AulScriptFunc *C4AulScript::GetSFunc(const char *) { return nullptr; }
+C4AulError::C4AulError() {}
+void C4AulError::show() const {}
+
+void C4Value::AddDataRef() {}
+void C4Value::Set(C4V_Data, C4V_Type) {}
+C4Value::~C4Value() {}
+C4Value &C4Value::operator=(const C4Value &) { return *this; }
+const C4Value &C4Value::GetRefVal() const { return *this; }
+
+bool C4Group::AccessEntry(const char *, size_t *, char *, bool *) { return false; }
+bool C4Group::Read(void *, size_t) { return false; }
+
+CSurface8::CSurface8(int, int) { std::abort(); }
+CSurface8::~CSurface8() {}
+
+void LogNTr(const spdlog::level::level_enum, const std::string_view message)
+{
+	std::fprintf(stderr, "%.*s\n", static_cast<int>(message.size()), message.data());
+}
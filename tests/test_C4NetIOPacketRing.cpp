@@ -0,0 +1,239 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4NetIOPacketRing.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+	struct TestPacket
+	{
+		unsigned int Nr, Cnt;
+
+		unsigned int GetNr() const { return Nr; }
+		unsigned int FragmentCnt() const { return Cnt; }
+	};
+
+	using Ring = C4NetIOPacketRing<TestPacket>;
+
+	// The sorted, doubly linked list C4NetIOUDP::PacketList used before, searched linearly.
+	// The window after the acknowledged number is the only addition.
+	class ReferenceList
+	{
+		std::list<TestPacket *> Packets;
+		unsigned int AckNr{0};
+
+	public:
+		TestPacket *GetPacketFrgm(const unsigned int iNr) const
+		{
+			for (TestPacket *const pPkt : Packets)
+				if (pPkt->Nr <= iNr && pPkt->Nr + pPkt->Cnt > iNr)
+					return pPkt;
+			return nullptr;
+		}
+
+		TestPacket *GetFirstPacket() const { return Packets.empty() ? nullptr : Packets.front(); }
+		unsigned int GetPacketCnt() const { return static_cast<unsigned int>(Packets.size()); }
+
+		bool Add(TestPacket *const pPacket)
+		{
+			const unsigned long long iEnd{static_cast<unsigned long long>(pPacket->Nr) + pPacket->Cnt};
+			if (pPacket->Nr < AckNr || iEnd > static_cast<unsigned long long>(AckNr) + Ring::MaxWindow) return false;
+			// search from the back, as new packets usually come last
+			auto it = Packets.end();
+			while (it != Packets.begin() && (*std::prev(it))->Nr > pPacket->Nr) --it;
+			if (it != Packets.begin() && (*std::prev(it))->Nr + (*std::prev(it))->Cnt > pPacket->Nr) return false;
+			if (it != Packets.end() && (*it)->Nr < pPacket->Nr + pPacket->Cnt) return false;
+			Packets.insert(it, pPacket);
+			return true;
+		}
+
+		void Remove(TestPacket *const pPacket) { Packets.remove(pPacket); }
+		void Acknowledge(const unsigned int iNr) { AckNr = iNr; }
+	};
+}
+
+TEST_CASE("C4NetIOPacketRing behaves like a sorted packet list", "[C4NetIOPacketRing]")
+{
+	std::mt19937 rng{GENERATE(1u, 2u, 3u, 4u)};
+	// packets arrive roughly in order, like the packet numbers of a peer, but with gaps, duplicates and stragglers
+	std::uniform_int_distribution<int> op{0, 10}, jitter{-40, 40}, fragments{1, 5};
+
+	Ring ring;
+	ReferenceList reference;
+	std::vector<std::unique_ptr<TestPacket>> packets;
+	unsigned int iNext{100};
+	std::size_t iMaxRingSize{0};
+
+	for (int iStep = 0; iStep < 20000; ++iStep)
+	{
+		const int iOp{op(rng)};
+		if (iOp < 6)
+		{
+			// add; the ring must refuse exactly what the list refuses (overlaps and packets outside the window)
+			auto pkt = std::make_unique<TestPacket>(TestPacket{static_cast<unsigned int>(std::max(0, static_cast<int>(iNext) + jitter(rng))), static_cast<unsigned int>(fragments(rng))});
+			iNext += pkt->Cnt;
+			const bool fAdded{reference.Add(pkt.get())};
+			REQUIRE(ring.Add(pkt.get()) == fAdded);
+			if (fAdded) packets.push_back(std::move(pkt));
+		}
+		else if (iOp < 9 && !packets.empty())
+		{
+			// remove a random packet or the first one, like the limit does
+			auto it = iOp == 8 ? std::find_if(packets.begin(), packets.end(), [&](const auto &pkt) { return pkt.get() == reference.GetFirstPacket(); })
+				: packets.begin() + std::uniform_int_distribution<std::size_t>{0, packets.size() - 1}(rng);
+			reference.Remove(it->get());
+			ring.Remove(it->get());
+			packets.erase(it);
+		}
+		else if (iOp == 9)
+		{
+			// acknowledge up to some recent number, like ClearPackets does
+			const unsigned int iUntil{std::max(ring.GetAckNr(), iNext > 60 ? iNext - 60 : 0)};
+			for (auto it = packets.begin(); it != packets.end(); )
+				if ((*it)->Nr < iUntil)
+				{
+					reference.Remove(it->get());
+					ring.Remove(it->get());
+					it = packets.erase(it);
+				}
+				else
+					++it;
+			reference.Acknowledge(iUntil);
+			ring.Acknowledge(iUntil);
+		}
+		else if (iOp == 10)
+		{
+			// packets ending at the window edge are taken, those beyond it are dropped
+			TestPacket edge{ring.GetAckNr() + Ring::MaxWindow - 2, 2}, beyond{ring.GetAckNr() + Ring::MaxWindow - 1, 2};
+			REQUIRE_FALSE(ring.Add(&beyond));
+			const bool fAdded{reference.Add(&edge)};
+			REQUIRE(ring.Add(&edge) == fAdded);
+			iMaxRingSize = std::max(iMaxRingSize, ring.GetRingSize());
+			if (fAdded)
+			{
+				reference.Remove(&edge);
+				ring.Remove(&edge);
+			}
+		}
+
+		REQUIRE(ring.GetPacketCnt() == reference.GetPacketCnt());
+		REQUIRE(ring.GetFirstPacket() == reference.GetFirstPacket());
+		if (iStep % 50 == 0)
+			for (unsigned int iNr = iNext > 300 ? iNext - 300 : 0; iNr < iNext + 50; ++iNr)
+				REQUIRE(ring.GetPacketFrgm(iNr) == reference.GetPacketFrgm(iNr));
+	}
+
+	// even with packets at the window edge, the ring never exceeds the window
+	REQUIRE(iMaxRingSize <= Ring::MaxWindow);
+}
+
+TEST_CASE("C4NetIOPacketRing only takes packets in the window after the acknowledged number", "[C4NetIOPacketRing]")
+{
+	Ring ring;
+	TestPacket wrapping{~0u - 1, 4}, first{0, 2}, last{Ring::MaxWindow - 1, 1}, beyond{Ring::MaxWindow, 1};
+	REQUIRE_FALSE(ring.Add(&wrapping));
+	REQUIRE(ring.Add(&first));
+	REQUIRE(ring.Add(&last));
+	REQUIRE_FALSE(ring.Add(&beyond));
+	REQUIRE(ring.GetPacketFrgm(1) == &first);
+	REQUIRE(ring.GetPacketFrgm(Ring::MaxWindow - 1) == &last);
+
+	// removing the first packet does not move the window, acknowledging does
+	ring.Remove(&first);
+	REQUIRE(ring.GetFirstPacket() == &last);
+	REQUIRE_FALSE(ring.Add(&beyond));
+	ring.Acknowledge(2);
+	REQUIRE(ring.Add(&beyond));
+	// acknowledged fragments are not taken again
+	REQUIRE_FALSE(ring.Add(&first));
+
+	ring.Remove(&last);
+	ring.Remove(&beyond);
+	REQUIRE(ring.GetPacketCnt() == 0);
+	REQUIRE(ring.GetFirstPacket() == nullptr);
+}
+
+TEST_CASE("C4NetIOPacketRing shrinks once its packets are gone", "[C4NetIOPacketRing]")
+{
+	Ring ring;
+	std::vector<TestPacket> packets;
+	for (unsigned int i = 0; i < 5000; ++i) packets.push_back({i * 4, 4});
+	for (auto &pkt : packets) REQUIRE(ring.Add(&pkt));
+	REQUIRE(ring.GetRingSize() == 32768);
+
+	// keep the last few, like a backlog that was mostly acknowledged
+	for (std::size_t i = 0; i + 10 < packets.size(); ++i) ring.Remove(&packets[i]);
+	REQUIRE(ring.GetRingSize() == 128);
+	for (std::size_t i = packets.size() - 10; i < packets.size(); ++i)
+		REQUIRE(ring.GetPacketFrgm(packets[i].Nr + 3) == &packets[i]);
+
+	for (std::size_t i = packets.size() - 10; i < packets.size(); ++i) ring.Remove(&packets[i]);
+	REQUIRE(ring.GetRingSize() == Ring::MinRingSize);
+}
+
+TEST_CASE("C4NetIOPacketRing benchmark", "[.][benchmark][C4NetIOPacketRing]")
+{
+	// a full outgoing backlog (C4NetIOUDP::iMaxOPacketBacklog) of two-fragment packets;
+	// every check packet makes the peer look up the fragments it is asked for
+	constexpr unsigned int iPackets{100};
+	std::vector<TestPacket> packets;
+	for (unsigned int i = 0; i < iPackets; ++i) packets.push_back({i * 2, 2});
+	Ring ring;
+	ReferenceList reference;
+	for (auto &pkt : packets)
+	{
+		ring.Add(&pkt);
+		reference.Add(&pkt);
+	}
+
+	BENCHMARK("list: look up every fragment")
+	{
+		unsigned int iFound{0};
+		for (unsigned int iNr = 0; iNr < iPackets * 2; ++iNr)
+			if (reference.GetPacketFrgm(iNr)) ++iFound;
+		return iFound;
+	};
+	BENCHMARK("ring: look up every fragment")
+	{
+		unsigned int iFound{0};
+		for (unsigned int iNr = 0; iNr < iPackets * 2; ++iNr)
+			if (ring.GetPacketFrgm(iNr)) ++iFound;
+		return iFound;
+	};
+	BENCHMARK("list: send and acknowledge 100 packets")
+	{
+		ReferenceList list;
+		for (auto &pkt : packets) list.Add(&pkt);
+		while (TestPacket *const pPkt = list.GetFirstPacket()) list.Remove(pPkt);
+		return list.GetPacketCnt();
+	};
+	BENCHMARK("ring: send and acknowledge 100 packets")
+	{
+		Ring r;
+		for (auto &pkt : packets) r.Add(&pkt);
+		while (TestPacket *const pPkt = r.GetFirstPacket()) r.Remove(pPkt);
+		return r.GetPacketCnt();
+	};
+}
@@ -0,0 +1,219 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4NetIO.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// echoes every packet back to its sender
+	class EchoServer : public C4NetIO::CBClass
+	{
+	public:
+		int Connections{0}, Disconnections{0};
+		std::uint64_t Packets{0};
+		bool Echo{true};
+
+		bool OnConn(const C4NetIO::addr_t &, const C4NetIO::addr_t &, const C4NetIO::addr_t *, C4NetIO *) override { ++Connections; return true; }
+		void OnDisconn(const C4NetIO::addr_t &, C4NetIO *, const char *) override { ++Disconnections; }
+		void OnPacket(const C4NetIOPacket &rPacket, C4NetIO *const pNetIO) override
+		{
+			++Packets;
+			if (Echo) pNetIO->Send(rPacket);
+		}
+	};
+
+	class Client : public C4NetIO::CBClass
+	{
+	public:
+		C4NetIOTCP NetIO;
+		C4NetIO::addr_t ServerAddr;
+		bool Connected{false}, Disconnected{false};
+		std::uint32_t LastEcho{0};
+		std::uint64_t Echoes{0};
+
+		bool OnConn(const C4NetIO::addr_t &AddrPeer, const C4NetIO::addr_t &, const C4NetIO::addr_t *, C4NetIO *) override
+		{
+			ServerAddr = AddrPeer;
+			Connected = true;
+			return true;
+		}
+		void OnDisconn(const C4NetIO::addr_t &, C4NetIO *, const char *) override { Disconnected = true; }
+		void OnPacket(const C4NetIOPacket &rPacket, C4NetIO *) override
+		{
+			REQUIRE(rPacket.getPSize() == sizeof(LastEcho));
+			std::memcpy(&LastEcho, rPacket.getPData(), sizeof(LastEcho));
+			++Echoes;
+		}
+
+		bool Send(const std::uint32_t iValue)
+		{
+			char data[1 + sizeof(iValue)]{};
+			std::memcpy(data + 1, &iValue, sizeof(iValue));
+			return NetIO.Send(C4NetIOPacket{data, sizeof(data), true, ServerAddr});
+		}
+	};
+
+	// a listening server and iClients clients connected to it over loopback
+	struct LoopbackNetwork
+	{
+		EchoServer ServerCB;
+		C4NetIOTCP Server;
+		std::vector<std::unique_ptr<Client>> Clients;
+
+		explicit LoopbackNetwork(const int iClients)
+		{
+			Server.SetCallback(&ServerCB);
+			std::uint16_t iPort{23170};
+			for (; !Server.Init(iPort); ++iPort)
+			{
+				Server.Close();
+				REQUIRE(iPort < 23270);
+			}
+
+			for (int i = 0; i < iClients; ++i)
+			{
+				auto &client = *Clients.emplace_back(std::make_unique<Client>());
+				client.NetIO.SetCallback(&client);
+				REQUIRE(client.NetIO.Init());
+				REQUIRE(client.NetIO.Connect(C4NetIO::addr_t{C4Network2HostAddress::Loopback, iPort}));
+			}
+			RunUntil([this] { return ServerCB.Connections == static_cast<int>(Clients.size()) && AllClients([](const Client &client) { return client.Connected; }); });
+		}
+
+		~LoopbackNetwork()
+		{
+			for (auto &client : Clients)
+				client->NetIO.Close();
+			Server.Close();
+		}
+
+		template<typename Pred> bool AllClients(Pred pred) const
+		{
+			for (const auto &client : Clients)
+				if (!pred(*client)) return false;
+			return true;
+		}
+
+		// execute everything until the condition is met
+		template<typename Cond> void RunUntil(Cond cond)
+		{
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+			while (!cond())
+			{
+				REQUIRE(std::chrono::steady_clock::now() < deadline);
+				REQUIRE(Server.Execute(0));
+				for (auto &client : Clients)
+					REQUIRE(client->NetIO.Execute(0));
+			}
+		}
+
+		// execute the server only
+		template<typename Cond> void RunServerUntil(Cond cond)
+		{
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+			while (!cond())
+			{
+				REQUIRE(std::chrono::steady_clock::now() < deadline);
+				REQUIRE(Server.Execute(100));
+			}
+		}
+	};
+}
+
+TEST_CASE("C4NetIOTCP serves many loopback clients", "[C4NetIOTCP]")
+{
+	LoopbackNetwork network{64};
+
+	SECTION("every client gets its own packets back")
+	{
+		for (std::uint32_t iRound = 1; iRound <= 20; ++iRound)
+		{
+			for (std::size_t i = 0; i < network.Clients.size(); ++i)
+				REQUIRE(network.Clients[i]->Send(iRound * 1000 + static_cast<std::uint32_t>(i)));
+			network.RunUntil([&] { return network.AllClients([&](const Client &client) { return client.Echoes == iRound; }); });
+			for (std::size_t i = 0; i < network.Clients.size(); ++i)
+				REQUIRE(network.Clients[i]->LastEcho == iRound * 1000 + i);
+		}
+		REQUIRE(network.ServerCB.Packets == 20 * network.Clients.size());
+	}
+
+	SECTION("large packets are echoed in pieces")
+	{
+		// more than the socket buffers take at once, so both sides have to wait for writeability
+		std::vector<char> data(4 * 1024 * 1024, 'x');
+		data[0] = 0;
+		auto &client = *network.Clients[7];
+		REQUIRE(client.NetIO.Send(C4NetIOPacket{data.data(), data.size(), false, client.ServerAddr}));
+		struct BigEcho : C4NetIO::CBClass
+		{
+			std::size_t Size{0};
+			void OnPacket(const C4NetIOPacket &rPacket, C4NetIO *) override { Size = rPacket.getSize(); }
+		} bigEcho;
+		client.NetIO.SetCallback(&bigEcho);
+		network.RunUntil([&] { return bigEcho.Size != 0; });
+		REQUIRE(bigEcho.Size == data.size());
+		client.NetIO.SetCallback(&client);
+	}
+
+	SECTION("closed clients are noticed")
+	{
+		for (std::size_t i = 0; i < network.Clients.size(); i += 2)
+			REQUIRE(network.Clients[i]->NetIO.Close(network.Clients[i]->ServerAddr));
+		network.RunUntil([&] { return network.ServerCB.Disconnections == static_cast<int>(network.Clients.size() / 2); });
+		// the others still work
+		for (std::size_t i = 1; i < network.Clients.size(); i += 2)
+			REQUIRE(network.Clients[i]->Send(static_cast<std::uint32_t>(i)));
+		network.RunUntil([&] { return network.ServerCB.Packets == network.Clients.size() / 2; });
+	}
+}
+
+TEST_CASE("C4NetIOTCP loopback benchmark", "[.][benchmark][C4NetIOTCP]")
+{
+	for (const int iClients : {64, 256})
+	{
+		LoopbackNetwork network{iClients};
+		// the clients are not executed, so they would not take echoes
+		network.ServerCB.Echo = false;
+
+		// a packet from one client at a time, as during a game: the server has to find the one ready socket
+		std::uint32_t iSent{0};
+		BENCHMARK("one of " + std::to_string(iClients) + " clients sends")
+		{
+			Client &client{*network.Clients[iSent % network.Clients.size()]};
+			client.Send(iSent++);
+			network.RunServerUntil([&] { return network.ServerCB.Packets == iSent; });
+			return network.ServerCB.Packets;
+		};
+
+		// all clients send at once
+		BENCHMARK("all of " + std::to_string(iClients) + " clients send")
+		{
+			for (auto &client : network.Clients)
+				client->Send(iSent++);
+			network.RunServerUntil([&] { return network.ServerCB.Packets == iSent; });
+			return network.ServerCB.Packets;
+		};
+	}
+}
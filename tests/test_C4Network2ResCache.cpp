@@ -0,0 +1,199 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Network2ResCache.h"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	constexpr std::size_t ChunkSize{100 * 1024}; // C4NetResChunkSize
+	constexpr uint64_t MB{1024 * 1024};
+
+	std::string ReadFile(const std::filesystem::path &path)
+	{
+		std::ifstream file{path, std::ios::binary};
+		return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	}
+
+	void WriteFile(const std::filesystem::path &path, const std::string &data)
+	{
+		std::ofstream{path, std::ios::binary}.write(data.data(), data.size());
+	}
+
+	// a ressource offered by the host
+	struct HostRes
+	{
+		std::filesystem::path Path;
+		std::string Data;
+		std::string Key;
+
+		HostRes(const std::filesystem::path &dir, const char *const szName, const std::size_t size, const unsigned int seed)
+			: Path{dir / szName}, Data(size, '\0')
+		{
+			std::mt19937 rng{seed};
+			for (auto &c : Data) c = static_cast<char>(rng());
+			WriteFile(Path, Data);
+			// stands in for the checksums C4Network2ResList::GetCacheKey uses
+			Key = std::format("{:08x}{:08x}", Data.size(), seed);
+		}
+	};
+
+	// A client joining a host on the same machine, the way C4Network2ResList does it:
+	// take the ressource from the cache if possible, otherwise load it chunk by chunk,
+	// then store it on another thread. Returns the number of chunks transferred.
+	std::size_t Join(C4Network2ResCache &cache, const HostRes &res, const std::filesystem::path &target)
+	{
+		if (!cache.GetEntryPath(res.Key).empty() && cache.Retrieve(res.Key, target.string().c_str()))
+			return 0;
+		std::ifstream host{res.Path, std::ios::binary};
+		std::ofstream client{target, std::ios::binary};
+		std::vector<char> chunk(ChunkSize);
+		std::size_t iChunks{0};
+		while (host.read(chunk.data(), chunk.size()) || host.gcount())
+		{
+			client.write(chunk.data(), host.gcount());
+			++iChunks;
+		}
+		client.close();
+		std::thread{[&] { cache.Store(res.Key, target.string().c_str(), res.Data.size()); }}.join();
+		return iChunks;
+	}
+
+	struct TempDir
+	{
+		std::filesystem::path Path;
+
+		TempDir() : Path{std::filesystem::temp_directory_path() / std::format("C4Network2ResCacheTest{}", std::random_device{}())}
+		{
+			std::filesystem::create_directories(Path / "Host");
+			std::filesystem::create_directories(Path / "Client");
+		}
+		~TempDir() { std::filesystem::remove_all(Path); }
+	};
+}
+
+TEST_CASE("C4Network2ResCache makes repeated joins skip the download", "[C4Network2ResCache]")
+{
+	TempDir dir;
+	const std::string cachePath{(dir.Path / "ResCache").string()};
+	const HostRes scenario{dir.Path / "Host", "Scenario.c4s", 1536 * 1024 + 17, 1}, definitions{dir.Path / "Host", "Objects.c4d", 700 * 1024, 2};
+
+	C4Network2ResCache cache;
+	cache.Init(cachePath.c_str(), 256 * MB);
+
+	// first join downloads everything
+	REQUIRE(Join(cache, scenario, dir.Path / "Client" / "1.c4s") == 16);
+	REQUIRE(Join(cache, definitions, dir.Path / "Client" / "1.c4d") == 7);
+	REQUIRE(cache.GetEntryCount() == 2);
+	REQUIRE(cache.GetTotalSize() == scenario.Data.size() + definitions.Data.size());
+
+	// second join in the same session takes everything from the cache
+	REQUIRE(Join(cache, scenario, dir.Path / "Client" / "2.c4s") == 0);
+	REQUIRE(ReadFile(dir.Path / "Client" / "2.c4s") == scenario.Data);
+
+	// and so does one after a restart
+	C4Network2ResCache restarted;
+	restarted.Init(cachePath.c_str(), 256 * MB);
+	REQUIRE(restarted.GetEntryCount() == 2);
+	REQUIRE(Join(restarted, scenario, dir.Path / "Client" / "3.c4s") == 0);
+	REQUIRE(Join(restarted, definitions, dir.Path / "Client" / "3.c4d") == 0);
+	REQUIRE(ReadFile(dir.Path / "Client" / "3.c4s") == scenario.Data);
+	REQUIRE(ReadFile(dir.Path / "Client" / "3.c4d") == definitions.Data);
+
+	// a damaged entry is dropped by the caller and loaded again
+	restarted.Drop(scenario.Key);
+	REQUIRE(restarted.GetEntryPath(scenario.Key).empty());
+	REQUIRE(Join(restarted, scenario, dir.Path / "Client" / "4.c4s") == 16);
+}
+
+TEST_CASE("C4Network2ResCache evicts the least recently used entries", "[C4Network2ResCache]")
+{
+	TempDir dir;
+	const std::string cachePath{(dir.Path / "ResCache").string()};
+	std::vector<HostRes> res;
+	for (unsigned int i = 0; i < 4; ++i)
+		res.emplace_back(dir.Path / "Host", std::format("{}.c4d", i).c_str(), MB, 10 + i);
+
+	C4Network2ResCache cache;
+	cache.Init(cachePath.c_str(), 3 * MB);
+	for (std::size_t i = 0; i < 3; ++i)
+		Join(cache, res[i], dir.Path / "Client" / std::format("{}.c4d", i));
+	// use the oldest one again
+	REQUIRE(Join(cache, res[0], dir.Path / "Client" / "0b.c4d") == 0);
+	// so the next one has to go
+	Join(cache, res[3], dir.Path / "Client" / "3.c4d");
+	REQUIRE(cache.GetEntryCount() == 3);
+	REQUIRE(cache.GetTotalSize() == 3 * MB);
+	REQUIRE(cache.GetEntryPath(res[1].Key).empty());
+	REQUIRE_FALSE(cache.GetEntryPath(res[0].Key).empty());
+	REQUIRE_FALSE(cache.GetEntryPath(res[2].Key).empty());
+
+	// too large for the cache at all
+	const HostRes huge{dir.Path / "Host", "Huge.c4s", 4 * MB, 20};
+	REQUIRE_FALSE(cache.Store(huge.Key, huge.Path.string().c_str(), huge.Data.size()));
+
+	// a lowered limit applies on the next start, as do leftovers of interrupted stores
+	WriteFile(dir.Path / "ResCache" / "0123.tmp", "partial");
+	C4Network2ResCache restarted;
+	restarted.Init(cachePath.c_str(), 2 * MB);
+	REQUIRE(restarted.GetEntryCount() == 2);
+	REQUIRE_FALSE(std::filesystem::exists(dir.Path / "ResCache" / "0123.tmp"));
+	// disabled
+	C4Network2ResCache disabled;
+	disabled.Init(cachePath.c_str(), 0);
+	REQUIRE_FALSE(disabled.IsEnabled());
+	REQUIRE(disabled.GetEntryPath(res[0].Key).empty());
+}
+
+TEST_CASE("C4Network2ResCache can be read while storing on other threads", "[C4Network2ResCache]")
+{
+	TempDir dir;
+	const std::string cachePath{(dir.Path / "ResCache").string()};
+	std::vector<HostRes> res;
+	for (unsigned int i = 0; i < 8; ++i)
+		res.emplace_back(dir.Path / "Host", std::format("{}.c4d", i).c_str(), 512 * 1024, 30 + i);
+
+	C4Network2ResCache cache;
+	cache.Init(cachePath.c_str(), 256 * MB);
+	REQUIRE(cache.Store(res[0].Key, res[0].Path.string().c_str(), res[0].Data.size()));
+
+	// the same file might complete twice at once
+	std::vector<std::thread> threads;
+	for (std::size_t i = 1; i < res.size(); ++i)
+		for (int iTwice = 0; iTwice < 2; ++iTwice)
+			threads.emplace_back([&cache, &res, i] { cache.Store(res[i].Key, res[i].Path.string().c_str(), res[i].Data.size()); });
+	for (int i = 0; i < 20; ++i)
+	{
+		const auto target = dir.Path / "Client" / std::format("{}.c4d", i);
+		REQUIRE(cache.Retrieve(res[0].Key, target.string().c_str()));
+		REQUIRE(ReadFile(target) == res[0].Data);
+	}
+	for (auto &thread : threads) thread.join();
+
+	REQUIRE(cache.GetEntryCount() == res.size());
+	for (const auto &r : res)
+		REQUIRE(ReadFile(cache.GetEntryPath(r.Key)) == r.Data);
+}
@@ -0,0 +1,157 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4ObjectNumberIndex.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+	// the index never dereferences objects, so any distinct addresses do
+	char ObjectStorage[20000];
+	C4Object *Obj(const std::size_t i) { return reinterpret_cast<C4Object *>(&ObjectStorage[i]); }
+
+	// the list C4ObjectList::ObjectPointer searches without the index: number and object in list order
+	using ObjectList = std::vector<std::pair<int32_t, C4Object *>>;
+
+	C4Object *SearchList(const ObjectList &list, const int32_t iNumber)
+	{
+		for (const auto &[iObjNumber, pObj] : list)
+			if (iObjNumber == iNumber) return pObj;
+		return nullptr;
+	}
+
+	C4Object *Lookup(const C4ObjectNumberIndex &index, const ObjectList &list, const int32_t iNumber)
+	{
+		if (C4Object *pObj; index.Find(iNumber, pObj)) return pObj;
+		return SearchList(list, iNumber);
+	}
+}
+
+TEST_CASE("C4ObjectNumberIndex finds objects by number", "[C4ObjectNumberIndex]")
+{
+	C4ObjectNumberIndex index;
+	for (int32_t i = 1; i <= 100; ++i) index.Add(i, Obj(i));
+	REQUIRE(index.GetSize() == 100);
+
+	C4Object *pObj{nullptr};
+	REQUIRE(index.Find(42, pObj));
+	REQUIRE(pObj == Obj(42));
+	// unknown numbers are answered by the index as well
+	REQUIRE(index.Find(1000, pObj));
+	REQUIRE(pObj == nullptr);
+
+	index.Remove(42, Obj(42));
+	REQUIRE(index.Find(42, pObj));
+	REQUIRE(pObj == nullptr);
+
+	index.Clear();
+	REQUIRE(index.GetSize() == 0);
+	REQUIRE(index.Find(1, pObj));
+	REQUIRE(pObj == nullptr);
+}
+
+TEST_CASE("C4ObjectNumberIndex leaves shared numbers to the list", "[C4ObjectNumberIndex]")
+{
+	// the second object with number 5 comes first in the list, e.g. as it was inserted sorted
+	ObjectList list{{5, Obj(2)}, {5, Obj(1)}, {6, Obj(3)}};
+	C4ObjectNumberIndex index;
+	index.Add(5, Obj(1));
+	index.Add(6, Obj(3));
+	index.Add(5, Obj(2));
+	REQUIRE(index.GetCollisions() == 1);
+
+	// while numbers are shared, every lookup is a list lookup, which returns the first in list order
+	C4Object *pObj;
+	REQUIRE_FALSE(index.Find(5, pObj));
+	REQUIRE_FALSE(index.Find(6, pObj));
+	REQUIRE(Lookup(index, list, 5) == Obj(2));
+	REQUIRE(Lookup(index, list, 6) == Obj(3));
+
+	// removing the indexed one of them leaves the other unindexed, so the list is still searched
+	list.erase(list.begin() + 1);
+	index.Remove(5, Obj(1));
+	REQUIRE(index.GetCollisions() == 1);
+	REQUIRE(Lookup(index, list, 5) == Obj(2));
+
+	// once the last duplicate is gone, the index answers again
+	list.erase(list.begin());
+	index.Remove(5, Obj(2));
+	REQUIRE(index.GetCollisions() == 0);
+	REQUIRE(index.Find(6, pObj));
+	REQUIRE(pObj == Obj(3));
+	REQUIRE(index.Find(5, pObj));
+	REQUIRE(pObj == nullptr);
+}
+
+TEST_CASE("C4ObjectNumberIndex agrees with the list search", "[C4ObjectNumberIndex]")
+{
+	std::mt19937 rng{43};
+	std::uniform_int_distribution<int32_t> number{1, 300};
+	ObjectList list;
+	C4ObjectNumberIndex index;
+	for (std::size_t i = 0; i < 2000; ++i)
+	{
+		// insert at random positions, as sorted lists do, and remove some again
+		if (!list.empty() && rng() % 3 == 0)
+		{
+			const std::size_t iPos{rng() % list.size()};
+			index.Remove(list[iPos].first, list[iPos].second);
+			list.erase(list.begin() + iPos);
+		}
+		const int32_t iNumber{number(rng)};
+		list.insert(list.begin() + (list.empty() ? 0 : rng() % list.size()), {iNumber, Obj(i)});
+		index.Add(iNumber, Obj(i));
+
+		for (int32_t iLookup = 1; iLookup <= 300; iLookup += 37)
+			REQUIRE(Lookup(index, list, iLookup) == SearchList(list, iLookup));
+	}
+}
+
+TEST_CASE("C4ObjectNumberIndex benchmark", "[.][benchmark][C4ObjectNumberIndex]")
+{
+	// loading a savegame with 20000 objects resolves about one enumerated pointer per object
+	constexpr int32_t iObjects{20000};
+	ObjectList list;
+	C4ObjectNumberIndex index;
+	for (int32_t i = 0; i < iObjects; ++i)
+	{
+		list.emplace_back(i + 1, Obj(i));
+		index.Add(i + 1, Obj(i));
+	}
+	std::vector<int32_t> pointers(iObjects);
+	std::mt19937 rng{7};
+	std::generate(pointers.begin(), pointers.end(), [&rng] { return static_cast<int32_t>(rng() % iObjects) + 1; });
+
+	BENCHMARK("list search: 20000 pointers in 20000 objects")
+	{
+		std::size_t iFound{0};
+		for (const int32_t iNumber : pointers) iFound += SearchList(list, iNumber) != nullptr;
+		return iFound;
+	};
+	BENCHMARK("index: 20000 pointers in 20000 objects")
+	{
+		std::size_t iFound{0};
+		for (const int32_t iNumber : pointers) iFound += Lookup(index, list, iNumber) != nullptr;
+		return iFound;
+	};
+}
@@ -0,0 +1,210 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "C4Pool.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+	// pools register themselves globally and are never destroyed, so they must not live on the stack
+	C4Pool ReusePool{"Reuse", 40};
+	C4Pool CounterPool{"Counter", 100};
+	C4Pool LargePool{"Large", 16};
+
+	// block sizes of C4Object, C4ObjectLink, C4Command and C4Effect in a 64 bit build
+	constexpr std::array<std::size_t, 4> TypeSizes{2280, 48, 224, 256};
+	C4Pool ObjectPool{"Object", TypeSizes[0]}, LinkPool{"Link", TypeSizes[1]}, CommandPool{"Command", TypeSizes[2]}, EffectPool{"Effect", TypeSizes[3]};
+	const std::array<C4Pool *, 4> TypePools{&ObjectPool, &LinkPool, &CommandPool, &EffectPool};
+
+	struct HeapAllocator
+	{
+		void *Allocate(std::size_t iType) { return ::operator new(TypeSizes[iType]); }
+		void Deallocate(void *ptr, std::size_t iType) { ::operator delete(ptr, TypeSizes[iType]); }
+		void EndFrame() {}
+	};
+
+	struct PoolAllocator
+	{
+		void *Allocate(std::size_t iType) { return TypePools[iType]->Allocate(TypeSizes[iType]); }
+		void Deallocate(void *ptr, std::size_t iType) { TypePools[iType]->Deallocate(ptr, TypeSizes[iType]); }
+		void EndFrame() { C4Pool::EndFrame(); }
+	};
+
+	// A busy scenario: per object there are a few links, a command and an effect.
+	// Every frame some of each are deleted and as many created, and all live objects are touched once.
+	template<typename Allocator>
+	class Churn
+	{
+		static constexpr std::array<std::size_t, 4> LiveCounts{4000, 12000, 4000, 4000};
+
+		Allocator Alloc;
+		std::array<std::vector<void *>, 4> Live;
+		std::mt19937 Rng{17};
+		// other allocations of the engine (strings, arrays, values) that are made in between
+		std::vector<std::vector<char>> Other;
+
+	public:
+		Churn()
+		{
+			for (std::size_t iType{0}; iType < Live.size(); ++iType)
+				for (std::size_t i{0}; i < LiveCounts[iType]; ++i)
+					Live[iType].push_back(Create(iType));
+			Alloc.EndFrame();
+		}
+
+		~Churn()
+		{
+			for (std::size_t iType{0}; iType < Live.size(); ++iType)
+				for (void *const ptr : Live[iType])
+					Alloc.Deallocate(ptr, iType);
+			Alloc.EndFrame();
+		}
+
+		std::uint64_t Frame()
+		{
+			for (std::size_t iType{0}; iType < Live.size(); ++iType)
+			{
+				auto &live = Live[iType];
+				std::uniform_int_distribution<std::size_t> pick{0, live.size() - 1};
+				for (std::size_t i{0}; i < live.size() / 50; ++i)
+				{
+					void *&ptr{live[pick(Rng)]};
+					Alloc.Deallocate(ptr, iType);
+					ptr = Create(iType);
+				}
+			}
+			Alloc.EndFrame();
+			// execute: read the head of everything
+			std::uint64_t iSum{0};
+			for (const auto &live : Live)
+				for (void *const ptr : live)
+					iSum += *static_cast<const std::uint32_t *>(ptr);
+			return iSum;
+		}
+
+	private:
+		void *Create(const std::size_t iType)
+		{
+			std::uniform_int_distribution<std::size_t> otherSize{16, 600};
+			if (Other.size() < 20000) Other.emplace_back(otherSize(Rng));
+			else Other[Rng() % Other.size()] = std::vector<char>(otherSize(Rng));
+			void *const ptr{Alloc.Allocate(iType)};
+			// constructors write the whole object
+			std::memset(ptr, static_cast<int>(iType), TypeSizes[iType]);
+			return ptr;
+		}
+	};
+}
+
+TEST_CASE("C4Pool hands out deleted blocks again only after the frame", "[C4Pool]")
+{
+	std::vector<void *> blocks;
+	for (int i = 0; i < 1000; ++i)
+	{
+		void *const ptr{ReusePool.Allocate(40)};
+		REQUIRE(reinterpret_cast<std::uintptr_t>(ptr) % alignof(std::max_align_t) == 0);
+		blocks.push_back(ptr);
+	}
+	REQUIRE(std::set<void *>(blocks.begin(), blocks.end()).size() == blocks.size());
+
+	const std::set<void *> deleted(blocks.begin(), blocks.begin() + 500);
+	for (void *const ptr : deleted)
+		ReusePool.Deallocate(ptr, 40);
+
+	// same frame: no deleted address may come back
+	std::vector<void *> sameFrame;
+	for (int i = 0; i < 500; ++i)
+	{
+		sameFrame.push_back(ReusePool.Allocate(40));
+		REQUIRE_FALSE(deleted.contains(sameFrame.back()));
+	}
+
+	// next frame: the deleted blocks are used before new slabs are added
+	C4Pool::EndFrame();
+	const std::size_t iSlabs{ReusePool.GetSlabCount()};
+	for (std::size_t i = 0; i < deleted.size(); ++i)
+		REQUIRE(deleted.contains(ReusePool.Allocate(40)));
+	REQUIRE(ReusePool.GetSlabCount() == iSlabs);
+}
+
+TEST_CASE("C4Pool counts live blocks and allocations", "[C4Pool]")
+{
+	C4Pool::ResetStats();
+	std::vector<void *> blocks;
+	for (int i = 0; i < 30; ++i)
+		blocks.push_back(CounterPool.Allocate(100));
+	for (int i = 0; i < 10; ++i)
+		CounterPool.Deallocate(blocks[i], 100);
+	REQUIRE(CounterPool.GetLive() == 20);
+	REQUIRE(CounterPool.GetAllocations() == 30);
+	C4Pool::EndFrame();
+	REQUIRE(CounterPool.GetLastFrameAllocations() == 30);
+	REQUIRE(CounterPool.GetFrames() == 1);
+
+	for (int i = 0; i < 5; ++i)
+		blocks.push_back(CounterPool.Allocate(100));
+	C4Pool::EndFrame();
+	REQUIRE(CounterPool.GetLastFrameAllocations() == 5);
+	REQUIRE(CounterPool.GetAllocations() == 35);
+	REQUIRE(CounterPool.GetLive() == 25);
+
+	C4Pool::ResetStats();
+	REQUIRE(CounterPool.GetAllocations() == 0);
+	REQUIRE(CounterPool.GetFrames() == 0);
+	REQUIRE(CounterPool.GetLive() == 25);
+	for (std::size_t i = 10; i < blocks.size(); ++i)
+		CounterPool.Deallocate(blocks[i], 100);
+	REQUIRE(CounterPool.GetLive() == 0);
+
+	bool fRegistered{false};
+	for (C4Pool *pool{C4Pool::GetFirst()}; pool; pool = pool->GetNext())
+		if (pool == &CounterPool) fRegistered = true;
+	REQUIRE(fRegistered);
+}
+
+TEST_CASE("C4Pool leaves larger derived classes to the heap", "[C4Pool]")
+{
+	void *const ptr{LargePool.Allocate(1000)};
+	std::memset(ptr, 0, 1000);
+	REQUIRE(LargePool.GetLive() == 0);
+	LargePool.Deallocate(ptr, 1000);
+	REQUIRE(LargePool.GetLive() == 0);
+	LargePool.Deallocate(nullptr, 16);
+}
+
+TEST_CASE("C4Pool benchmark", "[.][benchmark][C4Pool]")
+{
+	BENCHMARK_ADVANCED("heap: 10 frames of object churn")(Catch::Benchmark::Chronometer meter)
+	{
+		Churn<HeapAllocator> churn;
+		meter.measure([&] { std::uint64_t iSum{0}; for (int i = 0; i < 10; ++i) iSum += churn.Frame(); return iSum; });
+	};
+	BENCHMARK_ADVANCED("pools: 10 frames of object churn")(Catch::Benchmark::Chronometer meter)
+	{
+		Churn<PoolAllocator> churn;
+		meter.measure([&] { std::uint64_t iSum{0}; for (int i = 0; i < 10; ++i) iSum += churn.Frame(); return iSum; });
+	};
+}
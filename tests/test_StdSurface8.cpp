@@ -0,0 +1,268 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2024, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+#include "StdSurface8.h"
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace
+{
+	// landscape-like pixels: long runs of the same material with some noise
+	std::vector<uint8_t> MakePixels(const std::size_t size, const unsigned int seed)
+	{
+		std::mt19937 rng{seed};
+		std::uniform_int_distribution<int> run{1, 40}, pix{0, 255};
+		std::vector<uint8_t> pixels(size);
+		for (std::size_t i = 0; i < size;)
+		{
+			const uint8_t byPix{static_cast<uint8_t>(pix(rng) < 64 ? 0 : pix(rng))};
+			for (int n = run(rng); n-- && i < size; ++i) pixels[i] = byPix;
+		}
+		return pixels;
+	}
+
+	const auto IsDense = [](const uint8_t pix) { return pix >= 100; };
+
+	// the per-pixel loops the kernels replaced
+
+	int CountRowPerPixel(const uint8_t *const pRow, const int iLen)
+	{
+		int iCnt = 0;
+		for (int i = 0; i < iLen; ++i)
+			if (IsDense(pRow[i]))
+				iCnt++;
+		return iCnt;
+	}
+
+	// UpdatePixCnt counted each cell column by column
+	int CountRectPerPixel(const std::vector<uint8_t> &bits, const int iPitch, const int iX, const int iY, const int iWdt, const int iHgt)
+	{
+		int iCnt = 0;
+		for (int x = iX; x < iX + iWdt; ++x)
+			for (int y = iY; y < iY + iHgt; ++y)
+				if (IsDense(bits[y * iPitch + x]))
+					iCnt++;
+		return iCnt;
+	}
+
+	// SaveDiff masked the whole surface pixel by pixel
+	bool MaskPerPixel(std::vector<uint8_t> &surface, const std::vector<uint8_t> &initial)
+	{
+		bool fChanged = false;
+		for (std::size_t i = 0; i < surface.size(); ++i)
+			if (initial[i] == surface[i])
+				surface[i] = 0xff;
+			else
+				fChanged = true;
+		return fChanged;
+	}
+}
+
+TEST_CASE("CSurface8::CountRow matches a per-pixel count", "[StdSurface8]")
+{
+	const auto pixels = MakePixels(1024, 1);
+	// all lengths and unaligned starts, so every unrolled and remainder path is taken
+	for (int iStart = 0; iStart < 33; ++iStart)
+		for (int iLen = 0; iLen <= 300; ++iLen)
+			REQUIRE(CSurface8::CountRow(pixels.data() + iStart, iLen, IsDense) == CountRowPerPixel(pixels.data() + iStart, iLen));
+}
+
+TEST_CASE("CSurface8::CountRect matches the old PixCnt cell count", "[StdSurface8]")
+{
+	constexpr int iWdt{300}, iHgt{200}, iPitch{304};
+	const auto bits = MakePixels(iPitch * iHgt, 2);
+	// PixCnt cells are 17x15, cut off at the landscape border
+	for (int y = 0; y < iHgt; y += 15)
+		for (int x = 0; x < iWdt; x += 17)
+		{
+			const int iCellWdt{std::min(x + 17, iWdt) - x}, iCellHgt{std::min(y + 15, iHgt) - y};
+			REQUIRE(CSurface8::CountRect(bits.data() + y * iPitch + x, iPitch, iCellWdt, iCellHgt, IsDense) == CountRectPerPixel(bits, iPitch, x, y, iCellWdt, iCellHgt));
+		}
+	REQUIRE(CSurface8::CountRect(bits.data(), iPitch, iWdt, iHgt, IsDense) == CountRectPerPixel(bits, iPitch, 0, 0, iWdt, iHgt));
+	REQUIRE(CSurface8::CountRect(bits.data(), iPitch, 0, iHgt, IsDense) == 0);
+}
+
+TEST_CASE("CSurface8::MaskRowEqual matches the old per-pixel masking", "[StdSurface8]")
+{
+	const auto initial = MakePixels(1000, 3);
+	auto current = initial;
+	std::mt19937 rng{4};
+	std::uniform_int_distribution<std::size_t> pos{0, current.size() - 1};
+	for (int i = 0; i < 50; ++i) current[pos(rng)] ^= 0x21;
+
+	for (int iLen : {0, 1, 15, 16, 17, 63, 64, 65, 999, 1000})
+	{
+		std::vector<uint8_t> expected(current.begin(), current.begin() + iLen), actual{expected};
+		const std::vector<uint8_t> reference(initial.begin(), initial.begin() + iLen);
+		const bool fExpected{MaskPerPixel(expected, reference)};
+		REQUIRE(CSurface8::MaskRowEqual(actual.data(), reference.data(), iLen, 0xff) == fExpected);
+		REQUIRE(actual == expected);
+	}
+
+	// an unchanged row reports no difference
+	auto unchanged = initial;
+	REQUIRE_FALSE(CSurface8::MaskRowEqual(unchanged.data(), initial.data(), static_cast<int>(initial.size()), 0xff));
+}
+
+TEST_CASE("CSurface8::MaskRowEqual matches its scalar version", "[StdSurface8]")
+{
+	const auto initial = MakePixels(1024, 7);
+	auto current = initial;
+	std::mt19937 rng{8};
+	std::uniform_int_distribution<std::size_t> pos{0, current.size() - 1};
+	for (int i = 0; i < 20; ++i) current[pos(rng)] ^= 0x80;
+
+	// all lengths and unaligned starts, so every vector block and remainder is taken, and a single difference in any of them is found
+	for (int iStart = 0; iStart < 17; ++iStart)
+		for (int iLen = 0; iLen <= 300; ++iLen)
+		{
+			std::vector<uint8_t> expected(current.begin() + iStart, current.begin() + iStart + iLen), actual{expected};
+			const uint8_t *const pRef{initial.data() + iStart};
+			REQUIRE(CSurface8::MaskRowEqual(actual.data(), pRef, iLen, 0xff) == CSurface8::MaskRowEqualScalar(expected.data(), pRef, iLen, 0xff));
+			REQUIRE(actual == expected);
+		}
+	for (int iDiff = 0; iDiff < 40; ++iDiff)
+	{
+		std::vector<uint8_t> row(initial.begin(), initial.begin() + 40);
+		row[iDiff] ^= 1;
+		REQUIRE(CSurface8::MaskRowEqual(row.data(), initial.data(), 40, 0xff));
+	}
+}
+
+TEST_CASE("CSurface8::SelectRowByBit clears rows like ClearPix", "[StdSurface8]")
+{
+	constexpr uint8_t IFT{0x80}, Tunnel{0x90};
+	const auto pixels = MakePixels(1024, 9);
+	for (int iStart = 0; iStart < 17; ++iStart)
+		for (int iLen = 0; iLen <= 300; ++iLen)
+		{
+			std::vector<uint8_t> expected(pixels.begin() + iStart, pixels.begin() + iStart + iLen), actual{expected}, scalar{expected};
+			// ClearPix leaves tunnel behind pixels that were in front of it, and sky elsewhere
+			for (uint8_t &byPix : expected) byPix = (byPix & IFT) ? Tunnel : 0;
+			CSurface8::SelectRowByBit(actual.data(), iLen, IFT, Tunnel, 0);
+			CSurface8::SelectRowByBitScalar(scalar.data(), iLen, IFT, Tunnel, 0);
+			REQUIRE(actual == expected);
+			REQUIRE(scalar == expected);
+		}
+}
+
+TEST_CASE("CSurface8::DiffRect builds the same landscape diff as the old full-surface masking", "[StdSurface8]")
+{
+	constexpr int iWdt{200}, iHgt{130}, iTile{64};
+	const auto initial = MakePixels(iWdt * iHgt, 5);
+	auto current = initial;
+	// change a few areas, like digging would
+	for (int y = 20; y < 40; ++y)
+		for (int x = 50; x < 90; ++x)
+			current[y * iWdt + x] = 0;
+	for (int y = 100; y < 130; ++y)
+		current[y * iWdt + 199] = 77;
+
+	// old: mask the whole surface
+	auto expected = current;
+	const bool fExpected{MaskPerPixel(expected, initial)};
+
+	// new: start with an empty diff and only compare tiles (here all of them, with tiles cut off at the border)
+	std::vector<uint8_t> actual(iWdt * iHgt, 0xff);
+	bool fActual = false;
+	for (int y = 0; y < iHgt; y += iTile)
+		for (int x = 0; x < iWdt; x += iTile)
+		{
+			const int iTileWdt{std::min(iTile, iWdt - x)}, iTileHgt{std::min(iTile, iHgt - y)};
+			// the initial tile copy is packed, like C4Landscape::SaveInitialTile does
+			std::vector<uint8_t> tile(iTileWdt * iTileHgt);
+			for (int i = 0; i < iTileHgt; ++i)
+				std::copy_n(initial.data() + (y + i) * iWdt + x, iTileWdt, tile.data() + i * iTileWdt);
+			if (CSurface8::DiffRect(actual.data() + y * iWdt + x, iWdt, current.data() + y * iWdt + x, iWdt, tile.data(), iTileWdt, iTileWdt, iTileHgt, 0xff))
+				fActual = true;
+		}
+	REQUIRE(fActual == fExpected);
+	REQUIRE(actual == expected);
+}
+
+TEST_CASE("CSurface8 row kernels benchmark", "[.][benchmark][StdSurface8]")
+{
+	constexpr int iWdt{2400}, iHgt{1200};
+	const auto initial = MakePixels(iWdt * iHgt, 6);
+	auto current = initial;
+	for (std::size_t i = 0; i < current.size(); i += 97) current[i] ^= 1;
+
+	BENCHMARK("count per pixel")
+	{
+		return CountRectPerPixel(current, iWdt, 0, 0, iWdt, iHgt);
+	};
+	BENCHMARK("CountRect")
+	{
+		return CSurface8::CountRect(current.data(), iWdt, iWdt, iHgt, IsDense);
+	};
+	BENCHMARK_ADVANCED("copy and mask per pixel")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<uint8_t> diff(iWdt * iHgt);
+		meter.measure([&] { diff = current; return MaskPerPixel(diff, initial); });
+	};
+	BENCHMARK_ADVANCED("DiffRect")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<uint8_t> diff(iWdt * iHgt);
+		meter.measure([&] { return CSurface8::DiffRect(diff.data(), iWdt, current.data(), iWdt, initial.data(), iWdt, iWdt, iHgt, 0xff); });
+	};
+	BENCHMARK_ADVANCED("MaskRowEqualScalar")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<uint8_t> diff(iWdt * iHgt);
+		meter.measure([&] { diff = current; return CSurface8::MaskRowEqualScalar(diff.data(), initial.data(), iWdt * iHgt, 0xff); });
+	};
+	BENCHMARK_ADVANCED("MaskRowEqual")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<uint8_t> diff(iWdt * iHgt);
+		meter.measure([&] { diff = current; return CSurface8::MaskRowEqual(diff.data(), initial.data(), iWdt * iHgt, 0xff); });
+	};
+	BENCHMARK_ADVANCED("clear per pixel")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<uint8_t> cleared(iWdt * iHgt);
+		meter.measure([&]
+		{
+			cleared = current;
+			for (int y = 0; y < iHgt; ++y)
+				for (int x = 0; x < iWdt; ++x)
+					cleared[y * iWdt + x] = (cleared[y * iWdt + x] & 0x80) ? 0x90 : 0;
+			return cleared[0];
+		});
+	};
+	BENCHMARK_ADVANCED("SelectRowByBitScalar")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<uint8_t> cleared(iWdt * iHgt);
+		meter.measure([&]
+		{
+			cleared = current;
+			for (int y = 0; y < iHgt; ++y) CSurface8::SelectRowByBitScalar(cleared.data() + y * iWdt, iWdt, 0x80, 0x90, 0);
+			return cleared[0];
+		});
+	};
+	BENCHMARK_ADVANCED("SelectRowByBit")(Catch::Benchmark::Chronometer meter)
+	{
+		std::vector<uint8_t> cleared(iWdt * iHgt);
+		meter.measure([&]
+		{
+			cleared = current;
+			for (int y = 0; y < iHgt; ++y) CSurface8::SelectRowByBit(cleared.data() + y * iWdt, iWdt, 0x80, 0x90, 0);
+			return cleared[0];
+		});
+	};
+}
@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+
+# Compares the screenshots saved by the /landscapecompare chat command:
+# the landscape drawn by the landscape shader (Graphics.ShaderLandscape) and
+# the same frame drawn from the lit 32 bit landscape surface.
+# Both are expected to be byte-identical.
+
+import argparse
+from pathlib import Path
+import struct
+import sys
+import zlib
+
+PNG_SIGNATURE = b'\x89PNG\r\n\x1a\n'
+
+def main():
+	ap = argparse.ArgumentParser(
+		description='Compare the landscape screenshots of the shader and the classic renderer')
+	ap.add_argument('shader', type=Path, help='LandscapeShader.png')
+	ap.add_argument('classic', type=Path, help='LandscapeClassic.png')
+	ap.add_argument('-d', '--diff', type=Path,
+		help='Write an image marking the differing pixels in red.')
+	args = ap.parse_args()
+
+	width, height, shader = read_png(args.shader)
+	classic_size = read_png(args.classic)
+	if classic_size[:2] != (width, height):
+		sys.exit(f'Size mismatch: {width}x{height} vs. {classic_size[0]}x{classic_size[1]}')
+	classic = classic_size[2]
+
+	differing = 0
+	max_delta = 0
+	diff = bytearray(width * height * 3)
+	for i in range(width * height):
+		a = shader[i * 3:i * 3 + 3]
+		b = classic[i * 3:i * 3 + 3]
+		if a != b:
+			differing += 1
+			max_delta = max(max_delta, *(abs(x - y) for x, y in zip(a, b)))
+			diff[i * 3] = 255
+		else:
+			# dimmed original for orientation
+			diff[i * 3:i * 3 + 3] = bytes(c // 4 for c in a)
+
+	print(f'{width}x{height} pixels, {differing} differing '
+		f'({100 * differing / (width * height):.4f}%), max channel delta {max_delta}')
+	if args.diff:
+		write_png(args.diff, width, height, diff)
+	return 1 if differing else 0
+
+def read_png(path):
+	data = path.read_bytes()
+	if not data.startswith(PNG_SIGNATURE):
+		sys.exit(f'{path}: not a PNG file')
+	pos = len(PNG_SIGNATURE)
+	idat = b''
+	while pos < len(data):
+		length, chunk_type = struct.unpack('>I4s', data[pos:pos + 8])
+		chunk = data[pos + 8:pos + 8 + length]
+		pos += length + 12
+		if chunk_type == b'IHDR':
+			width, height, depth, color_type, _, _, interlace = struct.unpack('>IIBBBBB', chunk)
+			if depth != 8 or color_type not in (2, 6) or interlace:
+				sys.exit(f'{path}: only non-interlaced 8 bit RGB(A) images are supported')
+		elif chunk_type == b'IDAT':
+			idat += chunk
+		elif chunk_type == b'IEND':
+			break
+
+	bpp = 3 if color_type == 2 else 4
+	stride = width * bpp
+	raw = zlib.decompress(idat)
+	pixels = bytearray()
+	prev = bytearray(stride)
+	for y in range(height):
+		filter_type = raw[y * (stride + 1)]
+		line = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+		for x in range(stride):
+			left = line[x - bpp] if x >= bpp else 0
+			up = prev[x]
+			up_left = prev[x - bpp] if x >= bpp else 0
+			if filter_type == 1:
+				line[x] = (line[x] + left) & 0xff
+			elif filter_type == 2:
+				line[x] = (line[x] + up) & 0xff
+			elif filter_type == 3:
+				line[x] = (line[x] + (left + up) // 2) & 0xff
+			elif filter_type == 4:
+				p = left + up - up_left
+				pa, pb, pc = abs(p - left), abs(p - up), abs(p - up_left)
+				predictor = left if pa <= pb and pa <= pc else up if pb <= pc else up_left
+				line[x] = (line[x] + predictor) & 0xff
+		prev = line
+		if bpp == 3:
+			pixels += line
+		else:
+			for x in range(width):
+				pixels += line[x * 4:x * 4 + 3]
+	return width, height, bytes(pixels)
+
+def write_png(path, width, height, pixels):
+	def chunk(chunk_type, data):
+		return struct.pack('>I', len(data)) + chunk_type + data + struct.pack('>I', zlib.crc32(chunk_type + data))
+
+	stride = width * 3
+	raw = b''.join(b'\0' + pixels[y * stride:(y + 1) * stride] for y in range(height))
+	path.write_bytes(PNG_SIGNATURE
+		+ chunk(b'IHDR', struct.pack('>IIBBBBB', width, height, 8, 2, 0, 0, 0))
+		+ chunk(b'IDAT', zlib.compress(raw))
+		+ chunk(b'IEND', b''))
+
+if __name__ == '__main__':
+	sys.exit(main())